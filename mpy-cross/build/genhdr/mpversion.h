@@ -0,0 +1,4 @@
+// This file was generated by py/makeversionhdr.py
+#define MICROPY_GIT_TAG "e49176a-dirty"
+#define MICROPY_GIT_HASH "e49176a"
+#define MICROPY_BUILD_DATE "2026-10-19"
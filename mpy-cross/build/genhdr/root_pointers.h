@@ -0,0 +1,3 @@
+// Automatically generated by make_root_pointers.py.
+
+struct _mp_str_index_t *str_index_cache[(2)];
@@ -58,6 +58,10 @@
 #define MICROPY_COMP_DOUBLE_TUPLE_ASSIGN (1)
 #define MICROPY_COMP_TRIPLE_TUPLE_ASSIGN (1)
 #define MICROPY_COMP_RETURN_IF_EXPR (1)
+#define MICROPY_COMP_SUPERINSTRUCTIONS (1)
+#define MICROPY_COMP_STR_FORMAT     (1)
+#define MICROPY_COMP_BINARY_OP_TEMP (1)
+#define MICROPY_COMP_CONTROL_FLOW_OPT (1)
 
 #define MICROPY_READER_POSIX        (1)
 #define MICROPY_ENABLE_RUNTIME      (0)
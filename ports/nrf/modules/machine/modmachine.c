@@ -152,8 +152,8 @@ static mp_obj_t machine_info(mp_uint_t n_args, const mp_obj_t *args) {
 
     // qstr info
     {
-        mp_uint_t n_pool, n_qstr, n_str_data_bytes, n_total_bytes;
-        qstr_pool_info(&n_pool, &n_qstr, &n_str_data_bytes, &n_total_bytes);
+        mp_uint_t n_pool, n_qstr, n_str_data_bytes, n_total_bytes, n_reclaimed_bytes;
+        qstr_pool_info(&n_pool, &n_qstr, &n_str_data_bytes, &n_total_bytes, &n_reclaimed_bytes);
         printf("qstr:\n  n_pool=" UINT_FMT "\n  n_qstr=" UINT_FMT "\n  n_str_data_bytes=" UINT_FMT "\n  n_total_bytes=" UINT_FMT "\n", n_pool, n_qstr, n_str_data_bytes, n_total_bytes);
     }
 
@@ -132,8 +132,8 @@ static mp_obj_t machine_info(size_t n_args, const mp_obj_t *args) {
 
     // qstr info
     {
-        size_t n_pool, n_qstr, n_str_data_bytes, n_total_bytes;
-        qstr_pool_info(&n_pool, &n_qstr, &n_str_data_bytes, &n_total_bytes);
+        size_t n_pool, n_qstr, n_str_data_bytes, n_total_bytes, n_reclaimed_bytes;
+        qstr_pool_info(&n_pool, &n_qstr, &n_str_data_bytes, &n_total_bytes, &n_reclaimed_bytes);
         printf("qstr:\n  n_pool=%u\n  n_qstr=%u\n  n_str_data_bytes=%u\n  n_total_bytes=%u\n", n_pool, n_qstr, n_str_data_bytes, n_total_bytes);
     }
 
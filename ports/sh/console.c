@@ -102,6 +102,18 @@ bool linebuf_init(linebuf_t *buf, int capacity, int backlog_size)
         return false;
     memset(buf->lines, 0, capacity * sizeof *buf->lines);
 
+    /* Enough text storage for the backlog, the headers and alignment of every
+       line, the edited line, and the space wasted when wrapping around. */
+    int text_size = backlog_size
+        + capacity * (CONSOLE_FLINE_SIZE + 1 + TEXTARENA_ALIGN - 1)
+        + 2 * CONSOLE_LINE_ALLOC_SIZE;
+    void *text = kmalloc(text_size, PE_CONSOLE_LINE_ALLOC);
+    if(!text) {
+        kfree((void *)buf->lines);
+        return false;
+    }
+    textarena_init(&buf->text, text, text_size);
+
     stredit_init(&buf->edit, 0, 0, 0);
 
     buf->capacity = capacity;
@@ -118,9 +130,8 @@ bool linebuf_init(linebuf_t *buf, int capacity, int backlog_size)
 void linebuf_deinit(linebuf_t *buf)
 {
     stredit_reset(&buf->edit);
-    for(int i = 0; i < buf->capacity; i++)
-        free(buf->lines[i]);
     kfree((void *)buf->lines);
+    kfree(buf->text.data);
     memset(buf, 0, sizeof *buf);
 }
 
@@ -184,13 +195,15 @@ stredit_t *linebuf_newline(linebuf_t *buf)
     /* Make space if the buffer is full */
     linebuf_recycle_oldest_lines(buf, buf->size - buf->capacity + 1);
 
-    /* Freeze the current last line and reset the editor */
+    /* Freeze the current last line, give back the unused part of its
+       allocation, and reset the editor */
     if(buf->size > 0) {
         buf->total_size_except_last += buf->edit.size;
 
         int size = buf->edit.size;
         console_fline_t *frozen = (void *)stredit_freeze_and_reset(&buf->edit);
         frozen->size = size;
+        textarena_shrink_last(&buf->text, frozen, CONSOLE_FLINE_SIZE+size+1);
 
         int last_nth = linebuf_nth_to_index(buf, buf->size - 1);
         assert(buf->lines[last_nth] == NULL);
@@ -200,8 +213,19 @@ stredit_t *linebuf_newline(linebuf_t *buf)
     buf->size++;
     int last_nth = linebuf_nth_to_index(buf, buf->size - 1);
     buf->lines[last_nth] = NULL;
-    stredit_init(&buf->edit, 16, CONSOLE_FLINE_SIZE,
-        PE_CONSOLE_LINE_MAX_LENGTH);
+
+    /* Reserve a full-length line for edition, recycling old lines until it
+       fits. Once only the new line is left the arena is empty, and it always
+       has room for one line. */
+    char *raw = textarena_alloc(&buf->text, CONSOLE_LINE_ALLOC_SIZE);
+    while(!raw && buf->size > 1) {
+        linebuf_recycle_oldest_lines(buf, 1);
+        raw = textarena_alloc(&buf->text, CONSOLE_LINE_ALLOC_SIZE);
+    }
+    assert(raw != NULL);
+
+    stredit_init_buffer(&buf->edit, raw, CONSOLE_LINE_ALLOC_SIZE,
+        CONSOLE_FLINE_SIZE, PE_CONSOLE_LINE_MAX_LENGTH);
     return &buf->edit;
 }
 
@@ -218,12 +242,22 @@ void linebuf_recycle_oldest_lines(linebuf_t *buf, int count)
         buf->total_rendered -= FL->render_lines;
         if(nth != buf->size - 1)
             buf->total_size_except_last -= FL->size;
-        free(FL);
     }
 
+    /* Recycling the last line also ends its edition */
+    if(count == buf->size)
+        stredit_reset(&buf->edit);
+
     buf->start = linebuf_index_add(buf, buf->start, count);
     buf->size -= count;
     buf->absolute += count;
+
+    /* Free the text storage up to the new oldest line */
+    console_fline_t *oldest = linebuf_get_nth_line(buf, 0);
+    if(oldest)
+        textarena_free_until(&buf->text, oldest);
+    else
+        textarena_free_all(&buf->text);
 }
 
 void linebuf_clean_backlog(linebuf_t *buf)
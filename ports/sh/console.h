@@ -27,18 +27,14 @@
 #include <gint/defs/attributes.h>
 #include <stdbool.h>
 #include "stredit.h"
+#include "textarena.h"
 
 /* Maximum line length, to ensure the console can threshold its memory usage
    while cleaning only entire lines. Lines longer than this get split. */
 #define PE_CONSOLE_LINE_MAX_LENGTH 1024
 
-/* Allocation arena for arrays of lines. */
-// TODO: Split circular buffers
-#ifdef FX9860G
+/* kmalloc arena for the array of lines and the text storage. */
 #define PE_CONSOLE_LINE_ALLOC NULL
-#else
-#define PE_CONSOLE_LINE_ALLOC NULL
-#endif
 
 //=== Static console lines ===//
 
@@ -59,6 +55,10 @@ typedef struct
 /* sizeof(console_fline_t) without alignment */
 #define CONSOLE_FLINE_SIZE 3
 
+/* Size reserved in the text arena for the line being edited. */
+#define CONSOLE_LINE_ALLOC_SIZE \
+    (CONSOLE_FLINE_SIZE + PE_CONSOLE_LINE_MAX_LENGTH + 1)
+
 /* Update the number of render lines for the chosen width. */
 void console_fline_update_render_lines(console_fline_t *FL, int width);
 
@@ -76,9 +76,13 @@ typedef struct
        there is one, is stored as NULL and its address is edit->raw. */
     console_fline_t **lines;
     /* Editor for the last line. The pointer to the last line is stored there
-       instead of in the `lines` array because it gets reallocated regularly
-       during edition. */
+       instead of in the `lines` array because it is still being edited. */
     stredit_t edit;
+    /* Storage for the text of all lines, in order. The last line is edited in
+       place within a full-length allocation which is shrunk when the line is
+       frozen, so printing never calls malloc(). Recycling old lines advances
+       the arena's tail. */
+    textarena_t text;
 
     /* Invariants:
        - capacity > 0
@@ -115,9 +119,10 @@ typedef struct
 
 } linebuf_t;
 
-/* Initialize a rotating buffer by allocating `line_count` lines. The buffer
-   will allow up to `backlog_size` bytes of text data and clean up lines past
-   that limit. This function does not free pre-existing data in `buf`. */
+/* Initialize a rotating buffer by allocating `line_count` lines and the text
+   storage. The buffer will allow up to `backlog_size` bytes of text data and
+   clean up lines past that limit. This function does not free pre-existing
+   data in `buf`. */
 bool linebuf_init(linebuf_t *buf, int capacity, int backlog_size);
 
 /* Free a rotating buffer and clean it up. */
@@ -10,6 +10,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "py/mpstate.h"
+#include "py/mphal.h"
+#include "vcapture.h"
 
 #if GINT_RENDER_MONO
 #include <gint/gray.h>
@@ -173,6 +175,9 @@ static bool timeout_popup(void)
 #endif
 
 static bool videocapture = false;
+/* Compressed video capture encoder, allocated while recording */
+static vcapture_t vc;
+static bool vc_ready = false;
 
 void pe_debug_init(void)
 {
@@ -250,21 +255,88 @@ void pe_debug_screenshot(void)
 void pe_debug_toggle_videocapture(void)
 {
     videocapture = !videocapture;
+
+    /* This might be called asynchronously from the keyboard driver, so only
+       release the encoder's memory at the next frame */
+    if(videocapture)
+        vc_ready = false;
+}
+
+/* Get the frame that is currently on-screen, as 16-bit words. */
+static uint16_t const *videocapture_frame(int *row_words, int *format)
+{
+#if GINT_RENDER_RGB
+    uint16_t *main, *secondary;
+    dgetvram(&main, &secondary);
+    *row_words = DWIDTH;
+    *format = VCAPTURE_RGB565;
+    /* dupdate() has just switched to drawing in the other VRAM */
+    return (gint_vram == main) ? secondary : main;
+#else
+    *row_words = DWIDTH / 16;
+    *format = VCAPTURE_MONO;
+    return (void *)gint_vram;
+#endif
+}
+
+static void vc_usb_write(void *env, void const *data, int size)
+{
+    usb_write_sync((intptr_t)env, data, size, false);
 }
 
 void pe_debug_run_videocapture(void)
 {
-    if(videocapture) {
-        usb_open_wait();
+    if(!videocapture) {
+        if(vc.row_hash)
+            vcapture_deinit(&vc);
+        return;
+    }
+
+    usb_open_wait();
 #if GINT_RENDER_MONO
-        if(dgray_enabled())
-            usb_fxlink_videocapture_gray(true);
-        else
-            usb_fxlink_videocapture(true);
-#else
-        usb_fxlink_videocapture(true);
+    if(dgray_enabled()) {
+        usb_fxlink_videocapture_gray(true);
+        return;
+    }
 #endif
+
+    int row_words, format;
+    uint16_t const *frame = videocapture_frame(&row_words, &format);
+
+    /* (Re)start the stream with a keyframe; if there's not enough memory for
+       the encoder, fall back to sending full frames */
+    if(!vc_ready) {
+        if(vc.row_hash)
+            vcapture_deinit(&vc);
+        vc_ready = vcapture_init(&vc, DWIDTH, DHEIGHT, row_words, format);
+        if(!vc_ready) {
+            usb_fxlink_videocapture(true);
+            return;
+        }
     }
+
+    mp_uint_t t0 = mp_hal_ticks_us();
+    int size = vcapture_prepare(&vc, frame);
+    mp_uint_t t1 = mp_hal_ticks_us();
+    vc.prepare_us = t1 - t0;
+
+    usb_fxlink_header_t header;
+    if(!usb_fxlink_fill_header(&header, "pe", "vcframe", size)) {
+        vcapture_request_keyframe(&vc);
+        return;
+    }
+
+    int pipe = usb_ff_bulk_output();
+    vcapture_sink_t sink = {
+        .write = vc_usb_write,
+        .env = (void *)(intptr_t)pipe,
+    };
+    usb_write_sync(pipe, &header, sizeof header, false);
+    vcapture_emit(&vc, frame, &sink);
+    usb_commit_sync(pipe);
+
+    /* Reported in the next frame so the host can see the full cost */
+    vc.prev_send_us = mp_hal_ticks_us() - t1;
 }
 
 void pe_debug_close(void)
@@ -85,7 +85,9 @@ void pe_debug_screenshot(void);
 /* Toggle video capture. */
 void pe_debug_toggle_videocapture(void);
 
-/* Send a video capture frame if video capture is enabled. */
+/* Send a video capture frame if video capture is enabled. Frames are sent
+   compressed (see vcapture.h) and decoded with ports/sh/tools/vcdecode.py,
+   except in gray mode where gint's full-frame capture is used. */
 void pe_debug_run_videocapture(void);
 
 /* Close the debugging ressources */
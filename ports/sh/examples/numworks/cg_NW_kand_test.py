@@ -7,7 +7,7 @@ draw_string( "Hello Kandinsky", 10, 200, "k" )
 
 fill_rect( 25, 25, 100, 100, 00000 )
 fill_rect( 60, 25, 10, 100, 65000 )
-fill_rect( 25, 60, 100, 10, 00031 ) 
+fill_rect( 25, 60, 100, 10, 31 )
 
 fill_rect( 100, 100, 25, 25, "green" )
 
@@ -0,0 +1,450 @@
+//---------------------------------------------------------------------------//
+//    ____        PythonExtra                                                //
+//.-'`_ o `;__,   A community port of MicroPython for CASIO calculators.     //
+//.-'` `---`  '   License: MIT (except some files; see LICENSE)              //
+//---------------------------------------------------------------------------//
+
+#include "hostgint.h"
+#include "internal.h"
+#include <gint/display.h>
+#include <gint/defs/util.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+static uint16_t vram[DWIDTH * DHEIGHT];
+static uint16_t screen[DWIDTH * DHEIGHT];
+static uint32_t frames;
+
+uint16_t *gint_vram = vram;
+struct dwindow dwindow = { 0, 0, DWIDTH, DHEIGHT };
+
+void hostgint_display_reset(void)
+{
+    memset(vram, 0xff, sizeof vram);
+    memset(screen, 0xff, sizeof screen);
+    dwindow = (struct dwindow){ 0, 0, DWIDTH, DHEIGHT };
+    frames = 0;
+}
+
+uint32_t hostgint_frames(void)
+{
+    return frames;
+}
+
+void dupdate(void)
+{
+    memcpy(screen, vram, sizeof screen);
+    frames++;
+    hostgint_poll_timers();
+}
+
+struct dwindow dwindow_set(struct dwindow w)
+{
+    struct dwindow old = dwindow;
+    dwindow.left = max(w.left, 0);
+    dwindow.top = max(w.top, 0);
+    dwindow.right = min(w.right, DWIDTH);
+    dwindow.bottom = min(w.bottom, DHEIGHT);
+    return old;
+}
+
+//=== Pixel-level primitives ===//
+
+void hostgint_pixel(int x, int y, int color)
+{
+    if(color == C_NONE || x < dwindow.left || x >= dwindow.right
+       || y < dwindow.top || y >= dwindow.bottom)
+        return;
+    uint16_t *p = &vram[DWIDTH * y + x];
+    *p = (color == C_INVERT) ? ~*p : color;
+}
+
+void hostgint_hspan(int x1, int x2, int y, int color)
+{
+    if(color == C_NONE || y < dwindow.top || y >= dwindow.bottom)
+        return;
+    x1 = max(x1, dwindow.left);
+    x2 = min(x2, dwindow.right - 1);
+
+    uint16_t *p = &vram[DWIDTH * y];
+    for(int x = x1; x <= x2; x++)
+        p[x] = (color == C_INVERT) ? ~p[x] : color;
+}
+
+static void rect(int x1, int y1, int x2, int y2, int color)
+{
+    if(x1 > x2) swap(x1, x2);
+    if(y1 > y2) swap(y1, y2);
+    y1 = max(y1, dwindow.top);
+    y2 = min(y2, dwindow.bottom - 1);
+    for(int y = y1; y <= y2; y++)
+        hostgint_hspan(x1, x2, y, color);
+}
+
+static void line(int x1, int y1, int x2, int y2, int color)
+{
+    if(y1 == y2) {
+        if(x1 > x2) swap(x1, x2);
+        hostgint_hspan(x1, x2, y1, color);
+        return;
+    }
+
+    /* Bresenham's algorithm */
+    int dx = abs(x2 - x1), sx = (x1 < x2) ? 1 : -1;
+    int dy = -abs(y2 - y1), sy = (y1 < y2) ? 1 : -1;
+    int err = dx + dy;
+
+    while(1) {
+        hostgint_pixel(x1, y1, color);
+        if(x1 == x2 && y1 == y2)
+            break;
+        int e2 = 2 * err;
+        if(e2 >= dy) {
+            err += dy;
+            x1 += sx;
+        }
+        if(e2 <= dx) {
+            err += dx;
+            y1 += sy;
+        }
+    }
+}
+
+/* Ellipse inscribed in [x1..x2] x [y1..y2], drawn row by row. Each row is a
+   span; border pixels are the ends of each span and the pixels that stick out
+   of the spans of the rows above or below. */
+static void ellipse(int x1, int y1, int x2, int y2, int fill, int border)
+{
+    if(x1 > x2) swap(x1, x2);
+    if(y1 > y2) swap(y1, y2);
+
+    int rows = y2 - y1 + 1;
+    int *left = malloc(2 * (rows + 2) * sizeof *left);
+    if(!left)
+        return;
+    int *right = left + rows + 2;
+
+    double cx = (x1 + x2) / 2.0, cy = (y1 + y2) / 2.0;
+    double a = (x2 - x1 + 1) / 2.0, b = (y2 - y1 + 1) / 2.0;
+
+    /* Spans with one empty row on each side; empty spans have left > right */
+    left[0] = left[rows + 1] = 1;
+    right[0] = right[rows + 1] = 0;
+    for(int i = 0; i < rows; i++) {
+        /* Pixel x is inside if its center is */
+        double ny = (y1 + i - cy) / b;
+        double half = a * sqrt(max(1 - ny * ny, 0.0));
+        left[i+1] = (int)ceil(cx - half - 1e-9);
+        right[i+1] = (int)floor(cx + half + 1e-9);
+        /* Keep at least one pixel on very narrow rows */
+        if(left[i+1] > right[i+1])
+            left[i+1] = right[i+1] = (int)floor(cx + 0.5);
+    }
+
+    for(int i = 1; i <= rows; i++) {
+        int y = y1 + i - 1;
+        int l = left[i], r = right[i];
+        if(l > r)
+            continue;
+        if(border == C_NONE) {
+            hostgint_hspan(l, r, y, fill);
+            continue;
+        }
+        /* Interior: inside this row and both neighbors, excluding ends */
+        int il = max(l + 1, max(left[i-1], left[i+1]));
+        int ir = min(r - 1, min(right[i-1], right[i+1]));
+        if(il <= ir) {
+            hostgint_hspan(l, il - 1, y, border);
+            hostgint_hspan(il, ir, y, fill);
+            hostgint_hspan(ir + 1, r, y, border);
+        }
+        else {
+            hostgint_hspan(l, r, y, border);
+        }
+    }
+
+    free(left);
+}
+
+/* Scanline polygon fill with the even-odd rule, sampling pixel centers. */
+static void poly_fill(int const *x, int const *y, int N, int color)
+{
+    int ymin = y[0], ymax = y[0];
+    for(int i = 1; i < N; i++) {
+        ymin = min(ymin, y[i]);
+        ymax = max(ymax, y[i]);
+    }
+    ymin = max(ymin, dwindow.top);
+    ymax = min(ymax, dwindow.bottom - 1);
+
+    double *nodes = malloc(N * sizeof *nodes);
+    if(!nodes)
+        return;
+
+    for(int py = ymin; py <= ymax; py++) {
+        double sy = py + 0.5;
+        int count = 0;
+        for(int i = 0, j = N - 1; i < N; j = i++) {
+            if((y[i] + 0.5 <= sy) == (y[j] + 0.5 <= sy))
+                continue;
+            double t = (sy - y[i] - 0.5) / (y[j] - y[i]);
+            nodes[count++] = x[i] + t * (x[j] - x[i]);
+        }
+        /* Insertion sort; there are few nodes per row */
+        for(int i = 1; i < count; i++) {
+            double v = nodes[i];
+            int k = i;
+            for(; k > 0 && nodes[k-1] > v; k--)
+                nodes[k] = nodes[k-1];
+            nodes[k] = v;
+        }
+        for(int i = 0; i + 1 < count; i += 2)
+            hostgint_hspan((int)ceil(nodes[i]), (int)floor(nodes[i+1]), py,
+                color);
+    }
+
+    free(nodes);
+}
+
+//=== Public drawing functions ===//
+
+void dclear(int color)
+{
+    HOSTGINT_PROFILE(dclear, {
+        if(color != C_NONE)
+            for(int i = 0; i < DWIDTH * DHEIGHT; i++)
+                vram[i] = (color == C_INVERT) ? ~vram[i] : color;
+    });
+}
+
+void drect(int x1, int y1, int x2, int y2, int color)
+{
+    HOSTGINT_PROFILE(drect, rect(x1, y1, x2, y2, color));
+}
+
+void drect_border(int x1, int y1, int x2, int y2, int fill_color,
+    int border_width, int border_color)
+{
+    HOSTGINT_PROFILE(drect_border, {
+        if(x1 > x2) swap(x1, x2);
+        if(y1 > y2) swap(y1, y2);
+        int bw = border_width;
+        rect(x1 + bw, y1 + bw, x2 - bw, y2 - bw, fill_color);
+        if(bw > 0) {
+            rect(x1, y1, x2, y1 + bw - 1, border_color);
+            rect(x1, y2 - bw + 1, x2, y2, border_color);
+            rect(x1, y1 + bw, x1 + bw - 1, y2 - bw, border_color);
+            rect(x2 - bw + 1, y1 + bw, x2, y2 - bw, border_color);
+        }
+    });
+}
+
+void dpixel(int x, int y, int color)
+{
+    HOSTGINT_PROFILE(dpixel, hostgint_pixel(x, y, color));
+}
+
+int dgetpixel(int x, int y)
+{
+    int color = -1;
+    HOSTGINT_PROFILE(dgetpixel, {
+        if(x >= 0 && x < DWIDTH && y >= 0 && y < DHEIGHT)
+            color = vram[DWIDTH * y + x];
+    });
+    return color;
+}
+
+void dline(int x1, int y1, int x2, int y2, int color)
+{
+    HOSTGINT_PROFILE(dline, line(x1, y1, x2, y2, color));
+}
+
+void dhline(int y, int color)
+{
+    HOSTGINT_PROFILE(dhline,
+        hostgint_hspan(dwindow.left, dwindow.right - 1, y, color));
+}
+
+void dvline(int x, int color)
+{
+    HOSTGINT_PROFILE(dvline, {
+        for(int y = dwindow.top; y < dwindow.bottom; y++)
+            hostgint_pixel(x, y, color);
+    });
+}
+
+void dcircle(int xc, int yc, int r, int fill_color, int border_color)
+{
+    HOSTGINT_PROFILE(dcircle, {
+        if(r >= 0)
+            ellipse(xc - r, yc - r, xc + r, yc + r, fill_color,
+                border_color);
+    });
+}
+
+void dellipse(int x1, int y1, int x2, int y2, int fill_color,
+    int border_color)
+{
+    HOSTGINT_PROFILE(dellipse,
+        ellipse(x1, y1, x2, y2, fill_color, border_color));
+}
+
+void dpoly(int const *x, int const *y, int N, int fill_color,
+    int border_color)
+{
+    HOSTGINT_PROFILE(dpoly, {
+        if(N >= 3 && fill_color != C_NONE)
+            poly_fill(x, y, N, fill_color);
+        if(N >= 2 && border_color != C_NONE) {
+            for(int i = 0; i < N; i++) {
+                int j = (i + 1) % N;
+                line(x[i], y[i], x[j], y[j], border_color);
+            }
+        }
+    });
+}
+
+//=== Images (bopti) ===//
+
+static int be16(uint8_t const *p)
+{
+    return (p[0] << 8) | p[1];
+}
+
+/* Color of pixel (x,y) of the image, or C_NONE if transparent. */
+static int image_pixel(image_t const *img, int x, int y)
+{
+    uint8_t const *row = (uint8_t const *)img->data + y * img->stride;
+    uint8_t const *palette = (uint8_t const *)img->palette;
+    int index;
+
+    switch(img->format) {
+    case IMAGE_RGB565:
+        return be16(row + 2 * x);
+    case IMAGE_RGB565A: {
+        int c = be16(row + 2 * x);
+        return (c == 0x0001) ? C_NONE : c;
+    }
+    case IMAGE_P8_RGB565:
+    case IMAGE_P8_RGB565A:
+        index = (int8_t)row[x] + 128;
+        break;
+    case IMAGE_P4_RGB565:
+    case IMAGE_P4_RGB565A:
+        index = (x & 1) ? (row[x >> 1] & 15) : (row[x >> 1] >> 4);
+        break;
+    default:
+        return C_NONE;
+    }
+
+    if(IMAGE_IS_ALPHA(img->format) && index == 0)
+        return C_NONE;
+    if(!palette || index >= img->color_count)
+        return C_NONE;
+    return be16(palette + 2 * index);
+}
+
+static void subimage(int x, int y, image_t const *img, int left, int top,
+    int w, int h)
+{
+    if(!img || !img->data)
+        return;
+
+    /* Clip to the image, then to the window */
+    if(left < 0) w += left, x -= left, left = 0;
+    if(top < 0) h += top, y -= top, top = 0;
+    w = min(w, img->width - left);
+    h = min(h, img->height - top);
+
+    int x0 = max(x, dwindow.left), x1 = min(x + w, dwindow.right);
+    int y0 = max(y, dwindow.top), y1 = min(y + h, dwindow.bottom);
+
+    for(int dy = y0; dy < y1; dy++) {
+        uint16_t *p = &vram[DWIDTH * dy];
+        for(int dx = x0; dx < x1; dx++) {
+            int c = image_pixel(img, left + dx - x, top + dy - y);
+            if(c != C_NONE)
+                p[dx] = c;
+        }
+    }
+}
+
+void dimage(int x, int y, bopti_image_t const *image)
+{
+    HOSTGINT_PROFILE(dimage,
+        subimage(x, y, image, 0, 0, image->width, image->height));
+}
+
+void dsubimage(int x, int y, bopti_image_t const *image, int left, int top,
+    int width, int height, int flags)
+{
+    (void)flags;
+    HOSTGINT_PROFILE(dsubimage,
+        subimage(x, y, image, left, top, width, height));
+}
+
+//=== Screen access for the runner ===//
+
+uint16_t const *hostgint_screen(void)
+{
+    return screen;
+}
+
+uint32_t hostgint_screen_hash(void)
+{
+    uint32_t h = 2166136261u;
+    for(int i = 0; i < DWIDTH * DHEIGHT; i++)
+        h = (h ^ screen[i]) * 16777619u;
+    return h;
+}
+
+static void rgb888(uint16_t c, uint8_t *out)
+{
+    out[0] = ((c >> 11) & 0x1f) * 255 / 31;
+    out[1] = ((c >> 5) & 0x3f) * 255 / 63;
+    out[2] = (c & 0x1f) * 255 / 31;
+}
+
+bool hostgint_save_ppm(char const *path)
+{
+    FILE *fp = fopen(path, "wb");
+    if(!fp)
+        return false;
+
+    fprintf(fp, "P6\n%d %d\n255\n", DWIDTH, DHEIGHT);
+    for(int i = 0; i < DWIDTH * DHEIGHT; i++) {
+        uint8_t rgb[3];
+        rgb888(screen[i], rgb);
+        fwrite(rgb, 3, 1, fp);
+    }
+    return fclose(fp) == 0;
+}
+
+int hostgint_compare_ppm(char const *path)
+{
+    FILE *fp = fopen(path, "rb");
+    if(!fp)
+        return -1;
+
+    int w, h, maxval;
+    if(fscanf(fp, "P6 %d %d %d", &w, &h, &maxval) != 3 || fgetc(fp) < 0
+       || w != DWIDTH || h != DHEIGHT || maxval != 255) {
+        fclose(fp);
+        return -1;
+    }
+
+    int diff = 0;
+    for(int i = 0; i < DWIDTH * DHEIGHT; i++) {
+        uint8_t expected[3], rgb[3];
+        if(fread(expected, 3, 1, fp) != 1) {
+            diff = -1;
+            break;
+        }
+        rgb888(screen[i], rgb);
+        diff += (memcmp(expected, rgb, 3) != 0);
+    }
+
+    fclose(fp);
+    return diff;
+}
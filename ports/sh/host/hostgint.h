@@ -0,0 +1,143 @@
+//---------------------------------------------------------------------------//
+//    ____        PythonExtra                                                //
+//.-'`_ o `;__,   A community port of MicroPython for CASIO calculators.     //
+//.-'` `---`  '   License: MIT (except some files; see LICENSE)              //
+//---------------------------------------------------------------------------//
+// pe.hostgint: Headless gint for running the sh port on a computer
+//
+// The host build links the interpreter and the gint/casioplot/kandinsky
+// modules against a small reimplementation of the parts of gint they use
+// (include/gint and the other files of this folder). Nothing is displayed:
+// drawing goes to an in-memory VRAM, dupdate() only counts frames, and key
+// events come from a script instead of the keyboard. This is enough to run
+// the perftest programs and examples at full speed, time them, and compare
+// the final screen against golden images.
+//
+// Key scripts are text files with one event per line:
+//   <frame> <KEY> [down|up|press]
+// where <frame> is the number of dupdate() calls after which the event is
+// delivered, <KEY> is a gint key name without the KEY_ prefix (EXE, LEFT,
+// F1...) and "press" (the default) is a key down followed by a key up one
+// frame later. Lines starting with '#' are comments. When a program waits
+// for a key with getkey(), host_idle() is called to let timers and pending
+// redraws run, then the next event is delivered immediately instead of
+// waiting for its frame, so that menus don't need exact frame numbers. If
+// there are no events left, host_input_exhausted() is called.
+//
+// Fonts are placeholders: glyphs are boxes with a pattern that depends on
+// the character. They have the size of the calculator's fonts, so layouts
+// are preserved, but golden images are only meaningful for this build.
+//---
+
+#ifndef __PYTHONEXTRA_HOSTGINT_H
+#define __PYTHONEXTRA_HOSTGINT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+//=== Setup ===//
+
+/* Reset display, keyboard, timers and profile before running a program. */
+void hostgint_reset(void);
+
+/* Load a key script. Returns false and prints an error if it's invalid. */
+bool hostgint_load_keys(char const *path);
+
+/* Number of dupdate() calls since the last reset. */
+uint32_t hostgint_frames(void);
+
+/* Number of events not yet delivered from the key script. */
+int hostgint_keys_left(void);
+
+//=== Time ===//
+
+/* Emulated time in microseconds since the last reset: real time plus the
+   time skipped by sleep functions. */
+uint64_t hostgint_time_us(void);
+
+/* Total time skipped by sleep_us() and sleep_ms() (including key waits
+   skipped by the runner), in microseconds. */
+uint64_t hostgint_slept_us(void);
+
+/* Run the callbacks of timers that expired. */
+void hostgint_poll_timers(void);
+
+//=== Screen ===//
+
+/* Contents of the screen, ie. the VRAM at the last dupdate(). */
+uint16_t const *hostgint_screen(void);
+
+/* FNV-1a hash of the screen, for quick comparisons. */
+uint32_t hostgint_screen_hash(void);
+
+/* Write the screen as a binary PPM file. */
+bool hostgint_save_ppm(char const *path);
+
+/* Compare the screen with a PPM file. Returns the number of differing
+   pixels, or -1 if the file can't be read or has the wrong size. */
+int hostgint_compare_ppm(char const *path);
+
+//=== Profiling ===//
+
+/* Drawing and input functions whose calls are counted and timed. Only
+   top-level calls are measured, so that eg. a dtext() called by dprint() is
+   not counted twice. */
+#define HOSTGINT_PROFILED(X) \
+    X(dclear) X(drect) X(drect_border) X(dpixel) X(dgetpixel) X(dline) \
+    X(dhline) X(dvline) X(dcircle) X(dellipse) X(dpoly) X(dtext_opt) \
+    X(dprint) X(dsize) X(dnsize) X(drsize) X(dimage) X(dsubimage) \
+    X(pollevent) X(clearevents) X(keydown) X(getkey_opt)
+
+enum {
+#define X(name) HOSTGINT_CALL_##name,
+    HOSTGINT_PROFILED(X)
+#undef X
+    HOSTGINT_CALL_COUNT,
+};
+
+typedef struct {
+    char const *name;
+    uint64_t count;
+    uint64_t total_ns;
+} hostgint_profile_t;
+
+uint64_t hostgint_profile_enter(void);
+void hostgint_profile_leave(int call, uint64_t start);
+
+/* Run the statement and record its duration under NAME. */
+#define HOSTGINT_PROFILE(NAME, ...) do { \
+    uint64_t hostgint_start_ = hostgint_profile_enter(); \
+    __VA_ARGS__; \
+    hostgint_profile_leave(HOSTGINT_CALL_##NAME, hostgint_start_); \
+} while(0)
+
+/* Profile entries since the last reset (HOSTGINT_CALL_COUNT of them). */
+hostgint_profile_t const *hostgint_profile(void);
+
+//=== Functions provided by the runner ===//
+
+/* Called when a program waits for a key and no event is due yet. On the
+   calculator, timers would fire during the wait, so the runner performs the
+   pending screen updates here before the wait is skipped. */
+void host_idle(void);
+
+/* Called when a program waits for a key and the key script is over. This
+   should raise an exception; if it returns, the wait ends with KEYEV_NONE. */
+void host_input_exhausted(void);
+
+/* Called regularly during execution, see host_vm_hook(). */
+void host_vm_poll(void);
+
+/* Seed of the random module. */
+uint32_t host_random_seed(void);
+
+/* Hook for MICROPY_VM_HOOK_LOOP, which runs on every backwards jump. */
+extern uint32_t host_vm_hook_count;
+static inline void host_vm_hook(void)
+{
+    if(!(++host_vm_hook_count & 0x3ff))
+        host_vm_poll();
+}
+
+#endif /* __PYTHONEXTRA_HOSTGINT_H */
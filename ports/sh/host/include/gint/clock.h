@@ -0,0 +1,15 @@
+//---
+// gint:clock - Sleep functions (host stub)
+//
+// Sleeps are skipped and instead advance the host clock used by timers.
+//---
+
+#ifndef GINT_CLOCK
+#define GINT_CLOCK
+
+#include <stdint.h>
+
+void sleep_us(uint64_t delay_us);
+void sleep_ms(uint64_t delay_ms);
+
+#endif /* GINT_CLOCK */
@@ -0,0 +1,21 @@
+//---
+// gint:config - Host stub configuration (fx-CG 50 target)
+//---
+
+#ifndef GINT_CONFIG
+#define GINT_CONFIG
+
+#define GINT_VERSION "host"
+
+#define GINT_HW_FX 0
+#define GINT_HW_CG 1
+#define GINT_HW_CP 0
+
+#define GINT_OS_FX 0
+#define GINT_OS_CG 1
+#define GINT_OS_CP 0
+
+#define GINT_RENDER_MONO 0
+#define GINT_RENDER_RGB 1
+
+#endif /* GINT_CONFIG */
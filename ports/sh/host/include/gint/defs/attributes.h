@@ -0,0 +1,14 @@
+//---
+// gint:defs:attributes - Macros for compiler-specific attributes
+//---
+
+#ifndef GINT_DEFS_ATTRIBUTES
+#define GINT_DEFS_ATTRIBUTES
+
+#define GUNUSED      __attribute__((unused))
+#define GPACKED(x)   __attribute__((packed, aligned(x)))
+#define GALIGNED(x)  __attribute__((aligned(x)))
+#define GNORETURN    __attribute__((noreturn))
+#define GINLINE      __attribute__((always_inline)) inline
+
+#endif /* GINT_DEFS_ATTRIBUTES */
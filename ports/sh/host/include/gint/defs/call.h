@@ -0,0 +1,49 @@
+//---
+// gint:defs:call - Indirect calls
+//
+// On the host, arguments are stored as intptr_t and the function is called
+// with four integer arguments. This works for the integer and pointer
+// arguments used by PythonExtra on the usual 64-bit ABIs.
+//---
+
+#ifndef GINT_DEFS_CALL
+#define GINT_DEFS_CALL
+
+#include <stdint.h>
+
+typedef struct {
+    void *function;
+    intptr_t args[4];
+} gint_call_t;
+
+#define GINT_CALL_SELECT_(_0, _1, _2, _3, _4, N, ...) N
+#define GINT_CALL(...) GINT_CALL_SELECT_(__VA_ARGS__, GINT_CALL_4_, \
+    GINT_CALL_3_, GINT_CALL_2_, GINT_CALL_1_, GINT_CALL_0_, _)(__VA_ARGS__)
+
+#define GINT_CALL_0_(f) \
+    ((gint_call_t){ (void *)(f), { 0 } })
+#define GINT_CALL_1_(f, a1) \
+    ((gint_call_t){ (void *)(f), { (intptr_t)(a1) } })
+#define GINT_CALL_2_(f, a1, a2) \
+    ((gint_call_t){ (void *)(f), { (intptr_t)(a1), (intptr_t)(a2) } })
+#define GINT_CALL_3_(f, a1, a2, a3) \
+    ((gint_call_t){ (void *)(f), { (intptr_t)(a1), (intptr_t)(a2), \
+        (intptr_t)(a3) } })
+#define GINT_CALL_4_(f, a1, a2, a3, a4) \
+    ((gint_call_t){ (void *)(f), { (intptr_t)(a1), (intptr_t)(a2), \
+        (intptr_t)(a3), (intptr_t)(a4) } })
+
+#define GINT_CALL_NULL ((gint_call_t){ NULL, { 0 } })
+
+/* Set the int pointed to by `pointer` to 1 (and stop the calling timer). */
+int gint_call_set_int(volatile int *pointer);
+#define GINT_CALL_SET(pointer) GINT_CALL(gint_call_set_int, pointer)
+
+/* gint_call(): Perform an indirect call */
+static inline int gint_call(gint_call_t cb)
+{
+    int (*f)(intptr_t, intptr_t, intptr_t, intptr_t) = cb.function;
+    return f(cb.args[0], cb.args[1], cb.args[2], cb.args[3]);
+}
+
+#endif /* GINT_DEFS_CALL */
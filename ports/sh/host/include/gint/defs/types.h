@@ -0,0 +1,15 @@
+//---
+// gint:defs:types - Type definitions
+//---
+
+#ifndef GINT_DEFS_TYPES
+#define GINT_DEFS_TYPES
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/types.h>
+
+typedef unsigned int uint;
+
+#endif /* GINT_DEFS_TYPES */
@@ -0,0 +1,26 @@
+//---
+// gint:defs:util - Various utility macros
+//---
+
+#ifndef GINT_DEFS_UTIL
+#define GINT_DEFS_UTIL
+
+#define min(x, y) ({ \
+    __auto_type _x = (x); \
+    __auto_type _y = (y); \
+    (_x < _y) ? (_x) : (_y); \
+})
+
+#define max(x, y) ({ \
+    __auto_type _x = (x); \
+    __auto_type _y = (y); \
+    (_x > _y) ? (_x) : (_y); \
+})
+
+#define swap(a, b) ({ \
+    __auto_type _tmp = (a); \
+    (a) = (b); \
+    (b) = _tmp; \
+})
+
+#endif /* GINT_DEFS_UTIL */
@@ -0,0 +1,149 @@
+//---
+// gint:display - Drawing functions (host stub, fx-CG 50 geometry)
+//
+// The VRAM is a plain array of native-endian RGB565 pixels. Image and font
+// data supplied by programs is interpreted big-endian, as on the calculator.
+//---
+
+#ifndef GINT_DISPLAY
+#define GINT_DISPLAY
+
+#include <gint/defs/types.h>
+#include <gint/config.h>
+#include <gint/image.h>
+#include <gint/defs/util.h>
+
+#define DWIDTH 396
+#define DHEIGHT 224
+
+typedef uint16_t color_t;
+
+enum {
+    C_WHITE  = 0xffff,
+    C_LIGHT  = 0xad55,
+    C_DARK   = 0x528a,
+    C_BLACK  = 0x0000,
+    C_NONE   = -1,
+    C_INVERT = -2,
+
+    C_RED    = 0xf800,
+    C_GREEN  = 0x07e0,
+    C_BLUE   = 0x001f,
+};
+
+/* RGB color from 5-bit components */
+#define C_RGB(r, g, b) (((r) << 11) | ((g) << 6) | (b))
+
+/* The VRAM that is drawn to and sent by dupdate() */
+extern uint16_t *gint_vram;
+
+struct dwindow {
+    int left, top;
+    int right, bottom;
+};
+extern struct dwindow dwindow;
+
+struct dwindow dwindow_set(struct dwindow window);
+
+void dupdate(void);
+void dclear(int color);
+void drect(int x1, int y1, int x2, int y2, int color);
+void drect_border(int x1, int y1, int x2, int y2, int fill_color,
+    int border_width, int border_color);
+void dpixel(int x, int y, int color);
+int dgetpixel(int x, int y);
+void dline(int x1, int y1, int x2, int y2, int color);
+void dhline(int y, int color);
+void dvline(int x, int color);
+void dcircle(int xc, int yc, int r, int fill_color, int border_color);
+void dellipse(int x1, int y1, int x2, int y2, int fill_color,
+    int border_color);
+void dpoly(int const *x, int const *y, int N, int fill_color,
+    int border_color);
+
+//---
+// Text rendering (topti)
+//---
+
+typedef struct {
+    /* Font name (NUL-terminated), NULL if no title */
+    char const *name;
+
+    /* Font shape flags */
+    uint bold   :1;
+    uint italic :1;
+    uint serif  :1;
+    uint mono   :1;
+    uint        :3;
+    /* Whether the data is proportional */
+    uint prop   :1;
+
+    /* Line height */
+    uint8_t line_height;
+    /* Storage height */
+    uint8_t data_height;
+    /* Number of Unicode blocks */
+    uint8_t block_count;
+    /* Number of total glyphs */
+    uint32_t glyph_count;
+    /* Character spacing (usually 1) */
+    uint8_t char_spacing;
+    /* Distance between baselines of consecutive lines */
+    uint8_t line_distance;
+
+    /* Unicode blocks as big-endian u32 (20-bit start, 12-bit length) */
+    void const *blocks;
+    /* Raw glyph data as big-endian u32, MSB first */
+    void const *data;
+
+    union {
+        /* For monospaced fonts */
+        struct {
+            uint16_t width;
+            uint16_t storage_size;
+        };
+        /* For proportional fonts */
+        struct {
+            /* Big-endian u16 index of every 8th glyph's data */
+            void const *glyph_index;
+            uint8_t const *glyph_width;
+        };
+    };
+
+} font_t;
+
+enum {
+    DTEXT_LEFT   = 0,
+    DTEXT_CENTER = 1,
+    DTEXT_RIGHT  = 2,
+    DTEXT_TOP    = 0,
+    DTEXT_MIDDLE = 1,
+    DTEXT_BOTTOM = 2,
+};
+
+font_t const *dfont(font_t const *font);
+font_t const *dfont_default(void);
+void dsize(char const *str, font_t const *font, int *w, int *h);
+void dnsize(char const *str, int size, font_t const *font, int *w, int *h);
+char const *drsize(char const *str, font_t const *font, int width, int *w);
+void dtext_opt(int x, int y, int fg, int bg, int halign, int valign,
+    char const *str, int size);
+void dtext(int x, int y, int fg, char const *str);
+void dprint(int x, int y, int fg, char const *format, ...);
+
+//---
+// Image rendering (bopti)
+//---
+
+typedef image_t bopti_image_t;
+
+enum {
+    DIMAGE_NONE = 0x00,
+    DIMAGE_NOCLIP = 0x01,
+};
+
+void dimage(int x, int y, bopti_image_t const *image);
+void dsubimage(int x, int y, bopti_image_t const *image, int left, int top,
+    int width, int height, int flags);
+
+#endif /* GINT_DISPLAY */
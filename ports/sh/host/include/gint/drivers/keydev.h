@@ -0,0 +1,33 @@
+//---
+// gint:drivers:keydev - Keyboard device transforms (host stub)
+//---
+
+#ifndef GINT_DRIVERS_KEYDEV
+#define GINT_DRIVERS_KEYDEV
+
+#include <gint/keyboard.h>
+
+enum {
+    KEYDEV_TR_DELAYED_SHIFT   = 0x01,
+    KEYDEV_TR_DELAYED_ALPHA   = 0x02,
+    KEYDEV_TR_INSTANT_SHIFT   = 0x04,
+    KEYDEV_TR_INSTANT_ALPHA   = 0x08,
+    KEYDEV_TR_REPEATS         = 0x10,
+    KEYDEV_TR_DELETE_MODIFIERS = 0x20,
+    KEYDEV_TR_DELETE_RELEASES = 0x40,
+};
+
+typedef struct {
+    int enabled;
+    int (*repeater)(int key, int duration, int count);
+
+} keydev_transform_t;
+
+typedef struct keydev keydev_t;
+
+keydev_t *keydev_std(void);
+keydev_transform_t keydev_transform(keydev_t *d);
+void keydev_set_transform(keydev_t *d, keydev_transform_t tr);
+void keydev_set_async_filter(keydev_t *d, bool (*filter)(key_event_t ev));
+
+#endif /* GINT_DRIVERS_KEYDEV */
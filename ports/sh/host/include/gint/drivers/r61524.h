@@ -0,0 +1,13 @@
+//---
+// gint:drivers:r61524 - Display controller registers (host stub)
+//---
+
+#ifndef GINT_DRIVERS_R61524
+#define GINT_DRIVERS_R61524
+
+#include <stdint.h>
+
+uint16_t r61524_get(int reg);
+void r61524_set(int reg, uint16_t value);
+
+#endif /* GINT_DRIVERS_R61524 */
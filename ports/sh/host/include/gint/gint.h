@@ -0,0 +1,16 @@
+//---
+// gint:gint - World switch (host stub; there is only one world)
+//---
+
+#ifndef GINT_GINT
+#define GINT_GINT
+
+#include <gint/defs/call.h>
+#include <gint/hardware.h>
+
+static inline int gint_world_switch(gint_call_t call)
+{
+    return gint_call(call);
+}
+
+#endif /* GINT_GINT */
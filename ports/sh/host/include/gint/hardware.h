@@ -0,0 +1,19 @@
+//---
+// gint:hardware - Platform information (host stub)
+//---
+
+#ifndef GINT_HARDWARE
+#define GINT_HARDWARE
+
+#include <stdint.h>
+
+extern uint32_t gint[];
+
+#define HWCALC 0
+
+enum {
+    HWCALC_FXCG50  = 6,
+    HWCALC_FXCG100 = 9,
+};
+
+#endif /* GINT_HARDWARE */
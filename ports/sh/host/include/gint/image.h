@@ -0,0 +1,52 @@
+//---
+// gint:image - Image formats (host stub)
+//---
+
+#ifndef GINT_IMAGE
+#define GINT_IMAGE
+
+#include <gint/defs/types.h>
+
+enum {
+    IMAGE_RGB565        = 0,
+    IMAGE_RGB565A       = 1,
+    IMAGE_DEPRECATED_P8 = 2,
+    IMAGE_P4_RGB565A    = 3,
+    IMAGE_P8_RGB565     = 4,
+    IMAGE_P8_RGB565A    = 5,
+    IMAGE_P4_RGB565     = 6,
+};
+
+#define IMAGE_IS_RGB16(format) \
+    ((format) == IMAGE_RGB565 || (format) == IMAGE_RGB565A)
+#define IMAGE_IS_P8(format) \
+    ((format) == IMAGE_P8_RGB565 || (format) == IMAGE_P8_RGB565A)
+#define IMAGE_IS_P4(format) \
+    ((format) == IMAGE_P4_RGB565 || (format) == IMAGE_P4_RGB565A)
+#define IMAGE_IS_INDEXED(format) \
+    (IMAGE_IS_P8(format) || IMAGE_IS_P4(format))
+#define IMAGE_IS_ALPHA(format) \
+    ((format) == IMAGE_RGB565A || (format) == IMAGE_P8_RGB565A || \
+     (format) == IMAGE_P4_RGB565A)
+
+enum {
+    IMAGE_FLAGS_DATA_RO       = 0x01,
+    IMAGE_FLAGS_PALETTE_RO    = 0x02,
+    IMAGE_FLAGS_DATA_ALLOC    = 0x04,
+    IMAGE_FLAGS_PALETTE_ALLOC = 0x08,
+};
+
+/* Pixel data and palettes are big-endian, as on the calculator. */
+typedef struct {
+    uint8_t format;
+    uint8_t flags;
+    int16_t color_count;
+    uint16_t width;
+    uint16_t height;
+    int stride;
+    void *data;
+    uint16_t *palette;
+
+} image_t;
+
+#endif /* GINT_IMAGE */
@@ -0,0 +1,63 @@
+//---
+// gint:keyboard - Keyboard input (host stub)
+//
+// Events come from the key script loaded by the host runner (see
+// ports/sh/host/hostgint.h) instead of the keyboard matrix.
+//---
+
+#ifndef GINT_KEYBOARD
+#define GINT_KEYBOARD
+
+#include <gint/defs/types.h>
+#include <gint/keycodes.h>
+
+typedef struct {
+    /* Time of event (in frames on the host) */
+    uint16_t time;
+    /* Whether modifiers were applied and which ones */
+    bool mod, shift, alpha;
+    /* Type of event (KEYEV_*) */
+    uint8_t type;
+    /* Key code (KEY_*) */
+    uint8_t key;
+    /* Touch coordinates for KEYEV_TOUCH_* */
+    int16_t x, y;
+
+} key_event_t;
+
+enum {
+    KEYEV_NONE       = 0,
+    KEYEV_DOWN       = 1,
+    KEYEV_UP         = 2,
+    KEYEV_HOLD       = 3,
+    KEYEV_TOUCH_DOWN = 4,
+    KEYEV_TOUCH_UP   = 5,
+    KEYEV_TOUCH_DRAG = 6,
+};
+
+enum {
+    GETKEY_MOD_SHIFT   = 0x01,
+    GETKEY_MOD_ALPHA   = 0x02,
+    GETKEY_BACKLIGHT   = 0x04,
+    GETKEY_MENU        = 0x08,
+    GETKEY_REP_ARROWS  = 0x10,
+    GETKEY_REP_ALL     = 0x20,
+    GETKEY_REP_PROFILE = 0x40,
+    GETKEY_FEATURES    = 0x80,
+
+    GETKEY_NONE        = 0x00,
+    GETKEY_DEFAULT     = 0x9f,
+};
+
+key_event_t pollevent(void);
+void clearevents(void);
+void cleareventflips(void);
+int keydown(int key);
+int keypressed(int key);
+int keyreleased(int key);
+key_event_t getkey(void);
+key_event_t getkey_opt(int options, volatile int *timeout);
+int keycode_function(int keycode);
+int keycode_digit(int keycode);
+
+#endif /* GINT_KEYBOARD */
@@ -0,0 +1,109 @@
+//---
+// gint:keycodes - Matrix keycodes (host stub)
+//---
+
+#ifndef GINT_KEYCODES
+#define GINT_KEYCODES
+
+enum {
+    KEY_F1      = 0x91,
+    KEY_F2      = 0x92,
+    KEY_F3      = 0x93,
+    KEY_F4      = 0x94,
+    KEY_F5      = 0x95,
+    KEY_F6      = 0x96,
+
+    KEY_SHIFT   = 0x81,
+    KEY_OPTN    = 0x82,
+    KEY_VARS    = 0x83,
+    KEY_MENU    = 0x84,
+    KEY_LEFT    = 0x85,
+    KEY_UP      = 0x86,
+
+    KEY_ALPHA   = 0x71,
+    KEY_SQUARE  = 0x72,
+    KEY_POWER   = 0x73,
+    KEY_EXIT    = 0x74,
+    KEY_DOWN    = 0x75,
+    KEY_RIGHT   = 0x76,
+
+    KEY_XOT     = 0x61,
+    KEY_LOG     = 0x62,
+    KEY_LN      = 0x63,
+    KEY_SIN     = 0x64,
+    KEY_COS     = 0x65,
+    KEY_TAN     = 0x66,
+
+    KEY_FRAC    = 0x51,
+    KEY_FD      = 0x52,
+    KEY_LEFTP   = 0x53,
+    KEY_RIGHTP  = 0x54,
+    KEY_COMMA   = 0x55,
+    KEY_ARROW   = 0x56,
+
+    KEY_7       = 0x41,
+    KEY_8       = 0x42,
+    KEY_9       = 0x43,
+    KEY_DEL     = 0x44,
+
+    KEY_4       = 0x31,
+    KEY_5       = 0x32,
+    KEY_6       = 0x33,
+    KEY_MUL     = 0x34,
+    KEY_DIV     = 0x35,
+
+    KEY_1       = 0x21,
+    KEY_2       = 0x22,
+    KEY_3       = 0x23,
+    KEY_ADD     = 0x24,
+    KEY_SUB     = 0x25,
+
+    KEY_0       = 0x11,
+    KEY_DOT     = 0x12,
+    KEY_EXP     = 0x13,
+    KEY_NEG     = 0x14,
+    KEY_EXE     = 0x15,
+
+    KEY_ACON    = 0x07,
+    KEY_HELP    = 0x20,
+    KEY_LIGHT   = 0x10,
+
+    /* fx-CP 400 */
+    KEY_KBD     = 0xa1,
+    KEY_X       = 0xa2,
+    KEY_Y       = 0xa3,
+    KEY_Z       = 0xa4,
+    KEY_EQUALS  = 0xa5,
+    KEY_CLEAR   = 0xa6,
+
+    /* fx-CG 100 / Graph Math+ */
+    KEY_ON       = 0xb1,
+    KEY_HOME     = 0xb2,
+    KEY_PREVTAB  = 0xb3,
+    KEY_NEXTTAB  = 0xb4,
+    KEY_PAGEUP   = 0xb5,
+    KEY_PAGEDOWN = 0xb6,
+    KEY_SETTINGS = 0xb7,
+    KEY_BACK     = 0xb8,
+    KEY_OK       = 0xb9,
+    KEY_CATALOG  = 0xba,
+    KEY_TOOLS    = 0xbb,
+    KEY_FORMAT   = 0xbc,
+    KEY_SQRT     = 0xbd,
+    KEY_EXPFUN   = 0xbe,
+
+    /* Aliases */
+    KEY_X2       = KEY_SQUARE,
+    KEY_CARET    = KEY_POWER,
+    KEY_SWITCH   = KEY_FD,
+    KEY_LEFTPAR  = KEY_LEFTP,
+    KEY_RIGHTPAR = KEY_RIGHTP,
+    KEY_STORE    = KEY_ARROW,
+    KEY_TIMES    = KEY_MUL,
+    KEY_PLUS     = KEY_ADD,
+    KEY_MINUS    = KEY_SUB,
+
+    KEY_NONE     = 0x00,
+};
+
+#endif /* GINT_KEYCODES */
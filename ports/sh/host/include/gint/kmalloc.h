@@ -0,0 +1,14 @@
+//---
+// gint:kmalloc - Arena allocator (host stub, always uses malloc)
+//---
+
+#ifndef GINT_KMALLOC
+#define GINT_KMALLOC
+
+#include <stdlib.h>
+
+#define kmalloc(size, arena) ((void)(arena), malloc(size))
+#define krealloc(ptr, size) realloc(ptr, size)
+#define kfree(ptr) free(ptr)
+
+#endif /* GINT_KMALLOC */
@@ -0,0 +1,13 @@
+//---
+// gint:rtc - Real-time clock (host stub)
+//---
+
+#ifndef GINT_RTC
+#define GINT_RTC
+
+#include <stdint.h>
+
+/* Number of 1/128 s ticks of the host clock. */
+uint32_t rtc_ticks(void);
+
+#endif /* GINT_RTC */
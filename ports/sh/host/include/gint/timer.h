@@ -0,0 +1,30 @@
+//---
+// gint:timer - Timers (host stub)
+//
+// Timers run on the host clock and fire when polled by the stub: during
+// keyboard and display calls, sleeps and the MicroPython VM hook.
+//---
+
+#ifndef GINT_TIMER
+#define GINT_TIMER
+
+#include <gint/defs/types.h>
+#include <gint/defs/call.h>
+
+enum {
+    TIMER_ANY  = -1,
+    TIMER_TMU  = -2,
+    TIMER_ETMU = -3,
+};
+
+enum {
+    TIMER_CONTINUE = 0,
+    TIMER_STOP     = 1,
+};
+
+int timer_configure(int timer, uint64_t delay_us, gint_call_t call);
+void timer_start(int timer);
+void timer_pause(int timer);
+void timer_stop(int timer);
+
+#endif /* GINT_TIMER */
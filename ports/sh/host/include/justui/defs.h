@@ -0,0 +1,10 @@
+//---
+// JustUI.defs: Common definitions (host stub)
+//---
+
+#ifndef _J_DEFS
+#define _J_DEFS
+
+#include <gint/defs/types.h>
+
+#endif /* _J_DEFS */
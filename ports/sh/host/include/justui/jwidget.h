@@ -0,0 +1,19 @@
+//---
+// JustUI.jwidget: Base widget (host stub)
+//
+// The host runner doesn't have a GUI; only the fields used by PythonExtra's
+// VM hook are provided.
+//---
+
+#ifndef _J_JWIDGET
+#define _J_JWIDGET
+
+#include <justui/defs.h>
+
+typedef struct {
+    /* Whether the widget needs to be redrawn */
+    bool update;
+
+} jwidget;
+
+#endif /* _J_JWIDGET */
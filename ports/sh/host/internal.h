@@ -0,0 +1,27 @@
+//---------------------------------------------------------------------------//
+//    ____        PythonExtra                                                //
+//.-'`_ o `;__,   A community port of MicroPython for CASIO calculators.     //
+//.-'` `---`  '   License: MIT (except some files; see LICENSE)              //
+//---------------------------------------------------------------------------//
+// pe.host.internal: Functions shared between the files of the headless gint
+//---
+
+#ifndef __PYTHONEXTRA_HOST_INTERNAL_H
+#define __PYTHONEXTRA_HOST_INTERNAL_H
+
+/* Set a pixel, clipped to the window; handles C_NONE and C_INVERT. */
+void hostgint_pixel(int x, int y, int color);
+
+/* Fill the pixels x1..x2 of row y, clipped to the window. */
+void hostgint_hspan(int x1, int x2, int y, int color);
+
+/* Forget the calls being profiled, before raising an exception out of them. */
+void hostgint_profile_unwind(void);
+
+/* Reset functions for each module, called by hostgint_reset(). */
+void hostgint_display_reset(void);
+void hostgint_text_reset(void);
+void hostgint_keyboard_reset(void);
+void hostgint_system_reset(void);
+
+#endif /* __PYTHONEXTRA_HOST_INTERNAL_H */
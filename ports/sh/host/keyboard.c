@@ -0,0 +1,346 @@
+//---------------------------------------------------------------------------//
+//    ____        PythonExtra                                                //
+//.-'`_ o `;__,   A community port of MicroPython for CASIO calculators.     //
+//.-'` `---`  '   License: MIT (except some files; see LICENSE)              //
+//---------------------------------------------------------------------------//
+
+#include "hostgint.h"
+#include "internal.h"
+#include <gint/keyboard.h>
+#include <gint/drivers/keydev.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#define KEY(NAME) { #NAME, KEY_##NAME },
+static struct { char const *name; int key; } const key_names[] = {
+    KEY(F1) KEY(F2) KEY(F3) KEY(F4) KEY(F5) KEY(F6)
+    KEY(SHIFT) KEY(OPTN) KEY(VARS) KEY(MENU) KEY(LEFT) KEY(UP) KEY(ALPHA)
+    KEY(SQUARE) KEY(POWER) KEY(EXIT) KEY(DOWN) KEY(RIGHT) KEY(XOT) KEY(LOG)
+    KEY(LN) KEY(SIN) KEY(COS) KEY(TAN) KEY(FRAC) KEY(FD) KEY(LEFTP)
+    KEY(RIGHTP) KEY(COMMA) KEY(ARROW) KEY(DEL) KEY(MUL) KEY(DIV) KEY(ADD)
+    KEY(SUB) KEY(DOT) KEY(EXP) KEY(NEG) KEY(EXE) KEY(ACON) KEY(HELP)
+    KEY(LIGHT)
+    KEY(0) KEY(1) KEY(2) KEY(3) KEY(4) KEY(5) KEY(6) KEY(7) KEY(8) KEY(9)
+    KEY(X2) KEY(CARET) KEY(SWITCH) KEY(LEFTPAR) KEY(RIGHTPAR) KEY(STORE)
+    KEY(TIMES) KEY(PLUS) KEY(MINUS)
+    KEY(KBD) KEY(CLEAR) KEY(BACK) KEY(OK) KEY(EQUALS) KEY(X) KEY(Y) KEY(Z)
+    KEY(PAGEUP) KEY(PAGEDOWN) KEY(HOME) KEY(SETTINGS) KEY(TOOLS)
+    KEY(CATALOG) KEY(FORMAT) KEY(EXPFUN) KEY(SQRT) KEY(NEXTTAB)
+    KEY(PREVTAB) KEY(ON)
+};
+#undef KEY
+
+//=== Key script ===//
+
+typedef struct {
+    uint32_t frame;
+    uint8_t type;
+    uint8_t key;
+} script_event_t;
+
+static script_event_t *script;
+static int script_len, script_pos;
+
+/* Events delivered but not yet read */
+#define QUEUE_SIZE 64
+static key_event_t queue[QUEUE_SIZE];
+static int queue_head, queue_len;
+
+/* Key state, flips since the last cleareventflips(), delayed modifiers */
+static uint8_t state[256], pressed[256], released[256];
+static bool mod_shift, mod_alpha;
+
+static keydev_transform_t transform;
+static bool (*async_filter)(key_event_t ev);
+
+static int find_key(char const *name)
+{
+    if(!strncasecmp(name, "KEY_", 4))
+        name += 4;
+    for(size_t i = 0; i < sizeof key_names / sizeof *key_names; i++) {
+        if(!strcasecmp(name, key_names[i].name))
+            return key_names[i].key;
+    }
+    char *end;
+    long code = strtol(name, &end, 0);
+    return (*end || code <= 0 || code > 255) ? -1 : code;
+}
+
+static bool add_event(uint32_t frame, int type, int key)
+{
+    script_event_t *s = realloc(script, (script_len + 1) * sizeof *s);
+    if(!s)
+        return false;
+    script = s;
+    script[script_len++] = (script_event_t){ frame, type, key };
+    return true;
+}
+
+bool hostgint_load_keys(char const *path)
+{
+    FILE *fp = fopen(path, "r");
+    if(!fp) {
+        perror(path);
+        return false;
+    }
+
+    char line[128];
+    int lineno = 0;
+    bool ok = true;
+
+    while(ok && fgets(line, sizeof line, fp)) {
+        lineno++;
+        char name[32], action[16] = "press";
+        unsigned long frame;
+
+        char *p = line + strspn(line, " \t");
+        if(*p == '#' || *p == '\n' || *p == 0)
+            continue;
+
+        int n = sscanf(p, "%lu %31s %15s", &frame, name, action);
+        int key = (n >= 2) ? find_key(name) : -1;
+        if(key < 0) {
+            fprintf(stderr, "%s:%d: invalid event\n", path, lineno);
+            ok = false;
+        }
+        else if(!strcmp(action, "down"))
+            ok = add_event(frame, KEYEV_DOWN, key);
+        else if(!strcmp(action, "up"))
+            ok = add_event(frame, KEYEV_UP, key);
+        else if(!strcmp(action, "press"))
+            ok = add_event(frame, KEYEV_DOWN, key)
+              && add_event(frame + 1, KEYEV_UP, key);
+        else {
+            fprintf(stderr, "%s:%d: invalid action '%s'\n", path, lineno,
+                action);
+            ok = false;
+        }
+    }
+
+    fclose(fp);
+    /* Stable sort by frame, so events of the same frame keep their order */
+    for(int i = 1; i < script_len; i++) {
+        script_event_t e = script[i];
+        int j = i;
+        for(; j > 0 && script[j-1].frame > e.frame; j--)
+            script[j] = script[j-1];
+        script[j] = e;
+    }
+    return ok;
+}
+
+int hostgint_keys_left(void)
+{
+    return script_len - script_pos;
+}
+
+void hostgint_keyboard_reset(void)
+{
+    script_pos = 0;
+    queue_head = queue_len = 0;
+    memset(state, 0, sizeof state);
+    memset(pressed, 0, sizeof pressed);
+    memset(released, 0, sizeof released);
+    mod_shift = mod_alpha = false;
+    transform = (keydev_transform_t){ 0 };
+    async_filter = NULL;
+}
+
+//=== Event queue ===//
+
+/* Move the next script event to the queue. */
+static void release_one(void)
+{
+    script_event_t *s = &script[script_pos++];
+    key_event_t ev = { 0 };
+    ev.time = hostgint_frames();
+    ev.type = s->type;
+    ev.key = s->key;
+
+    if(async_filter && !async_filter(ev))
+        return;
+    if(queue_len >= QUEUE_SIZE)
+        return;
+    queue[(queue_head + queue_len++) % QUEUE_SIZE] = ev;
+}
+
+/* Deliver the script events whose frame has come. */
+static void release_due(void)
+{
+    uint32_t frame = hostgint_frames();
+    while(script_pos < script_len && script[script_pos].frame <= frame)
+        release_one();
+}
+
+static key_event_t next_event(void)
+{
+    hostgint_poll_timers();
+    release_due();
+
+    if(queue_len == 0)
+        return (key_event_t){ .type = KEYEV_NONE, .time = hostgint_frames() };
+
+    key_event_t ev = queue[queue_head];
+    queue_head = (queue_head + 1) % QUEUE_SIZE;
+    queue_len--;
+
+    if(ev.type == KEYEV_DOWN) {
+        state[ev.key] = 1;
+        pressed[ev.key] = 1;
+    }
+    else if(ev.type == KEYEV_UP) {
+        state[ev.key] = 0;
+        released[ev.key] = 1;
+    }
+    return ev;
+}
+
+key_event_t pollevent(void)
+{
+    key_event_t ev;
+    HOSTGINT_PROFILE(pollevent, ev = next_event());
+    return ev;
+}
+
+void clearevents(void)
+{
+    HOSTGINT_PROFILE(clearevents, {
+        while(next_event().type != KEYEV_NONE) {}
+    });
+}
+
+void cleareventflips(void)
+{
+    memset(pressed, 0, sizeof pressed);
+    memset(released, 0, sizeof released);
+}
+
+int keydown(int key)
+{
+    int down;
+    HOSTGINT_PROFILE(keydown, down = state[key & 0xff]);
+    return down;
+}
+
+int keypressed(int key)
+{
+    return pressed[key & 0xff];
+}
+
+int keyreleased(int key)
+{
+    return released[key & 0xff];
+}
+
+//=== getkey() ===//
+
+static key_event_t wait_key(int opt)
+{
+    bool idle = false;
+
+    while(1) {
+        key_event_t ev = next_event();
+
+        if(ev.type == KEYEV_NONE) {
+            /* Let the runner do what happens during the wait; this can run
+               dupdate() and release new events */
+            if(!idle) {
+                idle = true;
+                host_idle();
+                continue;
+            }
+            /* Don't wait for the event's frame (nor for the timeout), deliver
+               it now */
+            if(script_pos < script_len) {
+                release_one();
+                continue;
+            }
+            hostgint_profile_unwind();
+            host_input_exhausted();
+            return ev;
+        }
+        if(ev.type != KEYEV_DOWN)
+            continue;
+
+        if((opt & GETKEY_MOD_SHIFT) && ev.key == KEY_SHIFT) {
+            mod_shift = !mod_shift;
+            continue;
+        }
+        if((opt & GETKEY_MOD_ALPHA) && ev.key == KEY_ALPHA) {
+            mod_alpha = !mod_alpha;
+            continue;
+        }
+
+        ev.mod = (opt & (GETKEY_MOD_SHIFT | GETKEY_MOD_ALPHA)) != 0;
+        ev.shift = mod_shift;
+        ev.alpha = mod_alpha;
+        mod_shift = mod_alpha = false;
+        return ev;
+    }
+}
+
+key_event_t getkey_opt(int opt, volatile int *timeout)
+{
+    (void)timeout;
+    key_event_t ev;
+    HOSTGINT_PROFILE(getkey_opt, ev = wait_key(opt));
+    return ev;
+}
+
+key_event_t getkey(void)
+{
+    return getkey_opt(GETKEY_DEFAULT, NULL);
+}
+
+int keycode_function(int keycode)
+{
+    switch(keycode) {
+    case KEY_F1: return 1;
+    case KEY_F2: return 2;
+    case KEY_F3: return 3;
+    case KEY_F4: return 4;
+    case KEY_F5: return 5;
+    case KEY_F6: return 6;
+    default: return -1;
+    }
+}
+
+int keycode_digit(int keycode)
+{
+    static uint8_t const digits[10] = {
+        KEY_0, KEY_1, KEY_2, KEY_3, KEY_4, KEY_5, KEY_6, KEY_7, KEY_8, KEY_9,
+    };
+    for(int i = 0; i < 10; i++) {
+        if(keycode == digits[i])
+            return i;
+    }
+    return -1;
+}
+
+//=== Keyboard device ===//
+
+keydev_t *keydev_std(void)
+{
+    /* Only used as a handle */
+    static int dummy;
+    return (keydev_t *)&dummy;
+}
+
+keydev_transform_t keydev_transform(keydev_t *d)
+{
+    (void)d;
+    return transform;
+}
+
+void keydev_set_transform(keydev_t *d, keydev_transform_t tr)
+{
+    (void)d;
+    transform = tr;
+}
+
+void keydev_set_async_filter(keydev_t *d, bool (*filter)(key_event_t ev))
+{
+    (void)d;
+    async_filter = filter;
+}
@@ -0,0 +1,470 @@
+//---------------------------------------------------------------------------//
+//    ____        PythonExtra                                                //
+//.-'`_ o `;__,   A community port of MicroPython for CASIO calculators.     //
+//.-'` `---`  '   License: MIT (except some files; see LICENSE)              //
+//---------------------------------------------------------------------------//
+// pe.host.main: Headless runner for benchmarking programs on a computer
+//
+// Each program given on the command line is run in a fresh interpreter from
+// its own folder, with the output of print() going to the console like on
+// the calculator. Afterwards the runner reports the execution time, frame
+// statistics (one frame per dupdate()), and the time spent in each drawing
+// and input function. The last frame can be saved or compared with golden
+// images.
+//---
+
+#include "py/compile.h"
+#include "py/runtime.h"
+#include "py/gc.h"
+#include "py/stackctrl.h"
+#include "py/builtin.h"
+#include "py/mphal.h"
+#include "py/repl.h"
+#include "shared/runtime/gchelper.h"
+#include "pyexec.h"
+#include "hostgint.h"
+#include "console.h"
+#include "widget_shell.h"
+#include "resources.h"
+#include <gint/display.h>
+#include <gint/keyboard.h>
+#include <gint/timer.h>
+#include <gint/clock.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <libgen.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Heap layout of the fx-CG 50: the OS stack plus 300 kB of _uram */
+#define HEAP_OSTK_SIZE 350000
+#define HEAP_URAM_SIZE 300000
+
+static struct {
+    /* Stop after this many frames/seconds (0 = no limit) */
+    uint32_t max_frames;
+    double max_seconds;
+    /* Folders where the last frame is saved/compared (or NULL) */
+    char const *output_dir;
+    char const *golden_dir;
+    /* Save every frame instead of just the last one */
+    bool all_frames;
+    /* Echo the console output to stdout */
+    bool echo;
+    /* Random seed */
+    uint32_t seed;
+    /* Extra sys.path entries */
+    char const *path[8];
+    int path_count;
+
+} opt = {
+    .max_frames = 1000,
+    .max_seconds = 60,
+    .echo = true,
+    .seed = 1,
+};
+
+/* State of the program being run */
+static struct {
+    char const *name;
+    /* Why the runner interrupted the program (or NULL) */
+    char const *stop_reason;
+    /* Time of each dupdate(), in microseconds */
+    uint64_t *frame_time;
+    uint32_t frame_count, frame_alloc;
+    uint64_t last_frame_us;
+
+} run;
+
+/* Shell state, like on the calculator */
+static console_t *console;
+static widget_shell shell;
+widget_shell *pe_shell = &shell;
+bool pe_dupdate_scheduled = false;
+
+uint32_t host_vm_hook_count;
+
+//=== Hooks for the gint stub and the shared sh port files ===//
+
+/* Stop the program with a SystemExit, which unlike KeyboardInterrupt isn't
+   used by programs for their own purposes. This is repeated on every poll in
+   case the exception is caught anyway. */
+static void stop_program(char const *reason)
+{
+    if(!run.stop_reason)
+        run.stop_reason = reason;
+    mp_sched_exception(mp_obj_new_exception(&mp_type_SystemExit));
+}
+
+void host_idle(void)
+{
+    /* Let timers run as if the calculator had waited for a shell frame */
+    sleep_us(1000000 / WIDGET_SHELL_FPS);
+    if(pe_dupdate_scheduled)
+        pe_dupdate();
+    else if(pe_shell->widget.update)
+        pe_draw();
+}
+
+void host_input_exhausted(void)
+{
+    if(!run.stop_reason)
+        run.stop_reason = "end of key script";
+    mp_raise_type(&mp_type_SystemExit);
+}
+
+void host_vm_poll(void)
+{
+    hostgint_poll_timers();
+    if(run.stop_reason)
+        stop_program(run.stop_reason);
+    else if(opt.max_seconds > 0
+            && hostgint_time_us() >= opt.max_seconds * 1e6)
+        stop_program("time limit");
+}
+
+uint32_t host_random_seed(void)
+{
+    return opt.seed;
+}
+
+void pe_enter_graphics_mode(void)
+{
+    /* Cancel any pending update of the shell */
+    console->render_needed = false;
+    pe_shell->widget.update = 0;
+}
+
+void pe_schedule_dupdate(void)
+{
+    pe_enter_graphics_mode();
+    pe_dupdate_scheduled = true;
+}
+
+static void save_frame(char const *dir, char const *suffix)
+{
+    char path[512];
+    snprintf(path, sizeof path, "%s/%s%s.ppm", dir, run.name, suffix);
+    if(!hostgint_save_ppm(path))
+        perror(path);
+}
+
+void pe_dupdate(void)
+{
+    dupdate();
+    pe_dupdate_scheduled = false;
+
+    uint64_t now = hostgint_time_us();
+    if(run.frame_count >= run.frame_alloc) {
+        run.frame_alloc = run.frame_alloc ? 2 * run.frame_alloc : 256;
+        run.frame_time = realloc(run.frame_time,
+            run.frame_alloc * sizeof *run.frame_time);
+    }
+    run.frame_time[run.frame_count++] = now - run.last_frame_us;
+    run.last_frame_us = now;
+
+    if(opt.output_dir && opt.all_frames) {
+        char suffix[16];
+        sprintf(suffix, "-%05u", (unsigned)hostgint_frames());
+        save_frame(opt.output_dir, suffix);
+    }
+    if(opt.max_frames && hostgint_frames() >= opt.max_frames)
+        stop_program("frame limit");
+}
+
+void pe_draw(void)
+{
+    int line_height = shell.font->line_height + shell.line_spacing;
+
+    dclear(C_WHITE);
+    console_compute_view(console, shell.font, DWIDTH - 12, shell.lines);
+    shell.scroll = console_clamp_scrollpos(console, shell.scroll);
+    console_render(6, 3, console, line_height, shell.scroll);
+    console_clear_render_flag(console);
+    shell.widget.update = 0;
+    pe_dupdate();
+}
+
+static int shell_timer_handler(void)
+{
+    if(console->render_needed)
+        shell.widget.update = true;
+    return TIMER_CONTINUE;
+}
+
+void pe_after_python_exec(int input_kind, int exec_flags, void *ret_val,
+    int *ret)
+{
+    (void)input_kind;
+    (void)exec_flags;
+    (void)ret_val;
+    (void)ret;
+    clearevents();
+    pe_resources_autofree();
+}
+
+int pe_readline(vstr_t *line, char const *prompt)
+{
+    console_write(console, prompt, -1);
+    console_lock_prefix(console);
+
+    while(1) {
+        key_event_t ev = getkey();
+        int c = console_key_event_to_char(ev);
+
+        if(c == '\n' || c == '\r')
+            break;
+        else if(c == 8)
+            console_delete_at_cursor(console, 1);
+        else if(c >= 32 && c < 0x80)
+            console_write_raw(console, (char const *)&(char){ c }, 1);
+    }
+
+    char *text = console_get_line(console, true);
+    console_newline(console);
+    vstr_reset(line);
+    vstr_add_str(line, text);
+    free(text);
+    return 0;
+}
+
+int mp_hal_stdin_rx_chr(void)
+{
+    while(1) {
+        int c = console_key_event_to_char(getkey());
+        if(c != 0)
+            return c;
+    }
+}
+
+mp_uint_t mp_hal_stdout_tx_strn(const char *str, mp_uint_t len)
+{
+    console_write(console, str, len);
+    if(opt.echo)
+        fwrite(str, 1, len, stdout);
+    return len;
+}
+
+void nlr_jump_fail(void *val)
+{
+    fprintf(stderr, "nlr_jump_fail! val = %p\n", val);
+    abort();
+}
+
+void gc_collect(void)
+{
+    gc_collect_start();
+    gc_helper_collect_regs_and_stack();
+    gc_collect_end();
+}
+
+mp_import_stat_t mp_import_stat(const char *path)
+{
+    struct stat st;
+    if(stat(path, &st) < 0)
+        return MP_IMPORT_STAT_NO_EXIST;
+    return S_ISDIR(st.st_mode) ? MP_IMPORT_STAT_DIR : MP_IMPORT_STAT_FILE;
+}
+
+//=== Reports ===//
+
+static int compare_u64(void const *a, void const *b)
+{
+    uint64_t x = *(uint64_t const *)a, y = *(uint64_t const *)b;
+    return (x > y) - (x < y);
+}
+
+static void report_frames(void)
+{
+    uint32_t n = run.frame_count;
+    if(n == 0) {
+        printf("  frames   none\n");
+        return;
+    }
+
+    uint64_t *t = malloc(n * sizeof *t);
+    memcpy(t, run.frame_time, n * sizeof *t);
+    qsort(t, n, sizeof *t, compare_u64);
+
+    uint64_t total = 0;
+    for(uint32_t i = 0; i < n; i++)
+        total += t[i];
+
+    printf("  frames   %u, %.1f fps\n", (unsigned)n, n * 1e6 / (total ? total : 1));
+    printf("  frame ms min %.2f  avg %.2f  p50 %.2f  p95 %.2f  max %.2f\n",
+        t[0] / 1e3, total / 1e3 / n, t[n / 2] / 1e3, t[n * 95 / 100] / 1e3,
+        t[n - 1] / 1e3);
+    free(t);
+}
+
+static void report_calls(void)
+{
+    hostgint_profile_t const *p = hostgint_profile();
+    bool header = false;
+
+    for(int i = 0; i < HOSTGINT_CALL_COUNT; i++) {
+        if(!p[i].count)
+            continue;
+        if(!header)
+            printf("  %-12s %10s %12s %10s\n", "call", "count", "total ms",
+                "avg us");
+        header = true;
+        printf("  %-12s %10llu %12.2f %10.2f\n", p[i].name,
+            (unsigned long long)p[i].count, p[i].total_ns / 1e6,
+            p[i].total_ns / 1e3 / p[i].count);
+    }
+}
+
+//=== Running programs ===//
+
+static void reset_micropython(void)
+{
+    gc_sweep_all();
+    mp_deinit();
+    mp_init();
+
+    mp_obj_list_append(mp_sys_path, MP_OBJ_NEW_QSTR(MP_QSTR_));
+    for(int i = 0; i < opt.path_count; i++)
+        mp_obj_list_append(mp_sys_path,
+            mp_obj_new_str(opt.path[i], strlen(opt.path[i])));
+}
+
+/* Returns true if the program ran as expected. */
+static bool run_program(char const *path)
+{
+    char dir[512], file[512], name[256];
+    snprintf(dir, sizeof dir, "%s", path);
+    snprintf(file, sizeof file, "%s", path);
+    snprintf(name, sizeof name, "%s", basename(file));
+    char *ext = strrchr(name, '.');
+    if(ext)
+        *ext = 0;
+
+    memset(&run, 0, sizeof run);
+    run.name = name;
+    hostgint_reset();
+    reset_micropython();
+
+    shell.timer_id = timer_configure(TIMER_ANY, 1000000 / WIDGET_SHELL_FPS,
+        GINT_CALL(shell_timer_handler));
+    timer_start(shell.timer_id);
+
+    char cwd[512];
+    if(!getcwd(cwd, sizeof cwd) || chdir(dirname(dir)) < 0) {
+        perror(path);
+        return false;
+    }
+    snprintf(file, sizeof file, "%s", path);
+
+    uint64_t start = hostgint_time_us();
+    int ret = pyexec_file(basename(file));
+    uint64_t elapsed = hostgint_time_us() - start;
+
+    if(chdir(cwd) < 0)
+        perror(cwd);
+
+    /* Show the shell if the program ended with text to display */
+    if(console->render_needed && !run.stop_reason)
+        pe_draw();
+
+    bool ok = (ret == 1) || (run.stop_reason != NULL);
+    if(opt.echo)
+        printf("\n");
+    printf("== %s: %s%s\n", path,
+        run.stop_reason ? "stopped, " : (ok ? "ok" : "error"),
+        run.stop_reason ? run.stop_reason : "");
+    printf("  time     %.3f s (%.3f s of waiting skipped)\n",
+        elapsed / 1e6, hostgint_slept_us() / 1e6);
+    report_frames();
+    report_calls();
+    printf("  screen   %08x\n", (unsigned)hostgint_screen_hash());
+
+    if(opt.output_dir && !opt.all_frames)
+        save_frame(opt.output_dir, "");
+    if(opt.golden_dir) {
+        char golden[512];
+        snprintf(golden, sizeof golden, "%s/%s.ppm", opt.golden_dir, name);
+        int diff = hostgint_compare_ppm(golden);
+        if(diff < 0)
+            printf("  golden   %s: missing or invalid\n", golden);
+        else if(diff > 0)
+            printf("  golden   %s: %d pixels differ\n", golden, diff);
+        else
+            printf("  golden   %s: match\n", golden);
+        ok = ok && (diff == 0);
+    }
+
+    timer_stop(shell.timer_id);
+    free(run.frame_time);
+    return ok;
+}
+
+static void usage(char const *argv0)
+{
+    fprintf(stderr,
+        "usage: %s [options] <program.py>...\n"
+        "  -k FILE  key script (see hostgint.h)\n"
+        "  -n N     stop after N frames (default 1000, 0 = no limit)\n"
+        "  -t SEC   stop after SEC seconds (default 60, 0 = no limit)\n"
+        "  -o DIR   save the last frame of each program as DIR/<name>.ppm\n"
+        "  -a       with -o, save every frame as DIR/<name>-<frame>.ppm\n"
+        "  -g DIR   compare the last frame with DIR/<name>.ppm\n"
+        "  -p DIR   add DIR to sys.path (relative to the program's folder)\n"
+        "  -s SEED  seed of the random module (default 1)\n"
+        "  -q       don't print the programs' output\n", argv0);
+}
+
+int main(int argc, char **argv)
+{
+    int c;
+    while((c = getopt(argc, argv, "k:n:t:o:ag:p:s:qh")) >= 0) {
+        switch(c) {
+        case 'k':
+            if(!hostgint_load_keys(optarg))
+                return 2;
+            break;
+        case 'n': opt.max_frames = strtoul(optarg, NULL, 0); break;
+        case 't': opt.max_seconds = strtod(optarg, NULL); break;
+        case 'o': opt.output_dir = optarg; break;
+        case 'a': opt.all_frames = true; break;
+        case 'g': opt.golden_dir = optarg; break;
+        case 'p':
+            if(opt.path_count < 8)
+                opt.path[opt.path_count++] = optarg;
+            break;
+        case 's': opt.seed = strtoul(optarg, NULL, 0); break;
+        case 'q': opt.echo = false; break;
+        default:
+            usage(argv[0]);
+            return (c == 'h') ? 0 : 2;
+        }
+    }
+    if(optind >= argc) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    hostgint_reset();
+    console = console_create(8192, 200);
+    shell.console = console;
+    shell.font = dfont_default();
+    shell.color = C_BLACK;
+    shell.line_spacing = 3;
+    shell.lines = (DHEIGHT - 6) / (shell.font->line_height + 3);
+
+    mp_stack_ctrl_init();
+    static uint8_t heap_ostk[HEAP_OSTK_SIZE], heap_uram[HEAP_URAM_SIZE];
+    gc_init(heap_ostk, heap_ostk + sizeof heap_ostk);
+    gc_add(heap_uram, heap_uram + sizeof heap_uram);
+    mp_init();
+
+    int failed = 0;
+    for(int i = optind; i < argc; i++)
+        failed += !run_program(argv[i]);
+
+    mp_deinit();
+    if(failed)
+        printf("%d program(s) failed\n", failed);
+    return failed != 0;
+}
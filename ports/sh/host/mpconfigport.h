@@ -0,0 +1,44 @@
+//---------------------------------------------------------------------------//
+//    ____        PythonExtra                                                //
+//.-'`_ o `;__,   A community port of MicroPython for CASIO calculators.     //
+//.-'` `---`  '   License: MIT (except some files; see LICENSE)              //
+//---------------------------------------------------------------------------//
+// pe.host.mpconfigport: Port configuration for the headless host build
+//
+// This is the fx-CG configuration with the few changes needed to run on a
+// little-endian computer and produce reproducible measurements.
+//---
+
+#ifndef __PYTHONEXTRA_HOST_MPCONFIGPORT_H
+#define __PYTHONEXTRA_HOST_MPCONFIGPORT_H
+
+#include "../mpconfigport.h"
+#include "hostgint.h"
+
+/* Let MicroPython detect the host's endianness */
+#undef MP_ENDIANNESS_BIG
+
+/* The native emitter produces SuperH code, which the host can't run */
+#undef MICROPY_EMIT_SH
+#define MICROPY_EMIT_SH                   (0)
+
+/* Don't write __pycache__ folders next to the benchmarks; every run should
+   measure the same thing */
+#undef MICROPY_PERSISTENT_CODE_CACHE
+#define MICROPY_PERSISTENT_CODE_CACHE     (0)
+
+/* The runner prints its reports with the C library's printf() */
+#define MICROPY_USE_INTERNAL_PRINTF       (0)
+
+/* Seed set by the runner so that random programs are repeatable */
+#undef MICROPY_PY_RANDOM_SEED_INIT_FUNC
+#define MICROPY_PY_RANDOM_SEED_INIT_FUNC (host_random_seed())
+
+/* Run timers and check the runner's limits in addition to the usual work */
+#undef MICROPY_VM_HOOK_LOOP
+#define MICROPY_VM_HOOK_LOOP \
+    { host_vm_hook(); \
+      if(pe_shell->widget.update) pe_draw(); \
+      if(pe_dupdate_scheduled) pe_dupdate(); }
+
+#endif /* __PYTHONEXTRA_HOST_MPCONFIGPORT_H */
@@ -0,0 +1,205 @@
+//---------------------------------------------------------------------------//
+//    ____        PythonExtra                                                //
+//.-'`_ o `;__,   A community port of MicroPython for CASIO calculators.     //
+//.-'` `---`  '   License: MIT (except some files; see LICENSE)              //
+//---------------------------------------------------------------------------//
+
+#include "hostgint.h"
+#include "internal.h"
+#include <gint/timer.h>
+#include <gint/clock.h>
+#include <gint/rtc.h>
+#include <gint/hardware.h>
+#include <gint/drivers/r61524.h>
+#include "../numworks/syscalls.h"
+#include <string.h>
+#include <time.h>
+
+void hostgint_reset(void)
+{
+    hostgint_system_reset();
+    hostgint_display_reset();
+    hostgint_text_reset();
+    hostgint_keyboard_reset();
+}
+
+//=== Clock ===//
+
+static uint64_t epoch_ns, slept_us;
+
+static uint64_t monotonic_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+uint64_t hostgint_time_us(void)
+{
+    return (monotonic_ns() - epoch_ns) / 1000 + slept_us;
+}
+
+uint64_t hostgint_slept_us(void)
+{
+    return slept_us;
+}
+
+void sleep_us(uint64_t delay_us)
+{
+    slept_us += delay_us;
+    hostgint_poll_timers();
+}
+
+void sleep_ms(uint64_t delay_ms)
+{
+    sleep_us(delay_ms * 1000);
+}
+
+uint32_t rtc_ticks(void)
+{
+    /* The RTC runs at 128 Hz */
+    return hostgint_time_us() * 128 / 1000000;
+}
+
+//=== Timers ===//
+
+#define TIMER_COUNT 16
+
+static struct {
+    bool used, running;
+    uint64_t delay_us;
+    uint64_t next_us;
+    gint_call_t call;
+} timers[TIMER_COUNT];
+
+int timer_configure(int timer, uint64_t delay_us, gint_call_t call)
+{
+    (void)timer;
+    for(int id = 0; id < TIMER_COUNT; id++) {
+        if(timers[id].used)
+            continue;
+        timers[id].used = true;
+        timers[id].running = false;
+        timers[id].delay_us = delay_us ? delay_us : 1;
+        timers[id].call = call;
+        return id;
+    }
+    return -1;
+}
+
+void timer_start(int id)
+{
+    if(id < 0 || id >= TIMER_COUNT || !timers[id].used)
+        return;
+    timers[id].running = true;
+    timers[id].next_us = hostgint_time_us() + timers[id].delay_us;
+}
+
+void timer_pause(int id)
+{
+    if(id >= 0 && id < TIMER_COUNT)
+        timers[id].running = false;
+}
+
+void timer_stop(int id)
+{
+    if(id >= 0 && id < TIMER_COUNT)
+        timers[id].used = timers[id].running = false;
+}
+
+void hostgint_poll_timers(void)
+{
+    uint64_t now = hostgint_time_us();
+
+    for(int id = 0; id < TIMER_COUNT; id++) {
+        if(!timers[id].running || now < timers[id].next_us)
+            continue;
+
+        /* Fire once even if several periods elapsed, like a busy calculator
+           that only catches the last interrupt */
+        timers[id].next_us += timers[id].delay_us;
+        if(timers[id].next_us <= now)
+            timers[id].next_us = now + timers[id].delay_us;
+        if(gint_call(timers[id].call) == TIMER_STOP)
+            timer_stop(id);
+    }
+}
+
+int gint_call_set_int(volatile int *pointer)
+{
+    *pointer = 1;
+    return TIMER_CONTINUE;
+}
+
+//=== Profiling ===//
+
+static hostgint_profile_t profile[HOSTGINT_CALL_COUNT] = {
+#define X(name) [HOSTGINT_CALL_##name] = { #name, 0, 0 },
+    HOSTGINT_PROFILED(X)
+#undef X
+};
+static int profile_depth;
+
+uint64_t hostgint_profile_enter(void)
+{
+    return (profile_depth++ == 0) ? monotonic_ns() : 0;
+}
+
+void hostgint_profile_leave(int call, uint64_t start)
+{
+    /* Also ignores calls interrupted by hostgint_profile_unwind() */
+    if(profile_depth <= 0 || --profile_depth != 0)
+        return;
+    profile[call].count++;
+    profile[call].total_ns += monotonic_ns() - start;
+}
+
+void hostgint_profile_unwind(void)
+{
+    profile_depth = 0;
+}
+
+hostgint_profile_t const *hostgint_profile(void)
+{
+    return profile;
+}
+
+//=== Hardware ===//
+
+uint32_t gint[16] = {
+    [HWCALC] = HWCALC_FXCG50,
+};
+
+static uint16_t brightness = 0x0f;
+
+uint16_t r61524_get(int reg)
+{
+    return (reg == 0x5a1) ? brightness : 0;
+}
+
+void r61524_set(int reg, uint16_t value)
+{
+    if(reg == 0x5a1)
+        brightness = value;
+}
+
+int CASIOWIN_GetBatteryType(void)
+{
+    return 1;
+}
+
+int CASIOWIN_GetMainBatteryVoltage(int one)
+{
+    (void)one;
+    return 450;
+}
+
+void hostgint_system_reset(void)
+{
+    epoch_ns = monotonic_ns();
+    slept_us = 0;
+    memset(timers, 0, sizeof timers);
+    for(int i = 0; i < HOSTGINT_CALL_COUNT; i++)
+        profile[i].count = profile[i].total_ns = 0;
+    profile_depth = 0;
+}
@@ -0,0 +1,309 @@
+//---------------------------------------------------------------------------//
+//    ____        PythonExtra                                                //
+//.-'`_ o `;__,   A community port of MicroPython for CASIO calculators.     //
+//.-'` `---`  '   License: MIT (except some files; see LICENSE)              //
+//---------------------------------------------------------------------------//
+
+#include "hostgint.h"
+#include "internal.h"
+#include <gint/display.h>
+#include <gint/defs/util.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Fonts used by the port, which are converted by fxconv on the calculator
+   build. The host build generates placeholders of the same size. */
+font_t font_9, font_13, font_19, numworks;
+static font_t font_default;
+
+static font_t const *current_font = &font_default;
+
+//=== Placeholder fonts ===//
+
+/* Unicode blocks of the placeholders: ASCII, Latin-1 to Latin Extended-B,
+   and Greek, which covers the characters commonly printed by programs. */
+static uint32_t const placeholder_blocks[] = {
+    0x20 << 12 | 95,
+    0xa0 << 12 | 432,
+    0x370 << 12 | 144,
+};
+
+static void set_bit(uint32_t *data, int bit)
+{
+    data[bit >> 5] |= 0x80000000u >> (bit & 31);
+}
+
+/* Build a monospaced font whose glyphs are boxes with the bits of their code
+   point inside, stored big-endian like fxconv's output. */
+static void make_placeholder(font_t *f, char const *name, int w, int h)
+{
+    int block_count = sizeof placeholder_blocks / sizeof *placeholder_blocks;
+    int glyph_count = 0;
+    for(int i = 0; i < block_count; i++)
+        glyph_count += placeholder_blocks[i] & 0xfff;
+
+    int storage = (w * h + 31) >> 5;
+    uint32_t *data = calloc(glyph_count * storage, 4);
+    uint32_t *blocks = malloc(sizeof placeholder_blocks);
+    if(!data || !blocks)
+        abort();
+
+    int g = 0;
+    for(int i = 0; i < block_count; i++) {
+        uint32_t start = placeholder_blocks[i] >> 12;
+        int length = placeholder_blocks[i] & 0xfff;
+
+        for(int j = 0; j < length; j++, g++) {
+            uint32_t code = start + j;
+            uint32_t *glyph = data + g * storage;
+            if(code == 0x20 || code == 0xa0)
+                continue;
+
+            for(int y = 1; y < h - 1; y++)
+            for(int x = 0; x < w; x++) {
+                bool edge = (y == 1 || y == h - 2 || x == 0 || x == w - 1);
+                int k = (y - 2) * (w - 2) + (x - 1);
+                if(edge || ((code >> (k % 9)) & 1))
+                    set_bit(glyph, y * w + x);
+            }
+        }
+    }
+
+    /* The data is big-endian, like on the calculator */
+    for(int i = 0; i < block_count; i++)
+        blocks[i] = __builtin_bswap32(placeholder_blocks[i]);
+    for(int i = 0; i < glyph_count * storage; i++)
+        data[i] = __builtin_bswap32(data[i]);
+
+    memset(f, 0, sizeof *f);
+    f->name = name;
+    f->line_height = h;
+    f->data_height = h;
+    f->block_count = block_count;
+    f->glyph_count = glyph_count;
+    f->char_spacing = 1;
+    f->line_distance = h + 1;
+    f->blocks = blocks;
+    f->data = data;
+    f->width = w;
+    f->storage_size = storage;
+}
+
+void hostgint_text_reset(void)
+{
+    if(!font_default.data) {
+        make_placeholder(&font_default, "default", 7, 9);
+        make_placeholder(&font_9, "font_9", 7, 10);
+        make_placeholder(&font_13, "font_13", 9, 17);
+        make_placeholder(&font_19, "font_19", 13, 23);
+        make_placeholder(&numworks, "numworks", 10, 16);
+    }
+    current_font = &font_default;
+}
+
+font_t const *dfont(font_t const *font)
+{
+    font_t const *old = current_font;
+    current_font = font ? font : &font_default;
+    return old;
+}
+
+font_t const *dfont_default(void)
+{
+    return &font_default;
+}
+
+//=== Glyph lookup ===//
+
+static uint32_t be32(void const *p, int index)
+{
+    uint8_t const *b = (uint8_t const *)p + 4 * index;
+    return ((uint32_t)b[0] << 24) | (b[1] << 16) | (b[2] << 8) | b[3];
+}
+
+/* Decode the next UTF-8 code point, or return 0 at the end of the string. */
+static uint32_t utf8_next(uint8_t const **str, uint8_t const *end)
+{
+    uint8_t const *s = *str;
+    if((end && s >= end) || !*s)
+        return 0;
+
+    uint32_t c = *s++;
+    int extra = (c >= 0xf0) ? 3 : (c >= 0xe0) ? 2 : (c >= 0xc0) ? 1 : 0;
+    if(extra)
+        c &= 0x3f >> extra;
+    while(extra-- > 0 && (*s & 0xc0) == 0x80 && (!end || s < end))
+        c = (c << 6) | (*s++ & 0x3f);
+
+    *str = s;
+    return c;
+}
+
+static int glyph_index(font_t const *f, uint32_t code)
+{
+    int g = 0;
+    for(int i = 0; i < f->block_count; i++) {
+        uint32_t block = be32(f->blocks, i);
+        uint32_t start = block >> 12, length = block & 0xfff;
+        if(code >= start && code < start + length)
+            return g + (code - start);
+        g += length;
+    }
+    return -1;
+}
+
+static int glyph_width(font_t const *f, int g)
+{
+    return f->prop ? f->glyph_width[g] : f->width;
+}
+
+/* Offset of a glyph's data, in longwords. */
+static int glyph_offset(font_t const *f, int g)
+{
+    if(!f->prop)
+        return g * f->storage_size;
+
+    uint8_t const *index = f->glyph_index;
+    int offset = (index[2 * (g >> 3)] << 8) | index[2 * (g >> 3) + 1];
+    for(int k = g & ~7; k < g; k++)
+        offset += (f->glyph_width[k] * f->data_height + 31) >> 5;
+    return offset;
+}
+
+//=== Size computations ===//
+
+static void text_size(char const *str, int size, font_t const *f, int *w,
+    int *h)
+{
+    if(!f) f = current_font;
+    uint8_t const *s = (uint8_t const *)str;
+    uint8_t const *end = (size >= 0) ? s + size : NULL;
+    int width = 0;
+    uint32_t code;
+
+    while((code = utf8_next(&s, end))) {
+        int g = glyph_index(f, code);
+        if(g < 0)
+            continue;
+        if(width > 0)
+            width += f->char_spacing;
+        width += glyph_width(f, g);
+    }
+
+    if(w) *w = width;
+    if(h) *h = f->line_height;
+}
+
+void dsize(char const *str, font_t const *font, int *w, int *h)
+{
+    HOSTGINT_PROFILE(dsize, text_size(str, -1, font, w, h));
+}
+
+void dnsize(char const *str, int size, font_t const *font, int *w, int *h)
+{
+    HOSTGINT_PROFILE(dnsize, text_size(str, size, font, w, h));
+}
+
+/* Longest prefix that fits in `width` pixels. At least one character is
+   consumed when width > 0 so that callers splitting lines make progress. */
+static char const *rsize(char const *str, font_t const *f, int width, int *w)
+{
+    if(!f) f = current_font;
+    uint8_t const *s = (uint8_t const *)str;
+    int used = 0;
+
+    while(1) {
+        uint8_t const *next = s;
+        uint32_t code = utf8_next(&next, NULL);
+        if(!code)
+            break;
+        int g = glyph_index(f, code);
+        int extra = 0;
+        if(g >= 0)
+            extra = glyph_width(f, g) + (used > 0 ? f->char_spacing : 0);
+        if(used + extra > width && (s != (uint8_t const *)str || width <= 0))
+            break;
+        used += extra;
+        s = next;
+    }
+
+    if(w) *w = used;
+    return (char const *)s;
+}
+
+char const *drsize(char const *str, font_t const *font, int width, int *w)
+{
+    char const *end;
+    HOSTGINT_PROFILE(drsize, end = rsize(str, font, width, w));
+    return end;
+}
+
+//=== Rendering ===//
+
+static void render_glyph(font_t const *f, int g, int x, int y, int fg)
+{
+    int w = glyph_width(f, g);
+    int h = f->data_height;
+    int offset = glyph_offset(f, g);
+
+    for(int bit = 0; bit < w * h; bit++) {
+        uint32_t word = be32(f->data, offset + (bit >> 5));
+        if((word << (bit & 31)) & 0x80000000u)
+            hostgint_pixel(x + bit % w, y + bit / w, fg);
+    }
+}
+
+static void text(int x, int y, int fg, int bg, int halign, int valign,
+    char const *str, int size)
+{
+    font_t const *f = current_font;
+    int w, h;
+    text_size(str, size, f, &w, &h);
+
+    if(halign == DTEXT_RIGHT) x -= w - 1;
+    if(halign == DTEXT_CENTER) x -= (w >> 1);
+    if(valign == DTEXT_BOTTOM) y -= h - 1;
+    if(valign == DTEXT_MIDDLE) y -= (h >> 1);
+
+    if(bg != C_NONE && w > 0) {
+        for(int dy = 0; dy < f->data_height; dy++)
+            hostgint_hspan(x, x + w - 1, y + dy, bg);
+    }
+
+    uint8_t const *s = (uint8_t const *)str;
+    uint8_t const *end = (size >= 0) ? s + size : NULL;
+    uint32_t code;
+
+    while((code = utf8_next(&s, end))) {
+        int g = glyph_index(f, code);
+        if(g < 0)
+            continue;
+        render_glyph(f, g, x, y, fg);
+        x += glyph_width(f, g) + f->char_spacing;
+    }
+}
+
+void dtext_opt(int x, int y, int fg, int bg, int halign, int valign,
+    char const *str, int size)
+{
+    HOSTGINT_PROFILE(dtext_opt,
+        text(x, y, fg, bg, halign, valign, str, size));
+}
+
+void dtext(int x, int y, int fg, char const *str)
+{
+    dtext_opt(x, y, fg, C_NONE, DTEXT_LEFT, DTEXT_TOP, str, -1);
+}
+
+void dprint(int x, int y, int fg, char const *format, ...)
+{
+    char str[256];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(str, sizeof str, format, args);
+    va_end(args);
+
+    HOSTGINT_PROFILE(dprint,
+        text(x, y, fg, C_NONE, DTEXT_LEFT, DTEXT_TOP, str, -1));
+}
@@ -101,8 +101,9 @@ static bool py_file_filter(struct dirent const *ent)
 {
     if(!jfileselect_default_filter(ent))
         return false;
+    /* Hide the compiled code cache (see pycache.c) */
     if(ent->d_type == DT_DIR)
-        return true;
+        return strcmp(ent->d_name, "__pycache__") != 0;
     return strendswith(ent->d_name, ".py");
 }
 
@@ -5,6 +5,9 @@
 //---------------------------------------------------------------------------//
 // pe.mpconfigport: MicroPython's main port configuration file
 
+#ifndef __PYTHONEXTRA_MPCONFIGPORT_H
+#define __PYTHONEXTRA_MPCONFIGPORT_H
+
 #include <stdint.h>
 #include <alloca.h>
 #include <gint/rtc.h>
@@ -21,6 +24,8 @@
 #if PE_DEBUG
 extern const struct _mp_print_t mp_debug_print;
 #define MICROPY_DEBUG_PRINTER             (&mp_debug_print)
+/* Allocation-site heap profiler, micropython.heap_profile() */
+#define MICROPY_PY_MICROPYTHON_HEAP_PROFILE (64)
 #endif
 
 /* Custom option to use relative imports. For instance when working at the fs
@@ -35,6 +40,8 @@ extern const struct _mp_print_t mp_debug_print;
 #define MICROPY_ENABLE_COMPILER           (1)
 #define MICROPY_ENABLE_GC                 (1)
 #define MICROPY_GC_SPLIT_HEAP             (1)
+/* fx-CP uses 65 areas, fx-9860G as many 64 kB areas as kmalloc() gives */
+#define MICROPY_GC_SPLIT_HEAP_INDEX       (80)
 #define MP_ENDIANNESS_BIG                 (1)
 #define MICROPY_READER_POSIX              (1)
 #define MICROPY_ERROR_REPORTING           (MICROPY_ERROR_REPORTING_DETAILED)
@@ -42,6 +49,17 @@ extern const struct _mp_print_t mp_debug_print;
 #define MICROPY_FLOAT_IMPL                (MICROPY_FLOAT_IMPL_DOUBLE)
 #define MICROPY_REPL_EVENT_DRIVEN         (1)
 
+/* @micropython.native and @micropython.viper (py/asmsh.c); the emitter keeps
+   its exception handler in the r8 slot of the nlrsh.c buffer, so it follows
+   the opt-in hand-written NLR (MICROPY_NLR_SH).  Neither has been run on
+   qemu-sh4 or hardware yet, so mpy-cross doesn't offer -march=sh4 */
+#define MICROPY_EMIT_SH                   (MICROPY_NLR_SH)
+
+/* Cache compiled modules as .mpy data in __pycache__ folders (pycache.c) */
+#define MICROPY_PERSISTENT_CODE_LOAD      (1)
+#define MICROPY_PERSISTENT_CODE_SAVE      (1)
+#define MICROPY_PERSISTENT_CODE_CACHE     (1)
+
 /* Other features that we select against MICROPY_CONFIG_ROM_LEVEL */
 #define MICROPY_PY_FSTRINGS               (1) /* in EXTRA_FEATURES */
 #define MICROPY_HELPER_REPL               (1) /* in EXTRA_FEATURES */
@@ -54,12 +72,19 @@ extern const struct _mp_print_t mp_debug_print;
 #define MICROPY_PY_ALL_SPECIAL_METHODS    (1) /* in EXTRA_FEATURES */
 #define MICROPY_PY_REVERSE_SPECIAL_METHODS (1) /* in EXTRA_FEATURES */
 #define MICROPY_PY_BUILTINS_ROUND_INT     (1) /* in EXTRA_FEATURES */
+#define MICROPY_PY_MICROPYTHON_MEM_INFO   (1) /* in EXTRA_FEATURES */
+#define MICROPY_QSTR_HASH_INDEX           (1) /* in EXTRA_FEATURES */
 // #define MICROPY_PY_SYS_STDFILES           (1) /* in EXTRA_FEATURES */
 
 #define MICROPY_ALLOC_PATH_MAX            (256)
 #define MICROPY_ALLOC_PARSE_CHUNK_INIT    (32)
 #define MICROPY_MEM_STATS                 (0)
 #define MICROPY_GC_ALLOC_THRESHOLD        (1)
+#define MICROPY_GC_FREE_LISTS             (16)
+#define MICROPY_GC_ATB_WORD_SCAN          (1)
+#define MICROPY_GC_LAZY_SWEEP             (1)
+/* Free unused runtime qstrs instead of keeping them until a reset */
+#define MICROPY_QSTR_GC                   (1)
 #define MICROPY_ENABLE_DOC_STRING         (0)
 #define MICROPY_BUILTIN_METHOD_CHECK_SELF_ARG (1)
 
@@ -129,3 +154,4 @@ typedef long mp_off_t;
 
 #define MP_STATE_PORT MP_STATE_VM
 
+#endif /* __PYTHONEXTRA_MPCONFIGPORT_H */
@@ -7,11 +7,12 @@
 #include "py/objarray.h"
 #include "py/obj.h"
 
-mp_obj_t ptr_to_memoryview(void *ptr, int size, int typecode, bool rw)
+mp_obj_t ptr_to_memoryview(const void *ptr, int size, int typecode, bool rw)
 {
     if(ptr == NULL)
         return mp_const_none;
     if(rw)
         typecode |= MP_OBJ_ARRAY_TYPECODE_FLAG_RW;
-    return mp_obj_new_memoryview(typecode, size, ptr);
+    // Read-only views (rw false) are how const data is exposed
+    return mp_obj_new_memoryview(typecode, size, (void *)ptr);
 }
\ No newline at end of file
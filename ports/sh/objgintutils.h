@@ -11,7 +11,7 @@
 #include "py/obj.h"
 
 
-mp_obj_t ptr_to_memoryview(void *ptr, int size, int typecode, bool rw);
+mp_obj_t ptr_to_memoryview(const void *ptr, int size, int typecode, bool rw);
 
 
 #endif // __PYTHONEXTRA_OBJGINTUTILS_H
\ No newline at end of file
@@ -0,0 +1,191 @@
+//---------------------------------------------------------------------------//
+//    ____        PythonExtra                                                //
+//.-'`_ o `;__,   A community port of MicroPython for CASIO calculators.     //
+//.-'` `---`  '   License: MIT (except some files; see LICENSE)              //
+//---------------------------------------------------------------------------//
+// pe.pycache: Persistent cache of compiled modules
+//
+// Compiling a large program takes several seconds on the calculator, and the
+// file browser resets MicroPython and imports the program again on every run.
+// To avoid paying that price each time, every source file compiled by an
+// import is saved in MicroPython's .mpy format to `__pycache__/<name>.pyc`
+// next to it, and loaded from there as long as the source doesn't change.
+//
+// Each cache file starts with a small header recording the size, mtime and a
+// checksum of the source; any mismatch (or a corrupt/incompatible entry) gets
+// the source recompiled and the entry rewritten.
+//---
+
+#include "py/persistentcode.h"
+#include "py/reader.h"
+#include "py/runtime.h"
+
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+
+#if MICROPY_PERSISTENT_CODE_CACHE
+
+#define PE_PYCACHE_DIR "__pycache__"
+#define PE_PYCACHE_MAGIC 0x50456301 /* "PEc", format version 1 */
+
+struct pe_pycache_header {
+    uint32_t magic;
+    uint32_t source_size;
+    uint32_t source_mtime;
+    uint32_t source_hash;
+};
+
+/* Compute the header that the cache entry for `source` should have. Returns
+   false if the source file cannot be read. */
+static bool pycache_header(char const *source, struct pe_pycache_header *h)
+{
+    struct stat st;
+    if(stat(source, &st) < 0)
+        return false;
+
+    int fd = open(source, O_RDONLY);
+    if(fd < 0)
+        return false;
+
+    /* The filesystem doesn't always maintain mtimes, so also hash the
+       contents (FNV-1a); reading is much cheaper than compiling anyway. */
+    uint32_t hash = 2166136261u;
+    uint8_t buf[256];
+    ssize_t n;
+    while((n = read(fd, buf, sizeof buf)) > 0) {
+        for(ssize_t i = 0; i < n; i++)
+            hash = (hash ^ buf[i]) * 16777619u;
+    }
+    close(fd);
+    if(n < 0)
+        return false;
+
+    h->magic = PE_PYCACHE_MAGIC;
+    h->source_size = st.st_size;
+    h->source_mtime = st.st_mtime;
+    h->source_hash = hash;
+    return true;
+}
+
+/* Get the path of the cache entry for `source` ("a/b.py" -> "a/__pycache__/
+   b.pyc"). If `dir` is set, stop after the folder name instead. */
+static void pycache_path(vstr_t *path, char const *source, bool dir)
+{
+    char const *slash = strrchr(source, '/');
+    char const *name = slash ? slash + 1 : source;
+    size_t name_len = strlen(name);
+    if(name_len >= 3 && !strcmp(name + name_len - 3, ".py"))
+        name_len -= 3;
+
+    vstr_add_strn(path, source, name - source);
+    vstr_add_str(path, PE_PYCACHE_DIR);
+    if(dir)
+        return;
+    vstr_add_char(path, '/');
+    vstr_add_strn(path, name, name_len);
+    vstr_add_str(path, ".pyc");
+}
+
+bool mp_raw_code_cache_load(qstr source_file, mp_compiled_module_t *cm)
+{
+    char const *source = qstr_str(source_file);
+    struct pe_pycache_header expected, h;
+    if(!pycache_header(source, &expected))
+        return false;
+
+    vstr_t path;
+    vstr_init(&path, 32);
+    pycache_path(&path, source, false);
+    int fd = open(vstr_null_terminated_str(&path), O_RDONLY);
+    vstr_clear(&path);
+    if(fd < 0)
+        return false;
+
+    if(read(fd, &h, sizeof h) != sizeof h
+       || memcmp(&h, &expected, sizeof h)) {
+        close(fd);
+        return false;
+    }
+
+    /* The reader owns the fd from here and closes it, even on errors */
+    nlr_buf_t nlr;
+    if(nlr_push(&nlr) == 0) {
+        mp_reader_t reader;
+        mp_reader_new_file_from_fd(&reader, fd, true);
+        mp_raw_code_load(&reader, cm);
+        nlr_pop();
+        return true;
+    }
+
+    /* An entry from an older version of MicroPython raises ValueError; drop
+       it and recompile. Anything else (MemoryError, KeyboardInterrupt) is
+       an actual error for the import. */
+    mp_obj_base_t *exc = nlr.ret_val;
+    if(mp_obj_is_subclass_fast(MP_OBJ_FROM_PTR(exc->type),
+                               MP_OBJ_FROM_PTR(&mp_type_ValueError)))
+        return false;
+    nlr_jump(nlr.ret_val);
+}
+
+struct pycache_writer {
+    int fd;
+    bool failed;
+};
+
+static void pycache_print_strn(void *env, char const *str, size_t len)
+{
+    struct pycache_writer *w = env;
+    if(!w->failed && write(w->fd, str, len) != (ssize_t)len)
+        w->failed = true;
+}
+
+void mp_raw_code_cache_store(qstr source_file, mp_compiled_module_t *cm)
+{
+    char const *source = qstr_str(source_file);
+    struct pe_pycache_header h;
+    if(!pycache_header(source, &h))
+        return;
+
+    vstr_t path;
+    vstr_init(&path, 32);
+    pycache_path(&path, source, true);
+    mkdir(vstr_null_terminated_str(&path), 0755);
+    vstr_reset(&path);
+    pycache_path(&path, source, false);
+    char const *path_str = vstr_null_terminated_str(&path);
+
+    struct pycache_writer w = { .fd = -1, .failed = false };
+    w.fd = open(path_str, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(w.fd < 0) {
+        vstr_clear(&path);
+        return;
+    }
+
+    /* Write the header last so that an interrupted write (eg. the calculator
+       being reset) never leaves an entry that looks valid */
+    struct pe_pycache_header blank = { 0 };
+    mp_print_t print = { &w, pycache_print_strn };
+    pycache_print_strn(&w, (void *)&blank, sizeof blank);
+
+    nlr_buf_t nlr;
+    if(nlr_push(&nlr) == 0) {
+        mp_raw_code_save(cm, &print);
+        nlr_pop();
+    }
+    else w.failed = true;
+
+    if(!w.failed && lseek(w.fd, 0, SEEK_SET) == 0)
+        pycache_print_strn(&w, (void *)&h, sizeof h);
+    else
+        w.failed = true;
+    close(w.fd);
+
+    /* A failed cache write is not an error, the program just runs slower */
+    if(w.failed)
+        unlink(path_str);
+    vstr_clear(&path);
+}
+
+#endif /* MICROPY_PERSISTENT_CODE_CACHE */
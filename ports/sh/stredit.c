@@ -31,14 +31,32 @@ bool stredit_init(stredit_t *ed, int prealloc_size, int reserved_bytes,
     ed->size = 0;
     ed->alloc_size = reserved_bytes + prealloc_size + 1;
     ed->prefix = 0;
+    ed->borrowed = false;
     return true;
 }
 
+void stredit_init_buffer(stredit_t *ed, char *raw, int alloc_size,
+    int reserved_bytes, int max_size)
+{
+    assert(reserved_bytes + max_size + 1 <= alloc_size);
+
+    memset(raw, 0, reserved_bytes);
+    raw[reserved_bytes] = 0;
+    ed->raw = raw;
+
+    ed->reserved = reserved_bytes;
+    ed->max_size = max_size;
+    ed->size = 0;
+    ed->alloc_size = alloc_size;
+    ed->prefix = 0;
+    ed->borrowed = true;
+}
+
 char *stredit_freeze_and_reset(stredit_t *ed)
 {
     /* Downsize the allocation if it's larger than needed. */
     int size_needed = ed->reserved + ed->size + 1;
-    if(ed->alloc_size >= size_needed + 4)
+    if(!ed->borrowed && ed->alloc_size >= size_needed + 4)
         ed->raw = realloc(ed->raw, size_needed);
 
     char *raw = ed->raw;
@@ -49,7 +67,8 @@ char *stredit_freeze_and_reset(stredit_t *ed)
 
 void stredit_reset(stredit_t *ed)
 {
-    free(ed->raw);
+    if(!ed->borrowed)
+        free(ed->raw);
     memset(ed, 0, sizeof *ed);
 }
 
@@ -57,6 +76,8 @@ bool stredit_alloc(stredit_t *ed, int n)
 {
     if(ed->alloc_size >= ed->reserved + n + 1)
         return true;
+    if(ed->borrowed)
+        return false;
 
     /* Always increase the size by at least 16 so we can insert many times in a
        row without worrying about excessive allocations. */
@@ -34,6 +34,9 @@ typedef struct
     uint16_t alloc_size;
     /* Number of initial characters that can't be edited. */
     uint16_t prefix;
+    /* Whether raw was provided by the caller, in which case it is never
+       reallocated nor freed. */
+    bool borrowed;
 
 } stredit_t;
 
@@ -43,13 +46,19 @@ typedef struct
 bool stredit_init(stredit_t *ed, int init_chars, int reserved_bytes,
     int max_size);
 
+/* Same as stredit_init(), but edit within the provided buffer of alloc_size
+   bytes, which must be large enough for max_size characters. */
+void stredit_init_buffer(stredit_t *ed, char *raw, int alloc_size,
+    int reserved_bytes, int max_size);
+
 /* Get the data pointer out of an stredit. */
 static inline char *stredit_data(stredit_t *ed)
 {
     return ed ? ed->raw + ed->reserved : NULL;
 }
 
-/* Reset an editable string. This frees and destroys the string. */
+/* Reset an editable string. This frees (unless borrowed) and destroys the
+   string. */
 void stredit_reset(stredit_t *ed);
 
 /* Finish editing; return the raw pointer (with its ownership) and reset the
@@ -0,0 +1,150 @@
+//---------------------------------------------------------------------------//
+//    ____        PythonExtra                                                //
+//.-'`_ o `;__,   A community port of MicroPython for CASIO calculators.     //
+//.-'` `---`  '   License: MIT (except some files; see LICENSE)              //
+//---------------------------------------------------------------------------//
+// Host test for pe.textarena: drives the arena the way the console does
+// (reserve a full line, shrink it, recycle the oldest lines when full) with
+// random line lengths, and checks the wraparound invariants and that live
+// data is never overwritten.
+//---
+
+#include "textarena.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ARENA_SIZE 4096
+#define LINE_MAX 300
+#define LIVE_MAX 64
+
+struct line { char *ptr; int size; unsigned char fill; };
+
+static struct line live[LIVE_MAX];
+static int live_start, live_count;
+static int failures;
+
+#define CHECK(cond) do { if(!(cond)) { \
+    fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+    failures++; return; } } while(0)
+
+static int align(int n)
+{
+    return (n + TEXTARENA_ALIGN - 1) & -TEXTARENA_ALIGN;
+}
+
+static struct line *nth(int i)
+{
+    return &live[(live_start + i) % LIVE_MAX];
+}
+
+static void check_invariants(textarena_t const *ta)
+{
+    CHECK(0 <= ta->tail && ta->tail <= ta->size);
+    CHECK(0 <= ta->head && ta->head <= ta->size);
+    if(ta->wrap >= 0)
+        CHECK(ta->head <= ta->tail && ta->tail <= ta->wrap);
+    else
+        CHECK(ta->tail <= ta->head);
+    if(live_count == 0)
+        CHECK(ta->head == 0 && ta->tail == 0 && ta->wrap < 0);
+    else
+        CHECK(nth(0)->ptr == ta->data + ta->tail);
+
+    int used = 0;
+    for(int i = 0; i < live_count; i++) {
+        struct line *L = nth(i);
+        used += align(L->size);
+        CHECK(L->ptr >= ta->data && L->ptr + L->size <= ta->data + ta->size);
+        for(int j = 0; j < L->size; j++)
+            CHECK((unsigned char)L->ptr[j] == L->fill);
+    }
+    CHECK(used == textarena_used(ta));
+}
+
+static void free_oldest(textarena_t *ta)
+{
+    live_start = (live_start + 1) % LIVE_MAX;
+    live_count--;
+    if(live_count)
+        textarena_free_until(ta, nth(0)->ptr);
+    else
+        textarena_free_all(ta);
+}
+
+static void test_console_pattern(unsigned seed)
+{
+    static char storage[ARENA_SIZE];
+    textarena_t ta;
+    textarena_init(&ta, storage, sizeof storage);
+    live_start = live_count = 0;
+    srand(seed);
+
+    int wraps = 0;
+    for(int round = 0; round < 20000 && !failures; round++) {
+        if(live_count == LIVE_MAX)
+            free_oldest(&ta);
+
+        char *ptr;
+        while(!(ptr = textarena_alloc(&ta, LINE_MAX)) && live_count > 0)
+            free_oldest(&ta);
+        CHECK(ptr != NULL);
+        wraps += (ptr == ta.data && round > 0);
+
+        int size = 1 + rand() % LINE_MAX;
+        textarena_shrink_last(&ta, ptr, size);
+
+        struct line *L = nth(live_count++);
+        L->ptr = ptr;
+        L->size = size;
+        L->fill = rand();
+        memset(ptr, L->fill, size);
+        check_invariants(&ta);
+
+        /* Occasionally recycle a bunch of lines like the backlog cleaner */
+        if(rand() % 16 == 0) {
+            int n = rand() % (live_count + 1);
+            while(n-- > 0)
+                free_oldest(&ta);
+            check_invariants(&ta);
+        }
+    }
+    CHECK(wraps > 10);
+}
+
+static void test_exact_fit(void)
+{
+    static char storage[64];
+    textarena_t ta;
+    textarena_init(&ta, storage, sizeof storage);
+
+    char *a = textarena_alloc(&ta, 32);
+    char *b = textarena_alloc(&ta, 32);
+    CHECK(a == storage && b == storage + 32);
+    CHECK(textarena_alloc(&ta, 1) == NULL);
+
+    /* Wrap into exactly the freed space, making the arena full */
+    textarena_free_until(&ta, b);
+    char *c = textarena_alloc(&ta, 32);
+    CHECK(c == storage && ta.wrap == 64 && ta.head == ta.tail);
+    CHECK(textarena_alloc(&ta, 1) == NULL);
+    CHECK(textarena_used(&ta) == 64);
+
+    /* Passing the wrapping point unwraps */
+    textarena_free_until(&ta, c);
+    CHECK(ta.wrap < 0 && ta.tail == 0 && textarena_used(&ta) == 32);
+}
+
+int main(void)
+{
+    test_exact_fit();
+    for(unsigned seed = 1; seed <= 20 && !failures; seed++)
+        test_console_pattern(seed);
+
+    if(failures) {
+        printf("textarena: FAIL\n");
+        return 1;
+    }
+    printf("textarena: OK\n");
+    return 0;
+}
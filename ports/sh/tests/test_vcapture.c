@@ -0,0 +1,95 @@
+//---------------------------------------------------------------------------//
+//    ____        PythonExtra                                                //
+//.-'`_ o `;__,   A community port of MicroPython for CASIO calculators.     //
+//.-'` `---`  '   License: MIT (except some files; see LICENSE)              //
+//---------------------------------------------------------------------------//
+// Host test for pe.vcapture: encodes a synthetic animation to <stream> and
+// writes the original frames as big-endian words to <frames>. The Makefile
+// then decodes the stream with tools/vcdecode.py and compares.
+//---
+
+#include "vcapture.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define W 396
+#define H 224
+#define FRAMES 150
+
+static uint16_t frame[W * H];
+static long emitted;
+
+static void write_file(void *env, void const *data, int size)
+{
+    fwrite(data, 1, size, env);
+    emitted += size;
+}
+
+static void draw(int t)
+{
+    /* Background gradient that changes every 40 frames (uniform rows make
+       runs longer than a single RLE token) */
+    for(int y = 0; y < H; y++)
+    for(int x = 0; x < W; x++)
+        frame[y * W + x] = (t / 40) * 0x0821 + (y / 16);
+
+    /* Moving square */
+    int sx = (t * 5) % (W - 30), sy = (t * 3) % (H - 30);
+    for(int y = sy; y < sy + 30; y++)
+    for(int x = sx; x < sx + 30; x++)
+        frame[y * W + x] = 0xf800;
+
+    /* A noisy line now and then */
+    if(t % 7 == 0) {
+        for(int x = 0; x < W; x++)
+            frame[(t * 11 % H) * W + x] = rand();
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if(argc != 3) {
+        fprintf(stderr, "usage: %s <stream> <frames>\n", argv[0]);
+        return 2;
+    }
+    FILE *stream = fopen(argv[1], "wb"), *raw = fopen(argv[2], "wb");
+    if(!stream || !raw)
+        return 2;
+
+    vcapture_t vc;
+    if(!vcapture_init(&vc, W, H, W, VCAPTURE_RGB565))
+        return 2;
+
+    vcapture_sink_t sink = { .write = write_file, .env = stream };
+    long total = 0;
+    for(int t = 0; t < FRAMES; t++) {
+        draw(t);
+        if(t == 100)
+            vcapture_request_keyframe(&vc);
+
+        int size = vcapture_prepare(&vc, frame);
+        emitted = 0;
+        vc.prepare_us = t;
+        vcapture_emit(&vc, frame, &sink);
+        if(emitted != size) {
+            fprintf(stderr, "frame %d: prepared %d bytes, emitted %ld\n",
+                t, size, emitted);
+            return 1;
+        }
+        total += size;
+
+        for(int i = 0; i < W * H; i++) {
+            fputc(frame[i] >> 8, raw);
+            fputc(frame[i], raw);
+        }
+    }
+
+    vcapture_deinit(&vc);
+    fclose(stream);
+    fclose(raw);
+
+    long raw_total = (long)FRAMES * W * H * 2;
+    printf("vcapture: %ld bytes for %ld bytes of frames (%.1f%%)\n",
+        total, raw_total, 100.0 * total / raw_total);
+    return 0;
+}
@@ -0,0 +1,75 @@
+//---------------------------------------------------------------------------//
+//    ____        PythonExtra                                                //
+//.-'`_ o `;__,   A community port of MicroPython for CASIO calculators.     //
+//.-'` `---`  '   License: MIT (except some files; see LICENSE)              //
+//---------------------------------------------------------------------------//
+
+#include "textarena.h"
+#include <stddef.h>
+#include <assert.h>
+
+static int align(int size)
+{
+    return (size + TEXTARENA_ALIGN - 1) & -TEXTARENA_ALIGN;
+}
+
+void textarena_init(textarena_t *ta, void *data, int size)
+{
+    ta->data = data;
+    ta->size = size & -TEXTARENA_ALIGN;
+    textarena_free_all(ta);
+}
+
+void *textarena_alloc(textarena_t *ta, int size)
+{
+    size = align(size);
+
+    if(ta->wrap >= 0) {
+        /* Only the gap between the head and the tail is free */
+        if(ta->head + size > ta->tail)
+            return NULL;
+    }
+    else if(ta->head + size > ta->size) {
+        /* Not enough room at the end; wrap around if it fits before the tail.
+           This also works for an empty arena since then head == tail == 0. */
+        if(size > ta->tail)
+            return NULL;
+        ta->wrap = ta->head;
+        ta->head = 0;
+    }
+
+    void *ptr = ta->data + ta->head;
+    ta->head += size;
+    return ptr;
+}
+
+void textarena_shrink_last(textarena_t *ta, void *ptr, int size)
+{
+    int offset = (char *)ptr - ta->data;
+    assert(offset + align(size) <= ta->head);
+    ta->head = offset + align(size);
+}
+
+void textarena_free_until(textarena_t *ta, void *ptr)
+{
+    int offset = (char *)ptr - ta->data;
+
+    /* Moving below the tail means we passed the wrapping point */
+    if(ta->wrap >= 0 && offset < ta->tail)
+        ta->wrap = -1;
+    ta->tail = offset;
+}
+
+void textarena_free_all(textarena_t *ta)
+{
+    ta->head = 0;
+    ta->tail = 0;
+    ta->wrap = -1;
+}
+
+int textarena_used(textarena_t const *ta)
+{
+    if(ta->wrap >= 0)
+        return (ta->wrap - ta->tail) + ta->head;
+    return ta->head - ta->tail;
+}
@@ -0,0 +1,67 @@
+//---------------------------------------------------------------------------//
+//    ____        PythonExtra                                                //
+//.-'`_ o `;__,   A community port of MicroPython for CASIO calculators.     //
+//.-'` `---`  '   License: MIT (except some files; see LICENSE)              //
+//---------------------------------------------------------------------------//
+// pe.textarena: Ring-buffer arena for console text
+//
+// This header implements a fixed-size circular allocator for data that is
+// allocated and freed in FIFO order, like console lines. Allocations are laid
+// out contiguously from the "head" and released by advancing the "tail" past
+// the oldest ones, so printing doesn't go through malloc() and doesn't
+// fragment the OS heap. An allocation that doesn't fit before the end of the
+// storage is placed at offset 0 instead; the "wrap" offset remembers where the
+// upper part of the data stops until the tail catches up.
+//
+// The most recent allocation can be shrunk, which allows reserving a full
+// line, editing it in place and then keeping only the part that's used.
+//---
+
+#ifndef __PYTHONEXTRA_TEXTARENA_H
+#define __PYTHONEXTRA_TEXTARENA_H
+
+#include <stdbool.h>
+
+/* Alignment of allocations, suitable for console_fline_t. */
+#define TEXTARENA_ALIGN 4
+
+typedef struct
+{
+    /* Storage area, provided by the caller */
+    char *data;
+    /* Total size of the storage (multiple of TEXTARENA_ALIGN) */
+    int size;
+
+    /* Invariants:
+       - 0 <= tail, head <= size
+       - When not wrapped (wrap < 0), live data is [tail .. head).
+       - When wrapped, live data is [tail .. wrap) followed by [0 .. head), and
+         head <= tail <= wrap.
+       - The arena is empty iff head == tail and it's not wrapped, in which
+         case head == tail == 0. */
+    int head;
+    int tail;
+    int wrap;
+
+} textarena_t;
+
+/* Initialize an arena over the provided storage. */
+void textarena_init(textarena_t *ta, void *data, int size);
+
+/* Allocate `size` contiguous bytes at the head. Returns NULL if there isn't
+   enough free space; the caller should then free old allocations and retry. */
+void *textarena_alloc(textarena_t *ta, int size);
+
+/* Shrink the most recent allocation `ptr` to `size` bytes. */
+void textarena_shrink_last(textarena_t *ta, void *ptr, int size);
+
+/* Free all allocations older than `ptr`, which becomes the oldest. */
+void textarena_free_until(textarena_t *ta, void *ptr);
+
+/* Free all allocations. */
+void textarena_free_all(textarena_t *ta);
+
+/* Number of bytes currently allocated, excluding space lost to wrapping. */
+int textarena_used(textarena_t const *ta);
+
+#endif /* __PYTHONEXTRA_TEXTARENA_H */
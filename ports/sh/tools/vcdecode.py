@@ -0,0 +1,162 @@
+#!/usr/bin/env python3
+#
+# PythonExtra video capture decoder.
+#
+# Rebuilds the frames of a compressed video capture (see ports/sh/vcapture.h)
+# from the "pe"/"vcframe" fxlink messages saved by `fxlink -iw`, and reports
+# the capture cost per frame. Input files may contain any number of frames.
+#
+# Usage: vcdecode.py [-o DIR] [--raw FILE] [-q] INPUT...
+
+import argparse
+import os
+import struct
+import sys
+
+MAGIC = b"PEvc"
+VERSION = 1
+HEADER = struct.Struct(">4sBBHHHIIIIHH")
+RGB565, MONO = 0, 1
+KEYFRAME = 0x0001
+
+
+class DecodeError(Exception):
+    pass
+
+
+class Frame:
+    def __init__(self, header):
+        (
+            _,
+            _,
+            self.format,
+            self.width,
+            self.height,
+            self.row_words,
+            self.number,
+            self.size,
+            self.prepare_us,
+            self.prev_send_us,
+            self.spans,
+            self.flags,
+        ) = header
+        self.words = None
+
+
+def decode_rle(data, offset, count):
+    out = []
+    while len(out) < count:
+        (c,) = struct.unpack_from(">H", data, offset)
+        offset += 2
+        if c & 0x8000:
+            (w,) = struct.unpack_from(">H", data, offset)
+            offset += 2
+            out.extend([w] * ((c & 0x7FFF) + 1))
+        else:
+            n = c + 1
+            out.extend(struct.unpack_from(">%dH" % n, data, offset))
+            offset += 2 * n
+    if len(out) != count:
+        raise DecodeError("RLE data overflows span")
+    return out, offset
+
+
+def decode_stream(data, state):
+    """Decode all frames in data, updating the current picture in state."""
+    offset = 0
+    while offset < len(data):
+        header = HEADER.unpack_from(data, offset)
+        if header[0] != MAGIC or header[1] != VERSION:
+            raise DecodeError("bad frame header at offset %d" % offset)
+        f = Frame(header)
+        end = offset + f.size
+        offset += HEADER.size
+
+        n_words = f.height * f.row_words
+        if state.get("geometry") != (f.width, f.height, f.row_words):
+            if not f.flags & KEYFRAME:
+                raise DecodeError("frame %d: stream starts without keyframe" % f.number)
+            state["geometry"] = (f.width, f.height, f.row_words)
+            state["words"] = [0] * n_words
+        words = state["words"]
+
+        for _ in range(f.spans):
+            y0, rows = struct.unpack_from(">HH", data, offset)
+            offset += 4
+            start = y0 * f.row_words
+            span, offset = decode_rle(data, offset, rows * f.row_words)
+            words[start : start + len(span)] = span
+
+        if offset != end:
+            raise DecodeError("frame %d: size mismatch" % f.number)
+        f.words = list(words)
+        yield f
+
+
+def write_ppm(path, f):
+    pixels = bytearray()
+    if f.format == RGB565:
+        for w in f.words[: f.width * f.height]:
+            r, g, b = (w >> 11) & 0x1F, (w >> 5) & 0x3F, w & 0x1F
+            pixels += bytes(((r * 255) // 31, (g * 255) // 63, (b * 255) // 31))
+    else:
+        for y in range(f.height):
+            row = f.words[y * f.row_words : (y + 1) * f.row_words]
+            bits = b"".join(struct.pack(">H", w) for w in row)
+            for x in range(f.width):
+                black = (bits[x >> 3] >> (7 - (x & 7))) & 1
+                pixels += b"\x00\x00\x00" if black else b"\xff\xff\xff"
+    with open(path, "wb") as fp:
+        fp.write(b"P6\n%d %d\n255\n" % (f.width, f.height))
+        fp.write(pixels)
+
+
+def main():
+    p = argparse.ArgumentParser(description="Decode PythonExtra video captures.")
+    p.add_argument("inputs", nargs="+", help="files with saved vcframe messages")
+    p.add_argument("-o", "--output", help="directory to write frames to (PPM)")
+    p.add_argument("--raw", help="write all frames as raw big-endian words")
+    p.add_argument("-q", "--quiet", action="store_true", help="no statistics")
+    args = p.parse_args()
+
+    if args.output:
+        os.makedirs(args.output, exist_ok=True)
+    raw = open(args.raw, "wb") if args.raw else None
+
+    state = {}
+    frames = []
+    try:
+        for path in args.inputs:
+            with open(path, "rb") as fp:
+                data = fp.read()
+            for f in decode_stream(data, state):
+                if args.output:
+                    write_ppm(os.path.join(args.output, "frame-%05d.ppm" % len(frames)), f)
+                if raw:
+                    raw.write(struct.pack(">%dH" % len(f.words), *f.words))
+                f.words = None
+                frames.append(f)
+    except (DecodeError, struct.error) as e:
+        print("error:", e, file=sys.stderr)
+        return 1
+    finally:
+        if raw:
+            raw.close()
+
+    if not args.quiet and frames:
+        raw_size = frames[0].height * frames[0].row_words * 2
+        total = sum(f.size for f in frames)
+        prep = [f.prepare_us for f in frames]
+        send = [f.prev_send_us for f in frames[1:]] or [0]
+        print("%d frames (%d keyframes)" % (len(frames), sum(f.flags & KEYFRAME for f in frames)))
+        print(
+            "size: %d bytes/frame on average, %.1f%% of raw frames"
+            % (total // len(frames), 100 * total / (raw_size * len(frames)))
+        )
+        print("encode: %d us average, %d us max" % (sum(prep) // len(prep), max(prep)))
+        print("send:   %d us average, %d us max" % (sum(send) // len(send), max(send)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
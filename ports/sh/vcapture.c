@@ -0,0 +1,199 @@
+//---------------------------------------------------------------------------//
+//    ____        PythonExtra                                                //
+//.-'`_ o `;__,   A community port of MicroPython for CASIO calculators.     //
+//.-'` `---`  '   License: MIT (except some files; see LICENSE)              //
+//---------------------------------------------------------------------------//
+
+#include "vcapture.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Longest run or literal sequence in a single RLE token. */
+#define RLE_MAX 0x8000
+
+//=== Output ===//
+
+static void sink_flush(vcapture_sink_t *sink)
+{
+    if(sink->len > 0)
+        sink->write(sink->env, sink->buf, sink->len);
+    sink->len = 0;
+}
+
+static void sink_u16(vcapture_sink_t *sink, uint16_t x)
+{
+    if(sink->len + 2 > (int)sizeof sink->buf)
+        sink_flush(sink);
+    sink->buf[sink->len++] = x >> 8;
+    sink->buf[sink->len++] = x;
+}
+
+static void sink_u32(vcapture_sink_t *sink, uint32_t x)
+{
+    sink_u16(sink, x >> 16);
+    sink_u16(sink, x);
+}
+
+//=== RLE on 16-bit words ===//
+
+/* Encode n words to `sink`, or just count the output size if sink is NULL.
+   Returns the number of bytes produced. */
+static int rle_encode(uint16_t const *w, int n, vcapture_sink_t *sink)
+{
+    int size = 0;
+    int i = 0;
+
+    while(i < n) {
+        /* Length of the run starting at i */
+        int run = 1;
+        while(i + run < n && run < RLE_MAX && w[i + run] == w[i])
+            run++;
+
+        if(run >= 3) {
+            if(sink) {
+                sink_u16(sink, 0x8000 | (run - 1));
+                sink_u16(sink, w[i]);
+            }
+            size += 4;
+            i += run;
+            continue;
+        }
+
+        /* Literals until the next run of 3 or more */
+        int lit = 0;
+        while(i + lit < n && lit < RLE_MAX) {
+            if(i + lit + 2 < n && w[i + lit] == w[i + lit + 1]
+               && w[i + lit] == w[i + lit + 2])
+                break;
+            lit++;
+        }
+
+        if(sink) {
+            sink_u16(sink, lit - 1);
+            for(int j = 0; j < lit; j++)
+                sink_u16(sink, w[i + j]);
+        }
+        size += 2 + 2 * lit;
+        i += lit;
+    }
+
+    return size;
+}
+
+//=== Encoder ===//
+
+bool vcapture_init(vcapture_t *vc, int width, int height, int row_words,
+    int format)
+{
+    memset(vc, 0, sizeof *vc);
+    vc->row_hash = malloc(height * sizeof *vc->row_hash);
+    vc->changed = malloc((height + 7) >> 3);
+    if(!vc->row_hash || !vc->changed) {
+        vcapture_deinit(vc);
+        return false;
+    }
+
+    vc->width = width;
+    vc->height = height;
+    vc->row_words = row_words;
+    vc->format = format;
+    return true;
+}
+
+void vcapture_deinit(vcapture_t *vc)
+{
+    free(vc->row_hash);
+    free(vc->changed);
+    memset(vc, 0, sizeof *vc);
+}
+
+void vcapture_request_keyframe(vcapture_t *vc)
+{
+    /* Keyframes are determined by the frame number */
+    vc->frame = 0;
+}
+
+static uint32_t row_hash(uint16_t const *w, int n)
+{
+    /* FNV-1a over words */
+    uint32_t h = 2166136261u;
+    for(int i = 0; i < n; i++)
+        h = (h ^ w[i]) * 16777619u;
+    return h;
+}
+
+static bool is_changed(vcapture_t const *vc, int y)
+{
+    return (vc->changed[y >> 3] >> (y & 7)) & 1;
+}
+
+int vcapture_prepare(vcapture_t *vc, uint16_t const *frame)
+{
+    bool keyframe = (vc->frame % VCAPTURE_KEYFRAME_INTERVAL) == 0;
+    int rw = vc->row_words;
+
+    memset(vc->changed, 0, (vc->height + 7) >> 3);
+    vc->flags = keyframe ? VCAPTURE_KEYFRAME : 0;
+    vc->spans = 0;
+    vc->size = VCAPTURE_HEADER_SIZE;
+
+    for(int y = 0; y < vc->height; y++) {
+        uint32_t h = row_hash(frame + y * rw, rw);
+        if(keyframe || h != vc->row_hash[y])
+            vc->changed[y >> 3] |= 1 << (y & 7);
+        vc->row_hash[y] = h;
+    }
+
+    /* Group changed rows in spans and encode each span as a block */
+    for(int y = 0; y < vc->height;) {
+        if(!is_changed(vc, y)) {
+            y++;
+            continue;
+        }
+        int y0 = y;
+        while(y < vc->height && is_changed(vc, y))
+            y++;
+
+        vc->spans++;
+        vc->size += 4 + rle_encode(frame + y0 * rw, (y - y0) * rw, NULL);
+    }
+
+    vc->frame++;
+    return vc->size;
+}
+
+void vcapture_emit(vcapture_t *vc, uint16_t const *frame,
+    vcapture_sink_t *sink)
+{
+    int rw = vc->row_words;
+    sink->len = 0;
+
+    sink_u16(sink, ('P' << 8) | 'E');
+    sink_u16(sink, ('v' << 8) | 'c');
+    sink_u16(sink, (VCAPTURE_VERSION << 8) | vc->format);
+    sink_u16(sink, vc->width);
+    sink_u16(sink, vc->height);
+    sink_u16(sink, rw);
+    sink_u32(sink, vc->frame - 1);
+    sink_u32(sink, vc->size);
+    sink_u32(sink, vc->prepare_us);
+    sink_u32(sink, vc->prev_send_us);
+    sink_u16(sink, vc->spans);
+    sink_u16(sink, vc->flags);
+
+    for(int y = 0; y < vc->height;) {
+        if(!is_changed(vc, y)) {
+            y++;
+            continue;
+        }
+        int y0 = y;
+        while(y < vc->height && is_changed(vc, y))
+            y++;
+
+        sink_u16(sink, y0);
+        sink_u16(sink, y - y0);
+        rle_encode(frame + y0 * rw, (y - y0) * rw, sink);
+    }
+
+    sink_flush(sink);
+}
@@ -0,0 +1,116 @@
+//---------------------------------------------------------------------------//
+//    ____        PythonExtra                                                //
+//.-'`_ o `;__,   A community port of MicroPython for CASIO calculators.     //
+//.-'` `---`  '   License: MIT (except some files; see LICENSE)              //
+//---------------------------------------------------------------------------//
+// pe.vcapture: Compressed video capture stream
+//
+// Sending full frames over USB on every dupdate() slows programs to a crawl
+// while recording. This encoder only sends the rows that changed since the
+// previous frame, compressed with a simple RLE on 16-bit words. Frames are
+// sent as fxlink messages of application "pe" and type "vcframe" and rebuilt
+// on the computer by ports/sh/tools/vcdecode.py.
+//
+// Instead of keeping a copy of the previous frame (177 kB on the fx-CG), the
+// encoder remembers a 32-bit hash of each row. A periodic keyframe resends
+// everything so that a hash collision cannot leave a row stale for long.
+//
+// Encoding is done in two passes so that no output buffer is needed: first
+// vcapture_prepare() finds the changed rows and computes the message size
+// (which fxlink needs before the data), then vcapture_emit() produces the
+// data through a sink callback.
+//
+// Stream format (all integers big-endian):
+//   Header (32 bytes):
+//     char[4]  "PEvc"
+//     u8       version (1)
+//     u8       pixel format (VCAPTURE_RGB565 or VCAPTURE_MONO)
+//     u16      width, height (pixels)
+//     u16      row size (in 16-bit words)
+//     u32      frame number
+//     u32      total frame size in bytes, header included
+//     u32      time spent in vcapture_prepare() for this frame (µs)
+//     u32      time spent sending the previous frame (µs)
+//     u16      number of spans
+//     u16      flags (VCAPTURE_KEYFRAME)
+//   Spans of consecutive changed rows:
+//     u16      first row
+//     u16      number of rows
+//     tokens covering (number of rows * row size) words:
+//       u16 c with bit 15 set: next word repeated (c & 0x7fff) + 1 times
+//       u16 c with bit 15 clear: c + 1 literal words follow
+//---
+
+#ifndef __PYTHONEXTRA_VCAPTURE_H
+#define __PYTHONEXTRA_VCAPTURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define VCAPTURE_VERSION 1
+#define VCAPTURE_HEADER_SIZE 32
+
+/* Pixel formats (only used by the decoder to render frames). */
+enum {
+    /* 16-bit RGB565 pixels (fx-CG, fx-CP) */
+    VCAPTURE_RGB565 = 0,
+    /* 1-bit pixels, MSB first, 1 = black (fx-9860G) */
+    VCAPTURE_MONO = 1,
+};
+
+/* Header flags. */
+#define VCAPTURE_KEYFRAME 0x0001
+
+/* Number of frames between keyframes. */
+#define VCAPTURE_KEYFRAME_INTERVAL 64
+
+/* Output callback with a small buffer to batch writes. */
+typedef struct
+{
+    void (*write)(void *env, void const *data, int size);
+    void *env;
+    int len;
+    uint8_t buf[256];
+
+} vcapture_sink_t;
+
+typedef struct
+{
+    /* Frame geometry */
+    uint16_t width, height, row_words;
+    uint8_t format;
+    /* Hash of each row of the previous frame */
+    uint32_t *row_hash;
+    /* Rows changed in the frame being encoded (one bit per row) */
+    uint8_t *changed;
+    /* Number of frames encoded so far */
+    uint32_t frame;
+    /* Data of the frame being encoded, set by vcapture_prepare() */
+    uint32_t size;
+    uint16_t spans;
+    uint16_t flags;
+    /* Timing information, set by the caller before vcapture_emit() */
+    uint32_t prepare_us;
+    uint32_t prev_send_us;
+
+} vcapture_t;
+
+/* Initialize an encoder for frames of `height` rows of `row_words` 16-bit
+   words. Returns false if out of memory. */
+bool vcapture_init(vcapture_t *vc, int width, int height, int row_words,
+    int format);
+
+/* Free the encoder's memory. */
+void vcapture_deinit(vcapture_t *vc);
+
+/* Make the next frame a keyframe (eg. after the stream was interrupted). */
+void vcapture_request_keyframe(vcapture_t *vc);
+
+/* Find the rows that changed in `frame` and return the encoded size. */
+int vcapture_prepare(vcapture_t *vc, uint16_t const *frame);
+
+/* Encode the frame analyzed by the last vcapture_prepare() to `sink`. */
+void vcapture_emit(vcapture_t *vc, uint16_t const *frame,
+    vcapture_sink_t *sink);
+
+#endif /* __PYTHONEXTRA_VCAPTURE_H */
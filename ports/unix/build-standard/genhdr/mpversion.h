@@ -0,0 +1,4 @@
+// This file was generated by py/makeversionhdr.py
+#define MICROPY_GIT_TAG "f1133da-dirty"
+#define MICROPY_GIT_HASH "f1133da"
+#define MICROPY_BUILD_DATE "2026-10-19"
@@ -36,10 +36,20 @@
 // Enable testing of split heap.
 #define MICROPY_GC_SPLIT_HEAP          (1)
 #define MICROPY_GC_SPLIT_HEAP_N_HEAPS  (4)
+#define MICROPY_GC_SPLIT_HEAP_INDEX    (4)
+
+// Enable testing of the GC free lists and lazy sweeping.
+#define MICROPY_GC_FREE_LISTS          (4)
+#define MICROPY_GC_LAZY_SWEEP          (1)
+
+// Enable testing of freeing unused qstrs.
+#define MICROPY_QSTR_GC                (1)
 
 // Enable additional features.
 #define MICROPY_DEBUG_PARSE_RULE_NAME  (1)
 #define MICROPY_TRACKED_ALLOC          (1)
+#define MICROPY_PY_MICROPYTHON_HEAP_PROFILE (64)
+#define MICROPY_PY_MICROPYTHON_INLINE_CACHE_STATS (1)
 #define MICROPY_WARNINGS_CATEGORY      (1)
 #undef MICROPY_VFS_ROM_IOCTL
 #define MICROPY_VFS_ROM_IOCTL          (1)
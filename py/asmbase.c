@@ -105,10 +105,21 @@ void mp_asm_base_align(mp_asm_base_t *as, unsigned int align) {
     as->code_offset = (as->code_offset + align - 1) & (~(align - 1));
 }
 
-// this function assumes a little endian machine
+// SH machine code is big endian, all other targets are little endian
+#if MICROPY_EMIT_SH
+#define ASM_BASE_BIG_ENDIAN (MP_ENDIANNESS_BIG)
+#else
+#define ASM_BASE_BIG_ENDIAN (0)
+#endif
+
 void mp_asm_base_data(mp_asm_base_t *as, unsigned int bytesize, uintptr_t val) {
     uint8_t *c = mp_asm_base_get_cur_to_write_bytes(as, bytesize);
-    if (c != NULL) {
+    if (c != NULL && ASM_BASE_BIG_ENDIAN) {
+        for (unsigned int i = bytesize; i-- > 0;) {
+            c[i] = val;
+            val >>= 8;
+        }
+    } else if (c != NULL) {
         for (unsigned int i = 0; i < bytesize; i++) {
             *c++ = val;
             val >>= 8;
@@ -0,0 +1,395 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2025 The PythonExtra contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <assert.h>
+
+#include "py/mpconfig.h"
+
+// wrapper around everything in this file
+#if MICROPY_EMIT_SH
+
+#include "py/asmsh.h"
+
+#define WORD_SIZE (4)
+#define SIGNED_FIT8(x) ((((x) & 0xffffff80) == 0) || (((x) & 0xffffff80) == 0xffffff80))
+
+void asm_sh_end_pass(asm_sh_t *as) {
+    (void)as;
+}
+
+void asm_sh_op16(asm_sh_t *as, uint16_t op) {
+    uint8_t *c = mp_asm_base_get_cur_to_write_bytes(&as->base, 2);
+    if (c != NULL) {
+        #if ASM_SH_BIG_ENDIAN
+        c[0] = op >> 8;
+        c[1] = op;
+        #else
+        c[0] = op;
+        c[1] = op >> 8;
+        #endif
+    }
+}
+
+void asm_sh_data32(asm_sh_t *as, uint32_t data) {
+    uint8_t *c = mp_asm_base_get_cur_to_write_bytes(&as->base, 4);
+    if (c != NULL) {
+        #if ASM_SH_BIG_ENDIAN
+        c[0] = data >> 24;
+        c[1] = data >> 16;
+        c[2] = data >> 8;
+        c[3] = data;
+        #else
+        c[0] = data;
+        c[1] = data >> 8;
+        c[2] = data >> 16;
+        c[3] = data >> 24;
+        #endif
+    }
+}
+
+// Inline constants are placed after a "mov.l @(4,PC), reg" instruction and
+// two more instructions which jump over the constant. mov.l reads the word 8
+// bytes after the start of the 4-byte block holding the instruction, so when
+// the sequence starts on a 4-byte boundary the constant needs 2 bytes of
+// padding, otherwise it directly follows the third instruction.
+static void asm_sh_literal_pad(asm_sh_t *as) {
+    if (as->base.code_offset & 2) {
+        asm_sh_op_nop(as);
+    }
+}
+
+static size_t get_label_dest(asm_sh_t *as, uint label) {
+    assert(label < as->base.max_num_labels);
+    return as->base.label_offsets[label];
+}
+
+// Labels are only known in advance when they are behind the current
+// position; forward jumps always use the long form so that the code has the
+// same size in every pass. Returns whether a branch at offset pos can reach
+// the label with a displacement of the given width, in halfwords.
+static bool asm_sh_label_is_near(asm_sh_t *as, uint label, size_t pos, uint bits, int *disp) {
+    size_t dest = get_label_dest(as, label);
+    if (dest == (size_t)-1 || dest >= pos) {
+        return false;
+    }
+    *disp = ((int)dest - (int)pos - 4) / 2;
+    return *disp >= -(1 << (bits - 1));
+}
+
+// Size of the "mov.l; braf; nop; [pad]; .long" long jump emitted at pos
+static size_t asm_sh_long_jump_size(size_t pos) {
+    return 6 + ((pos + 6) & 2) + 4;
+}
+
+void asm_sh_entry(asm_sh_t *as, int num_locals) {
+    // save callee-save registers and the return address
+    asm_sh_op_push(as, ASM_SH_REG_R8);
+    asm_sh_op_push(as, ASM_SH_REG_R9);
+    asm_sh_op_push(as, ASM_SH_REG_R10);
+    asm_sh_op_push(as, ASM_SH_REG_SCRATCH);
+    asm_sh_op_push(as, ASM_SH_REG_FUN_TABLE);
+    asm_sh_op_push_pr(as);
+
+    // reserve space for the locals, which are accessed relative to r15
+    as->stack_adjust = num_locals * WORD_SIZE;
+    if (as->stack_adjust <= 128) {
+        if (as->stack_adjust != 0) {
+            asm_sh_op_add_i8(as, ASM_SH_REG_SP, -as->stack_adjust);
+        }
+    } else {
+        asm_sh_mov_reg_i32_optimised(as, ASM_SH_REG_SCRATCH, -as->stack_adjust);
+        asm_sh_op_add(as, ASM_SH_REG_SP, ASM_SH_REG_SCRATCH);
+    }
+}
+
+void asm_sh_exit(asm_sh_t *as) {
+    if (as->stack_adjust <= 127) {
+        if (as->stack_adjust != 0) {
+            asm_sh_op_add_i8(as, ASM_SH_REG_SP, as->stack_adjust);
+        }
+    } else {
+        asm_sh_mov_reg_i32_optimised(as, ASM_SH_REG_SCRATCH, as->stack_adjust);
+        asm_sh_op_add(as, ASM_SH_REG_SP, ASM_SH_REG_SCRATCH);
+    }
+
+    // restore registers and return, popping r8 in the delay slot
+    asm_sh_op_pop_pr(as);
+    asm_sh_op_pop(as, ASM_SH_REG_FUN_TABLE);
+    asm_sh_op_pop(as, ASM_SH_REG_SCRATCH);
+    asm_sh_op_pop(as, ASM_SH_REG_R10);
+    asm_sh_op_pop(as, ASM_SH_REG_R9);
+    asm_sh_op_rts(as);
+    asm_sh_op_pop(as, ASM_SH_REG_R8);
+}
+
+void asm_sh_jump_label(asm_sh_t *as, uint label) {
+    int disp;
+    if (asm_sh_label_is_near(as, label, as->base.code_offset, 12, &disp)) {
+        asm_sh_op_bra(as, disp);
+        asm_sh_op_nop(as);
+        return;
+    }
+
+    // braf jumps relative to its own address + 4
+    size_t pos = as->base.code_offset;
+    asm_sh_op_mov_l_pcrel(as, ASM_SH_REG_SCRATCH, 1);
+    asm_sh_op_braf(as, ASM_SH_REG_SCRATCH);
+    asm_sh_op_nop(as);
+    asm_sh_literal_pad(as);
+    asm_sh_data32(as, get_label_dest(as, label) - (pos + 6));
+}
+
+// jump to label if T == if_true
+void asm_sh_bt_label(asm_sh_t *as, bool if_true, uint label) {
+    int disp;
+    size_t pos = as->base.code_offset;
+    if (asm_sh_label_is_near(as, label, pos, 8, &disp)) {
+        if (if_true) {
+            asm_sh_op_bt(as, disp);
+        } else {
+            asm_sh_op_bf(as, disp);
+        }
+        return;
+    }
+
+    // skip over an unconditional jump with the opposite condition
+    size_t jump_size;
+    if (asm_sh_label_is_near(as, label, pos + 2, 12, &disp)) {
+        jump_size = 4;
+    } else {
+        jump_size = asm_sh_long_jump_size(pos + 2);
+    }
+    if (if_true) {
+        asm_sh_op_bf(as, (jump_size - 2) / 2);
+    } else {
+        asm_sh_op_bt(as, (jump_size - 2) / 2);
+    }
+    asm_sh_jump_label(as, label);
+}
+
+void asm_sh_jump_if_reg_zero(asm_sh_t *as, uint reg, uint label, bool bool_test, bool if_zero) {
+    if (!bool_test) {
+        asm_sh_op_tst(as, reg, reg);
+    } else if (reg == ASM_SH_REG_R0) {
+        asm_sh_op_tst_r0_i8(as, 0xff);
+    } else {
+        asm_sh_op_extu_b(as, ASM_SH_REG_SCRATCH, reg);
+        asm_sh_op_tst(as, ASM_SH_REG_SCRATCH, ASM_SH_REG_SCRATCH);
+    }
+    asm_sh_bt_label(as, if_zero, label);
+}
+
+void asm_sh_jump_if_reg_eq(asm_sh_t *as, uint reg1, uint reg2, uint label) {
+    asm_sh_op_cmp_eq(as, reg1, reg2);
+    asm_sh_bt_label(as, true, label);
+}
+
+// convenience function; reg_dest = reg_src1 <cond> reg_src2
+void asm_sh_setcc_reg_reg_reg(asm_sh_t *as, uint cond, uint reg_dest, uint reg_src1, uint reg_src2) {
+    bool is_signed = cond >= ASM_SH_CC_LT;
+    switch (cond - (is_signed ? ASM_SH_CC_LT : ASM_SH_CC_LTU)) {
+        case ASM_SH_CC_LTU:
+            // a < b is computed as b > a
+            if (is_signed) {
+                asm_sh_op_cmp_gt(as, reg_src2, reg_src1);
+            } else {
+                asm_sh_op_cmp_hi(as, reg_src2, reg_src1);
+            }
+            break;
+        case ASM_SH_CC_GTU:
+            if (is_signed) {
+                asm_sh_op_cmp_gt(as, reg_src1, reg_src2);
+            } else {
+                asm_sh_op_cmp_hi(as, reg_src1, reg_src2);
+            }
+            break;
+        case ASM_SH_CC_LEU:
+            // a <= b is computed as b >= a
+            if (is_signed) {
+                asm_sh_op_cmp_ge(as, reg_src2, reg_src1);
+            } else {
+                asm_sh_op_cmp_hs(as, reg_src2, reg_src1);
+            }
+            break;
+        case ASM_SH_CC_GEU:
+            if (is_signed) {
+                asm_sh_op_cmp_ge(as, reg_src1, reg_src2);
+            } else {
+                asm_sh_op_cmp_hs(as, reg_src1, reg_src2);
+            }
+            break;
+        default:
+            asm_sh_op_cmp_eq(as, reg_src1, reg_src2);
+            break;
+    }
+    asm_sh_op_movt(as, reg_dest);
+    if (cond == ASM_SH_CC_NE || cond == ASM_SH_CC_NE + ASM_SH_CC_LT) {
+        if (reg_dest == ASM_SH_REG_R0) {
+            asm_sh_op_xor_r0_i8(as, 1);
+        } else {
+            asm_sh_op_add_i8(as, reg_dest, -1);
+            asm_sh_op_neg(as, reg_dest, reg_dest);
+        }
+    }
+}
+
+void asm_sh_mov_reg_i32_optimised(asm_sh_t *as, uint reg_dest, uint32_t i32) {
+    if (SIGNED_FIT8(i32)) {
+        asm_sh_op_mov_i8(as, reg_dest, i32);
+        return;
+    }
+
+    // try to build the value from a signed top byte and a signed low byte,
+    // with the top byte at bit 8 or bit 16
+    int32_t lo = (int8_t)(i32 & 0xff);
+    int32_t hi = (int32_t)(i32 - lo) >> 8;
+    if (SIGNED_FIT8(hi)) {
+        asm_sh_op_mov_i8(as, reg_dest, hi);
+        asm_sh_op_shll8(as, reg_dest);
+    } else if ((hi & 0xff) == 0 && SIGNED_FIT8(hi >> 8)) {
+        asm_sh_op_mov_i8(as, reg_dest, hi >> 8);
+        asm_sh_op_shll16(as, reg_dest);
+    } else {
+        // load the full value from an inline constant
+        size_t pos = as->base.code_offset;
+        asm_sh_op_mov_l_pcrel(as, reg_dest, 1);
+        asm_sh_op_bra(as, (pos & 2) ? 2 : 3);
+        asm_sh_op_nop(as);
+        asm_sh_literal_pad(as);
+        asm_sh_data32(as, i32);
+        return;
+    }
+    if (lo != 0) {
+        asm_sh_op_add_i8(as, reg_dest, lo);
+    }
+}
+
+void asm_sh_mov_local_reg(asm_sh_t *as, int local_num, uint reg_src) {
+    if (local_num < 16) {
+        asm_sh_op_mov_l_store_disp(as, reg_src, ASM_SH_REG_SP, local_num);
+    } else {
+        asm_sh_mov_reg_i32_optimised(as, ASM_SH_REG_SCRATCH, local_num * WORD_SIZE);
+        asm_sh_op_add(as, ASM_SH_REG_SCRATCH, ASM_SH_REG_SP);
+        asm_sh_op_mov_l_store(as, reg_src, ASM_SH_REG_SCRATCH);
+    }
+}
+
+void asm_sh_mov_reg_local(asm_sh_t *as, uint reg_dest, int local_num) {
+    if (local_num < 16) {
+        asm_sh_op_mov_l_load_disp(as, reg_dest, ASM_SH_REG_SP, local_num);
+    } else {
+        asm_sh_mov_reg_i32_optimised(as, reg_dest, local_num * WORD_SIZE);
+        asm_sh_op_add(as, reg_dest, ASM_SH_REG_SP);
+        asm_sh_op_mov_l_load(as, reg_dest, reg_dest);
+    }
+}
+
+void asm_sh_mov_reg_local_addr(asm_sh_t *as, uint reg_dest, int local_num) {
+    uint off = local_num * WORD_SIZE;
+    if (off < 128) {
+        asm_sh_op_mov(as, reg_dest, ASM_SH_REG_SP);
+        if (off != 0) {
+            asm_sh_op_add_i8(as, reg_dest, off);
+        }
+    } else {
+        asm_sh_mov_reg_i32_optimised(as, reg_dest, off);
+        asm_sh_op_add(as, reg_dest, ASM_SH_REG_SP);
+    }
+}
+
+void asm_sh_mov_reg_pcrel(asm_sh_t *as, uint reg_dest, uint label) {
+    // Load the offset of the label relative to the return address of a bsr
+    // to the next instruction, which then gives the current PC in pr. This
+    // clobbers pr, which has been saved on entry to the function.
+    size_t pos = as->base.code_offset;
+    asm_sh_op_mov_l_pcrel(as, reg_dest, 1);
+    asm_sh_op_bsr(as, (pos & 2) ? 2 : 3);
+    asm_sh_op_nop(as);
+    asm_sh_literal_pad(as);
+    asm_sh_data32(as, get_label_dest(as, label) - (pos + 6));
+
+    // Add PC to relative offset
+    asm_sh_op_sts_pr(as, ASM_SH_REG_SCRATCH);
+    asm_sh_op_add(as, reg_dest, ASM_SH_REG_SCRATCH);
+}
+
+void asm_sh_load_reg_reg_offset(asm_sh_t *as, uint reg_dest, uint reg_base, uint word_offset) {
+    if (word_offset < 16) {
+        asm_sh_op_mov_l_load_disp(as, reg_dest, reg_base, word_offset);
+    } else {
+        asm_sh_mov_reg_i32_optimised(as, ASM_SH_REG_SCRATCH, word_offset * WORD_SIZE);
+        asm_sh_op_add(as, ASM_SH_REG_SCRATCH, reg_base);
+        asm_sh_op_mov_l_load(as, reg_dest, ASM_SH_REG_SCRATCH);
+    }
+}
+
+void asm_sh_load16_reg_reg_offset(asm_sh_t *as, uint reg_dest, uint reg_base, uint uint16_offset) {
+    if (uint16_offset == 0) {
+        asm_sh_op_mov_w_load(as, reg_dest, reg_base);
+    } else if (reg_dest == ASM_SH_REG_R0 && uint16_offset < 16) {
+        asm_sh_op_mov_w_load_r0_disp(as, reg_base, uint16_offset);
+    } else {
+        asm_sh_mov_reg_i32_optimised(as, ASM_SH_REG_SCRATCH, uint16_offset * 2);
+        asm_sh_op_add(as, ASM_SH_REG_SCRATCH, reg_base);
+        asm_sh_op_mov_w_load(as, reg_dest, ASM_SH_REG_SCRATCH);
+    }
+    asm_sh_op_extu_w(as, reg_dest, reg_dest);
+}
+
+void asm_sh_store_reg_reg_offset(asm_sh_t *as, uint reg_src, uint reg_base, uint word_offset) {
+    if (word_offset < 16) {
+        asm_sh_op_mov_l_store_disp(as, reg_src, reg_base, word_offset);
+    } else {
+        asm_sh_mov_reg_i32_optimised(as, ASM_SH_REG_SCRATCH, word_offset * WORD_SIZE);
+        asm_sh_op_add(as, ASM_SH_REG_SCRATCH, reg_base);
+        asm_sh_op_mov_l_store(as, reg_src, ASM_SH_REG_SCRATCH);
+    }
+}
+
+void asm_sh_lsr_reg_reg(asm_sh_t *as, uint reg_dest, uint reg_shift, bool arithmetic) {
+    // dynamic shifts go right when the shift amount is negative
+    asm_sh_op_neg(as, ASM_SH_REG_SCRATCH, reg_shift);
+    if (arithmetic) {
+        asm_sh_op_shad(as, reg_dest, ASM_SH_REG_SCRATCH);
+    } else {
+        asm_sh_op_shld(as, reg_dest, ASM_SH_REG_SCRATCH);
+    }
+}
+
+void asm_sh_call_ind(asm_sh_t *as, uint idx) {
+    // r0 holds the return value so it is free to hold the function address
+    if (idx < 16) {
+        asm_sh_op_mov_l_load_disp(as, ASM_SH_REG_R0, ASM_SH_REG_FUN_TABLE, idx);
+    } else {
+        asm_sh_mov_reg_i32_optimised(as, ASM_SH_REG_R0, idx * WORD_SIZE);
+        asm_sh_op_mov_l_load_r0(as, ASM_SH_REG_R0, ASM_SH_REG_FUN_TABLE);
+    }
+    asm_sh_op_jsr(as, ASM_SH_REG_R0);
+    asm_sh_op_nop(as);
+}
+
+#endif // MICROPY_EMIT_SH
@@ -0,0 +1,473 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2025 The PythonExtra contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MICROPY_INCLUDED_PY_ASMSH_H
+#define MICROPY_INCLUDED_PY_ASMSH_H
+
+#include "py/misc.h"
+#include "py/asmbase.h"
+
+// SuperH (SH-3/SH-4, no FPU) calling conventions, as used by GCC:
+// - r4-r7: first 4 args
+// - r0: return value
+// - r0-r7: caller save
+// - r8-r14: callee save
+// - r15: stack pointer, full descending, aligned to 4 bytes
+// - pr: return address, saved by the callee if it makes calls
+// - T: single condition bit, set by compare instructions
+//
+// Instructions are 16 bits wide. Immediates are only 8 bits, and memory
+// displacements only 4 bits, so larger values go through r0 or ASM_SH_REG_SCRATCH.
+// PC-relative loads only reach forward, so constants are stored inline next
+// to the instruction which uses them.
+
+#define ASM_SH_REG_R0  (0)
+#define ASM_SH_REG_R1  (1)
+#define ASM_SH_REG_R2  (2)
+#define ASM_SH_REG_R3  (3)
+#define ASM_SH_REG_R4  (4)
+#define ASM_SH_REG_R5  (5)
+#define ASM_SH_REG_R6  (6)
+#define ASM_SH_REG_R7  (7)
+#define ASM_SH_REG_R8  (8)
+#define ASM_SH_REG_R9  (9)
+#define ASM_SH_REG_R10 (10)
+#define ASM_SH_REG_R11 (11)
+#define ASM_SH_REG_R12 (12)
+#define ASM_SH_REG_R13 (13)
+#define ASM_SH_REG_R14 (14)
+#define ASM_SH_REG_R15 (15)
+#define ASM_SH_REG_SP  (ASM_SH_REG_R15)
+
+// Callee-save register used by the assembler for addresses and offsets which
+// don't fit in an instruction
+#define ASM_SH_REG_SCRATCH (ASM_SH_REG_R12)
+
+// Holds a pointer to mp_fun_table
+#define ASM_SH_REG_FUN_TABLE (ASM_SH_REG_R13)
+
+// Number of registers saved on the stack upon entry to function: r8, r9, r10,
+// r12, r13 and pr
+#define ASM_SH_NUM_REGS_SAVED (6)
+
+// Conditions for setcc, numbered like the comparison index of the native
+// emitter: unsigned comparisons first, then signed ones
+#define ASM_SH_CC_LTU (0)
+#define ASM_SH_CC_GTU (1)
+#define ASM_SH_CC_EQ  (2)
+#define ASM_SH_CC_LEU (3)
+#define ASM_SH_CC_GEU (4)
+#define ASM_SH_CC_NE  (5)
+#define ASM_SH_CC_LT  (6)
+#define ASM_SH_CC_GT  (7)
+#define ASM_SH_CC_LE  (9)
+#define ASM_SH_CC_GE  (10)
+
+// Machine code follows the byte order of the machine running the emitter,
+// which is big-endian on the calculators
+#define ASM_SH_BIG_ENDIAN (MP_ENDIANNESS_BIG)
+
+// macros for encoding instructions, n is the destination and m the source
+#define ASM_SH_ENCODE_NM(op, n, m, sub) \
+    (((op) << 12) | ((n) << 8) | ((m) << 4) | (sub))
+#define ASM_SH_ENCODE_NI(op, n, imm8) \
+    (((op) << 12) | ((n) << 8) | ((imm8) & 0xff))
+#define ASM_SH_ENCODE_N(op, n, sub) \
+    (((op) << 12) | ((n) << 8) | (sub))
+#define ASM_SH_ENCODE_NMD(op, n, m, disp4) \
+    (((op) << 12) | ((n) << 8) | ((m) << 4) | ((disp4) & 0xf))
+#define ASM_SH_ENCODE_I(op8, imm8) \
+    (((op8) << 8) | ((imm8) & 0xff))
+#define ASM_SH_ENCODE_D12(op, disp12) \
+    (((op) << 12) | ((disp12) & 0xfff))
+
+typedef struct _asm_sh_t {
+    mp_asm_base_t base;
+    uint32_t stack_adjust;
+} asm_sh_t;
+
+void asm_sh_end_pass(asm_sh_t *as);
+
+void asm_sh_entry(asm_sh_t *as, int num_locals);
+void asm_sh_exit(asm_sh_t *as);
+
+void asm_sh_op16(asm_sh_t *as, uint16_t op);
+void asm_sh_data32(asm_sh_t *as, uint32_t data);
+
+// raw instructions
+
+static inline void asm_sh_op_mov(asm_sh_t *as, uint reg_dest, uint reg_src) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NM(6, reg_dest, reg_src, 3));
+}
+
+static inline void asm_sh_op_mov_i8(asm_sh_t *as, uint reg_dest, int imm8) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NI(14, reg_dest, imm8));
+}
+
+// mov.l @(disp*4, PC), Rn; the constant is at (PC & ~3) + 4 + disp*4
+static inline void asm_sh_op_mov_l_pcrel(asm_sh_t *as, uint reg_dest, uint disp8) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NI(13, reg_dest, disp8));
+}
+
+static inline void asm_sh_op_add(asm_sh_t *as, uint reg_dest, uint reg_src) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NM(3, reg_dest, reg_src, 12));
+}
+
+static inline void asm_sh_op_add_i8(asm_sh_t *as, uint reg_dest, int imm8) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NI(7, reg_dest, imm8));
+}
+
+static inline void asm_sh_op_sub(asm_sh_t *as, uint reg_dest, uint reg_src) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NM(3, reg_dest, reg_src, 8));
+}
+
+static inline void asm_sh_op_neg(asm_sh_t *as, uint reg_dest, uint reg_src) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NM(6, reg_dest, reg_src, 11));
+}
+
+static inline void asm_sh_op_not(asm_sh_t *as, uint reg_dest, uint reg_src) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NM(6, reg_dest, reg_src, 7));
+}
+
+static inline void asm_sh_op_and(asm_sh_t *as, uint reg_dest, uint reg_src) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NM(2, reg_dest, reg_src, 9));
+}
+
+static inline void asm_sh_op_or(asm_sh_t *as, uint reg_dest, uint reg_src) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NM(2, reg_dest, reg_src, 11));
+}
+
+static inline void asm_sh_op_xor(asm_sh_t *as, uint reg_dest, uint reg_src) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NM(2, reg_dest, reg_src, 10));
+}
+
+// xor #imm8, r0
+static inline void asm_sh_op_xor_r0_i8(asm_sh_t *as, uint imm8) {
+    asm_sh_op16(as, ASM_SH_ENCODE_I(0xca, imm8));
+}
+
+// mul.l Rm, Rn; the result is in macl
+static inline void asm_sh_op_mul_l(asm_sh_t *as, uint reg_dest, uint reg_src) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NM(0, reg_dest, reg_src, 7));
+}
+
+static inline void asm_sh_op_sts_macl(asm_sh_t *as, uint reg_dest) {
+    asm_sh_op16(as, ASM_SH_ENCODE_N(0, reg_dest, 0x1a));
+}
+
+static inline void asm_sh_op_sts_pr(asm_sh_t *as, uint reg_dest) {
+    asm_sh_op16(as, ASM_SH_ENCODE_N(0, reg_dest, 0x2a));
+}
+
+// shld Rm, Rn: shift Rn left by Rm, or logically right by -Rm if negative
+static inline void asm_sh_op_shld(asm_sh_t *as, uint reg_dest, uint reg_shift) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NM(4, reg_dest, reg_shift, 13));
+}
+
+// shad Rm, Rn: shift Rn left by Rm, or arithmetically right by -Rm if negative
+static inline void asm_sh_op_shad(asm_sh_t *as, uint reg_dest, uint reg_shift) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NM(4, reg_dest, reg_shift, 12));
+}
+
+static inline void asm_sh_op_shll2(asm_sh_t *as, uint reg_dest) {
+    asm_sh_op16(as, ASM_SH_ENCODE_N(4, reg_dest, 0x08));
+}
+
+static inline void asm_sh_op_shll8(asm_sh_t *as, uint reg_dest) {
+    asm_sh_op16(as, ASM_SH_ENCODE_N(4, reg_dest, 0x18));
+}
+
+static inline void asm_sh_op_shll16(asm_sh_t *as, uint reg_dest) {
+    asm_sh_op16(as, ASM_SH_ENCODE_N(4, reg_dest, 0x28));
+}
+
+static inline void asm_sh_op_extu_b(asm_sh_t *as, uint reg_dest, uint reg_src) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NM(6, reg_dest, reg_src, 12));
+}
+
+static inline void asm_sh_op_extu_w(asm_sh_t *as, uint reg_dest, uint reg_src) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NM(6, reg_dest, reg_src, 13));
+}
+
+// compare instructions set T to the result of Rn <cond> Rm
+static inline void asm_sh_op_cmp_eq(asm_sh_t *as, uint reg_n, uint reg_m) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NM(3, reg_n, reg_m, 0));
+}
+
+static inline void asm_sh_op_cmp_hs(asm_sh_t *as, uint reg_n, uint reg_m) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NM(3, reg_n, reg_m, 2));
+}
+
+static inline void asm_sh_op_cmp_ge(asm_sh_t *as, uint reg_n, uint reg_m) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NM(3, reg_n, reg_m, 3));
+}
+
+static inline void asm_sh_op_cmp_hi(asm_sh_t *as, uint reg_n, uint reg_m) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NM(3, reg_n, reg_m, 6));
+}
+
+static inline void asm_sh_op_cmp_gt(asm_sh_t *as, uint reg_n, uint reg_m) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NM(3, reg_n, reg_m, 7));
+}
+
+// tst Rm, Rn: T = ((Rn & Rm) == 0)
+static inline void asm_sh_op_tst(asm_sh_t *as, uint reg_n, uint reg_m) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NM(2, reg_n, reg_m, 8));
+}
+
+// tst #imm8, r0
+static inline void asm_sh_op_tst_r0_i8(asm_sh_t *as, uint imm8) {
+    asm_sh_op16(as, ASM_SH_ENCODE_I(0xc8, imm8));
+}
+
+static inline void asm_sh_op_movt(asm_sh_t *as, uint reg_dest) {
+    asm_sh_op16(as, ASM_SH_ENCODE_N(0, reg_dest, 0x29));
+}
+
+// branches; the displacement is in halfwords from the instruction address + 4
+static inline void asm_sh_op_bt(asm_sh_t *as, int disp8) {
+    asm_sh_op16(as, ASM_SH_ENCODE_I(0x89, disp8));
+}
+
+static inline void asm_sh_op_bf(asm_sh_t *as, int disp8) {
+    asm_sh_op16(as, ASM_SH_ENCODE_I(0x8b, disp8));
+}
+
+// the following branches have a delay slot
+static inline void asm_sh_op_bra(asm_sh_t *as, int disp12) {
+    asm_sh_op16(as, ASM_SH_ENCODE_D12(10, disp12));
+}
+
+static inline void asm_sh_op_bsr(asm_sh_t *as, int disp12) {
+    asm_sh_op16(as, ASM_SH_ENCODE_D12(11, disp12));
+}
+
+// braf Rm: jump to the instruction address + 4 + Rm
+static inline void asm_sh_op_braf(asm_sh_t *as, uint reg_src) {
+    asm_sh_op16(as, ASM_SH_ENCODE_N(0, reg_src, 0x23));
+}
+
+static inline void asm_sh_op_jmp(asm_sh_t *as, uint reg_src) {
+    asm_sh_op16(as, ASM_SH_ENCODE_N(4, reg_src, 0x2b));
+}
+
+static inline void asm_sh_op_jsr(asm_sh_t *as, uint reg_src) {
+    asm_sh_op16(as, ASM_SH_ENCODE_N(4, reg_src, 0x0b));
+}
+
+static inline void asm_sh_op_rts(asm_sh_t *as) {
+    asm_sh_op16(as, 0x000b);
+}
+
+static inline void asm_sh_op_nop(asm_sh_t *as) {
+    asm_sh_op16(as, 0x0009);
+}
+
+// loads, mov.b and mov.w sign-extend
+static inline void asm_sh_op_mov_b_load(asm_sh_t *as, uint reg_dest, uint reg_base) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NM(6, reg_dest, reg_base, 0));
+}
+
+static inline void asm_sh_op_mov_w_load(asm_sh_t *as, uint reg_dest, uint reg_base) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NM(6, reg_dest, reg_base, 1));
+}
+
+static inline void asm_sh_op_mov_l_load(asm_sh_t *as, uint reg_dest, uint reg_base) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NM(6, reg_dest, reg_base, 2));
+}
+
+// mov.l @(disp*4, Rm), Rn with disp < 16
+static inline void asm_sh_op_mov_l_load_disp(asm_sh_t *as, uint reg_dest, uint reg_base, uint disp4) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NMD(5, reg_dest, reg_base, disp4));
+}
+
+// mov.l @(r0, Rm), Rn
+static inline void asm_sh_op_mov_l_load_r0(asm_sh_t *as, uint reg_dest, uint reg_base) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NM(0, reg_dest, reg_base, 14));
+}
+
+// mov.w @(r0, Rm), Rn
+static inline void asm_sh_op_mov_w_load_r0(asm_sh_t *as, uint reg_dest, uint reg_base) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NM(0, reg_dest, reg_base, 13));
+}
+
+// mov.b @(r0, Rm), Rn
+static inline void asm_sh_op_mov_b_load_r0(asm_sh_t *as, uint reg_dest, uint reg_base) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NM(0, reg_dest, reg_base, 12));
+}
+
+// mov.b @(disp, Rm), r0 with disp < 16
+static inline void asm_sh_op_mov_b_load_r0_disp(asm_sh_t *as, uint reg_base, uint disp4) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NMD(8, 4, reg_base, disp4));
+}
+
+// mov.w @(disp*2, Rm), r0 with disp < 16
+static inline void asm_sh_op_mov_w_load_r0_disp(asm_sh_t *as, uint reg_base, uint disp4) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NMD(8, 5, reg_base, disp4));
+}
+
+// stores
+static inline void asm_sh_op_mov_b_store(asm_sh_t *as, uint reg_src, uint reg_base) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NM(2, reg_base, reg_src, 0));
+}
+
+static inline void asm_sh_op_mov_w_store(asm_sh_t *as, uint reg_src, uint reg_base) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NM(2, reg_base, reg_src, 1));
+}
+
+static inline void asm_sh_op_mov_l_store(asm_sh_t *as, uint reg_src, uint reg_base) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NM(2, reg_base, reg_src, 2));
+}
+
+// mov.l Rm, @(disp*4, Rn) with disp < 16
+static inline void asm_sh_op_mov_l_store_disp(asm_sh_t *as, uint reg_src, uint reg_base, uint disp4) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NMD(1, reg_base, reg_src, disp4));
+}
+
+// mov.l Rm, @-Rn
+static inline void asm_sh_op_push(asm_sh_t *as, uint reg_src) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NM(2, ASM_SH_REG_SP, reg_src, 6));
+}
+
+// mov.l @Rm+, Rn
+static inline void asm_sh_op_pop(asm_sh_t *as, uint reg_dest) {
+    asm_sh_op16(as, ASM_SH_ENCODE_NM(6, reg_dest, ASM_SH_REG_SP, 6));
+}
+
+// sts.l pr, @-r15
+static inline void asm_sh_op_push_pr(asm_sh_t *as) {
+    asm_sh_op16(as, ASM_SH_ENCODE_N(4, ASM_SH_REG_SP, 0x22));
+}
+
+// lds.l @r15+, pr
+static inline void asm_sh_op_pop_pr(asm_sh_t *as) {
+    asm_sh_op16(as, ASM_SH_ENCODE_N(4, ASM_SH_REG_SP, 0x26));
+}
+
+// convenience functions
+void asm_sh_jump_label(asm_sh_t *as, uint label);
+void asm_sh_bt_label(asm_sh_t *as, bool if_true, uint label);
+void asm_sh_jump_if_reg_zero(asm_sh_t *as, uint reg, uint label, bool bool_test, bool if_zero);
+void asm_sh_jump_if_reg_eq(asm_sh_t *as, uint reg1, uint reg2, uint label);
+void asm_sh_setcc_reg_reg_reg(asm_sh_t *as, uint cond, uint reg_dest, uint reg_src1, uint reg_src2);
+void asm_sh_mov_reg_i32_optimised(asm_sh_t *as, uint reg_dest, uint32_t i32);
+void asm_sh_mov_local_reg(asm_sh_t *as, int local_num, uint reg_src);
+void asm_sh_mov_reg_local(asm_sh_t *as, uint reg_dest, int local_num);
+void asm_sh_mov_reg_local_addr(asm_sh_t *as, uint reg_dest, int local_num);
+void asm_sh_mov_reg_pcrel(asm_sh_t *as, uint reg_dest, uint label);
+void asm_sh_load_reg_reg_offset(asm_sh_t *as, uint reg_dest, uint reg_base, uint word_offset);
+void asm_sh_load16_reg_reg_offset(asm_sh_t *as, uint reg_dest, uint reg_base, uint uint16_offset);
+void asm_sh_store_reg_reg_offset(asm_sh_t *as, uint reg_src, uint reg_base, uint word_offset);
+void asm_sh_lsr_reg_reg(asm_sh_t *as, uint reg_dest, uint reg_shift, bool arithmetic);
+void asm_sh_call_ind(asm_sh_t *as, uint idx);
+
+#if GENERIC_ASM_API
+
+// The following macros provide a (mostly) arch-independent API to
+// generate native code, and are used by the native emitter.
+
+#define ASM_WORD_SIZE (4)
+
+#define REG_RET ASM_SH_REG_R0
+#define REG_ARG_1 ASM_SH_REG_R4
+#define REG_ARG_2 ASM_SH_REG_R5
+#define REG_ARG_3 ASM_SH_REG_R6
+#define REG_ARG_4 ASM_SH_REG_R7
+
+#define REG_TEMP0 ASM_SH_REG_R1
+#define REG_TEMP1 ASM_SH_REG_R2
+#define REG_TEMP2 ASM_SH_REG_R3
+
+#define REG_LOCAL_1 ASM_SH_REG_R8
+#define REG_LOCAL_2 ASM_SH_REG_R9
+#define REG_LOCAL_3 ASM_SH_REG_R10
+#define REG_LOCAL_NUM (3)
+
+#define REG_FUN_TABLE ASM_SH_REG_FUN_TABLE
+
+#define ASM_T               asm_sh_t
+#define ASM_END_PASS        asm_sh_end_pass
+#define ASM_ENTRY           asm_sh_entry
+#define ASM_EXIT            asm_sh_exit
+
+#define ASM_JUMP            asm_sh_jump_label
+#define ASM_JUMP_IF_REG_ZERO(as, reg, label, bool_test) \
+    asm_sh_jump_if_reg_zero(as, reg, label, bool_test, true)
+#define ASM_JUMP_IF_REG_NONZERO(as, reg, label, bool_test) \
+    asm_sh_jump_if_reg_zero(as, reg, label, bool_test, false)
+#define ASM_JUMP_IF_REG_EQ(as, reg1, reg2, label) \
+    asm_sh_jump_if_reg_eq(as, reg1, reg2, label)
+#define ASM_JUMP_REG(as, reg) \
+    do { \
+        asm_sh_op_jmp((as), (reg)); \
+        asm_sh_op_nop((as)); \
+    } while (0)
+#define ASM_CALL_IND(as, idx) asm_sh_call_ind(as, idx)
+
+#define ASM_MOV_LOCAL_REG(as, local_num, reg_src) asm_sh_mov_local_reg((as), (local_num), (reg_src))
+#define ASM_MOV_REG_IMM(as, reg_dest, imm) asm_sh_mov_reg_i32_optimised((as), (reg_dest), (imm))
+#define ASM_MOV_REG_LOCAL(as, reg_dest, local_num) asm_sh_mov_reg_local((as), (reg_dest), (local_num))
+#define ASM_MOV_REG_REG(as, reg_dest, reg_src) asm_sh_op_mov((as), (reg_dest), (reg_src))
+#define ASM_MOV_REG_LOCAL_ADDR(as, reg_dest, local_num) asm_sh_mov_reg_local_addr((as), (reg_dest), (local_num))
+#define ASM_MOV_REG_PCREL(as, reg_dest, label) asm_sh_mov_reg_pcrel((as), (reg_dest), (label))
+
+#define ASM_NOT_REG(as, reg_dest) asm_sh_op_not((as), (reg_dest), (reg_dest))
+#define ASM_NEG_REG(as, reg_dest) asm_sh_op_neg((as), (reg_dest), (reg_dest))
+#define ASM_LSL_REG_REG(as, reg_dest, reg_shift) asm_sh_op_shld((as), (reg_dest), (reg_shift))
+#define ASM_LSR_REG_REG(as, reg_dest, reg_shift) asm_sh_lsr_reg_reg((as), (reg_dest), (reg_shift), false)
+#define ASM_ASR_REG_REG(as, reg_dest, reg_shift) asm_sh_lsr_reg_reg((as), (reg_dest), (reg_shift), true)
+#define ASM_OR_REG_REG(as, reg_dest, reg_src) asm_sh_op_or((as), (reg_dest), (reg_src))
+#define ASM_XOR_REG_REG(as, reg_dest, reg_src) asm_sh_op_xor((as), (reg_dest), (reg_src))
+#define ASM_AND_REG_REG(as, reg_dest, reg_src) asm_sh_op_and((as), (reg_dest), (reg_src))
+#define ASM_ADD_REG_REG(as, reg_dest, reg_src) asm_sh_op_add((as), (reg_dest), (reg_src))
+#define ASM_SUB_REG_REG(as, reg_dest, reg_src) asm_sh_op_sub((as), (reg_dest), (reg_src))
+#define ASM_MUL_REG_REG(as, reg_dest, reg_src) \
+    do { \
+        asm_sh_op_mul_l((as), (reg_dest), (reg_src)); \
+        asm_sh_op_sts_macl((as), (reg_dest)); \
+    } while (0)
+
+#define ASM_LOAD_REG_REG_OFFSET(as, reg_dest, reg_base, word_offset) asm_sh_load_reg_reg_offset((as), (reg_dest), (reg_base), (word_offset))
+#define ASM_LOAD8_REG_REG(as, reg_dest, reg_base) \
+    do { \
+        asm_sh_op_mov_b_load((as), (reg_dest), (reg_base)); \
+        asm_sh_op_extu_b((as), (reg_dest), (reg_dest)); \
+    } while (0)
+#define ASM_LOAD16_REG_REG(as, reg_dest, reg_base) \
+    do { \
+        asm_sh_op_mov_w_load((as), (reg_dest), (reg_base)); \
+        asm_sh_op_extu_w((as), (reg_dest), (reg_dest)); \
+    } while (0)
+#define ASM_LOAD16_REG_REG_OFFSET(as, reg_dest, reg_base, uint16_offset) asm_sh_load16_reg_reg_offset((as), (reg_dest), (reg_base), (uint16_offset))
+#define ASM_LOAD32_REG_REG(as, reg_dest, reg_base) asm_sh_op_mov_l_load((as), (reg_dest), (reg_base))
+
+#define ASM_STORE_REG_REG_OFFSET(as, reg_src, reg_base, word_offset) asm_sh_store_reg_reg_offset((as), (reg_src), (reg_base), (word_offset))
+#define ASM_STORE8_REG_REG(as, reg_src, reg_base) asm_sh_op_mov_b_store((as), (reg_src), (reg_base))
+#define ASM_STORE16_REG_REG(as, reg_src, reg_base) asm_sh_op_mov_w_store((as), (reg_src), (reg_base))
+#define ASM_STORE32_REG_REG(as, reg_src, reg_base) asm_sh_op_mov_l_store((as), (reg_src), (reg_base))
+
+#endif // GENERIC_ASM_API
+
+#endif // MICROPY_INCLUDED_PY_ASMSH_H
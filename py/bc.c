@@ -144,6 +144,21 @@ static void mp_setup_code_state_helper(mp_code_state_t *code_state, size_t n_arg
     mp_obj_t *code_state_state = code_state->sp + 1;
     code_state->exc_sp_idx = 0;
 
+    #if MICROPY_OPT_FAST_CALL_SETUP
+    // Fast path for the common case of a call that passes exactly the declared
+    // positional args to a function with no defaults, star args, keyword-only
+    // args or closed over variables: there is nothing to check or fill in.
+    if (n_args == n_pos_args && n_kw == 0 && n_kwonly_args == 0 && n_cell == 0
+        && (scope_flags & (MP_SCOPE_FLAG_VARARGS | MP_SCOPE_FLAG_VARKEYWORDS | MP_SCOPE_FLAG_DEFKWARGS)) == 0) {
+        memset(code_state_state, 0, (n_state - n_args) * sizeof(*code_state->state));
+        for (size_t i = 0; i < n_args; i++) {
+            code_state_state[n_state - 1 - i] = args[i];
+        }
+        code_state->ip += n_info;
+        return;
+    }
+    #endif
+
     // zero out the local stack to begin with
     memset(code_state_state, 0, n_state * sizeof(*code_state->state));
 
@@ -325,8 +340,10 @@ void mp_setup_code_state(mp_code_state_t *code_state, size_t n_args, size_t n_kw
     #if MICROPY_STACKLESS
     code_state->prev = NULL;
     #endif
-    #if MICROPY_PY_SYS_SETTRACE
+    #if MICROPY_PY_SYS_SETTRACE || MICROPY_PY_MICROPYTHON_HEAP_PROFILE
     code_state->prev_state = NULL;
+    #endif
+    #if MICROPY_PY_SYS_SETTRACE
     code_state->frame = NULL;
     #endif
     mp_setup_code_state_helper(code_state, n_args, n_kw, args);
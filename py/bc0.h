@@ -43,6 +43,10 @@
 #define MP_BC_MASK_FORMAT                   (0xf0)
 #define MP_BC_MASK_EXTRA_BYTE               (0x9e)
 
+// Opcodes that take an extra byte after their argument are those matching
+// MP_BC_MASK_EXTRA_BYTE, and the last two opcodes with a qstr argument.
+#define MP_BC_OPCODE_HAS_EXTRA_BYTE(op) (((op) & MP_BC_MASK_EXTRA_BYTE) == 0 || ((op) & 0xfe) == MP_BC_LOAD_FAST_LOAD_ATTR)
+
 #define MP_BC_FORMAT_BYTE                   (0)
 #define MP_BC_FORMAT_QSTR                   (1)
 #define MP_BC_FORMAT_VAR_UINT               (2)
@@ -53,12 +57,12 @@
 
 // Load, Store, Delete, Import, Make, Build, Unpack, Call, Jump, Exception, For, sTack, Return, Yield, Op
 #define MP_BC_BASE_RESERVED                 (0x00) // ----------------
-#define MP_BC_BASE_QSTR_O                   (0x10) // LLLLLLSSSDDII---
+#define MP_BC_BASE_QSTR_O                   (0x10) // LLLLLLSSSDDII-LL
 #define MP_BC_BASE_VINT_E                   (0x20) // MMLLLLSSDDBBBBBB
-#define MP_BC_BASE_VINT_O                   (0x30) // UUMMCCCC--------
-#define MP_BC_BASE_JUMP_E                   (0x40) // J-JJJJJEEEEF----
+#define MP_BC_BASE_VINT_O                   (0x30) // UUMMCCCCOSOB----
+#define MP_BC_BASE_JUMP_E                   (0x40) // JJJJJJJEEEEF----
 #define MP_BC_BASE_BYTE_O                   (0x50) // LLLLSSDTTTTTEEFF
-#define MP_BC_BASE_BYTE_E                   (0x60) // --BREEEYYI------
+#define MP_BC_BASE_BYTE_E                   (0x60) // OOBREEEYYI------
 #define MP_BC_LOAD_CONST_SMALL_INT_MULTI    (0x70) // LLLLLLLLLLLLLLLL
 //                                          (0x80) // LLLLLLLLLLLLLLLL
 //                                          (0x90) // LLLLLLLLLLLLLLLL
@@ -138,6 +142,11 @@
 #define MP_BC_STORE_COMP                    (MP_BC_BASE_VINT_E + 0x0f) // uint
 #define MP_BC_UNPACK_SEQUENCE               (MP_BC_BASE_VINT_O + 0x00) // uint
 #define MP_BC_UNPACK_EX                     (MP_BC_BASE_VINT_O + 0x01) // uint
+#define MP_BC_FORMAT_VALUE                  (MP_BC_BASE_VINT_O + 0x0a) // uint: conversion, flags and depth
+#define MP_BC_BUILD_STRING                  (MP_BC_BASE_VINT_O + 0x0b) // uint
+
+#define MP_BC_BINARY_OP_TEMP                (MP_BC_BASE_BYTE_E + 0x00) // then a byte
+#define MP_BC_BINARY_OP_TEMP_RESULT         (MP_BC_BASE_BYTE_E + 0x01) // then a byte
 
 #define MP_BC_RETURN_VALUE                  (MP_BC_BASE_BYTE_E + 0x03)
 #define MP_BC_RAISE_LAST                    (MP_BC_BASE_BYTE_E + 0x04)
@@ -159,4 +168,39 @@
 #define MP_BC_IMPORT_FROM                   (MP_BC_BASE_QSTR_O + 0x0c) // qstr
 #define MP_BC_IMPORT_STAR                   (MP_BC_BASE_BYTE_E + 0x09)
 
+// Superinstructions, emitted in place of common sequences of the opcodes above
+#define MP_BC_LOAD_FAST_LOAD_ATTR           (MP_BC_BASE_QSTR_O + 0x0e) // qstr; then a byte
+#define MP_BC_LOAD_FAST_LOAD_METHOD         (MP_BC_BASE_QSTR_O + 0x0f) // qstr; then a byte
+#define MP_BC_LOAD_FAST_BINARY_OP_SMALL_INT (MP_BC_BASE_VINT_O + 0x08) // uint
+#define MP_BC_STORE_FAST_LOAD_FAST          (MP_BC_BASE_VINT_O + 0x09) // uint
+#define MP_BC_BINARY_OP_POP_JUMP_IF         (MP_BC_BASE_JUMP_E + 0x01) // signed relative bytecode offset; then a byte
+
+// The extra byte of LOAD_FAST_LOAD_ATTR and LOAD_FAST_LOAD_METHOD is the local.
+// The argument of LOAD_FAST_BINARY_OP_SMALL_INT packs the local (0-15), the
+// binary op and the small int, zigzag encoded so it is unsigned.
+// The extra byte of BINARY_OP_POP_JUMP_IF is the binary op, with the top bit
+// set to jump if the result is true, otherwise to jump if it is false.
+#define MP_BC_LOAD_FAST_BINARY_OP_SMALL_INT_ARG(local_num, op, val) \
+    ((((mp_uint_t)(val) << 1 ^ (mp_uint_t)((val) < 0 ? -1 : 0)) << 10) | ((mp_uint_t)(op) << 4) | (local_num))
+#define MP_BC_LOAD_FAST_BINARY_OP_SMALL_INT_LOCAL(arg) ((arg) & 0xf)
+#define MP_BC_LOAD_FAST_BINARY_OP_SMALL_INT_OP(arg) (((arg) >> 4) & 0x3f)
+#define MP_BC_LOAD_FAST_BINARY_OP_SMALL_INT_VAL(arg) ((mp_int_t)((arg) >> 11) ^ -(mp_int_t)(((arg) >> 10) & 1))
+#define MP_BC_BINARY_OP_POP_JUMP_IF_TRUE    (0x80)
+
+// The argument of FORMAT_VALUE is the conversion to apply to the value, with
+// MP_BC_FORMAT_VALUE_SPEC set if a format spec is on top of the stack, and
+// the depth of the value below the top (or below the spec) in the upper bits.
+#define MP_BC_FORMAT_VALUE_STR              (0x01)
+#define MP_BC_FORMAT_VALUE_REPR             (0x02)
+#define MP_BC_FORMAT_VALUE_SPEC             (0x04)
+#define MP_BC_FORMAT_VALUE_DEPTH_SHIFT      (3)
+
+// The extra byte of BINARY_OP_TEMP and BINARY_OP_TEMP_RESULT is the binary op,
+// with a flag set for each operand that is the result of a binary op nested in
+// the same expression.  BINARY_OP_TEMP_RESULT is used when the result itself
+// is only an operand of an enclosing binary op.
+#define MP_BC_BINARY_OP_TEMP_OP_MASK        (0x3f)
+#define MP_BC_BINARY_OP_TEMP_LHS            (0x40)
+#define MP_BC_BINARY_OP_TEMP_RHS            (0x80)
+
 #endif // MICROPY_INCLUDED_PY_BC0_H
@@ -164,7 +164,7 @@ static void do_load_from_lexer(mp_module_context_t *context, mp_lexer_t *lex) {
 }
 #endif
 
-#if (MICROPY_HAS_FILE_READER && MICROPY_PERSISTENT_CODE_LOAD) || MICROPY_MODULE_FROZEN_MPY
+#if (MICROPY_HAS_FILE_READER && MICROPY_PERSISTENT_CODE_LOAD) || MICROPY_MODULE_FROZEN_MPY || MICROPY_PERSISTENT_CODE_CACHE
 static void do_execute_proto_fun(const mp_module_context_t *context, mp_proto_fun_t proto_fun, qstr source_name) {
     #if MICROPY_PY___FILE__
     mp_store_attr(MP_OBJ_FROM_PTR(&context->module), MP_QSTR___file__, MP_OBJ_NEW_QSTR(source_name));
@@ -187,10 +187,19 @@ static void do_execute_proto_fun(const mp_module_context_t *context, mp_proto_fu
     // set exception handler to restore context if an exception is raised
     nlr_push_jump_callback(&ctx.callback, mp_globals_locals_set_from_nlr_jump_callback);
 
+    // record the file for relative imports, like mp_parse_compile_execute
+    #if MICROPY_RELATIVE_FILE_IMPORTS
+    mp_obj_list_append(MP_STATE_VM(mp_import_stack), MP_OBJ_NEW_QSTR(source_name));
+    #endif
+
     // make and execute the function
     mp_obj_t module_fun = mp_make_function_from_proto_fun(proto_fun, context, NULL);
     mp_call_function_0(module_fun);
 
+    #if MICROPY_RELATIVE_FILE_IMPORTS
+    mp_obj_list_pop(MP_STATE_VM(mp_import_stack), MP_OBJ_NEW_SMALL_INT(-1));
+    #endif
+
     // deregister exception handler and restore context
     nlr_pop_jump_callback(true);
 }
@@ -252,6 +261,23 @@ static void do_load(mp_module_context_t *module_obj, vstr_t *file) {
     }
     #endif
 
+    // If we have a compiled code cache then try it before compiling the file,
+    // and hand it the compiled module otherwise.
+    #if MICROPY_ENABLE_COMPILER && MICROPY_PERSISTENT_CODE_CACHE
+    {
+        mp_compiled_module_t cm;
+        cm.context = module_obj;
+        if (!mp_raw_code_cache_load(file_qstr, &cm)) {
+            mp_lexer_t *lex = mp_lexer_new_from_file(file_qstr);
+            mp_parse_tree_t parse_tree = mp_parse(lex, MP_PARSE_FILE_INPUT);
+            mp_compile_to_raw_code(&parse_tree, file_qstr, false, &cm);
+            mp_raw_code_cache_store(file_qstr, &cm);
+        }
+        do_execute_proto_fun(cm.context, cm.rc, file_qstr);
+        return;
+    }
+    #endif
+
     // If we can compile scripts then load the file and compile and execute it.
     #if MICROPY_ENABLE_COMPILER
     {
@@ -122,6 +122,8 @@ static const emit_method_table_t *emit_native_table[] = {
 #define NATIVE_EMITTER(f) emit_native_xtensawin_##f
 #elif MICROPY_EMIT_RV32
 #define NATIVE_EMITTER(f) emit_native_rv32_##f
+#elif MICROPY_EMIT_SH
+#define NATIVE_EMITTER(f) emit_native_sh_##f
 #elif MICROPY_EMIT_NATIVE_DEBUG
 #define NATIVE_EMITTER(f) emit_native_debug_##f
 #else
@@ -2002,6 +2004,53 @@ static void compile_async_stmt(compiler_t *comp, mp_parse_node_struct_t *pns) {
 }
 #endif
 
+#if MICROPY_COMP_BINARY_OP_TEMP
+
+static void compile_term_helper(compiler_t *comp, mp_parse_node_struct_t *pns, bool result_temp);
+static void compile_power_helper(compiler_t *comp, mp_parse_node_struct_t *pns, bool result_temp);
+
+// Compiles an operand of a binary op and returns true if it leaves the result
+// of another binary op on the stack, which nothing else refers to.  Such an
+// operand is compiled with its own result marked as a temporary.
+static bool compile_binary_op_operand(compiler_t *comp, mp_parse_node_t pn) {
+    if (MP_PARSE_NODE_IS_STRUCT_KIND(pn, PN_arith_expr) || MP_PARSE_NODE_IS_STRUCT_KIND(pn, PN_term)) {
+        mp_parse_node_struct_t *pns = (mp_parse_node_struct_t *)pn;
+        EMIT_ARG(set_source_line, pns->source_line);
+        compile_term_helper(comp, pns, true);
+        return true;
+    }
+    if (MP_PARSE_NODE_IS_STRUCT_KIND(pn, PN_power)) {
+        mp_parse_node_struct_t *pns = (mp_parse_node_struct_t *)pn;
+        EMIT_ARG(set_source_line, pns->source_line);
+        compile_power_helper(comp, pns, true);
+        return true;
+    }
+    compile_node(comp, pn);
+    return false;
+}
+
+static void compile_emit_binary_op(compiler_t *comp, mp_binary_op_t op, int temp_flags) {
+    if (temp_flags == 0) {
+        EMIT_ARG(binary_op, op);
+    } else {
+        EMIT_ARG(binary_op_temp, op, temp_flags);
+    }
+}
+
+#else
+
+static bool compile_binary_op_operand(compiler_t *comp, mp_parse_node_t pn) {
+    compile_node(comp, pn);
+    return false;
+}
+
+static void compile_emit_binary_op(compiler_t *comp, mp_binary_op_t op, int temp_flags) {
+    (void)temp_flags;
+    EMIT_ARG(binary_op, op);
+}
+
+#endif
+
 static void compile_expr_stmt(compiler_t *comp, mp_parse_node_struct_t *pns) {
     mp_parse_node_t pn_rhs = pns->nodes[1];
     if (MP_PARSE_NODE_IS_NULL(pn_rhs)) {
@@ -2043,11 +2092,11 @@ static void compile_expr_stmt(compiler_t *comp, mp_parse_node_struct_t *pns) {
             }
         } else if (kind == PN_expr_stmt_augassign) {
             c_assign(comp, pns->nodes[0], ASSIGN_AUG_LOAD); // lhs load for aug assign
-            compile_node(comp, pns1->nodes[1]); // rhs
+            bool rhs_temp = compile_binary_op_operand(comp, pns1->nodes[1]); // rhs
             assert(MP_PARSE_NODE_IS_TOKEN(pns1->nodes[0]));
             mp_token_kind_t tok = MP_PARSE_NODE_LEAF_ARG(pns1->nodes[0]);
             mp_binary_op_t op = MP_BINARY_OP_INPLACE_OR + (tok - MP_TOKEN_DEL_PIPE_EQUAL);
-            EMIT_ARG(binary_op, op);
+            compile_emit_binary_op(comp, op, rhs_temp ? MP_EMIT_BINARY_OP_TEMP_RHS : 0);
             c_assign(comp, pns->nodes[0], ASSIGN_AUG_STORE); // lhs store for aug assign
         } else if (kind == PN_expr_stmt_assign_list) {
             int rhs = MP_PARSE_NODE_STRUCT_NUM_NODES(pns1) - 1;
@@ -2272,17 +2321,28 @@ static void compile_binary_op(compiler_t *comp, mp_parse_node_struct_t *pns) {
     }
 }
 
-static void compile_term(compiler_t *comp, mp_parse_node_struct_t *pns) {
+static void compile_term_helper(compiler_t *comp, mp_parse_node_struct_t *pns, bool result_temp) {
     int num_nodes = MP_PARSE_NODE_STRUCT_NUM_NODES(pns);
-    compile_node(comp, pns->nodes[0]);
+    int temp_flags = compile_binary_op_operand(comp, pns->nodes[0]) ? MP_EMIT_BINARY_OP_TEMP_LHS : 0;
     for (int i = 1; i + 1 < num_nodes; i += 2) {
-        compile_node(comp, pns->nodes[i + 1]);
+        if (compile_binary_op_operand(comp, pns->nodes[i + 1])) {
+            temp_flags |= MP_EMIT_BINARY_OP_TEMP_RHS;
+        }
+        if (i + 2 < num_nodes || result_temp) {
+            temp_flags |= MP_EMIT_BINARY_OP_TEMP_RESULT;
+        }
         mp_token_kind_t tok = MP_PARSE_NODE_LEAF_ARG(pns->nodes[i]);
         mp_binary_op_t op = MP_BINARY_OP_LSHIFT + (tok - MP_TOKEN_OP_DBL_LESS);
-        EMIT_ARG(binary_op, op);
+        compile_emit_binary_op(comp, op, temp_flags);
+        // the result of this op is the lhs of the next one
+        temp_flags = MP_EMIT_BINARY_OP_TEMP_LHS;
     }
 }
 
+static void compile_term(compiler_t *comp, mp_parse_node_struct_t *pns) {
+    compile_term_helper(comp, pns, false);
+}
+
 static void compile_factor_2(compiler_t *comp, mp_parse_node_struct_t *pns) {
     compile_node(comp, pns->nodes[1]);
     mp_token_kind_t tok = MP_PARSE_NODE_LEAF_ARG(pns->nodes[0]);
@@ -2296,12 +2356,151 @@ static void compile_factor_2(compiler_t *comp, mp_parse_node_struct_t *pns) {
     EMIT_ARG(unary_op, op);
 }
 
-static void compile_atom_expr_normal(compiler_t *comp, mp_parse_node_struct_t *pns) {
-    // compile the subject of the expression
-    compile_node(comp, pns->nodes[0]);
+#if MICROPY_COMP_STR_FORMAT
+// Goes through the format string of a str.format() call, and returns the
+// number of pieces of the result (literal text and arguments), or -1 if the
+// format string can't be handled here.  Given the number of pieces, pass 1
+// compiles the pieces in order, then pass 2 compiles a FORMAT_VALUE for each
+// argument that has a conversion or format spec, or makes up the whole result.
+// So, like str.format(), all the arguments are evaluated before any of them is
+// formatted.
+static int compile_str_format_pieces(compiler_t *comp, const byte *str, const byte *top, mp_parse_node_t *args, size_t n_args, int n_emit, int pass) {
+    int n_pieces = 0;
+    size_t n_fields = 0;
+    while (str < top) {
+        // literal text, up to the next field; a doubled brace is one brace
+        const byte *start = str;
+        while (str < top && *str != '{' && *str != '}') {
+            ++str;
+        }
+        const byte *end = str;
+        if (str + 1 < top && str[1] == *str) {
+            end = ++str;
+            ++str;
+        }
+        if (end != start) {
+            if (end - start >= (1 << (8 * MICROPY_QSTR_BYTES_IN_LEN))) {
+                return -1;
+            }
+            if (pass == 1) {
+                EMIT_ARG(load_const_str, qstr_from_strn((const char *)start, end - start));
+            }
+            ++n_pieces;
+            continue;
+        }
+        if (str == top) {
+            break;
+        }
 
+        // replacement field, which must have no field name or nested fields
+        if (*str++ == '}') {
+            return -1;
+        }
+        int flags = 0;
+        if (str < top && *str == '!') {
+            ++str;
+            if (str < top && *str == 's') {
+                flags = MP_EMIT_FORMAT_VALUE_STR;
+            } else if (str < top && *str == 'r') {
+                flags = MP_EMIT_FORMAT_VALUE_REPR;
+            } else {
+                return -1;
+            }
+            ++str;
+        }
+        const byte *spec = NULL;
+        if (str < top && *str == ':') {
+            spec = ++str;
+            while (str < top && *str != '{' && *str != '}') {
+                ++str;
+            }
+        }
+        if (str == top || *str != '}' || n_fields == n_args) {
+            return -1;
+        }
+        if (pass == 1) {
+            compile_node(comp, args[n_fields]);
+        } else if (pass == 2) {
+            if (spec != NULL && spec != str) {
+                EMIT_ARG(load_const_str, qstr_from_strn((const char *)spec, str - spec));
+                flags |= MP_EMIT_FORMAT_VALUE_SPEC;
+            }
+            if ((flags & ~MP_EMIT_FORMAT_VALUE_STR) || n_emit == 1) {
+                // the argument is below the pieces after it
+                EMIT_ARG(format_value, flags, n_emit - 1 - n_pieces);
+            }
+        }
+        ++str;
+        ++n_fields;
+        ++n_pieces;
+    }
+    if (n_fields != n_args) {
+        return -1;
+    }
+    return n_pieces;
+}
+
+// Compiles "...".format(...), which is what the lexer turns f-strings into,
+// to code that builds the string directly, if the call only has positional
+// arguments and the format string only automatically numbered fields.
+// Returns false, having compiled nothing, if that's not the case.
+static bool compile_atom_expr_str_format(compiler_t *comp, mp_parse_node_t pn_str, mp_parse_node_struct_t *pns_period, mp_parse_node_struct_t *pns_paren) {
+    #if MICROPY_EMIT_NATIVE
+    if (comp->scope_cur->emit_options == MP_EMIT_OPT_NATIVE_PYTHON || comp->scope_cur->emit_options == MP_EMIT_OPT_VIPER) {
+        // native code calls str.format()
+        return false;
+    }
+    #endif
+
+    if (MP_PARSE_NODE_STRUCT_KIND(pns_period) != PN_trailer_period
+        || MP_PARSE_NODE_LEAF_ARG(pns_period->nodes[0]) != MP_QSTR_format
+        || MP_PARSE_NODE_STRUCT_KIND(pns_paren) != PN_trailer_paren) {
+        return false;
+    }
+
+    const byte *str;
+    size_t len;
+    if (MP_PARSE_NODE_IS_LEAF(pn_str) && MP_PARSE_NODE_LEAF_KIND(pn_str) == MP_PARSE_NODE_STRING) {
+        str = qstr_data(MP_PARSE_NODE_LEAF_ARG(pn_str), &len);
+    } else if (MP_PARSE_NODE_IS_STRUCT_KIND(pn_str, PN_const_object)
+               && mp_obj_is_str(mp_parse_node_extract_const_object((mp_parse_node_struct_t *)pn_str))) {
+        str = (const byte *)mp_obj_str_get_data(mp_parse_node_extract_const_object((mp_parse_node_struct_t *)pn_str), &len);
+    } else {
+        return false;
+    }
+
+    mp_parse_node_t pn_arglist = pns_paren->nodes[0];
+    mp_parse_node_t *args;
+    size_t n_args = mp_parse_node_extract_list(&pn_arglist, PN_arglist, &args);
+    for (size_t i = 0; i < n_args; i++) {
+        if (MP_PARSE_NODE_IS_STRUCT_KIND(args[i], PN_arglist_star)
+            || MP_PARSE_NODE_IS_STRUCT_KIND(args[i], PN_arglist_dbl_star)
+            || MP_PARSE_NODE_IS_STRUCT_KIND(args[i], PN_argument)) {
+            return false;
+        }
+    }
+
+    int n_pieces = compile_str_format_pieces(comp, str, str + len, args, n_args, 0, 0);
+    if (n_pieces < 0) {
+        return false;
+    }
+    if (n_pieces == 0) {
+        EMIT_ARG(load_const_str, MP_QSTR_);
+    } else {
+        compile_str_format_pieces(comp, str, str + len, args, n_args, n_pieces, 1);
+        compile_str_format_pieces(comp, str, str + len, args, n_args, n_pieces, 2);
+        if (n_pieces > 1) {
+            EMIT_ARG(build, n_pieces, MP_EMIT_BUILD_STRING);
+        }
+    }
+    return true;
+}
+#endif
+
+static void compile_atom_expr_normal(compiler_t *comp, mp_parse_node_struct_t *pns) {
     // compile_atom_expr_await may call us with a NULL node
     if (MP_PARSE_NODE_IS_NULL(pns->nodes[1])) {
+        compile_node(comp, pns->nodes[0]);
         return;
     }
 
@@ -2316,6 +2515,17 @@ static void compile_atom_expr_normal(compiler_t *comp, mp_parse_node_struct_t *p
     // the current index into the array of trailers
     size_t i = 0;
 
+    #if MICROPY_COMP_STR_FORMAT
+    // handle "...".format(...), which f-strings are turned into
+    if (num_trail >= 2 && compile_atom_expr_str_format(comp, pns->nodes[0], pns_trail[0], pns_trail[1])) {
+        i = 2;
+    } else
+    #endif
+    {
+        // compile the subject of the expression
+        compile_node(comp, pns->nodes[0]);
+    }
+
     // handle special super() call
     if (comp->scope_cur->kind == SCOPE_FUNCTION
         && MP_PARSE_NODE_IS_ID(pns->nodes[0])
@@ -2392,9 +2602,20 @@ static void compile_atom_expr_normal(compiler_t *comp, mp_parse_node_struct_t *p
     }
 }
 
+static void compile_power_helper(compiler_t *comp, mp_parse_node_struct_t *pns, bool result_temp) {
+    // 2 nodes, arguments of power
+    int temp_flags = compile_binary_op_operand(comp, pns->nodes[0]) ? MP_EMIT_BINARY_OP_TEMP_LHS : 0;
+    if (compile_binary_op_operand(comp, pns->nodes[1])) {
+        temp_flags |= MP_EMIT_BINARY_OP_TEMP_RHS;
+    }
+    if (result_temp) {
+        temp_flags |= MP_EMIT_BINARY_OP_TEMP_RESULT;
+    }
+    compile_emit_binary_op(comp, MP_BINARY_OP_POWER, temp_flags);
+}
+
 static void compile_power(compiler_t *comp, mp_parse_node_struct_t *pns) {
-    compile_generic_all_nodes(comp, pns); // 2 nodes, arguments of power
-    EMIT_ARG(binary_op, MP_BINARY_OP_POWER);
+    compile_power_helper(comp, pns, false);
 }
 
 static void compile_trailer_paren_helper(compiler_t *comp, mp_parse_node_t pn_arglist, bool is_method_call, int n_positional_extra) {
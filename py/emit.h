@@ -85,6 +85,17 @@ typedef enum {
 #define MP_EMIT_BUILD_MAP (2)
 #define MP_EMIT_BUILD_SET (3)
 #define MP_EMIT_BUILD_SLICE (4)
+#define MP_EMIT_BUILD_STRING (5)
+
+// Flags for emit->binary_op_temp()
+#define MP_EMIT_BINARY_OP_TEMP_LHS (0x40)
+#define MP_EMIT_BINARY_OP_TEMP_RHS (0x80)
+#define MP_EMIT_BINARY_OP_TEMP_RESULT (0x100)
+
+// Flags for emit->format_value()
+#define MP_EMIT_FORMAT_VALUE_STR (0x01)
+#define MP_EMIT_FORMAT_VALUE_REPR (0x02)
+#define MP_EMIT_FORMAT_VALUE_SPEC (0x04)
 
 // Kind for emit->yield()
 #define MP_EMIT_YIELD_VALUE (0)
@@ -154,8 +165,14 @@ typedef struct _emit_method_table_t {
     void (*pop_except_jump)(emit_t *emit, mp_uint_t label, bool within_exc_handler);
     void (*unary_op)(emit_t *emit, mp_unary_op_t op);
     void (*binary_op)(emit_t *emit, mp_binary_op_t op);
+    #if MICROPY_COMP_BINARY_OP_TEMP
+    void (*binary_op_temp)(emit_t *emit, mp_binary_op_t op, int flags);
+    #endif
     void (*build)(emit_t *emit, mp_uint_t n_args, int kind);
     void (*store_map)(emit_t *emit);
+    #if MICROPY_COMP_STR_FORMAT
+    void (*format_value)(emit_t *emit, int flags, mp_uint_t depth);
+    #endif
     void (*store_comp)(emit_t *emit, scope_kind_t kind, mp_uint_t set_stack_index);
     void (*unpack_sequence)(emit_t *emit, mp_uint_t n_args);
     void (*unpack_ex)(emit_t *emit, mp_uint_t n_left, mp_uint_t n_right);
@@ -205,6 +222,7 @@ extern const emit_method_table_t emit_native_arm_method_table;
 extern const emit_method_table_t emit_native_xtensa_method_table;
 extern const emit_method_table_t emit_native_xtensawin_method_table;
 extern const emit_method_table_t emit_native_rv32_method_table;
+extern const emit_method_table_t emit_native_sh_method_table;
 extern const emit_method_table_t emit_native_debug_method_table;
 
 extern const mp_emit_method_table_id_ops_t mp_emit_bc_method_table_load_id_ops;
@@ -219,6 +237,7 @@ emit_t *emit_native_arm_new(mp_emit_common_t *emit_common, mp_obj_t *error_slot,
 emit_t *emit_native_xtensa_new(mp_emit_common_t *emit_common, mp_obj_t *error_slot, uint *label_slot, mp_uint_t max_num_labels);
 emit_t *emit_native_xtensawin_new(mp_emit_common_t *emit_common, mp_obj_t *error_slot, uint *label_slot, mp_uint_t max_num_labels);
 emit_t *emit_native_rv32_new(mp_emit_common_t *emit_common, mp_obj_t *error_slot, uint *label_slot, mp_uint_t max_num_labels);
+emit_t *emit_native_sh_new(mp_emit_common_t *emit_common, mp_obj_t *error_slot, uint *label_slot, mp_uint_t max_num_labels);
 emit_t *emit_native_debug_new(mp_emit_common_t *emit_common, mp_obj_t *error_slot, uint *label_slot, mp_uint_t max_num_labels);
 
 void emit_bc_set_max_num_labels(emit_t *emit, mp_uint_t max_num_labels);
@@ -231,6 +250,7 @@ void emit_native_arm_free(emit_t *emit);
 void emit_native_xtensa_free(emit_t *emit);
 void emit_native_xtensawin_free(emit_t *emit);
 void emit_native_rv32_free(emit_t *emit);
+void emit_native_sh_free(emit_t *emit);
 void emit_native_debug_free(emit_t *emit);
 
 void mp_emit_bc_start_pass(emit_t *emit, pass_kind_t pass, scope_t *scope);
@@ -277,8 +297,14 @@ void mp_emit_bc_for_iter_end(emit_t *emit);
 void mp_emit_bc_pop_except_jump(emit_t *emit, mp_uint_t label, bool within_exc_handler);
 void mp_emit_bc_unary_op(emit_t *emit, mp_unary_op_t op);
 void mp_emit_bc_binary_op(emit_t *emit, mp_binary_op_t op);
+#if MICROPY_COMP_BINARY_OP_TEMP
+void mp_emit_bc_binary_op_temp(emit_t *emit, mp_binary_op_t op, int flags);
+#endif
 void mp_emit_bc_build(emit_t *emit, mp_uint_t n_args, int kind);
 void mp_emit_bc_store_map(emit_t *emit);
+#if MICROPY_COMP_STR_FORMAT
+void mp_emit_bc_format_value(emit_t *emit, int flags, mp_uint_t depth);
+#endif
 void mp_emit_bc_store_comp(emit_t *emit, scope_kind_t kind, mp_uint_t list_stack_index);
 void mp_emit_bc_unpack_sequence(emit_t *emit, mp_uint_t n_args);
 void mp_emit_bc_unpack_ex(emit_t *emit, mp_uint_t n_left, mp_uint_t n_right);
@@ -64,6 +64,18 @@ struct _emit_t {
     size_t max_num_labels;
     size_t *label_offsets;
 
+    #if MICROPY_COMP_CONTROL_FLOW_OPT
+    // Set if control flow is optimised in the scope being compiled, see
+    // emit_bc_jump_dest().  For each label this records the label that the
+    // opcode at it jumps to unconditionally (itself if it doesn't), and the
+    // passes in which the label was jumped to.
+    bool flow_opt;
+    size_t *label_jump_to;
+    byte *label_refs;
+    // Labels assigned since the last opcode, chained through label_jump_to.
+    size_t label_pending;
+    #endif
+
     size_t code_info_offset;
     size_t code_info_size;
     size_t bytecode_offset;
@@ -73,8 +85,42 @@ struct _emit_t {
 
     size_t n_info;
     size_t n_cell;
+
+    #if MICROPY_COMP_SUPERINSTRUCTIONS
+    // An opcode held back so it can be fused with the following one, see
+    // emit_bc_peep_flush(), and its arguments.
+    byte peep_kind;
+    byte peep_local_num;
+    mp_int_t peep_arg;
+    #endif
+};
+
+#if MICROPY_COMP_CONTROL_FLOW_OPT
+// Bits of label_refs[]
+#define LABEL_REF_PREV_PASS (1)
+#define LABEL_REF_THIS_PASS (2)
+
+#define LABEL_NONE ((size_t)-1)
+
+// Most unconditional jumps followed to find where a jump ends up.
+#define JUMP_THREAD_MAX_DEPTH (8)
+#endif
+
+#if MICROPY_COMP_SUPERINSTRUCTIONS
+enum {
+    PEEP_NONE,
+    PEEP_LOAD_FAST, // LOAD_FAST peep_local_num
+    PEEP_LOAD_FAST_SMALL_INT, // LOAD_FAST peep_local_num; LOAD_CONST_SMALL_INT peep_arg
+    PEEP_STORE_FAST, // STORE_FAST peep_local_num
+    PEEP_BINARY_OP, // BINARY_OP peep_arg; followed by UNARY_OP not if peep_local_num is set
 };
 
+// Largest magnitude of a small int that is fused into LOAD_FAST_BINARY_OP_SMALL_INT.
+#define PEEP_SMALL_INT_MAX (0x7fff)
+
+static void emit_bc_peep_flush(emit_t *emit);
+#endif
+
 emit_t *emit_bc_new(mp_emit_common_t *emit_common) {
     emit_t *emit = m_new0(emit_t, 1);
     emit->emit_common = emit_common;
@@ -84,9 +130,17 @@ emit_t *emit_bc_new(mp_emit_common_t *emit_common) {
 void emit_bc_set_max_num_labels(emit_t *emit, mp_uint_t max_num_labels) {
     emit->max_num_labels = max_num_labels;
     emit->label_offsets = m_new(size_t, emit->max_num_labels);
+    #if MICROPY_COMP_CONTROL_FLOW_OPT
+    emit->label_jump_to = m_new(size_t, emit->max_num_labels);
+    emit->label_refs = m_new(byte, emit->max_num_labels);
+    #endif
 }
 
 void emit_bc_free(emit_t *emit) {
+    #if MICROPY_COMP_CONTROL_FLOW_OPT
+    m_del(byte, emit->label_refs, emit->max_num_labels);
+    m_del(size_t, emit->label_jump_to, emit->max_num_labels);
+    #endif
     m_del(size_t, emit->label_offsets, emit->max_num_labels);
     m_del_obj(emit_t, emit);
 }
@@ -142,9 +196,54 @@ static void emit_write_code_info_bytes_lines(emit_t *emit, mp_uint_t bytes_to_sk
 }
 #endif
 
+#if MICROPY_COMP_CONTROL_FLOW_OPT
+
+// Jump threading and removal of unreachable code.  During MP_PASS_STACK_SIZE
+// the labels that an unconditional JUMP directly follows are recorded, and in
+// the later passes conditional and unconditional jumps to those labels go to
+// the final destination of the JUMP instead.  Which labels are jumped to is
+// recorded in every pass, and a label that no jump went to in the previous
+// pass doesn't end a region of dead code, so the code following it (usually
+// an implicit return after an if/else that returns) is not emitted.  Both can
+// only make the code shrink from one pass to the next, as required.
+
+// Sets the labels assigned since the last opcode as jumping to the given
+// label, or to themselves if that's LABEL_NONE.
+static void emit_bc_resolve_pending_labels(emit_t *emit, size_t label) {
+    size_t l = emit->label_pending;
+    emit->label_pending = LABEL_NONE;
+    while (l != LABEL_NONE) {
+        size_t next = emit->label_jump_to[l];
+        emit->label_jump_to[l] = label == LABEL_NONE ? l : label;
+        l = next;
+    }
+}
+
+// Returns the label that a jump to the given label should go to.  Chains of
+// jumps that loop back on themselves are only followed so far.
+static mp_uint_t emit_bc_jump_dest(emit_t *emit, mp_uint_t label) {
+    for (size_t i = 0; i < JUMP_THREAD_MAX_DEPTH && emit->label_jump_to[label] != label; ++i) {
+        label = emit->label_jump_to[label];
+    }
+    return label;
+}
+
+#endif
+
 // all functions must go through this one to emit byte code
 static uint8_t *emit_get_cur_to_write_bytecode(void *emit_in, size_t num_bytes_to_write) {
     emit_t *emit = emit_in;
+    #if MICROPY_COMP_SUPERINSTRUCTIONS
+    // Any opcode held back for fusing goes before the one being written
+    if (emit->peep_kind != PEEP_NONE) {
+        emit_bc_peep_flush(emit);
+    }
+    #endif
+    #if MICROPY_COMP_CONTROL_FLOW_OPT
+    if (emit->label_pending != LABEL_NONE) {
+        emit_bc_resolve_pending_labels(emit, LABEL_NONE);
+    }
+    #endif
     if (emit->suppress) {
         return emit->dummy_data;
     }
@@ -197,6 +296,17 @@ static void emit_write_bytecode_byte_int(emit_t *emit, int stack_adj, byte b1, m
     *c = *p;
 }
 
+static void emit_write_bytecode_small_int(emit_t *emit, int stack_adj, mp_int_t arg) {
+    assert(MP_SMALL_INT_FITS(arg));
+    if (-MP_BC_LOAD_CONST_SMALL_INT_MULTI_EXCESS <= arg
+        && arg < MP_BC_LOAD_CONST_SMALL_INT_MULTI_NUM - MP_BC_LOAD_CONST_SMALL_INT_MULTI_EXCESS) {
+        emit_write_bytecode_byte(emit, stack_adj,
+            MP_BC_LOAD_CONST_SMALL_INT_MULTI + MP_BC_LOAD_CONST_SMALL_INT_MULTI_EXCESS + arg);
+    } else {
+        emit_write_bytecode_byte_int(emit, stack_adj, MP_BC_LOAD_CONST_SMALL_INT, arg);
+    }
+}
+
 static void emit_write_bytecode_byte_uint(emit_t *emit, int stack_adj, byte b, mp_uint_t val) {
     emit_write_bytecode_byte(emit, stack_adj, b);
     mp_encode_uint(emit, emit_get_cur_to_write_bytecode, val);
@@ -230,6 +340,11 @@ static void emit_write_bytecode_byte_child(emit_t *emit, int stack_adj, byte b,
 static void emit_write_bytecode_byte_label(emit_t *emit, int stack_adj, byte b1, mp_uint_t label) {
     mp_emit_bc_adjust_stack_size(emit, stack_adj);
 
+    #if MICROPY_COMP_SUPERINSTRUCTIONS
+    // The jump offset depends on the position of this opcode
+    emit_bc_peep_flush(emit);
+    #endif
+
     if (emit->suppress) {
         return;
     }
@@ -237,6 +352,20 @@ static void emit_write_bytecode_byte_label(emit_t *emit, int stack_adj, byte b1,
     // Determine if the jump offset is signed or unsigned, based on the opcode.
     const bool is_signed = b1 <= MP_BC_POP_JUMP_IF_FALSE;
 
+    #if MICROPY_COMP_CONTROL_FLOW_OPT
+    if (emit->flow_opt) {
+        if (emit->pass == MP_PASS_STACK_SIZE) {
+            if (b1 == MP_BC_JUMP) {
+                emit_bc_resolve_pending_labels(emit, label);
+            }
+        } else if (is_signed && b1 != MP_BC_UNWIND_JUMP) {
+            // Only jumps with a signed offset can go back to an earlier label.
+            label = emit_bc_jump_dest(emit, label);
+        }
+        emit->label_refs[label] |= LABEL_REF_THIS_PASS;
+    }
+    #endif
+
     // Default to a 2-byte encoding (the largest) with an unknown jump offset.
     unsigned int jump_encoding_size = 1;
     ssize_t bytecode_offset = 0;
@@ -280,6 +409,56 @@ static void emit_write_bytecode_byte_label(emit_t *emit, int stack_adj, byte b1,
     }
 }
 
+#if MICROPY_COMP_SUPERINSTRUCTIONS
+
+// Peephole optimisation: LOAD_FAST, LOAD_CONST_SMALL_INT after LOAD_FAST,
+// STORE_FAST and comparison BINARY_OPs are not written straight away but held
+// in emit->peep_kind, and if the opcode emitted next can be fused with them a
+// single superinstruction is written for both.  Otherwise, and before anything
+// else that depends on the current bytecode offset, the held opcodes are
+// written out as they were.  The stack size is adjusted when an opcode is
+// emitted, whether it is held or not.
+
+static void emit_bc_peep_hold(emit_t *emit, byte kind, mp_uint_t local_num, mp_int_t arg) {
+    if (emit->suppress) {
+        // Dead code, nothing will be written
+        return;
+    }
+    emit->peep_kind = kind;
+    emit->peep_local_num = local_num;
+    emit->peep_arg = arg;
+}
+
+// Writes out the held opcodes, if any.
+static void emit_bc_peep_flush(emit_t *emit) {
+    byte kind = emit->peep_kind;
+    if (kind == PEEP_NONE) {
+        return;
+    }
+    emit->peep_kind = PEEP_NONE;
+    switch (kind) {
+        case PEEP_LOAD_FAST:
+            emit_write_bytecode_raw_byte(emit, MP_BC_LOAD_FAST_MULTI + emit->peep_local_num);
+            break;
+        case PEEP_LOAD_FAST_SMALL_INT:
+            emit_write_bytecode_raw_byte(emit, MP_BC_LOAD_FAST_MULTI + emit->peep_local_num);
+            emit_write_bytecode_small_int(emit, 0, emit->peep_arg);
+            break;
+        case PEEP_STORE_FAST:
+            emit_write_bytecode_raw_byte(emit, MP_BC_STORE_FAST_MULTI + emit->peep_local_num);
+            break;
+        default:
+            assert(kind == PEEP_BINARY_OP);
+            emit_write_bytecode_raw_byte(emit, MP_BC_BINARY_OP_MULTI + emit->peep_arg);
+            if (emit->peep_local_num) {
+                emit_write_bytecode_raw_byte(emit, MP_BC_UNARY_OP_MULTI + MP_UNARY_OP_NOT);
+            }
+            break;
+    }
+}
+
+#endif
+
 void mp_emit_bc_start_pass(emit_t *emit, pass_kind_t pass, scope_t *scope) {
     emit->pass = pass;
     emit->stack_size = 0;
@@ -290,6 +469,19 @@ void mp_emit_bc_start_pass(emit_t *emit, pass_kind_t pass, scope_t *scope) {
     emit->bytecode_offset = 0;
     emit->code_info_offset = 0;
     emit->overflow = false;
+    #if MICROPY_COMP_SUPERINSTRUCTIONS
+    emit->peep_kind = PEEP_NONE;
+    #endif
+    #if MICROPY_COMP_CONTROL_FLOW_OPT
+    emit->flow_opt = MP_STATE_VM(mp_optimise_value) >= 1 && pass > MP_PASS_SCOPE;
+    emit->label_pending = LABEL_NONE;
+    if (emit->flow_opt) {
+        for (size_t i = 0; i < emit->max_num_labels; ++i) {
+            emit->label_refs[i] = pass > MP_PASS_STACK_SIZE && (emit->label_refs[i] & LABEL_REF_THIS_PASS)
+                ? LABEL_REF_PREV_PASS : 0;
+        }
+    }
+    #endif
 
     // Write local state size, exception stack size, scope flags and number of arguments
     {
@@ -352,6 +544,13 @@ bool mp_emit_bc_end_pass(emit_t *emit) {
         return true;
     }
 
+    #if MICROPY_COMP_SUPERINSTRUCTIONS
+    emit_bc_peep_flush(emit);
+    #endif
+    #if MICROPY_COMP_CONTROL_FLOW_OPT
+    emit_bc_resolve_pending_labels(emit, LABEL_NONE);
+    #endif
+
     // check stack is back to zero size
     assert(emit->stack_size == 0);
 
@@ -431,10 +630,22 @@ void mp_emit_bc_set_source_line(emit_t *emit, mp_uint_t source_line) {
         return;
     }
     if (source_line > emit->last_source_line) {
-        mp_uint_t bytes_to_skip = emit->bytecode_offset - emit->last_source_line_offset;
+        mp_uint_t bytecode_offset = emit->bytecode_offset;
+        #if MICROPY_COMP_SUPERINSTRUCTIONS
+        if (MICROPY_PY_SYS_SETTRACE || emit->peep_kind != PEEP_STORE_FAST) {
+            emit_bc_peep_flush(emit);
+            bytecode_offset = emit->bytecode_offset;
+        } else {
+            // A held STORE_FAST can't raise, so unless lines are traced it is
+            // left to fuse with the first opcode of the new line.  Its one
+            // byte still counts towards the previous line.
+            bytecode_offset += 1;
+        }
+        #endif
+        mp_uint_t bytes_to_skip = bytecode_offset - emit->last_source_line_offset;
         mp_uint_t lines_to_skip = source_line - emit->last_source_line;
         emit_write_code_info_bytes_lines(emit, bytes_to_skip, lines_to_skip);
-        emit->last_source_line_offset = emit->bytecode_offset;
+        emit->last_source_line_offset = bytecode_offset;
         emit->last_source_line = source_line;
     }
     #else
@@ -444,13 +655,32 @@ void mp_emit_bc_set_source_line(emit_t *emit, mp_uint_t source_line) {
 }
 
 void mp_emit_bc_label_assign(emit_t *emit, mp_uint_t l) {
+    if (emit->pass == MP_PASS_SCOPE) {
+        emit->suppress = false;
+        return;
+    }
+
+    #if MICROPY_COMP_CONTROL_FLOW_OPT
+    if (emit->flow_opt) {
+        if (emit->pass == MP_PASS_STACK_SIZE) {
+            emit->label_jump_to[l] = emit->label_pending;
+            emit->label_pending = l;
+        } else if (!(emit->label_refs[l] & LABEL_REF_PREV_PASS)) {
+            // Nothing jumps here, so any dead-code region carries on.
+            emit->label_offsets[l] = emit->bytecode_offset;
+            return;
+        }
+    }
+    #endif
+
     // Assigning a label ends any dead-code region, and all following opcodes
     // should be emitted (until another unconditional flow control).
     emit->suppress = false;
 
-    if (emit->pass == MP_PASS_SCOPE) {
-        return;
-    }
+    #if MICROPY_COMP_SUPERINSTRUCTIONS
+    // Opcodes can't be fused across a jump target
+    emit_bc_peep_flush(emit);
+    #endif
 
     // Label offsets can change from one pass to the next, but they must only
     // decrease (ie code can only shrink).  There will be multiple MP_PASS_EMIT
@@ -485,14 +715,16 @@ void mp_emit_bc_load_const_tok(emit_t *emit, mp_token_kind_t tok) {
 }
 
 void mp_emit_bc_load_const_small_int(emit_t *emit, mp_int_t arg) {
-    assert(MP_SMALL_INT_FITS(arg));
-    if (-MP_BC_LOAD_CONST_SMALL_INT_MULTI_EXCESS <= arg
-        && arg < MP_BC_LOAD_CONST_SMALL_INT_MULTI_NUM - MP_BC_LOAD_CONST_SMALL_INT_MULTI_EXCESS) {
-        emit_write_bytecode_byte(emit, 1,
-            MP_BC_LOAD_CONST_SMALL_INT_MULTI + MP_BC_LOAD_CONST_SMALL_INT_MULTI_EXCESS + arg);
-    } else {
-        emit_write_bytecode_byte_int(emit, 1, MP_BC_LOAD_CONST_SMALL_INT, arg);
+    #if MICROPY_COMP_SUPERINSTRUCTIONS
+    if (emit->peep_kind == PEEP_LOAD_FAST && -PEEP_SMALL_INT_MAX <= arg && arg <= PEEP_SMALL_INT_MAX) {
+        // Hold the constant as well, to see if a binary op follows
+        mp_emit_bc_adjust_stack_size(emit, 1);
+        emit->peep_kind = PEEP_LOAD_FAST_SMALL_INT;
+        emit->peep_arg = arg;
+        return;
     }
+    #endif
+    emit_write_bytecode_small_int(emit, 1, arg);
 }
 
 void mp_emit_bc_load_const_str(emit_t *emit, qstr qst) {
@@ -511,6 +743,20 @@ void mp_emit_bc_load_local(emit_t *emit, qstr qst, mp_uint_t local_num, int kind
     MP_STATIC_ASSERT(MP_BC_LOAD_FAST_N + MP_EMIT_IDOP_LOCAL_FAST == MP_BC_LOAD_FAST_N);
     MP_STATIC_ASSERT(MP_BC_LOAD_FAST_N + MP_EMIT_IDOP_LOCAL_DEREF == MP_BC_LOAD_DEREF);
     (void)qst;
+    #if MICROPY_COMP_SUPERINSTRUCTIONS
+    if (kind == MP_EMIT_IDOP_LOCAL_FAST && local_num <= 15) {
+        if (emit->peep_kind == PEEP_STORE_FAST && emit->peep_local_num == local_num) {
+            // Storing a local and loading it straight back leaves it on the stack
+            emit->peep_kind = PEEP_NONE;
+            emit_write_bytecode_byte_uint(emit, 1, MP_BC_STORE_FAST_LOAD_FAST, local_num);
+        } else {
+            mp_emit_bc_adjust_stack_size(emit, 1);
+            emit_bc_peep_flush(emit);
+            emit_bc_peep_hold(emit, PEEP_LOAD_FAST, local_num, 0);
+        }
+        return;
+    }
+    #endif
     if (kind == MP_EMIT_IDOP_LOCAL_FAST && local_num <= 15) {
         emit_write_bytecode_byte(emit, 1, MP_BC_LOAD_FAST_MULTI + local_num);
     } else {
@@ -526,6 +772,14 @@ void mp_emit_bc_load_global(emit_t *emit, qstr qst, int kind) {
 }
 
 void mp_emit_bc_load_method(emit_t *emit, qstr qst, bool is_super) {
+    #if MICROPY_COMP_SUPERINSTRUCTIONS
+    if (emit->peep_kind == PEEP_LOAD_FAST && !is_super) {
+        emit->peep_kind = PEEP_NONE;
+        emit_write_bytecode_byte_qstr(emit, 1, MP_BC_LOAD_FAST_LOAD_METHOD, qst);
+        emit_write_bytecode_raw_byte(emit, emit->peep_local_num);
+        return;
+    }
+    #endif
     int stack_adj = 1 - 2 * is_super;
     emit_write_bytecode_byte_qstr(emit, stack_adj, is_super ? MP_BC_LOAD_SUPER_METHOD : MP_BC_LOAD_METHOD, qst);
 }
@@ -548,6 +802,14 @@ void mp_emit_bc_subscr(emit_t *emit, int kind) {
 
 void mp_emit_bc_attr(emit_t *emit, qstr qst, int kind) {
     if (kind == MP_EMIT_ATTR_LOAD) {
+        #if MICROPY_COMP_SUPERINSTRUCTIONS
+        if (emit->peep_kind == PEEP_LOAD_FAST) {
+            emit->peep_kind = PEEP_NONE;
+            emit_write_bytecode_byte_qstr(emit, 0, MP_BC_LOAD_FAST_LOAD_ATTR, qst);
+            emit_write_bytecode_raw_byte(emit, emit->peep_local_num);
+            return;
+        }
+        #endif
         emit_write_bytecode_byte_qstr(emit, 0, MP_BC_LOAD_ATTR, qst);
     } else {
         if (kind == MP_EMIT_ATTR_DELETE) {
@@ -562,6 +824,14 @@ void mp_emit_bc_store_local(emit_t *emit, qstr qst, mp_uint_t local_num, int kin
     MP_STATIC_ASSERT(MP_BC_STORE_FAST_N + MP_EMIT_IDOP_LOCAL_FAST == MP_BC_STORE_FAST_N);
     MP_STATIC_ASSERT(MP_BC_STORE_FAST_N + MP_EMIT_IDOP_LOCAL_DEREF == MP_BC_STORE_DEREF);
     (void)qst;
+    #if MICROPY_COMP_SUPERINSTRUCTIONS
+    if (kind == MP_EMIT_IDOP_LOCAL_FAST && local_num <= 15) {
+        mp_emit_bc_adjust_stack_size(emit, -1);
+        emit_bc_peep_flush(emit);
+        emit_bc_peep_hold(emit, PEEP_STORE_FAST, local_num, 0);
+        return;
+    }
+    #endif
     if (kind == MP_EMIT_IDOP_LOCAL_FAST && local_num <= 15) {
         emit_write_bytecode_byte(emit, -1, MP_BC_STORE_FAST_MULTI + local_num);
     } else {
@@ -614,6 +884,16 @@ void mp_emit_bc_jump(emit_t *emit, mp_uint_t label) {
 }
 
 void mp_emit_bc_pop_jump_if(emit_t *emit, bool cond, mp_uint_t label) {
+    #if MICROPY_COMP_SUPERINSTRUCTIONS
+    if (emit->peep_kind == PEEP_BINARY_OP) {
+        // Jump on the result of the comparison, without pushing it
+        emit->peep_kind = PEEP_NONE;
+        emit_write_bytecode_byte_label(emit, -1, MP_BC_BINARY_OP_POP_JUMP_IF, label);
+        emit_write_bytecode_raw_byte(emit,
+            emit->peep_arg | ((cond ^ emit->peep_local_num) ? MP_BC_BINARY_OP_POP_JUMP_IF_TRUE : 0));
+        return;
+    }
+    #endif
     if (cond) {
         emit_write_bytecode_byte_label(emit, -1, MP_BC_POP_JUMP_IF_TRUE, label);
     } else {
@@ -723,12 +1003,49 @@ void mp_emit_bc_binary_op(emit_t *emit, mp_binary_op_t op) {
         invert = true;
         op = MP_BINARY_OP_IS;
     }
+    #if MICROPY_COMP_SUPERINSTRUCTIONS
+    if (emit->peep_kind == PEEP_LOAD_FAST_SMALL_INT && !invert) {
+        emit->peep_kind = PEEP_NONE;
+        emit_write_bytecode_byte_uint(emit, -1, MP_BC_LOAD_FAST_BINARY_OP_SMALL_INT,
+            MP_BC_LOAD_FAST_BINARY_OP_SMALL_INT_ARG(emit->peep_local_num, op, emit->peep_arg));
+        return;
+    }
+    if (op <= MP_BINARY_OP_IS) {
+        // Hold a comparison, to see if a conditional jump follows
+        mp_emit_bc_adjust_stack_size(emit, -1);
+        emit_bc_peep_flush(emit);
+        emit_bc_peep_hold(emit, PEEP_BINARY_OP, invert, op);
+        return;
+    }
+    #endif
     emit_write_bytecode_byte(emit, -1, MP_BC_BINARY_OP_MULTI + op);
     if (invert) {
         emit_write_bytecode_byte(emit, 0, MP_BC_UNARY_OP_MULTI + MP_UNARY_OP_NOT);
     }
 }
 
+#if MICROPY_COMP_BINARY_OP_TEMP
+void mp_emit_bc_binary_op_temp(emit_t *emit, mp_binary_op_t op, int flags) {
+    MP_STATIC_ASSERT(MP_BINARY_OP_NUM_BYTECODE <= MP_BC_BINARY_OP_TEMP_OP_MASK + 1);
+    MP_STATIC_ASSERT(MP_EMIT_BINARY_OP_TEMP_LHS == MP_BC_BINARY_OP_TEMP_LHS);
+    MP_STATIC_ASSERT(MP_EMIT_BINARY_OP_TEMP_RHS == MP_BC_BINARY_OP_TEMP_RHS);
+    #if MICROPY_COMP_SUPERINSTRUCTIONS
+    if (flags == MP_EMIT_BINARY_OP_TEMP_RESULT && emit->peep_kind == PEEP_LOAD_FAST_SMALL_INT) {
+        // Neither operand is a temporary, so LOAD_FAST_BINARY_OP_SMALL_INT can
+        // be used, at the cost of not reusing the result
+        mp_emit_bc_binary_op(emit, op);
+        return;
+    }
+    #endif
+    byte opcode = MP_BC_BINARY_OP_TEMP;
+    if (flags & MP_EMIT_BINARY_OP_TEMP_RESULT) {
+        opcode = MP_BC_BINARY_OP_TEMP_RESULT;
+    }
+    emit_write_bytecode_byte(emit, -1, opcode);
+    emit_write_bytecode_raw_byte(emit, op | (flags & (MP_EMIT_BINARY_OP_TEMP_LHS | MP_EMIT_BINARY_OP_TEMP_RHS)));
+}
+#endif
+
 void mp_emit_bc_build(emit_t *emit, mp_uint_t n_args, int kind) {
     MP_STATIC_ASSERT(MP_BC_BUILD_TUPLE + MP_EMIT_BUILD_TUPLE == MP_BC_BUILD_TUPLE);
     MP_STATIC_ASSERT(MP_BC_BUILD_TUPLE + MP_EMIT_BUILD_LIST == MP_BC_BUILD_LIST);
@@ -736,6 +1053,12 @@ void mp_emit_bc_build(emit_t *emit, mp_uint_t n_args, int kind) {
     MP_STATIC_ASSERT(MP_BC_BUILD_TUPLE + MP_EMIT_BUILD_SET == MP_BC_BUILD_SET);
     MP_STATIC_ASSERT(MP_BC_BUILD_TUPLE + MP_EMIT_BUILD_SLICE == MP_BC_BUILD_SLICE);
     int stack_adj = kind == MP_EMIT_BUILD_MAP ? 1 : 1 - n_args;
+    #if MICROPY_COMP_STR_FORMAT
+    if (kind == MP_EMIT_BUILD_STRING) {
+        emit_write_bytecode_byte_uint(emit, stack_adj, MP_BC_BUILD_STRING, n_args);
+        return;
+    }
+    #endif
     emit_write_bytecode_byte_uint(emit, stack_adj, MP_BC_BUILD_TUPLE + kind, n_args);
 }
 
@@ -743,6 +1066,16 @@ void mp_emit_bc_store_map(emit_t *emit) {
     emit_write_bytecode_byte(emit, -2, MP_BC_STORE_MAP);
 }
 
+#if MICROPY_COMP_STR_FORMAT
+void mp_emit_bc_format_value(emit_t *emit, int flags, mp_uint_t depth) {
+    MP_STATIC_ASSERT(MP_EMIT_FORMAT_VALUE_STR == MP_BC_FORMAT_VALUE_STR);
+    MP_STATIC_ASSERT(MP_EMIT_FORMAT_VALUE_REPR == MP_BC_FORMAT_VALUE_REPR);
+    MP_STATIC_ASSERT(MP_EMIT_FORMAT_VALUE_SPEC == MP_BC_FORMAT_VALUE_SPEC);
+    int stack_adj = (flags & MP_EMIT_FORMAT_VALUE_SPEC) ? -1 : 0;
+    emit_write_bytecode_byte_uint(emit, stack_adj, MP_BC_FORMAT_VALUE, flags | depth << MP_BC_FORMAT_VALUE_DEPTH_SHIFT);
+}
+#endif
+
 void mp_emit_bc_store_comp(emit_t *emit, scope_kind_t kind, mp_uint_t collection_stack_index) {
     int t;
     int n;
@@ -893,8 +1226,14 @@ const emit_method_table_t emit_bc_method_table = {
     mp_emit_bc_pop_except_jump,
     mp_emit_bc_unary_op,
     mp_emit_bc_binary_op,
+    #if MICROPY_COMP_BINARY_OP_TEMP
+    mp_emit_bc_binary_op_temp,
+    #endif
     mp_emit_bc_build,
     mp_emit_bc_store_map,
+    #if MICROPY_COMP_STR_FORMAT
+    mp_emit_bc_format_value,
+    #endif
     mp_emit_bc_store_comp,
     mp_emit_bc_unpack_sequence,
     mp_emit_bc_unpack_ex,
@@ -126,6 +126,11 @@ void mp_emit_glue_assign_native(mp_raw_code_t *rc, mp_raw_code_kind_t kind, cons
         "mcr p15, 0, r0, c7, c7, 0\n" // invalidate I-cache and D-cache
         : : : "r0", "cc");
     #endif
+    #elif MICROPY_EMIT_SH && defined(__SH4A__)
+    // Write back the D-cache and invalidate the I-cache, one 32-byte line at a time.
+    for (uintptr_t p = (uintptr_t)fun_data & ~31; p < (uintptr_t)fun_data + fun_len; p += 32) {
+        __asm__ volatile ("ocbwb @%0\n icbi @%0" : : "r" (p) : "memory");
+    }
     #endif
 
     rc->kind = kind;
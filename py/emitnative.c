@@ -59,7 +59,7 @@
 #endif
 
 // wrapper around everything in this file
-#if N_X64 || N_X86 || N_THUMB || N_ARM || N_XTENSA || N_XTENSAWIN || N_RV32 || N_DEBUG
+#if N_X64 || N_X86 || N_THUMB || N_ARM || N_XTENSA || N_XTENSAWIN || N_RV32 || N_SH || N_DEBUG
 
 // C stack layout for native functions:
 //  0:                          nlr_buf_t [optional]
@@ -355,11 +355,18 @@ static void emit_native_mov_reg_state_addr(emit_t *emit, int reg_dest, int local
 static void emit_native_mov_reg_qstr(emit_t *emit, int arg_reg, qstr qst) {
     #if MICROPY_PERSISTENT_CODE_SAVE
     ASM_LOAD16_REG_REG_OFFSET(emit->as, arg_reg, REG_QSTR_TABLE, mp_emit_common_use_qstr(emit->emit_common, qst));
-    #elif defined(ASM_MOV_REG_QSTR)
+    #else
+    #if MICROPY_QSTR_GC
+    // the machine code isn't scanned by the collector, so keep the qstr alive
+    // through the qstr table of the module
+    mp_emit_common_use_qstr(emit->emit_common, qst);
+    #endif
+    #if defined(ASM_MOV_REG_QSTR)
     ASM_MOV_REG_QSTR(emit->as, arg_reg, qst);
     #else
     ASM_MOV_REG_IMM(emit->as, arg_reg, qst);
     #endif
+    #endif
 }
 
 // This function may clobber REG_TEMP0 (and `reg_dest` can be REG_TEMP0).
@@ -367,6 +374,9 @@ static void emit_native_mov_reg_qstr_obj(emit_t *emit, int reg_dest, qstr qst) {
     #if MICROPY_PERSISTENT_CODE_SAVE
     emit_load_reg_with_object(emit, reg_dest, MP_OBJ_NEW_QSTR(qst));
     #else
+    #if MICROPY_QSTR_GC
+    mp_emit_common_use_qstr(emit->emit_common, qst);
+    #endif
     ASM_MOV_REG_IMM(emit->as, reg_dest, (mp_uint_t)MP_OBJ_NEW_QSTR(qst));
     #endif
 }
@@ -596,8 +606,13 @@ static void emit_native_start_pass(emit_t *emit, pass_kind_t pass, scope_t *scop
             // Set code_state.fun_bc
             ASM_MOV_LOCAL_REG(emit->as, LOCAL_IDX_FUN_OBJ(emit), REG_PARENT_ARG_1);
 
-            // Set code_state.n_state (only works on little endian targets due to n_state being uint16_t)
+            // Set code_state.n_state (n_state is uint16_t, so on big endian targets it is
+            // in the upper half of the word)
+            #if N_SH
+            emit_native_mov_state_imm_via(emit, emit->code_state_start + OFFSETOF_CODE_STATE_N_STATE, emit->n_state << 16, REG_ARG_1);
+            #else
             emit_native_mov_state_imm_via(emit, emit->code_state_start + OFFSETOF_CODE_STATE_N_STATE, emit->n_state, REG_ARG_1);
+            #endif
 
             // Put address of code_state into first arg
             ASM_MOV_REG_LOCAL_ADDR(emit->as, REG_ARG_1, emit->code_state_start);
@@ -1555,6 +1570,12 @@ static void emit_native_load_subscr(emit_t *emit) {
                             asm_xtensa_op_l8ui(emit->as, REG_RET, reg_base, index_value);
                             break;
                         }
+                        #elif N_SH
+                        if (index_value > 0 && index_value < 16) {
+                            asm_sh_op_mov_b_load_r0_disp(emit->as, reg_base, index_value);
+                            asm_sh_op_extu_b(emit->as, REG_RET, REG_RET);
+                            break;
+                        }
                         #endif
                         need_reg_single(emit, reg_index, 0);
                         ASM_MOV_REG_IMM(emit->as, reg_index, index_value);
@@ -1583,6 +1604,12 @@ static void emit_native_load_subscr(emit_t *emit) {
                             asm_xtensa_op_l16ui(emit->as, REG_RET, reg_base, index_value);
                             break;
                         }
+                        #elif N_SH
+                        if (index_value > 0 && index_value < 16) {
+                            asm_sh_op_mov_w_load_r0_disp(emit->as, reg_base, index_value);
+                            asm_sh_op_extu_w(emit->as, REG_RET, REG_RET);
+                            break;
+                        }
                         #endif
                         need_reg_single(emit, reg_index, 0);
                         ASM_MOV_REG_IMM(emit->as, reg_index, index_value << 1);
@@ -1611,6 +1638,11 @@ static void emit_native_load_subscr(emit_t *emit) {
                             asm_xtensa_l32i_optimised(emit->as, REG_RET, reg_base, index_value);
                             break;
                         }
+                        #elif N_SH
+                        if (index_value > 0 && index_value < 16) {
+                            asm_sh_op_mov_l_load_disp(emit->as, REG_RET, reg_base, index_value);
+                            break;
+                        }
                         #endif
                         need_reg_single(emit, reg_index, 0);
                         ASM_MOV_REG_IMM(emit->as, reg_index, index_value << 2);
@@ -1639,6 +1671,12 @@ static void emit_native_load_subscr(emit_t *emit) {
                 case VTYPE_PTR8: {
                     // pointer to 8-bit memory
                     // TODO optimise to use thumb ldrb r1, [r2, r3]
+                    #if N_SH
+                    ASM_MOV_REG_REG(emit->as, REG_RET, reg_index);
+                    asm_sh_op_mov_b_load_r0(emit->as, REG_RET, REG_ARG_1);
+                    asm_sh_op_extu_b(emit->as, REG_RET, REG_RET);
+                    break;
+                    #endif
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
                     ASM_LOAD8_REG_REG(emit->as, REG_RET, REG_ARG_1); // store value to (base+index)
                     break;
@@ -1649,6 +1687,12 @@ static void emit_native_load_subscr(emit_t *emit) {
                     asm_xtensa_op_addx2(emit->as, REG_ARG_1, reg_index, REG_ARG_1);
                     asm_xtensa_op_l16ui(emit->as, REG_RET, REG_ARG_1, 0);
                     break;
+                    #elif N_SH
+                    ASM_MOV_REG_REG(emit->as, REG_RET, reg_index);
+                    ASM_ADD_REG_REG(emit->as, REG_RET, REG_RET);
+                    asm_sh_op_mov_w_load_r0(emit->as, REG_RET, REG_ARG_1);
+                    asm_sh_op_extu_w(emit->as, REG_RET, REG_RET);
+                    break;
                     #endif
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
@@ -1666,6 +1710,11 @@ static void emit_native_load_subscr(emit_t *emit) {
                     asm_xtensa_op_addx4(emit->as, REG_ARG_1, reg_index, REG_ARG_1);
                     asm_xtensa_op_l32i_n(emit->as, REG_RET, REG_ARG_1, 0);
                     break;
+                    #elif N_SH
+                    ASM_MOV_REG_REG(emit->as, REG_RET, reg_index);
+                    asm_sh_op_shll2(emit->as, REG_RET);
+                    asm_sh_op_mov_l_load_r0(emit->as, REG_RET, REG_ARG_1);
+                    break;
                     #endif
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
@@ -1890,6 +1939,11 @@ static void emit_native_store_subscr(emit_t *emit) {
                             asm_xtensa_s32i_optimised(emit->as, REG_RET, reg_base, index_value);
                             break;
                         }
+                        #elif N_SH
+                        if (index_value > 0 && index_value < 16) {
+                            asm_sh_op_mov_l_store_disp(emit->as, reg_value, reg_base, index_value);
+                            break;
+                        }
                         #elif N_ARM
                         ASM_MOV_REG_IMM(emit->as, reg_index, index_value);
                         asm_arm_str_reg_reg_reg(emit->as, reg_value, reg_base, reg_index);
@@ -1968,6 +2022,12 @@ static void emit_native_store_subscr(emit_t *emit) {
                     asm_xtensa_op_addx4(emit->as, REG_ARG_1, reg_index, REG_ARG_1);
                     asm_xtensa_op_s32i_n(emit->as, reg_value, REG_ARG_1, 0);
                     break;
+                    #elif N_SH
+                    ASM_MOV_REG_REG(emit->as, REG_TEMP2, reg_index);
+                    asm_sh_op_shll2(emit->as, REG_TEMP2);
+                    ASM_ADD_REG_REG(emit->as, REG_ARG_1, REG_TEMP2);
+                    ASM_STORE32_REG_REG(emit->as, reg_value, REG_ARG_1);
+                    break;
                     #endif
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
@@ -2696,6 +2756,8 @@ static void emit_native_binary_op(emit_t *emit, mp_binary_op_t op) {
                 default:
                     break;
             }
+            #elif N_SH
+            asm_sh_setcc_reg_reg_reg(emit->as, op_idx, REG_RET, REG_ARG_2, reg_rhs);
             #elif N_DEBUG
             asm_debug_setcc_reg_reg_reg(emit->as, op_idx, REG_RET, REG_ARG_2, reg_rhs);
             #else
@@ -2749,6 +2811,7 @@ static void emit_native_build(emit_t *emit, mp_uint_t n_args, int kind) {
         return;
     }
     #endif
+    assert(kind != MP_EMIT_BUILD_STRING);
     emit_native_pre(emit);
     if (kind == MP_EMIT_BUILD_TUPLE || kind == MP_EMIT_BUILD_LIST || kind == MP_EMIT_BUILD_SET) {
         emit_get_stack_pointer_to_reg_for_pop(emit, REG_ARG_2, n_args); // pointer to items
@@ -2757,6 +2820,25 @@ static void emit_native_build(emit_t *emit, mp_uint_t n_args, int kind) {
     emit_post_push_reg(emit, VTYPE_PYOBJ, REG_RET); // new tuple/list/map/set
 }
 
+#if MICROPY_COMP_BINARY_OP_TEMP
+static void emit_native_binary_op_temp(emit_t *emit, mp_binary_op_t op, int flags) {
+    // Native code doesn't reuse float objects
+    (void)flags;
+    emit_native_binary_op(emit, op);
+}
+#endif
+
+#if MICROPY_COMP_STR_FORMAT
+static void emit_native_format_value(emit_t *emit, int flags, mp_uint_t depth) {
+    // The compiler doesn't use this, or MP_EMIT_BUILD_STRING, for native code:
+    // str.format() is called instead, see compile_atom_expr_str_format().
+    (void)emit;
+    (void)flags;
+    (void)depth;
+    assert(0);
+}
+#endif
+
 static void emit_native_store_map(emit_t *emit) {
     vtype_kind_t vtype_key, vtype_value, vtype_map;
     emit_pre_pop_reg_reg_reg(emit, &vtype_key, REG_ARG_2, &vtype_value, REG_ARG_3, &vtype_map, REG_ARG_1); // key, value, map
@@ -3175,8 +3257,14 @@ const emit_method_table_t EXPORT_FUN(method_table) = {
     emit_native_pop_except_jump,
     emit_native_unary_op,
     emit_native_binary_op,
+    #if MICROPY_COMP_BINARY_OP_TEMP
+    emit_native_binary_op_temp,
+    #endif
     emit_native_build,
     emit_native_store_map,
+    #if MICROPY_COMP_STR_FORMAT
+    emit_native_format_value,
+    #endif
     emit_native_store_comp,
     emit_native_unpack_sequence,
     emit_native_unpack_ex,
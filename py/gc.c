@@ -31,6 +31,23 @@
 
 #include "py/gc.h"
 #include "py/runtime.h"
+#include "py/objtype.h"
+
+#if MICROPY_GC_LAZY_SWEEP
+#include "py/mphal.h"
+#endif
+
+#if MICROPY_QSTR_GC
+#include "py/parse.h"
+#endif
+
+#if MICROPY_PY_MICROPYTHON_HEAP_PROFILE
+#include "py/bc.h"
+#include "py/objfun.h"
+#if MICROPY_PY_MICROPYTHON_HEAP_PROFILE < 2 || MICROPY_PY_MICROPYTHON_HEAP_PROFILE > 256
+#error MICROPY_PY_MICROPYTHON_HEAP_PROFILE must be between 2 and 256
+#endif
+#endif
 
 #if MICROPY_DEBUG_VALGRIND
 #include <valgrind/memcheck.h>
@@ -73,6 +90,13 @@
 #define ATB_MASK_2 (0x30)
 #define ATB_MASK_3 (0xc0)
 
+// With the heap profiler, each block also has a byte for its allocation site
+#if MICROPY_PY_MICROPYTHON_HEAP_PROFILE
+#define SITE_BYTES_PER_BLOCK (1)
+#else
+#define SITE_BYTES_PER_BLOCK (0)
+#endif
+
 #define ATB_0_IS_FREE(a) (((a) & ATB_MASK_0) == 0)
 #define ATB_1_IS_FREE(a) (((a) & ATB_MASK_1) == 0)
 #define ATB_2_IS_FREE(a) (((a) & ATB_MASK_2) == 0)
@@ -92,6 +116,32 @@
 #define ATB_HEAD_TO_MARK(area, block) do { area->gc_alloc_table_start[(block) / BLOCKS_PER_ATB] |= (AT_MARK << BLOCK_SHIFT(block)); } while (0)
 #define ATB_MARK_TO_HEAD(area, block) do { area->gc_alloc_table_start[(block) / BLOCKS_PER_ATB] &= (~(AT_TAIL << BLOCK_SHIFT(block))); } while (0)
 
+#if MICROPY_GC_ATB_WORD_SCAN
+// The ATB can also be tested a machine word (BLOCKS_PER_ATB_WORD entries) at a
+// time.  These tests don't depend on the byte order of the word.
+#define BLOCKS_PER_ATB_WORD (BLOCKS_PER_ATB * sizeof(uintptr_t))
+#define ATB_WORD_LOW_BITS ((uintptr_t)-1 / 3)
+#define ATB_WORD_ALL_TAIL (ATB_WORD_LOW_BITS << 1)
+#define ATB_WORD_NONE_FREE(w) ((((w) | ((w) >> 1)) & ATB_WORD_LOW_BITS) == ATB_WORD_LOW_BITS)
+#define ATB_WORD_ALIGNED(area, i) ((((uintptr_t)(area)->gc_alloc_table_start + (i)) & (sizeof(uintptr_t) - 1)) == 0)
+
+static inline uintptr_t atb_get_word(mp_state_mem_area_t *area, size_t i) {
+    uintptr_t w;
+    memcpy(&w, area->gc_alloc_table_start + i, sizeof(w));
+    return w;
+}
+
+// Sweep transitions of a whole ATB byte, indexed by free_tail << 8 | byte.
+// Each entry holds the new ATB byte (bits 0-7), the new free_tail (bit 8), the
+// number of heads freed (bits 9-11) and 1 + the index of the last block left
+// in use, or 0 if there is none (bits 12-14).
+static uint16_t gc_sweep_table[2 << 8];
+#define SWEEP_ATB(e) ((e) & 0xff)
+#define SWEEP_FREE_TAIL(e) (((e) >> 8) & 1)
+#define SWEEP_N_HEADS(e) (((e) >> 9) & 7)
+#define SWEEP_LAST_USED(e) ((e) >> 12)
+#endif
+
 #define BLOCK_FROM_PTR(area, ptr) (((byte *)(ptr) - area->gc_pool_start) / BYTES_PER_BLOCK)
 #define PTR_FROM_BLOCK(area, block) (((block) * BYTES_PER_BLOCK + (uintptr_t)area->gc_pool_start))
 
@@ -127,21 +177,32 @@
 static void gc_collect_start_common(void);
 static void *gc_get_ptr(void **ptrs, int i);
 #if MICROPY_GC_SPLIT_HEAP
+static void gc_area_index_add(mp_state_mem_area_t *area);
+#if MICROPY_GC_SPLIT_HEAP_AUTO
+static void gc_area_index_remove(mp_state_mem_area_t *area);
+#endif
 static void gc_mark_subtree(mp_state_mem_area_t *area, size_t block);
 #else
 static void gc_mark_subtree(size_t block);
 #endif
 static void gc_deal_with_stack_overflow(void);
-static void gc_sweep_run_finalisers(void);
+static bool gc_sweep_run_finalisers(void);
 static void gc_sweep_free_blocks(void);
+#if MICROPY_GC_LAZY_SWEEP
+static void gc_sweep_lazy(size_t n_blocks);
+#endif
+#if MICROPY_GC_FREE_LISTS
+static void gc_free_list_add_run(mp_state_mem_area_t *area, size_t block, size_t n);
+#endif
 
 // TODO waste less memory; currently requires that all entries in alloc_table have a corresponding block in pool
 static void gc_setup_area(mp_state_mem_area_t *area, void *start, void *end) {
-    // calculate parameters for GC (T=total, A=alloc table, F=finaliser table, P=pool; all in bytes):
-    // T = A + F + P
+    // calculate parameters for GC (T=total, A=alloc table, F=finaliser table, S=site table, P=pool; all in bytes):
+    // T = A + F + S + P
     //     F = A * BLOCKS_PER_ATB / BLOCKS_PER_FTB
+    //     S = A * BLOCKS_PER_ATB * SITE_BYTES_PER_BLOCK
     //     P = A * BLOCKS_PER_ATB * BYTES_PER_BLOCK
-    // => T = A * (1 + BLOCKS_PER_ATB / BLOCKS_PER_FTB + BLOCKS_PER_ATB * BYTES_PER_BLOCK)
+    // => T = A * (1 + BLOCKS_PER_ATB / BLOCKS_PER_FTB + BLOCKS_PER_ATB * (SITE_BYTES_PER_BLOCK + BYTES_PER_BLOCK))
     size_t total_byte_len = (byte *)end - (byte *)start;
     #if MICROPY_ENABLE_FINALISER
     area->gc_alloc_table_byte_len = (total_byte_len - ALLOC_TABLE_GAP_BYTE)
@@ -149,10 +210,10 @@ static void gc_setup_area(mp_state_mem_area_t *area, void *start, void *end) {
         / (
             MP_BITS_PER_BYTE
             + MP_BITS_PER_BYTE * BLOCKS_PER_ATB / BLOCKS_PER_FTB
-            + MP_BITS_PER_BYTE * BLOCKS_PER_ATB * BYTES_PER_BLOCK
+            + MP_BITS_PER_BYTE * BLOCKS_PER_ATB * (SITE_BYTES_PER_BLOCK + BYTES_PER_BLOCK)
             );
     #else
-    area->gc_alloc_table_byte_len = (total_byte_len - ALLOC_TABLE_GAP_BYTE) / (1 + MP_BITS_PER_BYTE / 2 * BYTES_PER_BLOCK);
+    area->gc_alloc_table_byte_len = (total_byte_len - ALLOC_TABLE_GAP_BYTE) / (1 + MP_BITS_PER_BYTE / 2 * (SITE_BYTES_PER_BLOCK + BYTES_PER_BLOCK));
     #endif
 
     area->gc_alloc_table_start = (byte *)start;
@@ -166,7 +227,19 @@ static void gc_setup_area(mp_state_mem_area_t *area, void *start, void *end) {
     area->gc_pool_start = (byte *)end - gc_pool_block_len * BYTES_PER_BLOCK;
     area->gc_pool_end = end;
 
+    #if MICROPY_PY_MICROPYTHON_HEAP_PROFILE
+    // the site table sits just below the pool, and needs no clearing as only
+    // the entries of allocated heads are read
+    area->gc_site_table_start = area->gc_pool_start - gc_pool_block_len;
+    #endif
+
+    #if MICROPY_PY_MICROPYTHON_HEAP_PROFILE
     #if MICROPY_ENABLE_FINALISER
+    assert(area->gc_site_table_start >= area->gc_finaliser_table_start + gc_finaliser_table_byte_len);
+    #else
+    assert(area->gc_site_table_start >= area->gc_alloc_table_start + area->gc_alloc_table_byte_len + ALLOC_TABLE_GAP_BYTE);
+    #endif
+    #elif MICROPY_ENABLE_FINALISER
     assert(area->gc_pool_start >= area->gc_finaliser_table_start + gc_finaliser_table_byte_len);
     #endif
 
@@ -181,6 +254,14 @@ static void gc_setup_area(mp_state_mem_area_t *area, void *start, void *end) {
     area->gc_last_free_atb_index = 0;
     area->gc_last_used_block = 0;
 
+    #if MICROPY_GC_LAZY_SWEEP
+    area->gc_sweep_block = SIZE_MAX;
+    #endif
+
+    #if MICROPY_GC_FREE_LISTS
+    memset(area->gc_free_list_len, 0, sizeof(area->gc_free_list_len));
+    #endif
+
     #if MICROPY_GC_SPLIT_HEAP
     area->next = NULL;
     #endif
@@ -201,6 +282,36 @@ static void gc_setup_area(mp_state_mem_area_t *area, void *start, void *end) {
         gc_pool_block_len * BYTES_PER_BLOCK, gc_pool_block_len);
 }
 
+#if MICROPY_GC_ATB_WORD_SCAN
+// Run the block-wise sweep of gc_sweep_free_blocks on every ATB byte.
+static void gc_sweep_table_init(void) {
+    for (size_t e = 0; e < MP_ARRAY_SIZE(gc_sweep_table); e++) {
+        unsigned int atb = e & 0xff, free_tail = e >> 8;
+        unsigned int new_atb = 0, n_heads = 0, last_used = 0;
+        for (unsigned int k = 0; k < BLOCKS_PER_ATB; k++) {
+            switch ((atb >> (2 * k)) & 3) {
+                case AT_HEAD:
+                    free_tail = 1;
+                    n_heads++;
+                    break;
+                case AT_TAIL:
+                    if (!free_tail) {
+                        new_atb |= AT_TAIL << (2 * k);
+                        last_used = k + 1;
+                    }
+                    break;
+                case AT_MARK:
+                    new_atb |= AT_HEAD << (2 * k);
+                    free_tail = 0;
+                    last_used = k + 1;
+                    break;
+            }
+        }
+        gc_sweep_table[e] = new_atb | free_tail << 8 | n_heads << 9 | last_used << 12;
+    }
+}
+#endif
+
 void gc_init(void *start, void *end) {
     // align end pointer on block boundary
     end = (void *)((uintptr_t)end & (~(BYTES_PER_BLOCK - 1)));
@@ -208,9 +319,19 @@ void gc_init(void *start, void *end) {
 
     gc_setup_area(&MP_STATE_MEM(area), start, end);
 
+    #if MICROPY_GC_ATB_WORD_SCAN
+    gc_sweep_table_init();
+    #endif
+
     // set last free ATB index to start of heap
     #if MICROPY_GC_SPLIT_HEAP
     MP_STATE_MEM(gc_last_free_area) = &MP_STATE_MEM(area);
+    MP_STATE_MEM(gc_pools_start) = MP_STATE_MEM(area).gc_pool_start;
+    MP_STATE_MEM(gc_pools_end) = MP_STATE_MEM(area).gc_pool_end;
+    #if MICROPY_GC_SPLIT_HEAP_INDEX
+    MP_STATE_MEM(gc_area_index_len) = 0;
+    #endif
+    gc_area_index_add(&MP_STATE_MEM(area));
     #endif
 
     // unlock the GC
@@ -225,10 +346,71 @@ void gc_init(void *start, void *end) {
     MP_STATE_MEM(gc_alloc_amount) = 0;
     #endif
 
+    #if MICROPY_PY_MICROPYTHON_HEAP_PROFILE
+    memset(MP_STATE_MEM(gc_profile_sites), 0, sizeof(MP_STATE_MEM(gc_profile_sites)));
+    #endif
+
+    #if MICROPY_GC_LAZY_SWEEP
+    // by default, sweep the whole heap within each collection
+    MP_STATE_MEM(gc_sweep_step) = 0;
+    MP_STATE_MEM(gc_sweep_lazy) = false;
+    MP_STATE_MEM(gc_sweep).area = NULL;
+    MP_STATE_MEM(gc_pause_count) = 0;
+    MP_STATE_MEM(gc_pause_last) = 0;
+    MP_STATE_MEM(gc_pause_max) = 0;
+    MP_STATE_MEM(gc_sweep_step_count) = 0;
+    MP_STATE_MEM(gc_sweep_step_max) = 0;
+    #endif
+
     GC_MUTEX_INIT();
 }
 
 #if MICROPY_GC_SPLIT_HEAP
+// Make a new area known to gc_get_ptr_area.
+static void gc_area_index_add(mp_state_mem_area_t *area) {
+    MP_STATE_MEM(gc_pools_start) = MIN(MP_STATE_MEM(gc_pools_start), area->gc_pool_start);
+    MP_STATE_MEM(gc_pools_end) = MAX(MP_STATE_MEM(gc_pools_end), area->gc_pool_end);
+
+    #if MICROPY_GC_SPLIT_HEAP_INDEX
+    size_t n = MP_STATE_MEM(gc_area_index_len);
+    if (n >= MICROPY_GC_SPLIT_HEAP_INDEX) {
+        // too many areas (or already were), gc_get_ptr_area walks the list
+        MP_STATE_MEM(gc_area_index_len) = SIZE_MAX;
+        return;
+    }
+    mp_state_mem_area_t **index = MP_STATE_MEM(gc_area_index);
+    for (; n > 0 && index[n - 1]->gc_pool_start > area->gc_pool_start; n--) {
+        index[n] = index[n - 1];
+    }
+    index[n] = area;
+    MP_STATE_MEM(gc_area_index_len) += 1;
+    #endif
+}
+
+#if MICROPY_GC_SPLIT_HEAP_AUTO
+// Forget an area that is about to be freed.  The pool bounds are left as they
+// are, they only need to include all the pools.
+static void gc_area_index_remove(mp_state_mem_area_t *area) {
+    #if MICROPY_GC_SPLIT_HEAP_INDEX
+    size_t n = MP_STATE_MEM(gc_area_index_len);
+    if (n == SIZE_MAX) {
+        return;
+    }
+    mp_state_mem_area_t **index = MP_STATE_MEM(gc_area_index);
+    size_t i = 0;
+    while (index[i] != area) {
+        i++;
+    }
+    for (; i + 1 < n; i++) {
+        index[i] = index[i + 1];
+    }
+    MP_STATE_MEM(gc_area_index_len) = n - 1;
+    #else
+    (void)area;
+    #endif
+}
+#endif
+
 void gc_add(void *start, void *end) {
     // Place the area struct at the start of the area.
     mp_state_mem_area_t *area = (mp_state_mem_area_t *)start;
@@ -248,6 +430,7 @@ void gc_add(void *start, void *end) {
 
     // Add this area to the linked list
     prev_area->next = area;
+    gc_area_index_add(area);
 }
 
 #if MICROPY_GC_SPLIT_HEAP_AUTO
@@ -366,6 +549,31 @@ static inline mp_state_mem_area_t *gc_get_ptr_area(const void *ptr) {
     if (((uintptr_t)(ptr) & (BYTES_PER_BLOCK - 1)) != 0) {   // must be aligned on a block
         return NULL;
     }
+    if (ptr < (void *)MP_STATE_MEM(gc_pools_start) || ptr >= (void *)MP_STATE_MEM(gc_pools_end)) {
+        return NULL;
+    }
+    #if MICROPY_GC_SPLIT_HEAP_INDEX
+    size_t n = MP_STATE_MEM(gc_area_index_len);
+    if (n != SIZE_MAX) {
+        // find the last area starting at or below ptr
+        mp_state_mem_area_t *const *index = MP_STATE_MEM(gc_area_index);
+        size_t lo = 0;
+        while (n > 1) {
+            size_t half = n / 2;
+            if (ptr >= (void *)index[lo + half]->gc_pool_start) {
+                lo += half;
+                n -= half;
+            } else {
+                n = half;
+            }
+        }
+        mp_state_mem_area_t *area = index[lo];
+        if (ptr >= (void *)area->gc_pool_start && ptr < (void *)area->gc_pool_end) {
+            return area;
+        }
+        return NULL;
+    }
+    #endif
     for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
         if (ptr >= (void *)area->gc_pool_start   // must be above start of pool
             && ptr < (void *)area->gc_pool_end) {   // must be below end of pool
@@ -391,12 +599,65 @@ static inline mp_state_mem_area_t *gc_get_ptr_area(const void *ptr) {
 #endif
 #endif
 
+#if MICROPY_QSTR_GC
+// Mark q if it's the id of a dynamic qstr being collected.
+#define GC_MARK_QSTR(q) do { \
+        size_t i_ = (size_t)(q) - first; \
+        if (i_ < len) { \
+            MP_STATE_VM(qstr_gc_marks)[i_ / 8] |= 1 << (i_ & 7); \
+        } \
+} while (0)
+
+// Mark the qstrs that a word found while tracing may refer to.  A qstr can be
+// held as a plain id, a qstr object, a parse node, or a qstr_short_t, eg in
+// the qstr table of bytecode and in the name of a type.
+static inline void gc_mark_qstrs(uintptr_t w) {
+    size_t first = MP_STATE_VM(qstr_gc_first);
+    size_t len = MP_STATE_VM(qstr_gc_len);
+    GC_MARK_QSTR(w);
+    if (mp_obj_is_qstr((mp_obj_t)w)) {
+        GC_MARK_QSTR(MP_OBJ_QSTR_VALUE((mp_obj_t)w));
+    }
+    if ((w & 0x0f) == MP_PARSE_NODE_ID || (w & 0x0f) == MP_PARSE_NODE_STRING) {
+        GC_MARK_QSTR(MP_PARSE_NODE_LEAF_ARG(w));
+    }
+    for (size_t i = 0; i < sizeof(uintptr_t) / sizeof(qstr_short_t); i++) {
+        GC_MARK_QSTR((qstr_short_t)(w >> (i * 8 * sizeof(qstr_short_t))));
+    }
+}
+
+// Look for qstrs in the len words at ptrs, if qstrs are being collected.
+static void gc_mark_qstrs_in(void **ptrs, size_t len) {
+    if (MP_STATE_VM(qstr_gc_len) == 0) {
+        return;
+    }
+    for (size_t i = 0; i < len; i++) {
+        gc_mark_qstrs((uintptr_t)gc_get_ptr(ptrs, i));
+    }
+}
+#endif
+
 void gc_collect_start(void) {
     gc_collect_start_common();
     #if MICROPY_GC_ALLOC_THRESHOLD
     MP_STATE_MEM(gc_alloc_amount) = 0;
     #endif
 
+    #if MICROPY_OPT_CLASS_LOOKUP_CACHE
+    // types freed by this collection may be reallocated at the same address
+    mp_obj_class_lookup_invalidate();
+    #endif
+
+    #if MICROPY_QSTR_GC
+    qstr_gc_collect_start();
+    #if MICROPY_PY_MICROPYTHON_HEAP_PROFILE
+    for (size_t i = 0; i < MICROPY_PY_MICROPYTHON_HEAP_PROFILE; i++) {
+        gc_mark_qstrs(MP_STATE_MEM(gc_profile_sites)[i].source_file);
+        gc_mark_qstrs(MP_STATE_MEM(gc_profile_sites)[i].block_name);
+    }
+    #endif
+    #endif
+
     // Trace root pointers.  This relies on the root pointers being organised
     // correctly in the mp_state_ctx structure.  We scan nlr_top, dict_locals,
     // dict_globals, then the root pointer section of mp_state_vm.
@@ -415,6 +676,11 @@ void gc_collect_start(void) {
 static void gc_collect_start_common(void) {
     GC_ENTER();
     assert((MP_STATE_THREAD(gc_lock_depth) & GC_COLLECT_FLAG) == 0);
+    #if MICROPY_GC_LAZY_SWEEP
+    MP_STATE_MEM(gc_pause_start) = mp_hal_ticks_us();
+    // The marks of a new collection must not mix with those of the last one
+    gc_sweep_lazy(SIZE_MAX);
+    #endif
     MP_STATE_THREAD(gc_lock_depth) |= GC_COLLECT_FLAG;
     MP_STATE_MEM(gc_stack_overflow) = 0;
 }
@@ -423,6 +689,9 @@ void gc_collect_root(void **ptrs, size_t len) {
     #if !MICROPY_GC_SPLIT_HEAP
     mp_state_mem_area_t *area = &MP_STATE_MEM(area);
     #endif
+    #if MICROPY_QSTR_GC
+    gc_mark_qstrs_in(ptrs, len);
+    #endif
     for (size_t i = 0; i < len; i++) {
         MICROPY_GC_HOOK_LOOP(i);
         void *ptr = gc_get_ptr(ptrs, i);
@@ -477,6 +746,9 @@ static void gc_mark_subtree(size_t block)
 
         // check this block's children
         void **ptrs = (void **)PTR_FROM_BLOCK(area, block);
+        #if MICROPY_QSTR_GC
+        gc_mark_qstrs_in(ptrs, n_blocks * BYTES_PER_BLOCK / sizeof(void *));
+        #endif
         for (size_t i = n_blocks * BYTES_PER_BLOCK / sizeof(void *); i > 0; i--, ptrs++) {
             MICROPY_GC_HOOK_LOOP(i);
             void *ptr = *ptrs;
@@ -527,6 +799,41 @@ static void gc_mark_subtree(size_t block)
     }
 }
 
+#if MICROPY_QSTR_GC
+void gc_mark_leaf(const void *ptr) {
+    #if MICROPY_GC_SPLIT_HEAP
+    mp_state_mem_area_t *area = gc_get_ptr_area(ptr);
+    if (!area) {
+        return;
+    }
+    #else
+    if (!VERIFY_PTR(ptr)) {
+        return;
+    }
+    mp_state_mem_area_t *area = &MP_STATE_MEM(area);
+    #endif
+    size_t block = BLOCK_FROM_PTR(area, ptr);
+    if (ATB_GET_KIND(area, block) == AT_HEAD) {
+        ATB_HEAD_TO_MARK(area, block);
+    }
+}
+
+bool gc_is_marked(const void *ptr) {
+    #if MICROPY_GC_SPLIT_HEAP
+    mp_state_mem_area_t *area = gc_get_ptr_area(ptr);
+    if (!area) {
+        return false;
+    }
+    #else
+    if (!VERIFY_PTR(ptr)) {
+        return false;
+    }
+    mp_state_mem_area_t *area = &MP_STATE_MEM(area);
+    #endif
+    return ATB_GET_KIND(area, BLOCK_FROM_PTR(area, ptr)) == AT_MARK;
+}
+#endif
+
 void gc_sweep_all(void) {
     gc_collect_start_common();
     gc_collect_end();
@@ -534,8 +841,30 @@ void gc_sweep_all(void) {
 
 void gc_collect_end(void) {
     gc_deal_with_stack_overflow();
+    #if MICROPY_QSTR_GC
+    // A finaliser may store a qstr only held by garbage into a live object,
+    // so qstrs are only freed by collections that don't run any finaliser.
+    qstr_gc_sweep(!gc_sweep_run_finalisers());
+    #else
     gc_sweep_run_finalisers();
-    gc_sweep_free_blocks();
+    #endif
+    #if MICROPY_GC_LAZY_SWEEP
+    if (MP_STATE_MEM(gc_sweep_lazy)) {
+        // Leave the sweep to gc_alloc, which sweeps gc_sweep_step blocks per
+        // call.  Blocks allocated ahead of the sweep are marked so they stay.
+        #if MICROPY_PY_GC_COLLECT_RETVAL
+        MP_STATE_MEM(gc_collected) = 0;
+        #endif
+        MP_STATE_MEM(gc_sweep).free_tail = 0;
+        for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
+            area->gc_sweep_block = 0;
+        }
+        MP_STATE_MEM(gc_sweep).area = &MP_STATE_MEM(area);
+    } else
+    #endif
+    {
+        gc_sweep_free_blocks();
+    }
     #if MICROPY_GC_SPLIT_HEAP
     MP_STATE_MEM(gc_last_free_area) = &MP_STATE_MEM(area);
     #endif
@@ -543,6 +872,12 @@ void gc_collect_end(void) {
         area->gc_last_free_atb_index = 0;
     }
     MP_STATE_THREAD(gc_lock_depth) &= ~GC_COLLECT_FLAG;
+    #if MICROPY_GC_LAZY_SWEEP
+    mp_uint_t pause = mp_hal_ticks_us() - MP_STATE_MEM(gc_pause_start);
+    MP_STATE_MEM(gc_pause_count)++;
+    MP_STATE_MEM(gc_pause_last) = pause;
+    MP_STATE_MEM(gc_pause_max) = MAX(MP_STATE_MEM(gc_pause_max), pause);
+    #endif
     GC_EXIT();
 }
 
@@ -567,8 +902,9 @@ static void gc_deal_with_stack_overflow(void) {
     }
 }
 
-// Run finalisers for all to-be-freed blocks
-static void gc_sweep_run_finalisers(void) {
+// Run finalisers for all to-be-freed blocks, returns true if any was run
+static bool gc_sweep_run_finalisers(void) {
+    bool ran = false;
     #if MICROPY_ENABLE_FINALISER
     for (const mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
         assert(area->gc_last_used_block <= area->gc_alloc_table_byte_len * BLOCKS_PER_ATB);
@@ -592,6 +928,7 @@ static void gc_sweep_run_finalisers(void) {
                                 mp_sched_lock();
                                 #endif
                                 mp_call_function_1_protected(dest[0], dest[1]);
+                                ran = true;
                                 #if MICROPY_ENABLE_SCHEDULER
                                 mp_sched_unlock();
                                 #endif
@@ -607,6 +944,149 @@ static void gc_sweep_run_finalisers(void) {
         }
     }
     #endif // MICROPY_ENABLE_FINALISER
+    return ran;
+}
+
+// Free the unmarked heads and their tails among blocks first..last, from the
+// start of an ATB byte to the end of one, carrying on from the blocks before
+// them as recorded in sw.  Returns true if any block was freed.
+static bool gc_sweep_blocks(mp_state_mem_area_t *area, size_t first, size_t last, mp_state_mem_sweep_t *sw) {
+    bool freed = false;
+
+    #if MICROPY_GC_ATB_WORD_SCAN
+    // Same as the loop below, an ATB byte at a time through gc_sweep_table,
+    // skipping whole words of free blocks or of tails that stay in use.
+    byte *atb = area->gc_alloc_table_start;
+    size_t atb_end = last / BLOCKS_PER_ATB; // inclusive
+    for (size_t i = first / BLOCKS_PER_ATB; i <= atb_end; i++) {
+        MICROPY_GC_HOOK_LOOP(i);
+        if (ATB_WORD_ALIGNED(area, i) && i + sizeof(uintptr_t) - 1 <= atb_end) {
+            uintptr_t w = atb_get_word(area, i);
+            if (w == ATB_WORD_ALL_TAIL && sw->free_tail) {
+                memset(atb + i, 0, sizeof(uintptr_t));
+                #if CLEAR_ON_SWEEP
+                memset((void *)PTR_FROM_BLOCK(area, i * BLOCKS_PER_ATB), 0, BLOCKS_PER_ATB_WORD * BYTES_PER_BLOCK);
+                #endif
+                freed = true;
+                w = 0;
+            }
+            if (w == 0) {
+                #if MICROPY_GC_FREE_LISTS
+                sw->n_run += BLOCKS_PER_ATB_WORD;
+                #endif
+                i += sizeof(uintptr_t) - 1;
+                continue;
+            }
+            if (w == ATB_WORD_ALL_TAIL) {
+                #if MICROPY_GC_FREE_LISTS
+                if (sw->n_run > 0) {
+                    gc_free_list_add_run(area, i * BLOCKS_PER_ATB - sw->n_run, sw->n_run);
+                    sw->n_run = 0;
+                }
+                #endif
+                i += sizeof(uintptr_t) - 1;
+                sw->last_used_block = (i + 1) * BLOCKS_PER_ATB - 1;
+                continue;
+            }
+        }
+
+        uint16_t e = gc_sweep_table[sw->free_tail << 8 | atb[i]];
+        #if CLEAR_ON_SWEEP
+        for (size_t k = 0; k < BLOCKS_PER_ATB; k++) {
+            if (((atb[i] >> (2 * k)) & 3) != AT_FREE && ((SWEEP_ATB(e) >> (2 * k)) & 3) == AT_FREE) {
+                memset((void *)PTR_FROM_BLOCK(area, i * BLOCKS_PER_ATB + k), 0, BYTES_PER_BLOCK);
+            }
+        }
+        #endif
+        // a block is in use if either of its two bits is set
+        freed |= ((atb[i] | atb[i] >> 1) & ~(SWEEP_ATB(e) | SWEEP_ATB(e) >> 1) & 0x55) != 0;
+        atb[i] = SWEEP_ATB(e);
+        sw->free_tail = SWEEP_FREE_TAIL(e);
+        #if MICROPY_PY_GC_COLLECT_RETVAL
+        MP_STATE_MEM(gc_collected) += SWEEP_N_HEADS(e);
+        #endif
+        if (SWEEP_LAST_USED(e)) {
+            sw->last_used_block = i * BLOCKS_PER_ATB + SWEEP_LAST_USED(e) - 1;
+        }
+
+        #if MICROPY_GC_FREE_LISTS
+        for (size_t k = 0; k < BLOCKS_PER_ATB; k++) {
+            if (((atb[i] >> (2 * k)) & 3) == AT_FREE) {
+                sw->n_run++;
+            } else if (sw->n_run > 0) {
+                gc_free_list_add_run(area, i * BLOCKS_PER_ATB + k - sw->n_run, sw->n_run);
+                sw->n_run = 0;
+            }
+        }
+        #endif
+    }
+    #else
+    for (size_t block = first; block <= last; block++) {
+        MICROPY_GC_HOOK_LOOP(block);
+        switch (ATB_GET_KIND(area, block)) {
+            case AT_HEAD:
+                sw->free_tail = 1;
+                DEBUG_printf("gc_sweep_free_blocks(%p)\n", (void *)PTR_FROM_BLOCK(area, block));
+                #if MICROPY_PY_GC_COLLECT_RETVAL
+                MP_STATE_MEM(gc_collected)++;
+                #endif
+                // fall through to free the head
+                MP_FALLTHROUGH
+
+            case AT_TAIL:
+                if (sw->free_tail) {
+                    ATB_ANY_TO_FREE(area, block);
+                    #if CLEAR_ON_SWEEP
+                    memset((void *)PTR_FROM_BLOCK(area, block), 0, BYTES_PER_BLOCK);
+                    #endif
+                    freed = true;
+                } else {
+                    sw->last_used_block = block;
+                }
+                break;
+
+            case AT_MARK:
+                ATB_MARK_TO_HEAD(area, block);
+                sw->free_tail = 0;
+                sw->last_used_block = block;
+                break;
+        }
+
+        #if MICROPY_GC_FREE_LISTS
+        if (ATB_GET_KIND(area, block) == AT_FREE) {
+            sw->n_run++;
+        } else if (sw->n_run > 0) {
+            gc_free_list_add_run(area, block - sw->n_run, sw->n_run);
+            sw->n_run = 0;
+        }
+        #endif
+    }
+    #endif
+
+    return freed;
+}
+
+static void gc_sweep_area_start(mp_state_mem_area_t *area, mp_state_mem_sweep_t *sw) {
+    assert(area->gc_last_used_block <= area->gc_alloc_table_byte_len * BLOCKS_PER_ATB);
+    sw->last_used_block = SIZE_MAX;
+
+    #if MICROPY_GC_FREE_LISTS
+    // The free lists are rebuilt from the free runs seen by this sweep
+    sw->n_run = 0;
+    memset(area->gc_free_list_len, 0, sizeof(area->gc_free_list_len));
+    #else
+    (void)area;
+    #endif
+}
+
+static void gc_sweep_area_end(mp_state_mem_area_t *area, mp_state_mem_sweep_t *sw) {
+    area->gc_last_used_block = sw->last_used_block == SIZE_MAX ? 0 : sw->last_used_block;
+
+    #if MICROPY_GC_FREE_LISTS
+    // Cache the free space past the last used block as a long run; with no
+    // used block SIZE_MAX + 1 wraps to 0 and the run covers the whole area
+    gc_free_list_add_run(area, sw->last_used_block + 1, area->gc_alloc_table_byte_len * BLOCKS_PER_ATB - sw->last_used_block - 1);
+    #endif
 }
 
 // Free unmarked heads and their tails
@@ -614,61 +1094,107 @@ static void gc_sweep_free_blocks(void) {
     #if MICROPY_PY_GC_COLLECT_RETVAL
     MP_STATE_MEM(gc_collected) = 0;
     #endif
-    int free_tail = 0;
+    mp_state_mem_sweep_t sw;
+    sw.free_tail = 0;
     #if MICROPY_GC_SPLIT_HEAP_AUTO
     mp_state_mem_area_t *prev_area = NULL;
     #endif
 
     for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
-        size_t last_used_block = 0;
-        assert(area->gc_last_used_block <= area->gc_alloc_table_byte_len * BLOCKS_PER_ATB);
+        gc_sweep_area_start(area, &sw);
+        gc_sweep_blocks(area, 0, area->gc_last_used_block | (BLOCKS_PER_ATB - 1), &sw);
+        gc_sweep_area_end(area, &sw);
 
-        for (size_t block = 0; block <= area->gc_last_used_block; block++) {
-            MICROPY_GC_HOOK_LOOP(block);
-            switch (ATB_GET_KIND(area, block)) {
-                case AT_HEAD:
-                    free_tail = 1;
-                    DEBUG_printf("gc_sweep_free_blocks(%p)\n", (void *)PTR_FROM_BLOCK(area, block));
-                    #if MICROPY_PY_GC_COLLECT_RETVAL
-                    MP_STATE_MEM(gc_collected)++;
-                    #endif
-                    // fall through to free the head
-                    MP_FALLTHROUGH
+        #if MICROPY_GC_SPLIT_HEAP_AUTO
+        // Free any empty area, aside from the first one
+        if (sw.last_used_block == SIZE_MAX && prev_area != NULL) {
+            DEBUG_printf("gc_sweep_free_blocks free empty area %p\n", area);
+            NEXT_AREA(prev_area) = NEXT_AREA(area);
+            gc_area_index_remove(area);
+            MP_PLAT_FREE_HEAP(area);
+            area = prev_area;
+        }
+        prev_area = area;
+        #endif
+    }
+}
 
-                case AT_TAIL:
-                    if (free_tail) {
-                        ATB_ANY_TO_FREE(area, block);
-                        #if CLEAR_ON_SWEEP
-                        memset((void *)PTR_FROM_BLOCK(area, block), 0, BYTES_PER_BLOCK);
-                        #endif
-                    } else {
-                        last_used_block = block;
-                    }
-                    break;
+#if MICROPY_GC_LAZY_SWEEP
+// Carry on with the sweep left by gc_collect_end for n_blocks blocks, rounded
+// up to whole ATB bytes, or until it is done.
+static void gc_sweep_lazy(size_t n_blocks) {
+    mp_state_mem_sweep_t *sw = &MP_STATE_MEM(gc_sweep);
+    while (sw->area != NULL && n_blocks > 0) {
+        mp_state_mem_area_t *area = sw->area;
+        size_t first = area->gc_sweep_block;
+        if (first == 0) {
+            gc_sweep_area_start(area, sw);
+        }
+        size_t last = area->gc_last_used_block | (BLOCKS_PER_ATB - 1);
+        if (n_blocks <= last - first) {
+            last = (first + n_blocks - 1) | (BLOCKS_PER_ATB - 1);
+        }
+        n_blocks -= MIN(n_blocks, last - first + 1);
 
-                case AT_MARK:
-                    ATB_MARK_TO_HEAD(area, block);
-                    free_tail = 0;
-                    last_used_block = block;
-                    break;
-            }
+        if (gc_sweep_blocks(area, first, last, sw)) {
+            // let the next scan of gc_alloc find the blocks just freed
+            #if MICROPY_GC_SPLIT_HEAP
+            MP_STATE_MEM(gc_last_free_area) = &MP_STATE_MEM(area);
+            #endif
+            area->gc_last_free_atb_index = MIN(area->gc_last_free_atb_index, first / BLOCKS_PER_ATB);
         }
 
-        area->gc_last_used_block = last_used_block;
+        if (last < area->gc_last_used_block) {
+            area->gc_sweep_block = last + 1;
+            continue;
+        }
+
+        // this area is done, move on to the next one
+        area->gc_sweep_block = SIZE_MAX;
+        gc_sweep_area_end(area, sw);
+        sw->area = NEXT_AREA(area);
 
         #if MICROPY_GC_SPLIT_HEAP_AUTO
         // Free any empty area, aside from the first one
-        if (last_used_block == 0 && prev_area != NULL) {
-            DEBUG_printf("gc_sweep_free_blocks free empty area %p\n", area);
+        if (sw->last_used_block == SIZE_MAX && area != &MP_STATE_MEM(area)) {
+            mp_state_mem_area_t *prev_area = &MP_STATE_MEM(area);
+            while (NEXT_AREA(prev_area) != area) {
+                prev_area = NEXT_AREA(prev_area);
+            }
+            DEBUG_printf("gc_sweep_lazy free empty area %p\n", area);
             NEXT_AREA(prev_area) = NEXT_AREA(area);
+            if (MP_STATE_MEM(gc_last_free_area) == area) {
+                MP_STATE_MEM(gc_last_free_area) = &MP_STATE_MEM(area);
+            }
+            gc_area_index_remove(area);
             MP_PLAT_FREE_HEAP(area);
-            area = prev_area;
         }
-        prev_area = area;
         #endif
     }
 }
 
+// Called before blocks first..last of an area become a chain, or the tail of
+// one that starts at first.  A chain that would straddle the sweep position is
+// swept past first, as the sweep must not see its new tails.  Returns true if
+// the chain starts ahead of the sweep and so its head must be marked.
+static bool gc_sweep_claim(mp_state_mem_area_t *area, size_t first, size_t last) {
+    mp_state_mem_sweep_t *sw = &MP_STATE_MEM(gc_sweep);
+    if (first >= area->gc_sweep_block) {
+        return true;
+    }
+    if (last >= area->gc_sweep_block) {
+        assert(area == sw->area);
+        gc_sweep_lazy(last - area->gc_sweep_block + 1);
+    }
+    if (area == sw->area) {
+        if (sw->last_used_block == SIZE_MAX || sw->last_used_block < last) {
+            sw->last_used_block = last;
+        }
+    }
+    return false;
+}
+#endif
+
 // Address sanitizer needs to know that the access to ptrs[i] must always be
 // considered OK, even if it's a load from an address that would normally be
 // prohibited (due to being undefined, in a red zone, etc).
@@ -686,6 +1212,9 @@ static void *gc_get_ptr(void **ptrs, int i) {
 
 void gc_info(gc_info_t *info) {
     GC_ENTER();
+    #if MICROPY_GC_LAZY_SWEEP
+    gc_sweep_lazy(SIZE_MAX);
+    #endif
     info->total = 0;
     info->used = 0;
     info->free = 0;
@@ -757,6 +1286,124 @@ void gc_info(gc_info_t *info) {
     GC_EXIT();
 }
 
+#if MICROPY_GC_FREE_LISTS
+// Cache the free run of n blocks starting at block.  The last size class also
+// holds the longer runs, which are then handed out piecewise.
+static void gc_free_list_add_run(mp_state_mem_area_t *area, size_t block, size_t n) {
+    if (n > 0) {
+        size_t c = MIN(n, MP_GC_FREE_LIST_CLASSES);
+        uint16_t *len = &area->gc_free_list_len[c - 1];
+        if (*len < MICROPY_GC_FREE_LISTS) {
+            area->gc_free_list[c - 1][(*len)++] = block;
+        }
+    }
+}
+
+// Take n_blocks from the smallest cached run that can hold them.  Returns the
+// area and sets *block to the first block, or returns NULL if no run fits.
+static mp_state_mem_area_t *gc_free_list_take(size_t n_blocks, size_t *block) {
+    for (size_t c = n_blocks; c <= MP_GC_FREE_LIST_CLASSES; c++) {
+        // Look far enough into a long run to re-cache what is left of it
+        size_t n_check = c < MP_GC_FREE_LIST_CLASSES ? c : n_blocks + MP_GC_FREE_LIST_CLASSES;
+        for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
+            uint16_t *len = &area->gc_free_list_len[c - 1];
+            size_t n_total = area->gc_alloc_table_byte_len * BLOCKS_PER_ATB;
+            while (*len > 0) {
+                size_t b = area->gc_free_list[c - 1][--(*len)];
+                // Blocks may have been claimed by an ATB scan or an in-place
+                // realloc since the sweep; only the free prefix is usable.
+                size_t n_free = 0;
+                while (n_free < n_check && b + n_free < n_total
+                       && ATB_GET_KIND(area, b + n_free) == AT_FREE) {
+                    n_free++;
+                }
+                if (n_free >= n_blocks) {
+                    gc_free_list_add_run(area, b + n_blocks, n_free - n_blocks);
+                    *block = b;
+                    return area;
+                }
+            }
+        }
+    }
+    return NULL;
+}
+#endif
+
+#if MICROPY_PY_MICROPYTHON_HEAP_PROFILE
+// Return the site of an allocation of n_blocks from the running bytecode, and
+// count the allocation against it.
+static byte gc_heap_profile_site(size_t n_blocks) {
+    mp_heap_profile_site_t *sites = MP_STATE_MEM(gc_profile_sites);
+    size_t site = 0;
+    const mp_code_state_t *code_state = MP_STATE_THREAD(current_code_state);
+    if (code_state != NULL) {
+        // work out the source line, as for a traceback (see mp_execute_bytecode)
+        const byte *ip = code_state->fun_bc->bytecode;
+        MP_BC_PRELUDE_SIG_DECODE(ip);
+        MP_BC_PRELUDE_SIZE_DECODE(ip);
+        const byte *line_info_top = ip + n_info;
+        const byte *bytecode_start = ip + n_info + n_cell;
+        qstr block_name = mp_decode_uint_value(ip);
+        for (size_t i = 0; i < 1 + n_pos_args + n_kwonly_args; ++i) {
+            ip = mp_decode_uint_skip(ip);
+        }
+        #if MICROPY_EMIT_BYTECODE_USES_QSTR_TABLE
+        block_name = code_state->fun_bc->context->constants.qstr_table[block_name];
+        qstr source_file = code_state->fun_bc->context->constants.qstr_table[0];
+        #else
+        qstr source_file = code_state->fun_bc->context->constants.source_file;
+        #endif
+        size_t line = mp_bytecode_get_source_line(ip, line_info_top, code_state->ip - bytecode_start);
+
+        // find the site in the open-addressed table of sites 1 and up, or
+        // take a free entry for it
+        size_t n = MICROPY_PY_MICROPYTHON_HEAP_PROFILE - 1;
+        size_t h = (source_file * 31 + line) % n;
+        for (size_t k = 0; k < n; k++, h = h + 1 < n ? h + 1 : 0) {
+            mp_heap_profile_site_t *s = &sites[1 + h];
+            if (s->source_file == MP_QSTRnull) {
+                s->source_file = source_file;
+                s->block_name = block_name;
+                s->line = line;
+            } else if (s->source_file != source_file || s->line != line || s->block_name != block_name) {
+                continue;
+            }
+            site = 1 + h;
+            break;
+        }
+    }
+    sites[site].alloc_bytes += n_blocks * BYTES_PER_BLOCK;
+    sites[site].alloc_count += 1;
+    return site;
+}
+
+void gc_heap_profile(size_t *live_blocks, size_t *live_count) {
+    GC_ENTER();
+    #if MICROPY_GC_LAZY_SWEEP
+    gc_sweep_lazy(SIZE_MAX);
+    #endif
+    memset(live_blocks, 0, MICROPY_PY_MICROPYTHON_HEAP_PROFILE * sizeof(size_t));
+    memset(live_count, 0, MICROPY_PY_MICROPYTHON_HEAP_PROFILE * sizeof(size_t));
+    for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
+        size_t site = 0;
+        size_t n_total = area->gc_alloc_table_byte_len * BLOCKS_PER_ATB;
+        for (size_t block = 0; block <= area->gc_last_used_block && block < n_total; block++) {
+            switch (ATB_GET_KIND(area, block)) {
+                case AT_HEAD:
+                    site = area->gc_site_table_start[block];
+                    live_count[site] += 1;
+                    live_blocks[site] += 1;
+                    break;
+                case AT_TAIL:
+                    live_blocks[site] += 1;
+                    break;
+            }
+        }
+    }
+    GC_EXIT();
+}
+#endif
+
 void *gc_alloc(size_t n_bytes, unsigned int alloc_flags) {
     bool has_finaliser = alloc_flags & GC_ALLOC_FLAG_HAS_FINALISER;
     size_t n_blocks = ((n_bytes + BYTES_PER_BLOCK - 1) & (~(BYTES_PER_BLOCK - 1))) / BYTES_PER_BLOCK;
@@ -787,12 +1434,40 @@ void *gc_alloc(size_t n_bytes, unsigned int alloc_flags) {
     #if MICROPY_GC_ALLOC_THRESHOLD
     if (!collected && MP_STATE_MEM(gc_alloc_amount) >= MP_STATE_MEM(gc_alloc_threshold)) {
         GC_EXIT();
+        #if MICROPY_GC_LAZY_SWEEP
+        // An early collection can leave the sweep to the next allocations,
+        // unlike one on a failed allocation which needs the memory now
+        MP_STATE_MEM(gc_sweep_lazy) = MP_STATE_MEM(gc_sweep_step) != 0;
+        gc_collect();
+        MP_STATE_MEM(gc_sweep_lazy) = false;
+        #else
         gc_collect();
+        #endif
         collected = 1;
         GC_ENTER();
     }
     #endif
 
+    #if MICROPY_GC_LAZY_SWEEP
+    if (MP_STATE_MEM(gc_sweep).area != NULL) {
+        mp_uint_t t = mp_hal_ticks_us();
+        gc_sweep_lazy(MP_STATE_MEM(gc_sweep_step) ? MP_STATE_MEM(gc_sweep_step) : SIZE_MAX);
+        t = mp_hal_ticks_us() - t;
+        MP_STATE_MEM(gc_sweep_step_count)++;
+        MP_STATE_MEM(gc_sweep_step_max) = MAX(MP_STATE_MEM(gc_sweep_step_max), t);
+    }
+    #endif
+
+    #if MICROPY_GC_FREE_LISTS
+    if (n_blocks <= MP_GC_FREE_LIST_CLASSES) {
+        area = gc_free_list_take(n_blocks, &start_block);
+        if (area != NULL) {
+            end_block = start_block + n_blocks - 1;
+            goto found_run;
+        }
+    }
+    #endif
+
     for (;;) {
 
         #if MICROPY_GC_SPLIT_HEAP
@@ -806,6 +1481,27 @@ void *gc_alloc(size_t n_bytes, unsigned int alloc_flags) {
             n_free = 0;
             for (i = area->gc_last_free_atb_index; i < area->gc_alloc_table_byte_len; i++) {
                 MICROPY_GC_HOOK_LOOP(i);
+                #if MICROPY_GC_ATB_WORD_SCAN
+                // Step over whole words of free or of used blocks
+                if (ATB_WORD_ALIGNED(area, i) && i + sizeof(uintptr_t) <= area->gc_alloc_table_byte_len) {
+                    uintptr_t w = atb_get_word(area, i);
+                    if (w == 0) {
+                        if (n_free + BLOCKS_PER_ATB_WORD >= n_blocks) {
+                            i = i * BLOCKS_PER_ATB + (n_blocks - n_free) - 1;
+                            n_free = n_blocks;
+                            goto found;
+                        }
+                        n_free += BLOCKS_PER_ATB_WORD;
+                        i += sizeof(uintptr_t) - 1;
+                        continue;
+                    }
+                    if (ATB_WORD_NONE_FREE(w)) {
+                        n_free = 0;
+                        i += sizeof(uintptr_t) - 1;
+                        continue;
+                    }
+                }
+                #endif
                 byte a = area->gc_alloc_table_start[i];
                 // *FORMAT-OFF*
                 if (ATB_0_IS_FREE(a)) { if (++n_free >= n_blocks) { i = i * BLOCKS_PER_ATB + 0; goto found; } } else { n_free = 0; }
@@ -825,6 +1521,14 @@ void *gc_alloc(size_t n_bytes, unsigned int alloc_flags) {
             #endif
         }
 
+        #if MICROPY_GC_LAZY_SWEEP
+        // Finish the sweep of the last collection before starting another one
+        if (MP_STATE_MEM(gc_sweep).area != NULL) {
+            gc_sweep_lazy(SIZE_MAX);
+            continue;
+        }
+        #endif
+
         GC_EXIT();
         // nothing found!
         if (collected) {
@@ -860,10 +1564,25 @@ found:
         area->gc_last_free_atb_index = (i + 1) / BLOCKS_PER_ATB;
     }
 
+    #if MICROPY_GC_FREE_LISTS
+found_run:
+    #endif
+    #if MICROPY_GC_LAZY_SWEEP
+    bool mark = gc_sweep_claim(area, start_block, end_block);
+    #endif
     area->gc_last_used_block = MAX(area->gc_last_used_block, end_block);
 
     // mark first block as used head
     ATB_FREE_TO_HEAD(area, start_block);
+    #if MICROPY_GC_LAZY_SWEEP
+    if (mark) {
+        ATB_HEAD_TO_MARK(area, start_block);
+    }
+    #endif
+
+    #if MICROPY_PY_MICROPYTHON_HEAP_PROFILE
+    area->gc_site_table_start[start_block] = gc_heap_profile_site(end_block - start_block + 1);
+    #endif
 
     // mark rest of blocks as used tail
     // TODO for a run of many blocks can make this more efficient
@@ -949,7 +1668,11 @@ void gc_free(void *ptr) {
 
     size_t block = BLOCK_FROM_PTR(area, ptr);
     assert(ATB_GET_KIND(area, block) == AT_HEAD
-        || (ATB_GET_KIND(area, block) == AT_MARK && (MP_STATE_THREAD(gc_lock_depth) & GC_COLLECT_FLAG)));
+        || (ATB_GET_KIND(area, block) == AT_MARK && (MP_STATE_THREAD(gc_lock_depth) & GC_COLLECT_FLAG))
+        #if MICROPY_GC_LAZY_SWEEP
+        || (ATB_GET_KIND(area, block) == AT_MARK && block >= area->gc_sweep_block)
+        #endif
+        );
 
     #if MICROPY_ENABLE_FINALISER
     FTB_CLEAR(area, block);
@@ -1004,7 +1727,12 @@ size_t gc_nbytes(const void *ptr) {
 
     if (area) {
         size_t block = BLOCK_FROM_PTR(area, ptr);
-        if (ATB_GET_KIND(area, block) == AT_HEAD) {
+        if (ATB_GET_KIND(area, block) == AT_HEAD
+            #if MICROPY_GC_LAZY_SWEEP
+            // allocated ahead of a lazy sweep
+            || (ATB_GET_KIND(area, block) == AT_MARK && block >= area->gc_sweep_block)
+            #endif
+            ) {
             // work out number of consecutive blocks in the chain starting with this on
             size_t n_blocks = 0;
             do {
@@ -1050,7 +1778,12 @@ void *gc_realloc(void *ptr_in, size_t n_bytes, bool allow_move) {
     area = &MP_STATE_MEM(area);
     #endif
     size_t block = BLOCK_FROM_PTR(area, ptr);
+    #if MICROPY_GC_LAZY_SWEEP
+    assert(ATB_GET_KIND(area, block) == AT_HEAD
+        || (ATB_GET_KIND(area, block) == AT_MARK && block >= area->gc_sweep_block));
+    #else
     assert(ATB_GET_KIND(area, block) == AT_HEAD);
+    #endif
 
     // compute number of new blocks that are requested
     size_t new_blocks = (n_bytes + BYTES_PER_BLOCK - 1) / BYTES_PER_BLOCK;
@@ -1119,6 +1852,9 @@ void *gc_realloc(void *ptr_in, size_t n_bytes, bool allow_move) {
     if (new_blocks <= n_blocks + n_free) {
         // mark few more blocks as used tail
         size_t end_block = block + new_blocks;
+        #if MICROPY_GC_LAZY_SWEEP
+        gc_sweep_claim(area, block, end_block - 1);
+        #endif
         for (size_t bl = block + n_blocks; bl < end_block; bl++) {
             assert(ATB_GET_KIND(area, bl) == AT_FREE);
             ATB_FREE_TO_TAIL(area, bl);
@@ -1184,6 +1920,9 @@ void gc_dump_info(const mp_print_t *print) {
 
 void gc_dump_alloc_table(const mp_print_t *print) {
     GC_ENTER();
+    #if MICROPY_GC_LAZY_SWEEP
+    gc_sweep_lazy(SIZE_MAX);
+    #endif
     static const size_t DUMP_BYTES_PER_LINE = 64;
     for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
         #if !EXTENSIVE_HEAP_PROFILING
@@ -67,6 +67,12 @@ void gc_free(void *ptr); // does not call finaliser
 size_t gc_nbytes(const void *ptr);
 void *gc_realloc(void *ptr, size_t n_bytes, bool allow_move);
 
+#if MICROPY_QSTR_GC
+// For the qstr collector, while a collection is marking the heap
+void gc_mark_leaf(const void *ptr); // mark a block without scanning it
+bool gc_is_marked(const void *ptr);
+#endif
+
 typedef struct _gc_info_t {
     size_t total;
     size_t used;
@@ -82,6 +88,12 @@ typedef struct _gc_info_t {
 
 void gc_info(gc_info_t *info);
 void gc_dump_info(const mp_print_t *print);
+
+#if MICROPY_PY_MICROPYTHON_HEAP_PROFILE
+// Fill in the number of blocks and of chains currently allocated by each site
+// of MP_STATE_MEM(gc_profile_sites).
+void gc_heap_profile(size_t *live_blocks, size_t *live_count);
+#endif
 void gc_dump_alloc_table(const mp_print_t *print);
 
 #endif // MICROPY_INCLUDED_PY_GC_H
@@ -61,6 +61,17 @@
 #define MAP_CACHE_SET(index, pos)
 #endif
 
+#if MICROPY_OPT_INLINE_CACHE
+// Counts keys added to any map, see MP_STATE_VM(map_keys_added).
+#define MAP_KEY_ADDED() do { \
+        if (MP_STATE_VM(map_keys_added) != SIZE_MAX) { \
+            ++MP_STATE_VM(map_keys_added); \
+        } \
+} while (0)
+#else
+#define MAP_KEY_ADDED()
+#endif
+
 // This table of sizes is used to control the growth of hash tables.
 // The first set of sizes are chosen so the allocation fits exactly in a
 // 4-word GC block, and it's not so important for these small values to be
@@ -98,6 +109,7 @@ void mp_map_init(mp_map_t *map, size_t n) {
     map->all_keys_are_qstrs = 1;
     map->is_fixed = 0;
     map->is_ordered = 0;
+    map->is_class_locals = 0;
 }
 
 void mp_map_init_fixed_table(mp_map_t *map, size_t n, const mp_obj_t *table) {
@@ -106,6 +118,7 @@ void mp_map_init_fixed_table(mp_map_t *map, size_t n, const mp_obj_t *table) {
     map->all_keys_are_qstrs = 1;
     map->is_fixed = 1;
     map->is_ordered = 1;
+    map->is_class_locals = 0;
     map->table = (mp_map_elem_t *)table;
 }
 
@@ -220,6 +233,7 @@ mp_map_elem_t *MICROPY_WRAP_MP_MAP_LOOKUP(mp_map_lookup)(mp_map_t * map, mp_obj_
             mp_seq_clear(map->table, map->used, map->alloc, sizeof(*map->table));
         }
         mp_map_elem_t *elem = map->table + map->used++;
+        MAP_KEY_ADDED();
         elem->key = index;
         elem->value = MP_OBJ_NULL;
         if (!mp_obj_is_qstr(index)) {
@@ -258,6 +272,7 @@ mp_map_elem_t *MICROPY_WRAP_MP_MAP_LOOKUP(mp_map_lookup)(mp_map_t * map, mp_obj_
             // found NULL slot, so index is not in table
             if (lookup_kind == MP_MAP_LOOKUP_ADD_IF_NOT_FOUND) {
                 map->used += 1;
+                MAP_KEY_ADDED();
                 if (avail_slot == NULL) {
                     avail_slot = slot;
                 }
@@ -302,6 +317,7 @@ mp_map_elem_t *MICROPY_WRAP_MP_MAP_LOOKUP(mp_map_lookup)(mp_map_t * map, mp_obj_
                 if (avail_slot != NULL) {
                     // there was an available slot, so use that
                     map->used++;
+                    MAP_KEY_ADDED();
                     avail_slot->key = index;
                     avail_slot->value = MP_OBJ_NULL;
                     if (!mp_obj_is_qstr(index)) {
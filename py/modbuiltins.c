@@ -170,6 +170,9 @@ static mp_obj_t mp_builtin_dir(size_t n_args, const mp_obj_t *args) {
         // Implemented by probing all possible qstrs with mp_load_method_maybe
         size_t nqstr = QSTR_TOTAL();
         for (size_t i = MP_QSTR_ + 1; i < nqstr; ++i) {
+            if (!qstr_is_live(i)) {
+                continue;
+            }
             mp_obj_t dest[2];
             mp_load_method_protected(args[0], i, dest, false);
             if (dest[0] != MP_OBJ_NULL) {
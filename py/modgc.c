@@ -100,6 +100,37 @@ static mp_obj_t gc_threshold(size_t n_args, const mp_obj_t *args) {
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(gc_threshold_obj, 0, 1, gc_threshold);
 #endif
 
+#if MICROPY_GC_LAZY_SWEEP
+static mp_obj_t gc_sweep_step(size_t n_args, const mp_obj_t *args) {
+    if (n_args == 0) {
+        return mp_obj_new_int(MP_STATE_MEM(gc_sweep_step) * MICROPY_BYTES_PER_GC_BLOCK);
+    }
+    mp_int_t val = mp_obj_get_int(args[0]);
+    if (val <= 0) {
+        MP_STATE_MEM(gc_sweep_step) = 0;
+    } else {
+        MP_STATE_MEM(gc_sweep_step) = (val + MICROPY_BYTES_PER_GC_BLOCK - 1) / MICROPY_BYTES_PER_GC_BLOCK;
+    }
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(gc_sweep_step_obj, 0, 1, gc_sweep_step);
+
+// pause_info(): return the number of collections, the last and longest
+// collection pauses in microseconds, the number of sweep steps and the
+// longest sweep step in microseconds
+static mp_obj_t gc_pause_info(void) {
+    mp_obj_t items[5] = {
+        mp_obj_new_int_from_uint(MP_STATE_MEM(gc_pause_count)),
+        mp_obj_new_int_from_uint(MP_STATE_MEM(gc_pause_last)),
+        mp_obj_new_int_from_uint(MP_STATE_MEM(gc_pause_max)),
+        mp_obj_new_int_from_uint(MP_STATE_MEM(gc_sweep_step_count)),
+        mp_obj_new_int_from_uint(MP_STATE_MEM(gc_sweep_step_max)),
+    };
+    return mp_obj_new_tuple(5, items);
+}
+MP_DEFINE_CONST_FUN_OBJ_0(gc_pause_info_obj, gc_pause_info);
+#endif
+
 static const mp_rom_map_elem_t mp_module_gc_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_gc) },
     { MP_ROM_QSTR(MP_QSTR_collect), MP_ROM_PTR(&gc_collect_obj) },
@@ -111,6 +142,10 @@ static const mp_rom_map_elem_t mp_module_gc_globals_table[] = {
     #if MICROPY_GC_ALLOC_THRESHOLD
     { MP_ROM_QSTR(MP_QSTR_threshold), MP_ROM_PTR(&gc_threshold_obj) },
     #endif
+    #if MICROPY_GC_LAZY_SWEEP
+    { MP_ROM_QSTR(MP_QSTR_sweep_step), MP_ROM_PTR(&gc_sweep_step_obj) },
+    { MP_ROM_QSTR(MP_QSTR_pause_info), MP_ROM_PTR(&gc_pause_info_obj) },
+    #endif
 };
 
 static MP_DEFINE_CONST_DICT(mp_module_gc_globals, mp_module_gc_globals_table);
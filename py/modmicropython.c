@@ -95,12 +95,15 @@ static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_micropython_mem_info_obj, 0, 1, mp
 
 static mp_obj_t mp_micropython_qstr_info(size_t n_args, const mp_obj_t *args) {
     (void)args;
-    size_t n_pool, n_qstr, n_str_data_bytes, n_total_bytes;
-    qstr_pool_info(&n_pool, &n_qstr, &n_str_data_bytes, &n_total_bytes);
+    size_t n_pool, n_qstr, n_str_data_bytes, n_total_bytes, n_reclaimed_bytes;
+    qstr_pool_info(&n_pool, &n_qstr, &n_str_data_bytes, &n_total_bytes, &n_reclaimed_bytes);
     mp_printf(&mp_plat_print, "qstr pool: n_pool=%u, n_qstr=%u, n_str_data_bytes=%u, n_total_bytes=%u\n",
         n_pool, n_qstr, n_str_data_bytes, n_total_bytes);
     if (n_args == 1) {
         // arg given means dump qstr data
+        #if MICROPY_QSTR_GC
+        mp_printf(&mp_plat_print, "qstr gc: n_reclaimed_bytes=%u\n", n_reclaimed_bytes);
+        #endif
         qstr_dump_data();
     }
     return mp_const_none;
@@ -109,6 +112,61 @@ static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_micropython_qstr_info_obj, 0, 1, m
 
 #endif // MICROPY_PY_MICROPYTHON_MEM_INFO
 
+#if MICROPY_PY_MICROPYTHON_HEAP_PROFILE && MICROPY_ENABLE_GC
+static mp_obj_t mp_micropython_heap_profile(size_t n_args, const mp_obj_t *args) {
+    size_t live_blocks[MICROPY_PY_MICROPYTHON_HEAP_PROFILE];
+    size_t live_count[MICROPY_PY_MICROPYTHON_HEAP_PROFILE];
+    gc_heap_profile(live_blocks, live_count);
+
+    // one (file, line, name, live bytes, live count, allocated bytes,
+    // allocated count) tuple per site, with None for the file and name of the
+    // allocations that could not be attributed to a line
+    mp_heap_profile_site_t *sites = MP_STATE_MEM(gc_profile_sites);
+    mp_obj_t list = mp_obj_new_list(0, NULL);
+    for (size_t i = 0; i < MICROPY_PY_MICROPYTHON_HEAP_PROFILE; i++) {
+        if (live_count[i] == 0 && sites[i].alloc_count == 0) {
+            continue;
+        }
+        mp_obj_t items[7] = {
+            i == 0 ? mp_const_none : MP_OBJ_NEW_QSTR(sites[i].source_file),
+            MP_OBJ_NEW_SMALL_INT(sites[i].line),
+            i == 0 ? mp_const_none : MP_OBJ_NEW_QSTR(sites[i].block_name),
+            mp_obj_new_int_from_uint(live_blocks[i] * MICROPY_BYTES_PER_GC_BLOCK),
+            mp_obj_new_int_from_uint(live_count[i]),
+            mp_obj_new_int_from_uint(sites[i].alloc_bytes),
+            mp_obj_new_int_from_uint(sites[i].alloc_count),
+        };
+        mp_obj_list_append(list, mp_obj_new_tuple(7, items));
+    }
+
+    if (n_args == 1 && mp_obj_is_true(args[0])) {
+        // arg true means restart the allocation totals
+        for (size_t i = 0; i < MICROPY_PY_MICROPYTHON_HEAP_PROFILE; i++) {
+            sites[i].alloc_bytes = 0;
+            sites[i].alloc_count = 0;
+        }
+    }
+    return list;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_micropython_heap_profile_obj, 0, 1, mp_micropython_heap_profile);
+#endif
+
+#if MICROPY_PY_MICROPYTHON_INLINE_CACHE_STATS && MICROPY_OPT_INLINE_CACHE
+static mp_obj_t mp_micropython_inline_cache_stats(size_t n_args, const mp_obj_t *args) {
+    mp_obj_t items[2] = {
+        mp_obj_new_int_from_uint(MP_STATE_VM(inline_cache_hits)),
+        mp_obj_new_int_from_uint(MP_STATE_VM(inline_cache_misses)),
+    };
+    if (n_args == 1 && mp_obj_is_true(args[0])) {
+        // arg true means restart the counts
+        MP_STATE_VM(inline_cache_hits) = 0;
+        MP_STATE_VM(inline_cache_misses) = 0;
+    }
+    return mp_obj_new_tuple(2, items);
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_micropython_inline_cache_stats_obj, 0, 1, mp_micropython_inline_cache_stats);
+#endif
+
 #if MICROPY_PY_MICROPYTHON_STACK_USE
 static mp_obj_t mp_micropython_stack_use(void) {
     return MP_OBJ_NEW_SMALL_INT(mp_cstack_usage());
@@ -184,6 +242,9 @@ static const mp_rom_map_elem_t mp_module_micropython_globals_table[] = {
     #if MICROPY_PY_MICROPYTHON_STACK_USE
     { MP_ROM_QSTR(MP_QSTR_stack_use), MP_ROM_PTR(&mp_micropython_stack_use_obj) },
     #endif
+    #if MICROPY_PY_MICROPYTHON_INLINE_CACHE_STATS && MICROPY_OPT_INLINE_CACHE
+    { MP_ROM_QSTR(MP_QSTR_inline_cache_stats), MP_ROM_PTR(&mp_micropython_inline_cache_stats_obj) },
+    #endif
     #if MICROPY_ENABLE_EMERGENCY_EXCEPTION_BUF && (MICROPY_EMERGENCY_EXCEPTION_BUF_SIZE == 0)
     { MP_ROM_QSTR(MP_QSTR_alloc_emergency_exception_buf), MP_ROM_PTR(&mp_alloc_emergency_exception_buf_obj) },
     #endif
@@ -196,6 +257,9 @@ static const mp_rom_map_elem_t mp_module_micropython_globals_table[] = {
     #if MICROPY_PY_MICROPYTHON_HEAP_LOCKED
     { MP_ROM_QSTR(MP_QSTR_heap_locked), MP_ROM_PTR(&mp_micropython_heap_locked_obj) },
     #endif
+    #if MICROPY_PY_MICROPYTHON_HEAP_PROFILE
+    { MP_ROM_QSTR(MP_QSTR_heap_profile), MP_ROM_PTR(&mp_micropython_heap_profile_obj) },
+    #endif
     #endif
     #if MICROPY_KBD_EXCEPTION
     { MP_ROM_QSTR(MP_QSTR_kbd_intr), MP_ROM_PTR(&mp_micropython_kbd_intr_obj) },
@@ -203,6 +203,10 @@ static void *thread_entry(void *args_in) {
 
     MP_THREAD_GIL_EXIT();
 
+    #if MICROPY_QSTR_GC && !MICROPY_PY_THREAD_GIL
+    qstr_gc_add_threads(-1);
+    #endif
+
     return NULL;
 }
 
@@ -255,7 +259,20 @@ static mp_obj_t mod_thread_start_new_thread(size_t n_args, const mp_obj_t *args)
     th_args->fun = args[0];
 
     // spawn the thread!
+    #if MICROPY_QSTR_GC && !MICROPY_PY_THREAD_GIL
+    // count the thread from before it exists, so it never runs uncounted
+    qstr_gc_add_threads(1);
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        mp_uint_t id = mp_thread_create(thread_entry, th_args, &th_args->stack_size);
+        nlr_pop();
+        return mp_obj_new_int_from_uint(id);
+    }
+    qstr_gc_add_threads(-1);
+    nlr_jump(nlr.ret_val);
+    #else
     return mp_obj_new_int_from_uint(mp_thread_create(thread_entry, th_args, &th_args->stack_size));
+    #endif
 }
 static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_thread_start_new_thread_obj, 2, 3, mod_thread_start_new_thread);
 
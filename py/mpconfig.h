@@ -200,6 +200,27 @@
 #define MICROPY_GC_ALLOC_THRESHOLD (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_CORE_FEATURES)
 #endif
 
+// Number of free runs cached per size class (1 to 8 blocks) so that small
+// allocations can be served without scanning the ATB; 0 disables the lists.
+// Each heap area grows by 8 * MICROPY_GC_FREE_LISTS words.
+#ifndef MICROPY_GC_FREE_LISTS
+#define MICROPY_GC_FREE_LISTS (0)
+#endif
+
+// Whether the GC tests and sweeps its allocation table a machine word at a
+// time, rather than one block at a time.  Costs a 1k table of sweep states.
+#ifndef MICROPY_GC_ATB_WORD_SCAN
+#define MICROPY_GC_ATB_WORD_SCAN (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
+#endif
+
+// Whether collections started by the allocation threshold can leave the sweep
+// to be done in steps by the following allocations, configurable by
+// gc.sweep_step().  Marking is still done in one go.  Also records pause
+// times, returned by gc.pause_info().  Requires mp_hal_ticks_us().
+#ifndef MICROPY_GC_LAZY_SWEEP
+#define MICROPY_GC_LAZY_SWEEP (0)
+#endif
+
 // Number of bytes to allocate initially when creating new chunks to store
 // interned string data.  Smaller numbers lead to more chunks being needed
 // and more wastage at the end of the chunk.  Larger numbers lead to wasted
@@ -299,6 +320,21 @@
 #endif
 #endif
 
+// Whether to keep a hash index over the dynamically allocated qstr pools, so
+// that looking up a string does not scan every interned name linearly
+#ifndef MICROPY_QSTR_HASH_INDEX
+#define MICROPY_QSTR_HASH_INDEX (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
+#endif
+
+// Whether qstrs created at runtime are freed by the garbage collector once
+// nothing refers to them.  References are found conservatively while marking
+// the heap, and the ids of freed qstrs are reused.  Requires the qstr hash
+// index.  With threads that don't use the GIL, qstrs are only collected while
+// no thread started by _thread is running.
+#ifndef MICROPY_QSTR_GC
+#define MICROPY_QSTR_GC (0)
+#endif
+
 // Avoid using C stack when making Python function calls. C stack still
 // may be used if there's no free heap.
 #ifndef MICROPY_STACKLESS
@@ -342,6 +378,13 @@
 #define MICROPY_PERSISTENT_CODE_SAVE_FILE (0)
 #endif
 
+// Whether imported source files go through a port-provided cache of compiled
+// code (see mp_raw_code_cache_load/mp_raw_code_cache_store) so that they are
+// only recompiled when they change. Requires both load and save support.
+#ifndef MICROPY_PERSISTENT_CODE_CACHE
+#define MICROPY_PERSISTENT_CODE_CACHE (0)
+#endif
+
 // Whether to support converting functions to persistent code (bytes)
 #ifndef MICROPY_PERSISTENT_CODE_SAVE_FUN
 #define MICROPY_PERSISTENT_CODE_SAVE_FUN (MICROPY_PY_MARSHAL)
@@ -421,8 +464,13 @@
 #define MICROPY_EMIT_INLINE_RV32 (0)
 #endif
 
+// Whether to emit SuperH SH-4 native code
+#ifndef MICROPY_EMIT_SH
+#define MICROPY_EMIT_SH (0)
+#endif
+
 // Convenience definition for whether any native emitter is enabled
-#define MICROPY_EMIT_NATIVE (MICROPY_EMIT_X64 || MICROPY_EMIT_X86 || MICROPY_EMIT_THUMB || MICROPY_EMIT_ARM || MICROPY_EMIT_XTENSA || MICROPY_EMIT_XTENSAWIN || MICROPY_EMIT_RV32 || MICROPY_EMIT_NATIVE_DEBUG)
+#define MICROPY_EMIT_NATIVE (MICROPY_EMIT_X64 || MICROPY_EMIT_X86 || MICROPY_EMIT_THUMB || MICROPY_EMIT_ARM || MICROPY_EMIT_XTENSA || MICROPY_EMIT_XTENSAWIN || MICROPY_EMIT_RV32 || MICROPY_EMIT_SH || MICROPY_EMIT_NATIVE_DEBUG)
 
 // Some architectures cannot read byte-wise from executable memory.  In this case
 // the prelude for a native function (which usually sits after the machine code)
@@ -498,6 +546,35 @@
 #define MICROPY_COMP_RETURN_IF_EXPR (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
 #endif
 
+// Whether the bytecode emitter fuses common sequences of opcodes, such as a
+// load of a local followed by a load of one of its attributes, into single
+// superinstructions.  The VM always executes them, whatever this setting.
+#ifndef MICROPY_COMP_SUPERINSTRUCTIONS
+#define MICROPY_COMP_SUPERINSTRUCTIONS (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_CORE_FEATURES)
+#endif
+
+// Whether to compile str.format() calls on a string literal, which is what
+// f-strings become, into opcodes that format each argument in turn and join
+// the pieces, instead of parsing the format string at runtime
+#ifndef MICROPY_COMP_STR_FORMAT
+#define MICROPY_COMP_STR_FORMAT (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_CORE_FEATURES)
+#endif
+
+// Whether to compile the binary ops of arithmetic expressions whose operands
+// or result are intermediate values of the expression into an opcode that
+// says so, letting the VM reuse such float objects once they are consumed.
+// The VM always executes this opcode, whatever this setting.
+#ifndef MICROPY_COMP_BINARY_OP_TEMP
+#define MICROPY_COMP_BINARY_OP_TEMP (MICROPY_OPT_FLOAT_POOL)
+#endif
+
+// Whether to optimise control flow in bytecode compiled at an optimisation
+// level of 1 or more: jumps to an unconditional jump go straight to its
+// destination, and code that can't be reached is not emitted
+#ifndef MICROPY_COMP_CONTROL_FLOW_OPT
+#define MICROPY_COMP_CONTROL_FLOW_OPT (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
+#endif
+
 /*****************************************************************************/
 /* Internal debugging stuff                                                  */
 
@@ -575,12 +652,99 @@
 #define MICROPY_OPT_MAP_LOOKUP_CACHE_SIZE (128)
 #endif
 
+// Store the attributes of instances of classes as an array of values, indexed
+// through a "shape" that lists their names and is shared by the instances which
+// had the same attributes added in the same order.  Saves a hash table per
+// instance and makes attribute loads a short linear search.  Instances fall
+// back to a map if an attribute is deleted or there are too many shapes.
+#ifndef MICROPY_OPT_INSTANCE_SHAPES
+#define MICROPY_OPT_INSTANCE_SHAPES (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_CORE_FEATURES)
+#endif
+
+// Use extra RAM to cache where attributes and special methods are found when
+// looking them up in a class, which otherwise searches the dict of the class
+// and then of each of its bases in turn.  Entries are invalidated when a type
+// is created, when a class has an attribute stored or deleted (directly or
+// through its locals dict) and at the start of each garbage collection.
+#ifndef MICROPY_OPT_CLASS_LOOKUP_CACHE
+#define MICROPY_OPT_CLASS_LOOKUP_CACHE (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
+#endif
+
+// Number of entries in the class lookup cache (a power of 2).
+#ifndef MICROPY_OPT_CLASS_LOOKUP_CACHE_SIZE
+#define MICROPY_OPT_CLASS_LOOKUP_CACHE_SIZE (64)
+#endif
+
+// Give each bytecode function object a small table, allocated when it first
+// runs, that remembers where its LOAD_ATTR, STORE_ATTR, LOAD_METHOD and
+// LOAD_GLOBAL opcodes last found their attribute or global, so repeated runs
+// of the same opcode on the same kind of object skip the lookup.
+#ifndef MICROPY_OPT_INLINE_CACHE
+#define MICROPY_OPT_INLINE_CACHE (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
+#endif
+
+// Maximum number of entries in the inline cache of a function (a power of 2).
+#ifndef MICROPY_OPT_INLINE_CACHE_MAX_ENTRIES
+#define MICROPY_OPT_INLINE_CACHE_MAX_ENTRIES (256)
+#endif
+
+// Whether to set up the frame of a bytecode function with a short path when
+// the call passes exactly its positional args and it has no closed over
+// variables, skipping the generic default and keyword argument handling.
+#ifndef MICROPY_OPT_FAST_CALL_SETUP
+#define MICROPY_OPT_FAST_CALL_SETUP (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_CORE_FEATURES)
+#endif
+
+// Whether to keep the heap-allocated frames of returning bytecode functions
+// in a small per-thread cache and reuse them for the next calls, instead of
+// freeing them and allocating new ones from the GC heap.
+#ifndef MICROPY_OPT_FRAME_CACHE
+#define MICROPY_OPT_FRAME_CACHE (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES && !MICROPY_ENABLE_PYSTACK)
+#endif
+
+// Maximum number of frames kept in the per-thread frame cache.
+#ifndef MICROPY_OPT_FRAME_CACHE_DEPTH
+#define MICROPY_OPT_FRAME_CACHE_DEPTH (8)
+#endif
+
 // Whether to use fast versions of bitwise operations (and, or, xor) when the
 // arguments are both positive.  Increases Thumb2 code size by about 250 bytes.
 #ifndef MICROPY_OPT_MPZ_BITWISE
 #define MICROPY_OPT_MPZ_BITWISE (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
 #endif
 
+// Whether to multiply big integers with Karatsuba's method, which is faster
+// than the plain method when both have many digits.  It needs scratch memory
+// of about 6 times the digits of the smaller integer, and falls back to the
+// plain method if that can't be allocated.
+#ifndef MICROPY_OPT_MPZ_KARATSUBA
+#define MICROPY_OPT_MPZ_KARATSUBA (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_CORE_FEATURES)
+#endif
+
+// Number of digits of the smaller integer from which Karatsuba's method is used.
+#ifndef MICROPY_OPT_MPZ_KARATSUBA_THRESHOLD
+#define MICROPY_OPT_MPZ_KARATSUBA_THRESHOLD (32)
+#endif
+
+// Whether to convert big integers to and from strings by splitting them in
+// two with powers of the base, which is much faster than the plain method of
+// one division or multiplication by the base per character for long strings.
+#ifndef MICROPY_OPT_MPZ_FAST_STR
+#define MICROPY_OPT_MPZ_FAST_STR (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_CORE_FEATURES)
+#endif
+
+// Number of digits of an integer from which it is split to make a string.
+#ifndef MICROPY_OPT_MPZ_TO_STR_THRESHOLD
+#define MICROPY_OPT_MPZ_TO_STR_THRESHOLD (32)
+#endif
+
+// Number of digits' worth of characters from which a string is split to make
+// an integer.  This is higher because joining the parts multiplies them, which
+// is only cheaper than the plain method when Karatsuba's method is used.
+#ifndef MICROPY_OPT_MPZ_FROM_STR_THRESHOLD
+#define MICROPY_OPT_MPZ_FROM_STR_THRESHOLD (128)
+#endif
+
 
 // Whether math.factorial is large, fast and recursive (1) or small and slow (0).
 #ifndef MICROPY_OPT_MATH_FACTORIAL
@@ -596,6 +760,13 @@
 #define MICROPY_NLR_THUMB_USE_LONG_JUMP (0)
 #endif
 
+// Use the hand-written SuperH nlr_push/nlr_jump in nlrsh.c instead of the
+// setjmp implementation on SuperH.  It is opt-in until it has passed the test
+// suite on qemu-sh4 or hardware.
+#ifndef MICROPY_NLR_SH
+#define MICROPY_NLR_SH (0)
+#endif
+
 // Whether to enable import of external modules
 // When disabled, only importing of built-in modules is supported
 // When enabled, a port must implement mp_import_stat (among other things)
@@ -655,6 +826,13 @@
 #define MICROPY_GC_SPLIT_HEAP_AUTO (0)
 #endif
 
+// Number of areas of a split heap kept sorted by address, so that finding the
+// area of a pointer is a binary search instead of a walk over all the areas.
+// Heaps with more areas than this fall back to the walk.  Set to 0 to disable.
+#ifndef MICROPY_GC_SPLIT_HEAP_INDEX
+#define MICROPY_GC_SPLIT_HEAP_INDEX (0)
+#endif
+
 // Hook to run code during time consuming garbage collector operations
 // *i* is the loop index variable (e.g. can be used to run every x loops)
 #ifndef MICROPY_GC_HOOK_LOOP
@@ -866,6 +1044,19 @@ typedef double mp_float_t;
 #define MICROPY_FLOAT_HIGH_QUALITY_HASH (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EVERYTHING)
 #endif
 
+// Whether to keep float and complex objects that the VM knows are no longer
+// referenced, such as intermediate results of an arithmetic expression, in a
+// small per-thread pool and reuse them for new objects instead of allocating
+// from the GC heap.  Only applies when floats are stored on the heap.
+#ifndef MICROPY_OPT_FLOAT_POOL
+#define MICROPY_OPT_FLOAT_POOL (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_CORE_FEATURES && MICROPY_PY_BUILTINS_FLOAT && (MICROPY_OBJ_REPR == MICROPY_OBJ_REPR_A || MICROPY_OBJ_REPR == MICROPY_OBJ_REPR_B))
+#endif
+
+// Maximum number of float objects, and of complex objects, in the pool.
+#ifndef MICROPY_OPT_FLOAT_POOL_DEPTH
+#define MICROPY_OPT_FLOAT_POOL_DEPTH (4)
+#endif
+
 // Enable features which improve CPython compatibility
 // but may lead to more code size/memory usage.
 // TODO: Originally intended as generic category to not
@@ -1114,6 +1305,17 @@ typedef double mp_float_t;
 #define MICROPY_PY_BUILTINS_STR_UNICODE_CHECK (MICROPY_PY_BUILTINS_STR_UNICODE)
 #endif
 
+// Whether to keep a sparse character index of recently indexed long str
+// objects, so that indexing and slicing them doesn't walk from either end
+#ifndef MICROPY_PY_BUILTINS_STR_UNICODE_INDEX
+#define MICROPY_PY_BUILTINS_STR_UNICODE_INDEX (MICROPY_PY_BUILTINS_STR_UNICODE)
+#endif
+
+// Number of recently indexed strings whose character index is kept
+#ifndef MICROPY_PY_BUILTINS_STR_UNICODE_INDEX_CACHE
+#define MICROPY_PY_BUILTINS_STR_UNICODE_INDEX_CACHE (2)
+#endif
+
 // Whether str.center() method provided
 #ifndef MICROPY_PY_BUILTINS_STR_CENTER
 #define MICROPY_PY_BUILTINS_STR_CENTER (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
@@ -1276,6 +1478,19 @@ typedef double mp_float_t;
 #define MICROPY_PY_BUILTINS_REVERSED (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_CORE_FEATURES)
 #endif
 
+// Whether list.sort() and sorted() use a stable merge sort, which calls the key
+// function once per item, rather than an unstable quicksort which needs no
+// extra memory
+#ifndef MICROPY_PY_BUILTINS_LIST_SORT_STABLE
+#define MICROPY_PY_BUILTINS_LIST_SORT_STABLE (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_CORE_FEATURES)
+#endif
+
+// Maximum number of items in the scratch buffer of the stable sort; merges of
+// longer runs are done in place, which is slower
+#ifndef MICROPY_PY_BUILTINS_LIST_SORT_MERGE_MAX
+#define MICROPY_PY_BUILTINS_LIST_SORT_MERGE_MAX ((size_t)-1)
+#endif
+
 // Whether to define "NotImplemented" special constant
 #ifndef MICROPY_PY_BUILTINS_NOTIMPLEMENTED
 #define MICROPY_PY_BUILTINS_NOTIMPLEMENTED (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
@@ -1333,6 +1548,19 @@ typedef double mp_float_t;
 #define MICROPY_PY_MICROPYTHON_HEAP_LOCKED (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EVERYTHING)
 #endif
 
+// Whether to provide "micropython.heap_profile" function, which reports heap
+// usage by allocation site (source line).  The value is the number of sites
+// tracked, at most 256.  Costs one byte of heap per GC block.
+#ifndef MICROPY_PY_MICROPYTHON_HEAP_PROFILE
+#define MICROPY_PY_MICROPYTHON_HEAP_PROFILE (0)
+#endif
+
+// Whether to count the hits and misses of the inline caches of functions and
+// provide "micropython.inline_cache_stats" to report them.
+#ifndef MICROPY_PY_MICROPYTHON_INLINE_CACHE_STATS
+#define MICROPY_PY_MICROPYTHON_INLINE_CACHE_STATS (0)
+#endif
+
 // Support for micropython.RingIO()
 #ifndef MICROPY_PY_MICROPYTHON_RINGIO
 #define MICROPY_PY_MICROPYTHON_RINGIO (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
@@ -77,6 +77,19 @@ typedef struct _mp_sched_item_t {
     mp_obj_t arg;
 } mp_sched_item_t;
 
+#if MICROPY_OPT_CLASS_LOOKUP_CACHE
+// An entry of the class lookup cache, see mp_obj_class_lookup.  found_type is
+// NULL if the attribute was not found.
+typedef struct _mp_class_lookup_cache_entry_t {
+    size_t version;
+    const mp_obj_type_t *type;
+    qstr attr;
+    size_t slot_offset;
+    const mp_obj_type_t *found_type;
+    mp_obj_t value;
+} mp_class_lookup_cache_entry_t;
+#endif
+
 // gc_lock_depth field is a combination of the GC_COLLECT_FLAG
 // bit and a lock depth shifted GC_LOCK_DEPTH_SHIFT bits left.
 #if MICROPY_ENABLE_FINALISER
@@ -89,6 +102,11 @@ typedef struct _mp_sched_item_t {
 #define GC_LOCK_DEPTH_SHIFT 0
 #endif
 
+#if MICROPY_GC_FREE_LISTS
+// Free runs of up to this many blocks are cached per size class by the sweep.
+#define MP_GC_FREE_LIST_CLASSES (8)
+#endif
+
 // This structure holds information about a single contiguous area of
 // memory reserved for the memory manager.
 typedef struct _mp_state_mem_area_t {
@@ -101,13 +119,51 @@ typedef struct _mp_state_mem_area_t {
     #if MICROPY_ENABLE_FINALISER
     byte *gc_finaliser_table_start;
     #endif
+    #if MICROPY_PY_MICROPYTHON_HEAP_PROFILE
+    byte *gc_site_table_start; // Allocation site of each head block
+    #endif
     byte *gc_pool_start;
     byte *gc_pool_end;
 
     size_t gc_last_free_atb_index;
     size_t gc_last_used_block; // The block ID of the highest block allocated in the area
+
+    #if MICROPY_GC_LAZY_SWEEP
+    size_t gc_sweep_block; // Next block for a lazy sweep, or SIZE_MAX once swept
+    #endif
+
+    #if MICROPY_GC_FREE_LISTS
+    // Start blocks of free runs found by the last sweep, indexed by run length
+    // minus one.  Entries are hints: they are checked against the ATB on use.
+    uint16_t gc_free_list_len[MP_GC_FREE_LIST_CLASSES];
+    size_t gc_free_list[MP_GC_FREE_LIST_CLASSES][MICROPY_GC_FREE_LISTS];
+    #endif
 } mp_state_mem_area_t;
 
+#if MICROPY_PY_MICROPYTHON_HEAP_PROFILE
+// An allocation site of the heap profiler.  Site 0 gathers the allocations
+// made outside bytecode, or once all the other sites are taken.
+typedef struct _mp_heap_profile_site_t {
+    qstr source_file; // MP_QSTRnull if the site is unused
+    qstr block_name;
+    size_t line;
+    size_t alloc_bytes;
+    size_t alloc_count;
+} mp_heap_profile_site_t;
+#endif
+
+// State carried from one part of a heap sweep to the next.
+typedef struct _mp_state_mem_sweep_t {
+    #if MICROPY_GC_LAZY_SWEEP
+    mp_state_mem_area_t *area; // Area being swept lazily, or NULL if none
+    #endif
+    size_t last_used_block; // Highest block still in use, or SIZE_MAX if none
+    int free_tail;
+    #if MICROPY_GC_FREE_LISTS
+    size_t n_run;
+    #endif
+} mp_state_mem_sweep_t;
+
 // This structure hold information about the memory allocation system.
 typedef struct _mp_state_mem_t {
     #if MICROPY_MEM_STATS
@@ -137,6 +193,34 @@ typedef struct _mp_state_mem_t {
 
     #if MICROPY_GC_SPLIT_HEAP
     mp_state_mem_area_t *gc_last_free_area;
+    // Lowest start and highest end of all the pools
+    byte *gc_pools_start;
+    byte *gc_pools_end;
+    #if MICROPY_GC_SPLIT_HEAP_INDEX
+    // The areas sorted by address, with gc_area_index_len set to SIZE_MAX if
+    // there are too many of them
+    size_t gc_area_index_len;
+    mp_state_mem_area_t *gc_area_index[MICROPY_GC_SPLIT_HEAP_INDEX];
+    #endif
+    #endif
+
+    #if MICROPY_PY_MICROPYTHON_HEAP_PROFILE
+    mp_heap_profile_site_t gc_profile_sites[MICROPY_PY_MICROPYTHON_HEAP_PROFILE];
+    #endif
+
+    #if MICROPY_GC_LAZY_SWEEP
+    // Blocks swept by each allocation after a collection started by gc_alloc,
+    // or 0 to sweep the whole heap within the collection.
+    size_t gc_sweep_step;
+    bool gc_sweep_lazy;
+    mp_state_mem_sweep_t gc_sweep;
+    // Pause times of the collections and of the sweep steps, in microseconds
+    mp_uint_t gc_pause_start;
+    size_t gc_pause_count;
+    mp_uint_t gc_pause_last;
+    mp_uint_t gc_pause_max;
+    size_t gc_sweep_step_count;
+    mp_uint_t gc_sweep_step_max;
     #endif
 
     #if MICROPY_PY_GC_COLLECT_RETVAL
@@ -151,6 +235,15 @@ typedef struct _mp_state_mem_t {
 
 // This structure hold runtime and VM information.  It includes a section
 // which contains root pointers that must be scanned by the GC.
+#if MICROPY_PY_BUILTINS_STR_UNICODE_INDEX
+// A long str that missed the character index cache, see objstrunicode.c.
+typedef struct _mp_str_index_miss_t {
+    const byte *data;
+    size_t len;
+    size_t count;
+} mp_str_index_miss_t;
+#endif
+
 typedef struct _mp_state_vm_t {
     //
     // CONTINUE ROOT POINTER SECTION
@@ -161,6 +254,11 @@ typedef struct _mp_state_vm_t {
 
     qstr_pool_t *last_pool;
 
+    #if MICROPY_QSTR_HASH_INDEX
+    // hash index over the dynamic qstr pools, NULL if not allocated
+    qstr_index_t *qstr_index;
+    #endif
+
     #if MICROPY_TRACKED_ALLOC
     struct _m_tracked_node_t *m_tracked_head;
     #endif
@@ -217,6 +315,24 @@ typedef struct _mp_state_vm_t {
     size_t qstr_last_alloc;
     size_t qstr_last_used;
 
+    #if MICROPY_QSTR_GC
+    // marks of the dynamic qstrs, for ids first..first+len-1, while the
+    // collector is looking for references to them (len is 0 otherwise)
+    byte *qstr_gc_marks;
+    size_t qstr_gc_first;
+    size_t qstr_gc_len;
+    // list of freed qstr ids, linked through their pool entries
+    qstr qstr_free;
+    // number of qstrs added since the last time qstrs were collected
+    size_t qstr_gc_added;
+    // total size of the string data of freed qstrs
+    size_t qstr_reclaimed_bytes;
+    #if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
+    // number of threads started by _thread that have not finished
+    size_t qstr_gc_threads;
+    #endif
+    #endif
+
     #if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
     // This is a global mutex used to make qstr interning thread-safe.
     mp_thread_mutex_t qstr_mutex;
@@ -229,6 +345,12 @@ typedef struct _mp_state_vm_t {
     #endif
     #endif
 
+    #if MICROPY_PY_BUILTINS_STR_UNICODE_INDEX
+    // strings that recently missed the str index cache, most recent first;
+    // not a root pointer, so the string data may be freed meanwhile
+    mp_str_index_miss_t str_index_miss[MICROPY_PY_BUILTINS_STR_UNICODE_INDEX_CACHE];
+    #endif
+
     // size of the emergency exception buf, if it's dynamically allocated
     #if MICROPY_ENABLE_EMERGENCY_EXCEPTION_BUF && MICROPY_EMERGENCY_EXCEPTION_BUF_SIZE == 0
     mp_int_t mp_emergency_exception_buf_size;
@@ -264,6 +386,23 @@ typedef struct _mp_state_vm_t {
     // See mp_map_lookup.
     uint8_t map_lookup_cache[MICROPY_OPT_MAP_LOOKUP_CACHE_SIZE];
     #endif
+
+    #if MICROPY_OPT_CLASS_LOOKUP_CACHE
+    // See mp_obj_class_lookup.  The entries may refer to freed objects, so
+    // they must not be traced by the GC.
+    size_t class_lookup_version;
+    mp_class_lookup_cache_entry_t class_lookup_cache[MICROPY_OPT_CLASS_LOOKUP_CACHE_SIZE];
+    #endif
+
+    #if MICROPY_OPT_INLINE_CACHE
+    // Incremented whenever a key is added to any map, stopping at SIZE_MAX.
+    // The inline caches use it to know that a global is still not defined.
+    size_t map_keys_added;
+    #if MICROPY_PY_MICROPYTHON_INLINE_CACHE_STATS
+    size_t inline_cache_hits;
+    size_t inline_cache_misses;
+    #endif
+    #endif
 } mp_state_vm_t;
 
 // This structure holds state that is specific to a given thread. Everything
@@ -288,6 +427,17 @@ typedef struct _mp_state_thread_t {
     // See GC_LOCK_DEPTH_SHIFT for an explanation of this field.
     uint16_t gc_lock_depth;
 
+    #if MICROPY_OPT_FRAME_CACHE
+    // Number of frames in frame_cache, and the size of their state in bytes.
+    size_t frame_cache_len;
+    size_t frame_cache_size[MICROPY_OPT_FRAME_CACHE_DEPTH];
+    #endif
+
+    #if MICROPY_OPT_FLOAT_POOL
+    // Number of float objects, then of complex objects, in float_pool.
+    uint8_t float_pool_len[1 + MICROPY_PY_BUILTINS_COMPLEX];
+    #endif
+
     ////////////////////////////////////////////////////////////
     // START ROOT POINTER SECTION
     // Everything that needs GC scanning must start here, and
@@ -309,12 +459,24 @@ typedef struct _mp_state_thread_t {
     #if MICROPY_PY_SYS_SETTRACE
     mp_obj_t prof_trace_callback;
     bool prof_callback_is_executing;
+    #endif
+    #if MICROPY_PY_SYS_SETTRACE || MICROPY_PY_MICROPYTHON_HEAP_PROFILE
     struct _mp_code_state_t *current_code_state;
     #endif
 
     #if MICROPY_PY_SSL_MBEDTLS_NEED_ACTIVE_CONTEXT
     struct _mp_obj_ssl_context_t *tls_ssl_context;
     #endif
+
+    #if MICROPY_OPT_FRAME_CACHE
+    // Heap-allocated frames of returned bytecode functions, kept for reuse.
+    struct _mp_code_state_t *frame_cache[MICROPY_OPT_FRAME_CACHE_DEPTH];
+    #endif
+
+    #if MICROPY_OPT_FLOAT_POOL
+    // Float objects, then complex objects, that are no longer used, kept for reuse.
+    mp_obj_t float_pool[1 + MICROPY_PY_BUILTINS_COMPLEX][MICROPY_OPT_FLOAT_POOL_DEPTH];
+    #endif
 } mp_state_thread_t;
 
 // This structure combines the above 3 structures.
@@ -432,7 +432,7 @@ static size_t mpn_mul_dig_add_dig(mpz_dig_t *idig, size_t ilen, mpz_dig_t dmul,
    assumes enough memory in i; assumes i is zeroed; assumes normalised j, k
    can have j, k point to same memory
 */
-static size_t mpn_mul(mpz_dig_t *idig, mpz_dig_t *jdig, size_t jlen, mpz_dig_t *kdig, size_t klen) {
+static size_t mpn_mul(mpz_dig_t *idig, const mpz_dig_t *jdig, size_t jlen, const mpz_dig_t *kdig, size_t klen) {
     mpz_dig_t *oidig = idig;
     size_t ilen = 0;
 
@@ -441,7 +441,7 @@ static size_t mpn_mul(mpz_dig_t *idig, mpz_dig_t *jdig, size_t jlen, mpz_dig_t *
         mpz_dbl_dig_t carry = 0;
 
         size_t jl = jlen;
-        for (mpz_dig_t *jd = jdig; jl > 0; --jl, ++jd, ++id) {
+        for (const mpz_dig_t *jd = jdig; jl > 0; --jl, ++jd, ++id) {
             carry += (mpz_dbl_dig_t)*id + (mpz_dbl_dig_t)*jd * (mpz_dbl_dig_t)*kdig; // will never overflow so long as DIG_SIZE <= 8*sizeof(mpz_dbl_dig_t)/2
             *id = carry & DIG_MASK;
             carry >>= DIG_SIZE;
@@ -457,6 +457,112 @@ static size_t mpn_mul(mpz_dig_t *idig, mpz_dig_t *jdig, size_t jlen, mpz_dig_t *
     return ilen;
 }
 
+#if MICROPY_OPT_MPZ_KARATSUBA
+
+/* returns number of digits of scratch memory needed by mpn_mul_kara for n digits
+*/
+static size_t mpn_mul_kara_scratch(size_t n) {
+    size_t s = 0;
+    while (n >= MICROPY_OPT_MPZ_KARATSUBA_THRESHOLD) {
+        n = n - n / 2 + 1;
+        s += 4 * n;
+    }
+    return s;
+}
+
+/* computes i = j * k using Karatsuba's method
+   writes exactly 2 * n digits of i; j, k have n digits each and need not be normalised
+   assumes enough memory in scratch, see mpn_mul_kara_scratch
+   can have j, k point to same memory
+*/
+static void mpn_mul_kara(mpz_dig_t *idig, const mpz_dig_t *jdig, const mpz_dig_t *kdig, size_t n, mpz_dig_t *scratch) {
+    if (n < MICROPY_OPT_MPZ_KARATSUBA_THRESHOLD) {
+        memset(idig, 0, 2 * n * sizeof(mpz_dig_t));
+        mpn_mul(idig, jdig, n, kdig, n);
+        return;
+    }
+
+    // split j = j1 * B^h + j0 and k = k1 * B^h + k0, with m >= h digits in the high halves
+    size_t h = n / 2;
+    size_t m = n - h;
+
+    // z0 = j0 * k0 goes in the low 2h digits of i and z2 = j1 * k1 in the high 2m digits
+    mpn_mul_kara(idig, jdig, kdig, h, scratch);
+    mpn_mul_kara(idig + 2 * h, jdig + h, kdig + h, m, scratch);
+
+    // z1 = (j0 + j1) * (k0 + k1) - z0 - z2, each sum with m + 1 digits
+    mpz_dig_t *jsum = scratch;
+    mpz_dig_t *ksum = jsum + m + 1;
+    mpz_dig_t *z1 = ksum + m + 1;
+    jsum[m] = 0;
+    ksum[m] = 0;
+    mpn_add(jsum, jdig + h, m, jdig, h);
+    mpn_add(ksum, kdig + h, m, kdig, h);
+    mpn_mul_kara(z1, jsum, ksum, m + 1, z1 + 2 * (m + 1));
+    mpn_sub(z1, z1, 2 * (m + 1), idig, 2 * h);
+    size_t z1len = mpn_sub(z1, z1, 2 * (m + 1), idig + 2 * h, 2 * m);
+
+    // i += z1 * B^h, which can't carry out of the 2n digits of i
+    mpn_add(idig + h, idig + h, 2 * n - h, z1, z1len);
+}
+
+/* returns number of digits of scratch memory needed by mpn_mul_big for jlen, klen digits
+*/
+static size_t mpn_mul_big_scratch(size_t jlen, size_t klen) {
+    if (klen < MICROPY_OPT_MPZ_KARATSUBA_THRESHOLD) {
+        return 0;
+    }
+    size_t s = 0;
+    if (jlen >= klen) {
+        s = 2 * klen + mpn_mul_kara_scratch(klen);
+    }
+    size_t part = jlen % klen;
+    if (part != 0) {
+        size_t s2 = klen + part + mpn_mul_big_scratch(klen, part);
+        if (s2 > s) {
+            s = s2;
+        }
+    }
+    return s;
+}
+
+/* computes i = j * k, using Karatsuba's method on klen sized pieces of j
+   returns number of digits in i
+   assumes enough memory in i; assumes i is zeroed; assumes normalised j, k; assumes jlen >= klen
+   assumes enough memory in scratch, see mpn_mul_big_scratch
+   can have j, k point to same memory
+*/
+static size_t mpn_mul_big(mpz_dig_t *idig, const mpz_dig_t *jdig, size_t jlen, const mpz_dig_t *kdig, size_t klen, mpz_dig_t *scratch) {
+    if (klen < MICROPY_OPT_MPZ_KARATSUBA_THRESHOLD) {
+        return mpn_mul(idig, jdig, jlen, kdig, klen);
+    }
+
+    for (size_t off = 0; off < jlen; off += klen) {
+        size_t part = jlen - off;
+        if (part >= klen) {
+            part = klen;
+            mpn_mul_kara(scratch, jdig + off, kdig, klen, scratch + 2 * klen);
+        } else {
+            memset(scratch, 0, (klen + part) * sizeof(mpz_dig_t));
+            mpn_mul_big(scratch, kdig, klen, jdig + off, part, scratch + klen + part);
+        }
+        // the digits of i above off + klen are still zero, so the carry stops within them
+        size_t plen = klen + part;
+        while (plen > 0 && scratch[plen - 1] == 0) {
+            --plen;
+        }
+        mpn_add(idig + off, idig + off, klen + part, scratch, plen);
+    }
+
+    size_t ilen = jlen + klen;
+    while (ilen > 0 && idig[ilen - 1] == 0) {
+        --ilen;
+    }
+    return ilen;
+}
+
+#endif
+
 /* natural_div - quo * den + new_num = old_num (ie num is replaced with rem)
    assumes den != 0
    assumes num_dig has enough memory to be extended by 1 digit
@@ -813,6 +919,178 @@ void mpz_set_from_float(mpz_t *z, mp_float_t src) {
 }
 #endif
 
+#if MICROPY_OPT_MPZ_FAST_STR
+
+// Maximum number of powers kept by mpz_str_pow_t.  Bigger integers are still
+// converted, by splitting them into less even parts.
+#define MPZ_STR_POW_NUM (20)
+
+// Powers of the base used to split big integers when converting them to and
+// from strings.  Each piece of chars characters is a number smaller than
+// base_pow, which fits in a digit, and pow[n] is base_pow ** (2 ** n).
+typedef struct _mpz_str_pow_t {
+    unsigned int base;
+    mpz_dig_t base_pow;
+    size_t chars;
+    size_t num;
+    mpz_t pow[MPZ_STR_POW_NUM];
+} mpz_str_pow_t;
+
+static void mpz_str_pow_init(mpz_str_pow_t *p, unsigned int base) {
+    mpz_dbl_dig_t base_pow = base;
+    p->base = base;
+    p->chars = 1;
+    while (base_pow * base <= DIG_MASK) {
+        base_pow *= base;
+        p->chars += 1;
+    }
+    p->base_pow = base_pow;
+    p->num = 0;
+}
+
+static void mpz_str_pow_deinit(mpz_str_pow_t *p) {
+    for (size_t n = 0; n < p->num; ++n) {
+        mpz_deinit(&p->pow[n]);
+    }
+}
+
+static const mpz_t *mpz_str_pow_get(mpz_str_pow_t *p, size_t n) {
+    for (; p->num <= n; ++p->num) {
+        mpz_t *z = &p->pow[p->num];
+        if (p->num == 0) {
+            mpz_init_from_int(z, p->base_pow);
+        } else {
+            mpz_init_zero(z);
+            mpz_mul_inpl(z, &p->pow[p->num - 1], &p->pow[p->num - 1]);
+        }
+    }
+    return &p->pow[n];
+}
+
+/* sets z to the value of the n characters at str, which must all be digits of the base
+   a piece of p->chars characters at a time
+*/
+static void mpz_str_parse_pieces(mpz_t *z, const char *str, size_t n, const mpz_str_pow_t *p) {
+    mpz_need_dig(z, n / p->chars + 1);
+    z->neg = 0;
+    z->len = 0;
+
+    // the first piece has the left over characters
+    size_t piece = n % p->chars;
+    if (piece == 0) {
+        piece = p->chars;
+    }
+    for (const char *top = str + n; str < top; piece = p->chars) {
+        mpz_dig_t mul = 1;
+        mpz_dig_t val = 0;
+        for (; piece > 0; --piece, ++str) {
+            mp_uint_t v = *str;
+            if (v <= '9') {
+                v -= '0';
+            } else {
+                v = (v | 0x20) - ('a' - 10);
+            }
+            mul *= p->base;
+            val = val * p->base + v;
+        }
+        z->len = mpn_mul_dig_add_dig(z->dig, z->len, mul, val);
+    }
+}
+
+/* sets z to the value of the n characters at str, which must all be digits of the base
+   splits the characters in two and joins the values with a power of the base
+*/
+static void mpz_str_parse(mpz_t *z, const char *str, size_t n, mpz_str_pow_t *p) {
+    if (n < MICROPY_OPT_MPZ_FROM_STR_THRESHOLD * p->chars) {
+        mpz_str_parse_pieces(z, str, n, p);
+        return;
+    }
+
+    // the low part has p->chars << k characters, at least half of them
+    size_t k = 0;
+    while (k + 1 < MPZ_STR_POW_NUM && (p->chars << (k + 1)) < n) {
+        ++k;
+    }
+    size_t low = p->chars << k;
+
+    mpz_t high;
+    mpz_init_zero(&high);
+    mpz_str_parse(&high, str, n - low, p);
+    mpz_str_parse(z, str + n - low, low, p);
+    mpz_mul_inpl(&high, &high, mpz_str_pow_get(p, k));
+    mpz_add_inpl(z, z, &high);
+    mpz_deinit(&high);
+}
+
+static char mpz_str_char(mpz_dbl_dig_t a, char base_char) {
+    a += '0';
+    if (a > '9') {
+        a += base_char - '9' - 1;
+    }
+    return a;
+}
+
+/* writes the characters of the len digits at dig, least significant first, padded with
+   zeros to at least width characters; destroys the digits
+   divides by p->base_pow to get p->chars characters at a time
+   returns the end of the characters
+*/
+static char *mpz_str_pieces(mpz_dig_t *dig, size_t len, const mpz_str_pow_t *p, char base_char, size_t width, char *s) {
+    char *start = s;
+    while (len > 0) {
+        mpz_dbl_dig_t a = 0;
+        for (mpz_dig_t *d = dig + len; --d >= dig;) {
+            a = (a << DIG_SIZE) | *d;
+            *d = a / p->base_pow;
+            a %= p->base_pow;
+        }
+        while (len > 0 && dig[len - 1] == 0) {
+            --len;
+        }
+        // only the most significant piece can have fewer characters
+        for (size_t n = p->chars; n > 0 && (len > 0 || a != 0); --n) {
+            *s++ = mpz_str_char(a % p->base, base_char);
+            a /= p->base;
+        }
+    }
+    while ((size_t)(s - start) < width) {
+        *s++ = '0';
+    }
+    return s;
+}
+
+/* writes the characters of the len digits at dig, least significant first, padded with
+   zeros to at least width characters; destroys the digits
+   assumes dig has memory for len + 1 digits
+   divides by a power of the base with about a quarter to a half of the digits and
+   writes the remainder and the quotient separately
+   returns the end of the characters
+*/
+static char *mpz_str_split(mpz_dig_t *dig, size_t len, mpz_str_pow_t *p, char base_char, size_t width, char *s) {
+    if (len < MICROPY_OPT_MPZ_TO_STR_THRESHOLD) {
+        return mpz_str_pieces(dig, len, p, base_char, width, s);
+    }
+
+    size_t k = 0;
+    while (k + 1 < MPZ_STR_POW_NUM && mpz_str_pow_get(p, k)->len * 4 <= len) {
+        ++k;
+    }
+    const mpz_t *pow = mpz_str_pow_get(p, k);
+    size_t low = p->chars << k;
+
+    size_t quo_alloc = len - pow->len + 2;
+    mpz_dig_t *quo = m_new(mpz_dig_t, quo_alloc);
+    size_t quo_len;
+    mpn_div(dig, &len, pow->dig, pow->len, quo, &quo_len);
+    s = mpz_str_split(dig, len, p, base_char, low, s);
+    s = mpz_str_split(quo, quo_len, p, base_char, width > low ? width - low : 0, s);
+    m_del(mpz_dig_t, quo, quo_alloc);
+
+    return s;
+}
+
+#endif
+
 // returns number of bytes from str that were processed
 size_t mpz_set_from_str(mpz_t *z, const char *str, size_t len, bool neg, unsigned int base) {
     assert(base <= 36);
@@ -820,6 +1098,29 @@ size_t mpz_set_from_str(mpz_t *z, const char *str, size_t len, bool neg, unsigne
     const char *cur = str;
     const char *top = str + len;
 
+    #if MICROPY_OPT_MPZ_FAST_STR
+    for (; cur < top; ++cur) {
+        mp_uint_t v = *cur;
+        if ('0' <= v && v <= '9') {
+            v -= '0';
+        } else if ('A' <= v && v <= 'Z') {
+            v -= 'A' - 10;
+        } else if ('a' <= v && v <= 'z') {
+            v -= 'a' - 10;
+        } else {
+            break;
+        }
+        if (v >= base) {
+            break;
+        }
+    }
+
+    mpz_str_pow_t pows;
+    mpz_str_pow_init(&pows, base);
+    mpz_str_parse(z, str, cur - str, &pows);
+    mpz_str_pow_deinit(&pows);
+    z->neg = neg;
+    #else
     mpz_need_dig(z, len * 8 / DIG_SIZE + 1);
 
     if (neg) {
@@ -846,6 +1147,7 @@ size_t mpz_set_from_str(mpz_t *z, const char *str, size_t len, bool neg, unsigne
         }
         z->len = mpn_mul_dig_add_dig(z->dig, z->len, base, v);
     }
+    #endif
 
     return cur - str;
 }
@@ -1307,7 +1609,27 @@ void mpz_mul_inpl(mpz_t *dest, const mpz_t *lhs, const mpz_t *rhs) {
 
     mpz_need_dig(dest, lhs->len + rhs->len); // min mem l+r-1, max mem l+r
     memset(dest->dig, 0, dest->alloc * sizeof(mpz_dig_t));
-    dest->len = mpn_mul(dest->dig, lhs->dig, lhs->len, rhs->dig, rhs->len);
+
+    #if MICROPY_OPT_MPZ_KARATSUBA
+    if (lhs->len < rhs->len) {
+        const mpz_t *t = lhs;
+        lhs = rhs;
+        rhs = t;
+    }
+    // if there isn't enough memory for the scratch digits use the plain method
+    size_t scratch_len = mpn_mul_big_scratch(lhs->len, rhs->len);
+    mpz_dig_t *scratch = NULL;
+    if (scratch_len > 0) {
+        scratch = m_new_maybe(mpz_dig_t, scratch_len);
+    }
+    if (scratch != NULL) {
+        dest->len = mpn_mul_big(dest->dig, lhs->dig, lhs->len, rhs->dig, rhs->len, scratch);
+        m_del(mpz_dig_t, scratch, scratch_len);
+    } else
+    #endif
+    {
+        dest->len = mpn_mul(dest->dig, lhs->dig, lhs->len, rhs->dig, rhs->len);
+    }
 
     if (lhs->neg == rhs->neg) {
         dest->neg = 0;
@@ -1684,6 +2006,32 @@ size_t mpz_as_str_inpl(const mpz_t *i, unsigned int base, const char *prefix, ch
         return s - str;
     }
 
+    #if MICROPY_OPT_MPZ_FAST_STR
+    // make a copy of mpz digits, with room for mpn_div to extend them
+    mpz_dig_t *dig = m_new(mpz_dig_t, ilen + 1);
+    memcpy(dig, i->dig, ilen * sizeof(mpz_dig_t));
+
+    // convert
+    mpz_str_pow_t pows;
+    mpz_str_pow_init(&pows, base);
+    s = mpz_str_split(dig, ilen, &pows, base_char, 0, s);
+    mpz_str_pow_deinit(&pows);
+
+    // free the copy of the digits array
+    m_del(mpz_dig_t, dig, ilen + 1);
+
+    // spread out the characters to put a comma after every 3, from the end
+    if (comma) {
+        size_t n = s - str;
+        s += (n - 1) / 3;
+        for (size_t j = n; j-- > 3;) {
+            str[j + j / 3] = str[j];
+            if (j % 3 == 0) {
+                str[j + j / 3 - 1] = comma;
+            }
+        }
+    }
+    #else
     // make a copy of mpz digits, so we can do the div/mod calculation
     mpz_dig_t *dig = m_new(mpz_dig_t, ilen);
     memcpy(dig, i->dig, ilen * sizeof(mpz_dig_t));
@@ -1726,6 +2074,7 @@ size_t mpz_as_str_inpl(const mpz_t *i, unsigned int base, const char *prefix, ch
 
     // free the copy of the digits array
     m_del(mpz_dig_t, dig, ilen);
+    #endif
 
     if (prefix) {
         const char *p = &prefix[strlen(prefix)];
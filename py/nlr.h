@@ -46,6 +46,7 @@
 #define MICROPY_NLR_NUM_REGS_XTENSAWIN      (17)
 #define MICROPY_NLR_NUM_REGS_RV32I          (14)
 #define MICROPY_NLR_NUM_REGS_RV64I          (14)
+#define MICROPY_NLR_NUM_REGS_SH             (9)
 
 // *FORMAT-OFF*
 
@@ -100,6 +101,8 @@
     #else
         #error Unsupported RISC-V variant.
     #endif
+#elif defined(__sh__) && MICROPY_NLR_SH
+    #define MICROPY_NLR_NUM_REGS (MICROPY_NLR_NUM_REGS_SH)
 #else
     #define MICROPY_NLR_SETJMP (1)
     //#warning "No native NLR support for this arch, using setjmp implementation"
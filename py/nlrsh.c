@@ -0,0 +1,83 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2025 The PythonExtra contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "py/mpstate.h"
+
+#if !MICROPY_NLR_SETJMP && defined(__sh__) && MICROPY_NLR_SH
+
+// GCC doesn't support naked functions on SuperH, so nlr_push is written as a
+// top-level asm block. C symbols may have a leading underscore (sh-elf).
+#define NLR_SYMBOL_PUSH MP_STRINGIFY(__USER_LABEL_PREFIX__) "nlr_push"
+#define NLR_SYMBOL_PUSH_TAIL MP_STRINGIFY(__USER_LABEL_PREFIX__) "nlr_push_tail"
+
+__asm__ (
+    "   .text                           \n"
+    "   .align  2                       \n"
+    "   .global " NLR_SYMBOL_PUSH "     \n"
+    NLR_SYMBOL_PUSH ":                  \n"
+    "   mov.l   r8, @(8, r4)            \n" // Store r8.
+    "   mov.l   r9, @(12, r4)           \n" // Store r9.
+    "   mov.l   r10, @(16, r4)          \n" // Store r10.
+    "   mov.l   r11, @(20, r4)          \n" // Store r11.
+    "   mov.l   r12, @(24, r4)          \n" // Store r12.
+    "   mov.l   r13, @(28, r4)          \n" // Store r13.
+    "   mov.l   r14, @(32, r4)          \n" // Store r14.
+    "   mov.l   r15, @(36, r4)          \n" // Store r15 (sp).
+    "   sts     pr, r0                  \n"
+    "   mov.l   r0, @(40, r4)           \n" // Store pr.
+    "   mov.l   1f, r0                  \n"
+    "   jmp     @r0                     \n" // Do the rest in C.
+    "   nop                             \n"
+    "   .align  2                       \n"
+    "1: .long   " NLR_SYMBOL_PUSH_TAIL "\n"
+    );
+
+NORETURN void nlr_jump(void *val) {
+    MP_NLR_JUMP_HEAD(val, top)
+
+    __asm volatile (
+        "mov    %0, r4          \n" // Load nlr_buf address.
+        "mov.l  @(8, r4), r8    \n" // Retrieve r8.
+        "mov.l  @(12, r4), r9   \n" // Retrieve r9.
+        "mov.l  @(16, r4), r10  \n" // Retrieve r10.
+        "mov.l  @(20, r4), r11  \n" // Retrieve r11.
+        "mov.l  @(24, r4), r12  \n" // Retrieve r12.
+        "mov.l  @(28, r4), r13  \n" // Retrieve r13.
+        "mov.l  @(32, r4), r14  \n" // Retrieve r14.
+        "mov.l  @(36, r4), r15  \n" // Retrieve r15 (sp).
+        "mov.l  @(40, r4), r0   \n"
+        "lds    r0, pr          \n" // Retrieve pr.
+        "rts                    \n" // Return,
+        "mov    #1, r0          \n" // with 1 for a non-local return.
+        :                           // Outputs.
+        : "r" (top)                 // Inputs.
+        : "memory"                  // Clobbered.
+        );
+
+    MP_UNREACHABLE
+}
+
+#endif // MICROPY_NLR_SH
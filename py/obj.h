@@ -464,7 +464,8 @@ typedef struct _mp_map_t {
     size_t all_keys_are_qstrs : 1;
     size_t is_fixed : 1;    // if set, table is fixed/read-only and can't be modified
     size_t is_ordered : 1;  // if set, table is an ordered array, not a hash map
-    size_t used : (8 * sizeof(size_t) - 3);
+    size_t is_class_locals : 1; // if set, this is the locals of a class, see mp_obj_class_lookup_invalidate
+    size_t used : (8 * sizeof(size_t) - 4);
     size_t alloc;
     mp_map_elem_t *table;
 } mp_map_t;
@@ -1147,6 +1148,12 @@ static inline mp_int_t mp_float_hash(mp_float_t val) {
 }
 #endif
 mp_obj_t mp_obj_float_binary_op(mp_binary_op_t op, mp_float_t lhs_val, mp_obj_t rhs); // can return MP_OBJ_NULL if op not supported
+#if MICROPY_OPT_FLOAT_POOL
+#define MP_OBJ_FLOAT_POOL_FLOAT (0)
+#define MP_OBJ_FLOAT_POOL_COMPLEX (1)
+void *mp_obj_float_pool_take(size_t kind); // can return NULL if the pool is empty
+void mp_obj_float_recycle(mp_obj_t o); // o must be a float or complex that nothing refers to
+#endif
 
 // complex
 void mp_obj_complex_get(mp_obj_t self_in, mp_float_t *real, mp_float_t *imag);
@@ -161,7 +161,15 @@ MP_DEFINE_CONST_OBJ_TYPE(
     );
 
 mp_obj_t mp_obj_new_complex(mp_float_t real, mp_float_t imag) {
+    #if MICROPY_OPT_FLOAT_POOL
+    mp_obj_complex_t *o = mp_obj_float_pool_take(MP_OBJ_FLOAT_POOL_COMPLEX);
+    if (o == NULL) {
+        o = m_new_obj(mp_obj_complex_t);
+    }
+    o->base.type = &mp_type_complex;
+    #else
     mp_obj_complex_t *o = mp_obj_malloc(mp_obj_complex_t, &mp_type_complex);
+    #endif
     o->real = real;
     o->imag = imag;
     return MP_OBJ_FROM_PTR(o);
@@ -242,10 +242,17 @@ static mp_obj_t dict_subscr(mp_obj_t self_in, mp_obj_t index, mp_obj_t value) {
 /******************************************************************************/
 /* dict methods                                                               */
 
+// Called before a dict is changed.
 static void mp_ensure_not_fixed(const mp_obj_dict_t *dict) {
     if (dict->map.is_fixed) {
         mp_raise_TypeError(NULL);
     }
+    #if MICROPY_OPT_CLASS_LOOKUP_CACHE
+    if (dict->map.is_class_locals) {
+        // eg the locals() of a class body, which the class keeps using
+        mp_obj_class_lookup_invalidate();
+    }
+    #endif
 }
 
 static mp_obj_t dict_clear(mp_obj_t self_in) {
@@ -199,9 +199,58 @@ MP_DEFINE_CONST_OBJ_TYPE(
 
 #if MICROPY_OBJ_REPR != MICROPY_OBJ_REPR_C && MICROPY_OBJ_REPR != MICROPY_OBJ_REPR_D
 
+#if MICROPY_OPT_FLOAT_POOL
+
+#if MICROPY_PY_THREAD
+#define FLOAT_POOL_THREAD_STATE() (mp_thread_get_state())
+#else
+#define FLOAT_POOL_THREAD_STATE() (&mp_state_ctx.thread)
+#endif
+
+// Takes an object of the given kind from the float pool of this thread.  Its
+// type and value must be set by the caller.
+void *mp_obj_float_pool_take(size_t kind) {
+    mp_state_thread_t *ts = FLOAT_POOL_THREAD_STATE();
+    size_t len = ts->float_pool_len[kind];
+    if (len == 0) {
+        return NULL;
+    }
+    ts->float_pool_len[kind] = --len;
+    mp_obj_t o = ts->float_pool[kind][len];
+    ts->float_pool[kind][len] = MP_OBJ_NULL;
+    return MP_OBJ_TO_PTR(o);
+}
+
+// Puts a float or complex object that is no longer referenced in the float
+// pool of this thread, or leaves it to the GC if the pool is full.
+void mp_obj_float_recycle(mp_obj_t o) {
+    size_t kind = MP_OBJ_FLOAT_POOL_FLOAT;
+    #if MICROPY_PY_BUILTINS_COMPLEX
+    if (!mp_obj_is_float(o)) {
+        assert(mp_obj_is_type(o, &mp_type_complex));
+        kind = MP_OBJ_FLOAT_POOL_COMPLEX;
+    }
+    #endif
+    mp_state_thread_t *ts = FLOAT_POOL_THREAD_STATE();
+    size_t len = ts->float_pool_len[kind];
+    if (len < MICROPY_OPT_FLOAT_POOL_DEPTH) {
+        ts->float_pool[kind][len] = o;
+        ts->float_pool_len[kind] = len + 1;
+    }
+}
+
+#endif
+
 mp_obj_t mp_obj_new_float(mp_float_t value) {
+    #if MICROPY_OPT_FLOAT_POOL
+    mp_obj_float_t *o = mp_obj_float_pool_take(MP_OBJ_FLOAT_POOL_FLOAT);
+    if (o == NULL) {
+        o = m_new_obj(mp_obj_float_t);
+    }
+    #else
     // Don't use mp_obj_malloc here to avoid extra function call overhead.
     mp_obj_float_t *o = m_new_obj(mp_obj_float_t);
+    #endif
     o->base.type = &mp_type_float;
     o->value = value;
     return MP_OBJ_FROM_PTR(o);
@@ -214,6 +214,54 @@ static void dump_args(const mp_obj_t *a, size_t sz) {
             + n_exc_stack * sizeof(mp_exc_stack_t);                \
     }
 
+#if MICROPY_OPT_FRAME_CACHE
+
+#if MICROPY_PY_THREAD
+#define FRAME_CACHE_THREAD_STATE() (mp_thread_get_state())
+#else
+#define FRAME_CACHE_THREAD_STATE() (&mp_state_ctx.thread)
+#endif
+
+// Takes a frame from the frame cache of this thread that has room for
+// *state_size bytes of state, without being more than twice that size, and
+// updates *state_size to its actual size.  Returns NULL if there is none.
+static mp_code_state_t *fun_bc_frame_cache_take(size_t *state_size) {
+    mp_state_thread_t *ts = FRAME_CACHE_THREAD_STATE();
+    // Search from the most recently returned frame, which is the one most
+    // likely to fit when the same function is called again or recursively
+    for (size_t i = ts->frame_cache_len; i-- > 0;) {
+        size_t size = ts->frame_cache_size[i];
+        if (size >= *state_size && size <= 2 * *state_size) {
+            mp_code_state_t *code_state = ts->frame_cache[i];
+            size_t last = --ts->frame_cache_len;
+            ts->frame_cache[i] = ts->frame_cache[last];
+            ts->frame_cache_size[i] = ts->frame_cache_size[last];
+            ts->frame_cache[last] = NULL;
+            *state_size = size;
+            return code_state;
+        }
+    }
+    return NULL;
+}
+
+// Puts a heap-allocated frame in the frame cache of this thread, or frees it
+// if the cache is full.
+static void fun_bc_frame_cache_give(mp_code_state_t *code_state, size_t state_size) {
+    mp_state_thread_t *ts = FRAME_CACHE_THREAD_STATE();
+    size_t len = ts->frame_cache_len;
+    if (len < MICROPY_OPT_FRAME_CACHE_DEPTH) {
+        // Clear the frame so it doesn't keep the objects it refers to alive
+        memset(code_state, 0, offsetof(mp_code_state_t, state) + state_size);
+        ts->frame_cache[len] = code_state;
+        ts->frame_cache_size[len] = state_size;
+        ts->frame_cache_len = len + 1;
+    } else {
+        m_del_var(mp_code_state_t, state, byte, state_size, code_state);
+    }
+}
+
+#endif
+
 #define INIT_CODESTATE(code_state, _fun_bc, _n_state, n_args, n_kw, args) \
     code_state->fun_bc = _fun_bc; \
     code_state->n_state = _n_state; \
@@ -272,7 +320,12 @@ static mp_obj_t fun_bc_call(mp_obj_t self_in, size_t n_args, size_t n_kw, const
     code_state = mp_pystack_alloc(offsetof(mp_code_state_t, state) + state_size);
     #else
     if (state_size > VM_MAX_STATE_ON_STACK) {
-        code_state = m_new_obj_var_maybe(mp_code_state_t, state, byte, state_size);
+        #if MICROPY_OPT_FRAME_CACHE
+        code_state = fun_bc_frame_cache_take(&state_size);
+        #endif
+        if (code_state == NULL) {
+            code_state = m_new_obj_var_maybe(mp_code_state_t, state, byte, state_size);
+        }
         #if MICROPY_DEBUG_VM_STACK_OVERFLOW
         if (code_state != NULL) {
             memset(code_state->state, 0, state_size);
@@ -342,7 +395,11 @@ static mp_obj_t fun_bc_call(mp_obj_t self_in, size_t n_args, size_t n_kw, const
     #else
     // free the state if it was allocated on the heap
     if (state_size != 0) {
+        #if MICROPY_OPT_FRAME_CACHE
+        fun_bc_frame_cache_give(code_state, state_size);
+        #else
         m_del_var(mp_code_state_t, state, byte, state_size, code_state);
+        #endif
     }
     #endif
 
@@ -431,6 +488,9 @@ mp_obj_t mp_obj_new_fun_bc(const mp_obj_t *def_args, const byte *code, const mp_
     o->bytecode = code;
     o->context = context;
     o->child_table = child_table;
+    #if MICROPY_OPT_INLINE_CACHE
+    o->inline_cache = NULL;
+    #endif
     if (def_pos_args != NULL) {
         memcpy(o->extra_args, def_pos_args->items, n_def_args * sizeof(mp_obj_t));
     }
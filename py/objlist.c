@@ -296,6 +296,614 @@ mp_obj_t mp_obj_list_pop(mp_obj_t self_in, mp_obj_t index)
     return list_pop(2, args);
 }
 
+#if MICROPY_PY_BUILTINS_LIST_SORT_STABLE
+
+// Lists are sorted with powersort, a natural merge sort: it finds the runs of
+// items which are already in order (reversing strictly descending ones),
+// extends short runs with binary insertion, and merges adjacent runs in an
+// order which keeps the merges balanced.  A merge copies the shorter run to a
+// scratch buffer and switches to galloping (exponential search) when one run
+// keeps winning, as CPython's timsort does.  This is stable, and takes linear
+// time on input which is already sorted or reversed.
+//
+// When there is a key function, it is called once per item and the sort is done
+// on an array of (key, item) pairs.  So an item is `stride` words long and is
+// compared on its first word.
+
+#define SORT_MIN_GALLOP (7)
+
+typedef struct _sort_run_t {
+    mp_obj_t *base;
+    size_t len;
+    unsigned int power;
+} sort_run_t;
+
+typedef struct _sort_state_t {
+    size_t stride;
+    bool reverse;
+    size_t min_gallop;
+    mp_obj_t *buf;
+    size_t buf_alloc;
+    // During a merge, the items held in the scratch buffer belong in the hole;
+    // if a comparison raises they are copied back so no item is lost.
+    mp_obj_t *hole;
+    mp_obj_t *held;
+    size_t n_held;
+    size_t n_runs;
+    sort_run_t runs[MP_BITS_PER_BYTE * sizeof(size_t) + 1];
+} sort_state_t;
+
+static inline bool sort_lt(sort_state_t *ms, const mp_obj_t *x, const mp_obj_t *y) {
+    mp_obj_t a = *x;
+    mp_obj_t b = *y;
+    if (ms->reverse) {
+        a = *y;
+        b = *x;
+    }
+    if (mp_obj_is_small_int(a) && mp_obj_is_small_int(b)) {
+        return MP_OBJ_SMALL_INT_VALUE(a) < MP_OBJ_SMALL_INT_VALUE(b);
+    }
+    return mp_obj_is_true(mp_binary_op(MP_BINARY_OP_LESS, a, b));
+}
+
+static inline void sort_hold(sort_state_t *ms, mp_obj_t *hole, mp_obj_t *held, size_t n_held) {
+    ms->hole = hole;
+    ms->held = held;
+    ms->n_held = n_held;
+}
+
+static inline void sort_move(sort_state_t *ms, mp_obj_t *dest, const mp_obj_t *src, size_t n) {
+    memmove(dest, src, n * ms->stride * sizeof(mp_obj_t));
+}
+
+static void sort_reverse(sort_state_t *ms, mp_obj_t *lo, mp_obj_t *hi) {
+    size_t s = ms->stride;
+    for (hi -= s; lo < hi; lo += s, hi -= s) {
+        for (size_t i = 0; i < s; ++i) {
+            mp_obj_t t = lo[i];
+            lo[i] = hi[i];
+            hi[i] = t;
+        }
+    }
+}
+
+// Sorts n items starting at lo, of which the first `start` are sorted already.
+static void sort_binary_insertion(sort_state_t *ms, mp_obj_t *lo, size_t n, size_t start) {
+    size_t s = ms->stride;
+    mp_obj_t pivot[2];
+    for (; start < n; ++start) {
+        mp_obj_t *p = lo + start * s;
+        size_t l = 0;
+        size_t r = start;
+        while (l < r) {
+            size_t m = l + (r - l) / 2;
+            if (sort_lt(ms, p, lo + m * s)) {
+                r = m;
+            } else {
+                l = m + 1;
+            }
+        }
+        memcpy(pivot, p, s * sizeof(mp_obj_t));
+        sort_move(ms, lo + (l + 1) * s, lo + l * s, start - l);
+        memcpy(lo + l * s, pivot, s * sizeof(mp_obj_t));
+    }
+}
+
+// Returns the length of the run starting at lo, which is made ascending.
+static size_t sort_count_run(sort_state_t *ms, mp_obj_t *lo, size_t n) {
+    size_t s = ms->stride;
+    size_t len = 2;
+    if (n < 2) {
+        return n;
+    }
+    if (sort_lt(ms, lo + s, lo)) {
+        while (len < n && sort_lt(ms, lo + len * s, lo + (len - 1) * s)) {
+            ++len;
+        }
+        sort_reverse(ms, lo, lo + len * s);
+    } else {
+        while (len < n && !sort_lt(ms, lo + len * s, lo + (len - 1) * s)) {
+            ++len;
+        }
+    }
+    return len;
+}
+
+// Returns the position of key in the n sorted items at a, before any items
+// equal to it, searching outwards from position hint.
+static size_t sort_gallop_left(sort_state_t *ms, const mp_obj_t *key, const mp_obj_t *a, size_t n, size_t hint) {
+    size_t s = ms->stride;
+    mp_int_t lastofs = 0;
+    mp_int_t ofs = 1;
+    if (sort_lt(ms, a + hint * s, key)) {
+        // a[hint] < key: gallop right until a[hint + lastofs] < key <= a[hint + ofs]
+        mp_int_t maxofs = n - hint;
+        while (ofs < maxofs && sort_lt(ms, a + (hint + ofs) * s, key)) {
+            lastofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > maxofs) {
+            ofs = maxofs;
+        }
+        lastofs += hint;
+        ofs += hint;
+    } else {
+        // key <= a[hint]: gallop left until a[hint - ofs] < key <= a[hint - lastofs]
+        mp_int_t maxofs = hint + 1;
+        while (ofs < maxofs && !sort_lt(ms, a + (hint - ofs) * s, key)) {
+            lastofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > maxofs) {
+            ofs = maxofs;
+        }
+        mp_int_t k = lastofs;
+        lastofs = hint - ofs;
+        ofs = hint - k;
+    }
+    // now a[lastofs] < key <= a[ofs], so binary search between them
+    ++lastofs;
+    while (lastofs < ofs) {
+        mp_int_t m = lastofs + ((ofs - lastofs) >> 1);
+        if (sort_lt(ms, a + m * s, key)) {
+            lastofs = m + 1;
+        } else {
+            ofs = m;
+        }
+    }
+    return ofs;
+}
+
+// Like sort_gallop_left but returns the position after any items equal to key.
+static size_t sort_gallop_right(sort_state_t *ms, const mp_obj_t *key, const mp_obj_t *a, size_t n, size_t hint) {
+    size_t s = ms->stride;
+    mp_int_t lastofs = 0;
+    mp_int_t ofs = 1;
+    if (sort_lt(ms, key, a + hint * s)) {
+        // key < a[hint]: gallop left until a[hint - ofs] <= key < a[hint - lastofs]
+        mp_int_t maxofs = hint + 1;
+        while (ofs < maxofs && sort_lt(ms, key, a + (hint - ofs) * s)) {
+            lastofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > maxofs) {
+            ofs = maxofs;
+        }
+        mp_int_t k = lastofs;
+        lastofs = hint - ofs;
+        ofs = hint - k;
+    } else {
+        // a[hint] <= key: gallop right until a[hint + lastofs] <= key < a[hint + ofs]
+        mp_int_t maxofs = n - hint;
+        while (ofs < maxofs && !sort_lt(ms, key, a + (hint + ofs) * s)) {
+            lastofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > maxofs) {
+            ofs = maxofs;
+        }
+        lastofs += hint;
+        ofs += hint;
+    }
+    // now a[lastofs] <= key < a[ofs], so binary search between them
+    ++lastofs;
+    while (lastofs < ofs) {
+        mp_int_t m = lastofs + ((ofs - lastofs) >> 1);
+        if (sort_lt(ms, key, a + m * s)) {
+            ofs = m;
+        } else {
+            lastofs = m + 1;
+        }
+    }
+    return ofs;
+}
+
+// Merges the na items at pa with the nb items following them, where na <= nb,
+// pa[0] > pb[0] and pa[na - 1] is greater than all of pb, copying pa to the
+// scratch buffer.  After each move, the hole in the array is at dest and the
+// na remaining items of pa fill it exactly.
+static void sort_merge_lo(sort_state_t *ms, mp_obj_t *pa, size_t na, mp_obj_t *pb, size_t nb) {
+    size_t s = ms->stride;
+    size_t min_gallop = ms->min_gallop;
+    mp_obj_t *dest = pa;
+    sort_move(ms, ms->buf, pa, na);
+    pa = ms->buf;
+
+    sort_move(ms, dest, pb, 1);
+    dest += s;
+    pb += s;
+    if (--nb == 0) {
+        goto done;
+    }
+    if (na == 1) {
+        goto copy_b;
+    }
+    for (;;) {
+        size_t acount = 0;
+        size_t bcount = 0;
+        // one item at a time, until one run seems to win consistently
+        for (;;) {
+            sort_hold(ms, dest, pa, na);
+            if (sort_lt(ms, pb, pa)) {
+                sort_move(ms, dest, pb, 1);
+                dest += s;
+                pb += s;
+                ++bcount;
+                acount = 0;
+                if (--nb == 0) {
+                    goto done;
+                }
+                if (bcount >= min_gallop) {
+                    break;
+                }
+            } else {
+                sort_move(ms, dest, pa, 1);
+                dest += s;
+                pa += s;
+                ++acount;
+                bcount = 0;
+                if (--na == 1) {
+                    goto copy_b;
+                }
+                if (acount >= min_gallop) {
+                    break;
+                }
+            }
+        }
+        // then gallop, until neither run wins by much
+        ++min_gallop;
+        do {
+            min_gallop -= min_gallop > 1;
+            ms->min_gallop = min_gallop;
+            sort_hold(ms, dest, pa, na);
+            acount = sort_gallop_right(ms, pb, pa, na, 0);
+            if (acount != 0) {
+                sort_move(ms, dest, pa, acount);
+                dest += acount * s;
+                pa += acount * s;
+                na -= acount;
+                if (na == 1) {
+                    goto copy_b;
+                }
+                // only possible if the comparisons are inconsistent
+                if (na == 0) {
+                    goto done;
+                }
+            }
+            sort_move(ms, dest, pb, 1);
+            dest += s;
+            pb += s;
+            if (--nb == 0) {
+                goto done;
+            }
+
+            sort_hold(ms, dest, pa, na);
+            bcount = sort_gallop_left(ms, pa, pb, nb, 0);
+            if (bcount != 0) {
+                sort_move(ms, dest, pb, bcount);
+                dest += bcount * s;
+                pb += bcount * s;
+                nb -= bcount;
+                if (nb == 0) {
+                    goto done;
+                }
+            }
+            sort_move(ms, dest, pa, 1);
+            dest += s;
+            pa += s;
+            if (--na == 1) {
+                goto copy_b;
+            }
+        } while (acount >= SORT_MIN_GALLOP || bcount >= SORT_MIN_GALLOP);
+        ++min_gallop;
+        ms->min_gallop = min_gallop;
+    }
+
+copy_b:
+    // the last item of pa goes after the rest of pb
+    sort_move(ms, dest, pb, nb);
+    dest += nb * s;
+done:
+    sort_move(ms, dest, pa, na);
+    ms->n_held = 0;
+}
+
+// Merges the na items at pa with the nb items following them, where na >= nb,
+// pa[0] > pb[0] and pa[na - 1] is greater than all of pb, copying pb to the
+// scratch buffer and merging from the end.  The hole in the array is then the
+// nb items ending at dest, and the nb remaining items of pb are at the start
+// of the buffer.
+static void sort_merge_hi(sort_state_t *ms, mp_obj_t *pa, size_t na, mp_obj_t *pb, size_t nb) {
+    size_t s = ms->stride;
+    size_t min_gallop = ms->min_gallop;
+    mp_obj_t *base_a = pa;
+    mp_obj_t *base_b = ms->buf;
+    mp_obj_t *dest = pb + (nb - 1) * s;
+    sort_move(ms, base_b, pb, nb);
+    pb = base_b + (nb - 1) * s;
+    pa += (na - 1) * s;
+
+    sort_move(ms, dest, pa, 1);
+    dest -= s;
+    pa -= s;
+    if (--na == 0) {
+        goto done;
+    }
+    if (nb == 1) {
+        goto copy_a;
+    }
+    for (;;) {
+        size_t acount = 0;
+        size_t bcount = 0;
+        for (;;) {
+            sort_hold(ms, dest - (nb - 1) * s, base_b, nb);
+            if (sort_lt(ms, pb, pa)) {
+                sort_move(ms, dest, pa, 1);
+                dest -= s;
+                pa -= s;
+                ++acount;
+                bcount = 0;
+                if (--na == 0) {
+                    goto done;
+                }
+                if (acount >= min_gallop) {
+                    break;
+                }
+            } else {
+                sort_move(ms, dest, pb, 1);
+                dest -= s;
+                pb -= s;
+                ++bcount;
+                acount = 0;
+                if (--nb == 1) {
+                    goto copy_a;
+                }
+                if (bcount >= min_gallop) {
+                    break;
+                }
+            }
+        }
+        ++min_gallop;
+        do {
+            min_gallop -= min_gallop > 1;
+            ms->min_gallop = min_gallop;
+            sort_hold(ms, dest - (nb - 1) * s, base_b, nb);
+            acount = na - sort_gallop_right(ms, pb, base_a, na, na - 1);
+            if (acount != 0) {
+                dest -= acount * s;
+                pa -= acount * s;
+                sort_move(ms, dest + s, pa + s, acount);
+                na -= acount;
+                if (na == 0) {
+                    goto done;
+                }
+            }
+            sort_move(ms, dest, pb, 1);
+            dest -= s;
+            pb -= s;
+            if (--nb == 1) {
+                goto copy_a;
+            }
+
+            sort_hold(ms, dest - (nb - 1) * s, base_b, nb);
+            bcount = nb - sort_gallop_left(ms, pa, base_b, nb, nb - 1);
+            if (bcount != 0) {
+                dest -= bcount * s;
+                pb -= bcount * s;
+                sort_move(ms, dest + s, pb + s, bcount);
+                nb -= bcount;
+                if (nb == 1) {
+                    goto copy_a;
+                }
+                // only possible if the comparisons are inconsistent
+                if (nb == 0) {
+                    goto done;
+                }
+            }
+            sort_move(ms, dest, pa, 1);
+            dest -= s;
+            pa -= s;
+            if (--na == 0) {
+                goto done;
+            }
+        } while (acount >= SORT_MIN_GALLOP || bcount >= SORT_MIN_GALLOP);
+        ++min_gallop;
+        ms->min_gallop = min_gallop;
+    }
+
+copy_a:
+    // the first item of pb goes before the rest of pa
+    dest -= na * s;
+    pa -= na * s;
+    sort_move(ms, dest + s, pa + s, na);
+done:
+    sort_move(ms, dest - (nb - 1) * s, base_b, nb);
+    ms->n_held = 0;
+}
+
+// Swaps the items in [lo, mid) with those in [mid, hi).
+static void sort_rotate(sort_state_t *ms, mp_obj_t *lo, mp_obj_t *mid, mp_obj_t *hi) {
+    sort_reverse(ms, lo, mid);
+    sort_reverse(ms, mid, hi);
+    sort_reverse(ms, lo, hi);
+}
+
+static bool sort_reserve(sort_state_t *ms, size_t n) {
+    if (n <= ms->buf_alloc) {
+        return true;
+    }
+    if (n > MICROPY_PY_BUILTINS_LIST_SORT_MERGE_MAX) {
+        return false;
+    }
+    mp_obj_t *buf = m_new_maybe(mp_obj_t, n * ms->stride);
+    if (buf == NULL) {
+        return false;
+    }
+    m_del(mp_obj_t, ms->buf, ms->buf_alloc * ms->stride);
+    ms->buf = buf;
+    ms->buf_alloc = n;
+    return true;
+}
+
+// Merges the na sorted items at pa with the nb sorted items following them.
+static void sort_merge(sort_state_t *ms, mp_obj_t *pa, size_t na, mp_obj_t *pb, size_t nb) {
+    size_t s = ms->stride;
+    if (na == 0 || nb == 0) {
+        return;
+    }
+
+    // items of pa before the first of pb, and items of pb after the last of
+    // pa, are already in place
+    size_t k = sort_gallop_right(ms, pb, pa, na, 0);
+    pa += k * s;
+    na -= k;
+    if (na == 0) {
+        return;
+    }
+    nb = sort_gallop_left(ms, pa + (na - 1) * s, pb, nb, nb - 1);
+    if (nb == 0) {
+        return;
+    }
+
+    if (sort_reserve(ms, MIN(na, nb))) {
+        if (na <= nb) {
+            sort_merge_lo(ms, pa, na, pb, nb);
+        } else {
+            sort_merge_hi(ms, pa, na, pb, nb);
+        }
+        return;
+    }
+
+    // Without enough scratch memory, split the longer run in half and the other
+    // one at the same value, swap the middle parts and merge both sides.
+    mp_cstack_check();
+    size_t ka, kb;
+    if (na >= nb) {
+        ka = na / 2;
+        kb = sort_gallop_left(ms, pa + ka * s, pb, nb, 0);
+    } else {
+        kb = nb / 2;
+        ka = sort_gallop_right(ms, pb + kb * s, pa, na, 0);
+    }
+    sort_rotate(ms, pa + ka * s, pb, pb + kb * s);
+    mp_obj_t *mid = pa + (ka + kb) * s;
+    sort_merge(ms, pa, ka, pa + ka * s, kb);
+    sort_merge(ms, mid, na - ka, mid + (na - ka) * s, nb - kb);
+}
+
+static void sort_merge_top(sort_state_t *ms) {
+    sort_run_t *a = &ms->runs[ms->n_runs - 2];
+    sort_run_t *b = a + 1;
+    sort_merge(ms, a->base, a->len, b->base, b->len);
+    a->len += b->len;
+    --ms->n_runs;
+}
+
+// Returns the depth in a balanced merge tree of the boundary between two
+// adjacent runs, of n1 items starting at item s1 and of n2 items, out of n.
+static unsigned int sort_power(size_t s1, size_t n1, size_t n2, size_t n) {
+    unsigned int power = 0;
+    size_t a = 2 * s1 + n1;
+    size_t b = a + n1 + n2;
+    for (;;) {
+        ++power;
+        if (a >= n) {
+            a -= n;
+            b -= n;
+        } else if (b >= n) {
+            break;
+        }
+        a <<= 1;
+        b <<= 1;
+    }
+    return power;
+}
+
+static void sort_items(sort_state_t *ms, mp_obj_t *items, size_t n) {
+    size_t s = ms->stride;
+
+    // runs shorter than min_run are extended, which gives at most a power of 2
+    // of them (or slightly fewer), each at least 32 items long
+    size_t min_run = n;
+    size_t r = 0;
+    while (min_run >= 64) {
+        r |= min_run & 1;
+        min_run >>= 1;
+    }
+    min_run += r;
+
+    mp_obj_t *lo = items;
+    size_t remaining = n;
+    do {
+        size_t len = sort_count_run(ms, lo, remaining);
+        if (len < min_run) {
+            size_t force = MIN(remaining, min_run);
+            sort_binary_insertion(ms, lo, force, len);
+            len = force;
+        }
+        if (ms->n_runs > 0) {
+            sort_run_t *top = &ms->runs[ms->n_runs - 1];
+            unsigned int power = sort_power((top->base - items) / s, top->len, len, n);
+            while (ms->n_runs > 1 && ms->runs[ms->n_runs - 2].power > power) {
+                sort_merge_top(ms);
+            }
+            ms->runs[ms->n_runs - 1].power = power;
+        }
+        ms->runs[ms->n_runs].base = lo;
+        ms->runs[ms->n_runs].len = len;
+        ++ms->n_runs;
+        lo += len * s;
+        remaining -= len;
+    } while (remaining != 0);
+
+    while (ms->n_runs > 1) {
+        sort_merge_top(ms);
+    }
+}
+
+static void mp_list_sort_stable(mp_obj_list_t *self, mp_obj_t key_fn, bool reverse) {
+    size_t n = self->len;
+    sort_state_t ms;
+    ms.reverse = reverse;
+    ms.min_gallop = SORT_MIN_GALLOP;
+    ms.buf = NULL;
+    ms.buf_alloc = 0;
+    ms.n_held = 0;
+    ms.n_runs = 0;
+    if (key_fn == MP_OBJ_NULL) {
+        ms.stride = 1;
+        nlr_buf_t nlr;
+        if (nlr_push(&nlr) == 0) {
+            sort_items(&ms, self->items, n);
+            nlr_pop();
+        } else {
+            if (ms.n_held != 0) {
+                memcpy(ms.hole, ms.held, ms.n_held * sizeof(mp_obj_t));
+            }
+            nlr_jump(nlr.ret_val);
+        }
+    } else {
+        // sort (key, item) pairs, so the key is computed once per item
+        ms.stride = 2;
+        mp_obj_t *pairs = m_new(mp_obj_t, 2 * n);
+        for (size_t i = 0; i < n; ++i) {
+            pairs[2 * i] = mp_call_function_1(key_fn, self->items[i]);
+            pairs[2 * i + 1] = self->items[i];
+        }
+        sort_items(&ms, pairs, n);
+        // the list may have been changed by the key function or comparisons
+        if (self->len == n) {
+            for (size_t i = 0; i < n; ++i) {
+                self->items[i] = pairs[2 * i + 1];
+            }
+        }
+        m_del(mp_obj_t, pairs, 2 * n);
+    }
+    m_del(mp_obj_t, ms.buf, ms.buf_alloc * ms.stride);
+}
+
+#else
+
 static void mp_quicksort(mp_obj_t *head, mp_obj_t *tail, mp_obj_t key_fn, mp_obj_t binop_less_result) {
     mp_cstack_check();
     while (head < tail) {
@@ -328,7 +936,8 @@ static void mp_quicksort(mp_obj_t *head, mp_obj_t *tail, mp_obj_t key_fn, mp_obj
     }
 }
 
-// TODO Python defines sort to be stable but ours is not
+#endif
+
 mp_obj_t mp_obj_list_sort(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_key, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE} },
@@ -346,9 +955,16 @@ mp_obj_t mp_obj_list_sort(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_
     mp_obj_list_t *self = MP_OBJ_TO_PTR(pos_args[0]);
 
     if (self->len > 1) {
+        #if MICROPY_PY_BUILTINS_LIST_SORT_STABLE
+        mp_list_sort_stable(self,
+            args.key.u_obj == mp_const_none ? MP_OBJ_NULL : args.key.u_obj,
+            args.reverse.u_bool);
+        #else
+        // Python defines sort to be stable but this is not
         mp_quicksort(self->items, self->items + self->len - 1,
             args.key.u_obj == mp_const_none ? MP_OBJ_NULL : args.key.u_obj,
             args.reverse.u_bool ? mp_const_false : mp_const_true);
+        #endif
     }
 
     return mp_const_none;
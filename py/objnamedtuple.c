@@ -31,6 +31,7 @@
 #include "py/runtime.h"
 #include "py/objstr.h"
 #include "py/objnamedtuple.h"
+#include "py/objtype.h"
 
 #if MICROPY_PY_COLLECTIONS
 
@@ -148,6 +149,10 @@ mp_obj_namedtuple_type_t *mp_obj_new_namedtuple_base(size_t n_fields, mp_obj_t *
     for (size_t i = 0; i < n_fields; i++) {
         o->fields[i] = mp_obj_str_get_qstr(fields[i]);
     }
+    #if MICROPY_OPT_CLASS_LOOKUP_CACHE
+    // a new type, which may be at the address of a freed one
+    mp_obj_class_lookup_invalidate();
+    #endif
     return o;
 }
 
@@ -320,28 +320,79 @@ wrong_args:
     mp_raise_TypeError(MP_ERROR_TEXT("wrong number of arguments"));
 }
 
+// Needles at least this long are searched for in haystacks at least
+// FIND_SUBBYTES_SKIP_MIN_HLEN long with the Boyer-Moore-Horspool algorithm,
+// which skips ahead by up to 255 bytes using a table built from the needle.
+// Shorter searches don't repay building the table and instead look for the
+// first byte of the needle with memchr, which is usually word-at-a-time.
+#define FIND_SUBBYTES_SKIP_MIN_NLEN (4)
+#define FIND_SUBBYTES_SKIP_MIN_HLEN (256)
+
 // like strstr but with specified length and allows \0 bytes
-// TODO replace with something more efficient/standard
 const byte *find_subbytes(const byte *haystack, size_t hlen, const byte *needle, size_t nlen, int direction) {
-    if (hlen >= nlen) {
-        size_t str_index, str_index_end;
-        if (direction > 0) {
-            str_index = 0;
-            str_index_end = hlen - nlen;
-        } else {
-            str_index = hlen - nlen;
-            str_index_end = 0;
+    if (hlen < nlen) {
+        return NULL;
+    }
+    if (nlen == 0) {
+        return direction > 0 ? haystack : haystack + hlen;
+    }
+    size_t last = hlen - nlen;
+    bool use_skip = nlen >= FIND_SUBBYTES_SKIP_MIN_NLEN && hlen >= FIND_SUBBYTES_SKIP_MIN_HLEN;
+    uint8_t skip[256];
+    if (use_skip) {
+        // A smaller skip than the needle allows is always safe, so long
+        // needles are capped to 255 bytes of skip.
+        memset(skip, nlen < 255 ? nlen : 255, sizeof(skip));
+    }
+    if (direction > 0) {
+        if (!use_skip) {
+            const byte *top = haystack + last + 1;
+            for (const byte *p = haystack; (p = memchr(p, needle[0], top - p)) != NULL; ++p) {
+                if (memcmp(p + 1, needle + 1, nlen - 1) == 0) {
+                    return p;
+                }
+            }
+            return NULL;
+        }
+        // skip[c] is the distance from the last occurrence of c in the
+        // needle (excluding its last byte) to the end of the needle
+        for (size_t i = nlen > 256 ? nlen - 256 : 0; i < nlen - 1; ++i) {
+            skip[needle[i]] = nlen - 1 - i;
+        }
+        byte tail = needle[nlen - 1];
+        for (size_t i = 0; i <= last;) {
+            byte c = haystack[i + nlen - 1];
+            if (c == tail && memcmp(haystack + i, needle, nlen - 1) == 0) {
+                return haystack + i;
+            }
+            i += skip[c];
         }
-        for (;;) {
-            if (memcmp(&haystack[str_index], needle, nlen) == 0) {
-                // found
-                return haystack + str_index;
+    } else {
+        if (!use_skip) {
+            for (const byte *p = haystack + last;; --p) {
+                if (*p == needle[0] && memcmp(p + 1, needle + 1, nlen - 1) == 0) {
+                    return p;
+                }
+                if (p == haystack) {
+                    return NULL;
+                }
             }
-            if (str_index == str_index_end) {
-                // not found
+        }
+        // the same, mirrored: skip[c] is the distance from the start of the
+        // needle to the first occurrence of c after its first byte
+        for (size_t i = nlen - 1 < 255 ? nlen - 1 : 255; i > 0; --i) {
+            skip[needle[i]] = i;
+        }
+        byte head = needle[0];
+        for (size_t i = last;;) {
+            byte c = haystack[i];
+            if (c == head && memcmp(haystack + i + 1, needle + 1, nlen - 1) == 0) {
+                return haystack + i;
+            }
+            if (i < skip[c]) {
                 break;
             }
-            str_index += direction;
+            i -= skip[c];
         }
     }
     return NULL;
@@ -623,14 +674,12 @@ mp_obj_t mp_obj_str_split(size_t n_args, const mp_obj_t *args) {
 
         for (;;) {
             const byte *start = s;
-            for (;;) {
-                if (splits == 0 || s + sep_len > top) {
-                    s = top;
-                    break;
-                } else if (memcmp(s, sep_str, sep_len) == 0) {
-                    break;
-                }
-                s++;
+            s = NULL;
+            if (splits != 0) {
+                s = find_subbytes(start, top - start, (const byte *)sep_str, sep_len, 1);
+            }
+            if (s == NULL) {
+                s = top;
             }
             mp_obj_list_append(res, mp_obj_new_str_of_type(self_type, start, s - start));
             if (s >= top) {
@@ -729,16 +778,11 @@ static mp_obj_t str_rsplit(size_t n_args, const mp_obj_t *args) {
         const byte *beg = s;
         const byte *last = s + len;
         for (;;) {
-            s = last - sep_len;
-            for (;;) {
-                if (splits == 0 || s < beg) {
-                    break;
-                } else if (memcmp(s, sep_str, sep_len) == 0) {
-                    break;
-                }
-                s--;
+            s = NULL;
+            if (splits != 0) {
+                s = find_subbytes(beg, last - beg, (const byte *)sep_str, sep_len, -1);
             }
-            if (s < beg || splits == 0) {
+            if (s == NULL) {
                 res->items[idx] = mp_obj_new_str_of_type(self_type, beg, last - beg);
                 break;
             }
@@ -1009,6 +1053,297 @@ static NORETURN void terse_str_format_value_error(void) {
 #define terse_str_format_value_error()
 #endif
 
+// Formats the argument of a single replacement field into print, given its
+// conversion ('\0', 's' or 'r') and format spec (NULL if there isn't one,
+// otherwise null-terminated).
+static void str_format_arg(const mp_print_t *print, mp_obj_t arg, char conversion, const char *spec, size_t spec_len) {
+    if (!spec && !conversion) {
+        conversion = 's';
+    }
+    if (conversion) {
+        mp_print_kind_t print_kind;
+        if (conversion == 's') {
+            print_kind = PRINT_STR;
+        } else {
+            assert(conversion == 'r');
+            print_kind = PRINT_REPR;
+        }
+        vstr_t arg_vstr;
+        mp_print_t arg_print;
+        vstr_init_print(&arg_vstr, 16, &arg_print);
+        mp_obj_print_helper(&arg_print, arg, print_kind);
+        arg = mp_obj_new_str_type_from_vstr(&mp_type_str, &arg_vstr);
+    }
+
+    char fill = '\0';
+    char align = '\0';
+    int width = -1;
+    int precision = -1;
+    char type = '\0';
+    int flags = 0;
+
+    if (spec) {
+        // The format specifier (from http://docs.python.org/2/library/string.html#formatspec)
+        //
+        // [[fill]align][sign][#][0][width][,][.precision][type]
+        // fill        ::=  <any character>
+        // align       ::=  "<" | ">" | "=" | "^"
+        // sign        ::=  "+" | "-" | " "
+        // width       ::=  integer
+        // precision   ::=  integer
+        // type        ::=  "b" | "c" | "d" | "e" | "E" | "f" | "F" | "g" | "G" | "n" | "o" | "s" | "x" | "X" | "%"
+
+        const char *s = spec;
+        const char *stop = spec + spec_len;
+        if (isalignment(*s)) {
+            align = *s++;
+        } else if (*s && isalignment(s[1])) {
+            fill = *s++;
+            align = *s++;
+        }
+        if (*s == '+' || *s == '-' || *s == ' ') {
+            if (*s == '+') {
+                flags |= PF_FLAG_SHOW_SIGN;
+            } else if (*s == ' ') {
+                flags |= PF_FLAG_SPACE_SIGN;
+            }
+            s++;
+        }
+        if (*s == '#') {
+            flags |= PF_FLAG_SHOW_PREFIX;
+            s++;
+        }
+        if (*s == '0') {
+            if (!align && arg_looks_numeric(arg)) {
+                align = '=';
+            }
+            if (!fill) {
+                fill = '0';
+            }
+        }
+        s = str_to_int(s, stop, &width);
+        if (*s == ',') {
+            flags |= PF_FLAG_SHOW_COMMA;
+            s++;
+        }
+        if (*s == '.') {
+            s++;
+            s = str_to_int(s, stop, &precision);
+        }
+        if (istype(*s)) {
+            type = *s++;
+        }
+        if (*s) {
+            #if MICROPY_ERROR_REPORTING <= MICROPY_ERROR_REPORTING_TERSE
+            terse_str_format_value_error();
+            #else
+            mp_raise_ValueError(MP_ERROR_TEXT("invalid format specifier"));
+            #endif
+        }
+    }
+    if (!align) {
+        if (arg_looks_numeric(arg)) {
+            align = '>';
+        } else {
+            align = '<';
+        }
+    }
+    if (!fill) {
+        fill = ' ';
+    }
+
+    if (flags & (PF_FLAG_SHOW_SIGN | PF_FLAG_SPACE_SIGN)) {
+        if (type == 's') {
+            #if MICROPY_ERROR_REPORTING <= MICROPY_ERROR_REPORTING_TERSE
+            terse_str_format_value_error();
+            #else
+            mp_raise_ValueError(MP_ERROR_TEXT("sign not allowed in string format specifier"));
+            #endif
+        }
+        if (type == 'c') {
+            #if MICROPY_ERROR_REPORTING <= MICROPY_ERROR_REPORTING_TERSE
+            terse_str_format_value_error();
+            #else
+            mp_raise_ValueError(
+                MP_ERROR_TEXT("sign not allowed with integer format specifier 'c'"));
+            #endif
+        }
+    }
+
+    switch (align) {
+        case '<':
+            flags |= PF_FLAG_LEFT_ADJUST;
+            break;
+        case '=':
+            flags |= PF_FLAG_PAD_AFTER_SIGN;
+            break;
+        case '^':
+            flags |= PF_FLAG_CENTER_ADJUST;
+            break;
+    }
+
+    if (arg_looks_integer(arg)) {
+        switch (type) {
+            case 'b':
+                mp_print_mp_int(print, arg, 2, 'a', flags, fill, width, 0);
+                return;
+
+            case 'c': {
+                char ch = mp_obj_get_int(arg);
+                mp_print_strn(print, &ch, 1, flags, fill, width);
+                return;
+            }
+
+            case '\0':  // No explicit format type implies 'd'
+            case 'n':   // I don't think we support locales in uPy so use 'd'
+            case 'd':
+                mp_print_mp_int(print, arg, 10, 'a', flags, fill, width, 0);
+                return;
+
+            case 'o':
+                if (flags & PF_FLAG_SHOW_PREFIX) {
+                    flags |= PF_FLAG_SHOW_OCTAL_LETTER;
+                }
+
+                mp_print_mp_int(print, arg, 8, 'a', flags, fill, width, 0);
+                return;
+
+            case 'X':
+            case 'x':
+                mp_print_mp_int(print, arg, 16, type - ('X' - 'A'), flags, fill, width, 0);
+                return;
+
+            case 'e':
+            case 'E':
+            case 'f':
+            case 'F':
+            case 'g':
+            case 'G':
+            case '%':
+                // The floating point formatters all work with anything that
+                // looks like an integer
+                break;
+
+            default:
+                #if MICROPY_ERROR_REPORTING <= MICROPY_ERROR_REPORTING_TERSE
+                terse_str_format_value_error();
+                #else
+                mp_raise_msg_varg(&mp_type_ValueError,
+                    MP_ERROR_TEXT("unknown format code '%c' for object of type '%s'"),
+                    type, mp_obj_get_type_str(arg));
+                #endif
+        }
+    }
+
+    // NOTE: no else here. We need the e, f, g etc formats for integer
+    //       arguments (from above if) to take this if.
+    if (arg_looks_numeric(arg)) {
+        if (!type) {
+
+            // Even though the docs say that an unspecified type is the same
+            // as 'g', there is one subtle difference, when the exponent
+            // is one less than the precision.
+            //
+            // '{:10.1}'.format(0.0) ==> '0e+00'
+            // '{:10.1g}'.format(0.0) ==> '0'
+            //
+            // TODO: Figure out how to deal with this.
+            //
+            // A proper solution would involve adding a special flag
+            // or something to format_float, and create a format_double
+            // to deal with doubles. In order to fix this when using
+            // sprintf, we'd need to use the e format and tweak the
+            // returned result to strip trailing zeros like the g format
+            // does.
+            //
+            // {:10.3} and {:10.2e} with 1.23e2 both produce 1.23e+02
+            // but with 1.e2 you get 1e+02 and 1.00e+02
+            //
+            // Stripping the trailing 0's (like g) does would make the
+            // e format give us the right format.
+            //
+            // CPython sources say:
+            //   Omitted type specifier.  Behaves in the same way as repr(x)
+            //   and str(x) if no precision is given, else like 'g', but with
+            //   at least one digit after the decimal point. */
+
+            type = 'g';
+        }
+        if (type == 'n') {
+            type = 'g';
+        }
+
+        switch (type) {
+            #if MICROPY_PY_BUILTINS_FLOAT
+            case 'e':
+            case 'E':
+            case 'f':
+            case 'F':
+            case 'g':
+            case 'G':
+                mp_print_float(print, mp_obj_get_float(arg), type, flags, fill, width, precision);
+                break;
+
+            case '%':
+                flags |= PF_FLAG_ADD_PERCENT;
+                #if MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_FLOAT
+                #define F100 100.0F
+                #else
+                #define F100 100.0
+                #endif
+                mp_print_float(print, mp_obj_get_float(arg) * F100, 'f', flags, fill, width, precision);
+#undef F100
+                break;
+            #endif
+
+            default:
+                #if MICROPY_ERROR_REPORTING <= MICROPY_ERROR_REPORTING_TERSE
+                terse_str_format_value_error();
+                #else
+                mp_raise_msg_varg(&mp_type_ValueError,
+                    MP_ERROR_TEXT("unknown format code '%c' for object of type '%s'"),
+                    type, mp_obj_get_type_str(arg));
+                #endif
+        }
+    } else {
+        // arg doesn't look like a number
+
+        if (align == '=') {
+            #if MICROPY_ERROR_REPORTING <= MICROPY_ERROR_REPORTING_TERSE
+            terse_str_format_value_error();
+            #else
+            mp_raise_ValueError(
+                MP_ERROR_TEXT("'=' alignment not allowed in string format specifier"));
+            #endif
+        }
+
+        switch (type) {
+            case '\0': // no explicit format type implies 's'
+            case 's': {
+                size_t slen;
+                const char *s = mp_obj_str_get_data(arg, &slen);
+                if (precision < 0) {
+                    precision = slen;
+                }
+                if (slen > (size_t)precision) {
+                    slen = precision;
+                }
+                mp_print_strn(print, s, slen, flags, fill, width);
+                break;
+            }
+
+            default:
+                #if MICROPY_ERROR_REPORTING <= MICROPY_ERROR_REPORTING_TERSE
+                terse_str_format_value_error();
+                #else
+                mp_raise_msg_varg(&mp_type_ValueError,
+                    MP_ERROR_TEXT("unknown format code '%c' for object of type '%s'"),
+                    type, mp_obj_get_type_str(arg));
+                #endif
+        }
+    }
+}
+
 static vstr_t mp_obj_str_format_helper(const char *str, const char *top, int *arg_i, size_t n_args, const mp_obj_t *args, mp_map_t *kwargs) {
     vstr_t vstr;
     mp_print_t print;
@@ -1161,294 +1496,14 @@ static vstr_t mp_obj_str_format_helper(const char *str, const char *top, int *ar
             arg = args[(*arg_i) + 1];
             (*arg_i)++;
         }
-        if (!format_spec && !conversion) {
-            conversion = 's';
-        }
-        if (conversion) {
-            mp_print_kind_t print_kind;
-            if (conversion == 's') {
-                print_kind = PRINT_STR;
-            } else {
-                assert(conversion == 'r');
-                print_kind = PRINT_REPR;
-            }
-            vstr_t arg_vstr;
-            mp_print_t arg_print;
-            vstr_init_print(&arg_vstr, 16, &arg_print);
-            mp_obj_print_helper(&arg_print, arg, print_kind);
-            arg = mp_obj_new_str_type_from_vstr(&mp_type_str, &arg_vstr);
-        }
-
-        char fill = '\0';
-        char align = '\0';
-        int width = -1;
-        int precision = -1;
-        char type = '\0';
-        int flags = 0;
-
         if (format_spec) {
-            // The format specifier (from http://docs.python.org/2/library/string.html#formatspec)
-            //
-            // [[fill]align][sign][#][0][width][,][.precision][type]
-            // fill        ::=  <any character>
-            // align       ::=  "<" | ">" | "=" | "^"
-            // sign        ::=  "+" | "-" | " "
-            // width       ::=  integer
-            // precision   ::=  integer
-            // type        ::=  "b" | "c" | "d" | "e" | "E" | "f" | "F" | "g" | "G" | "n" | "o" | "s" | "x" | "X" | "%"
-
             // recursively call the formatter to format any nested specifiers
             mp_cstack_check();
             vstr_t format_spec_vstr = mp_obj_str_format_helper(format_spec, str, arg_i, n_args, args, kwargs);
-            const char *s = vstr_null_terminated_str(&format_spec_vstr);
-            const char *stop = s + format_spec_vstr.len;
-            if (isalignment(*s)) {
-                align = *s++;
-            } else if (*s && isalignment(s[1])) {
-                fill = *s++;
-                align = *s++;
-            }
-            if (*s == '+' || *s == '-' || *s == ' ') {
-                if (*s == '+') {
-                    flags |= PF_FLAG_SHOW_SIGN;
-                } else if (*s == ' ') {
-                    flags |= PF_FLAG_SPACE_SIGN;
-                }
-                s++;
-            }
-            if (*s == '#') {
-                flags |= PF_FLAG_SHOW_PREFIX;
-                s++;
-            }
-            if (*s == '0') {
-                if (!align && arg_looks_numeric(arg)) {
-                    align = '=';
-                }
-                if (!fill) {
-                    fill = '0';
-                }
-            }
-            s = str_to_int(s, stop, &width);
-            if (*s == ',') {
-                flags |= PF_FLAG_SHOW_COMMA;
-                s++;
-            }
-            if (*s == '.') {
-                s++;
-                s = str_to_int(s, stop, &precision);
-            }
-            if (istype(*s)) {
-                type = *s++;
-            }
-            if (*s) {
-                #if MICROPY_ERROR_REPORTING <= MICROPY_ERROR_REPORTING_TERSE
-                terse_str_format_value_error();
-                #else
-                mp_raise_ValueError(MP_ERROR_TEXT("invalid format specifier"));
-                #endif
-            }
+            str_format_arg(&print, arg, conversion, vstr_null_terminated_str(&format_spec_vstr), format_spec_vstr.len);
             vstr_clear(&format_spec_vstr);
-        }
-        if (!align) {
-            if (arg_looks_numeric(arg)) {
-                align = '>';
-            } else {
-                align = '<';
-            }
-        }
-        if (!fill) {
-            fill = ' ';
-        }
-
-        if (flags & (PF_FLAG_SHOW_SIGN | PF_FLAG_SPACE_SIGN)) {
-            if (type == 's') {
-                #if MICROPY_ERROR_REPORTING <= MICROPY_ERROR_REPORTING_TERSE
-                terse_str_format_value_error();
-                #else
-                mp_raise_ValueError(MP_ERROR_TEXT("sign not allowed in string format specifier"));
-                #endif
-            }
-            if (type == 'c') {
-                #if MICROPY_ERROR_REPORTING <= MICROPY_ERROR_REPORTING_TERSE
-                terse_str_format_value_error();
-                #else
-                mp_raise_ValueError(
-                    MP_ERROR_TEXT("sign not allowed with integer format specifier 'c'"));
-                #endif
-            }
-        }
-
-        switch (align) {
-            case '<':
-                flags |= PF_FLAG_LEFT_ADJUST;
-                break;
-            case '=':
-                flags |= PF_FLAG_PAD_AFTER_SIGN;
-                break;
-            case '^':
-                flags |= PF_FLAG_CENTER_ADJUST;
-                break;
-        }
-
-        if (arg_looks_integer(arg)) {
-            switch (type) {
-                case 'b':
-                    mp_print_mp_int(&print, arg, 2, 'a', flags, fill, width, 0);
-                    continue;
-
-                case 'c': {
-                    char ch = mp_obj_get_int(arg);
-                    mp_print_strn(&print, &ch, 1, flags, fill, width);
-                    continue;
-                }
-
-                case '\0':  // No explicit format type implies 'd'
-                case 'n':   // I don't think we support locales in uPy so use 'd'
-                case 'd':
-                    mp_print_mp_int(&print, arg, 10, 'a', flags, fill, width, 0);
-                    continue;
-
-                case 'o':
-                    if (flags & PF_FLAG_SHOW_PREFIX) {
-                        flags |= PF_FLAG_SHOW_OCTAL_LETTER;
-                    }
-
-                    mp_print_mp_int(&print, arg, 8, 'a', flags, fill, width, 0);
-                    continue;
-
-                case 'X':
-                case 'x':
-                    mp_print_mp_int(&print, arg, 16, type - ('X' - 'A'), flags, fill, width, 0);
-                    continue;
-
-                case 'e':
-                case 'E':
-                case 'f':
-                case 'F':
-                case 'g':
-                case 'G':
-                case '%':
-                    // The floating point formatters all work with anything that
-                    // looks like an integer
-                    break;
-
-                default:
-                    #if MICROPY_ERROR_REPORTING <= MICROPY_ERROR_REPORTING_TERSE
-                    terse_str_format_value_error();
-                    #else
-                    mp_raise_msg_varg(&mp_type_ValueError,
-                        MP_ERROR_TEXT("unknown format code '%c' for object of type '%s'"),
-                        type, mp_obj_get_type_str(arg));
-                    #endif
-            }
-        }
-
-        // NOTE: no else here. We need the e, f, g etc formats for integer
-        //       arguments (from above if) to take this if.
-        if (arg_looks_numeric(arg)) {
-            if (!type) {
-
-                // Even though the docs say that an unspecified type is the same
-                // as 'g', there is one subtle difference, when the exponent
-                // is one less than the precision.
-                //
-                // '{:10.1}'.format(0.0) ==> '0e+00'
-                // '{:10.1g}'.format(0.0) ==> '0'
-                //
-                // TODO: Figure out how to deal with this.
-                //
-                // A proper solution would involve adding a special flag
-                // or something to format_float, and create a format_double
-                // to deal with doubles. In order to fix this when using
-                // sprintf, we'd need to use the e format and tweak the
-                // returned result to strip trailing zeros like the g format
-                // does.
-                //
-                // {:10.3} and {:10.2e} with 1.23e2 both produce 1.23e+02
-                // but with 1.e2 you get 1e+02 and 1.00e+02
-                //
-                // Stripping the trailing 0's (like g) does would make the
-                // e format give us the right format.
-                //
-                // CPython sources say:
-                //   Omitted type specifier.  Behaves in the same way as repr(x)
-                //   and str(x) if no precision is given, else like 'g', but with
-                //   at least one digit after the decimal point. */
-
-                type = 'g';
-            }
-            if (type == 'n') {
-                type = 'g';
-            }
-
-            switch (type) {
-                #if MICROPY_PY_BUILTINS_FLOAT
-                case 'e':
-                case 'E':
-                case 'f':
-                case 'F':
-                case 'g':
-                case 'G':
-                    mp_print_float(&print, mp_obj_get_float(arg), type, flags, fill, width, precision);
-                    break;
-
-                case '%':
-                    flags |= PF_FLAG_ADD_PERCENT;
-                    #if MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_FLOAT
-                    #define F100 100.0F
-                    #else
-                    #define F100 100.0
-                    #endif
-                    mp_print_float(&print, mp_obj_get_float(arg) * F100, 'f', flags, fill, width, precision);
-#undef F100
-                    break;
-                #endif
-
-                default:
-                    #if MICROPY_ERROR_REPORTING <= MICROPY_ERROR_REPORTING_TERSE
-                    terse_str_format_value_error();
-                    #else
-                    mp_raise_msg_varg(&mp_type_ValueError,
-                        MP_ERROR_TEXT("unknown format code '%c' for object of type '%s'"),
-                        type, mp_obj_get_type_str(arg));
-                    #endif
-            }
         } else {
-            // arg doesn't look like a number
-
-            if (align == '=') {
-                #if MICROPY_ERROR_REPORTING <= MICROPY_ERROR_REPORTING_TERSE
-                terse_str_format_value_error();
-                #else
-                mp_raise_ValueError(
-                    MP_ERROR_TEXT("'=' alignment not allowed in string format specifier"));
-                #endif
-            }
-
-            switch (type) {
-                case '\0': // no explicit format type implies 's'
-                case 's': {
-                    size_t slen;
-                    const char *s = mp_obj_str_get_data(arg, &slen);
-                    if (precision < 0) {
-                        precision = slen;
-                    }
-                    if (slen > (size_t)precision) {
-                        slen = precision;
-                    }
-                    mp_print_strn(&print, s, slen, flags, fill, width);
-                    break;
-                }
-
-                default:
-                    #if MICROPY_ERROR_REPORTING <= MICROPY_ERROR_REPORTING_TERSE
-                    terse_str_format_value_error();
-                    #else
-                    mp_raise_msg_varg(&mp_type_ValueError,
-                        MP_ERROR_TEXT("unknown format code '%c' for object of type '%s'"),
-                        type, mp_obj_get_type_str(arg));
-                    #endif
-            }
+            str_format_arg(&print, arg, conversion, NULL, 0);
         }
     }
 
@@ -1465,6 +1520,52 @@ mp_obj_t mp_obj_str_format(size_t n_args, const mp_obj_t *args, mp_map_t *kwargs
 }
 MP_DEFINE_CONST_FUN_OBJ_KW(str_format_obj, 1, mp_obj_str_format);
 
+// Formats a single value the way a replacement field of str.format would,
+// used for f-strings.  format_spec is MP_OBJ_NULL if there isn't one.
+mp_obj_t mp_obj_str_format_value(mp_obj_t arg, char conversion, mp_obj_t format_spec) {
+    if (format_spec == MP_OBJ_NULL && conversion != 'r' && mp_obj_is_str(arg)) {
+        return arg;
+    }
+    vstr_t vstr;
+    mp_print_t print;
+    vstr_init_print(&vstr, 16, &print);
+    if (format_spec == MP_OBJ_NULL) {
+        // same as str_format_arg() with no format spec
+        mp_obj_print_helper(&print, arg, conversion == 'r' ? PRINT_REPR : PRINT_STR);
+    } else {
+        // str data is always null terminated
+        GET_STR_DATA_LEN(format_spec, spec, spec_len);
+        str_format_arg(&print, arg, conversion, (const char *)spec, spec_len);
+    }
+    return mp_obj_new_str_type_from_vstr(&mp_type_str, &vstr);
+}
+
+// Concatenates str() of each item into a new str, used for f-strings.  Items
+// that are already strings are copied straight into a buffer sized for them.
+mp_obj_t mp_obj_str_build(size_t n, const mp_obj_t *items) {
+    size_t len = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (mp_obj_is_str(items[i])) {
+            GET_STR_LEN(items[i], item_len);
+            len += item_len;
+        } else {
+            len += 8;
+        }
+    }
+    vstr_t vstr;
+    mp_print_t print;
+    vstr_init_print(&vstr, len + 1, &print);
+    for (size_t i = 0; i < n; i++) {
+        if (mp_obj_is_str(items[i])) {
+            GET_STR_DATA_LEN(items[i], item, item_len);
+            vstr_add_strn(&vstr, (const char *)item, item_len);
+        } else {
+            mp_obj_print_helper(&print, items[i], PRINT_STR);
+        }
+    }
+    return mp_obj_new_str_type_from_vstr(&mp_type_str, &vstr);
+}
+
 #if MICROPY_PY_BUILTINS_STR_OP_MODULO
 static mp_obj_t str_modulo_format(mp_obj_t pattern, size_t n_args, const mp_obj_t *args, mp_obj_t dict) {
     check_is_str_or_bytes(pattern);
@@ -1800,17 +1901,14 @@ static mp_obj_t str_count(size_t n_args, const mp_obj_t *args) {
         return MP_OBJ_NEW_SMALL_INT(utf8_charlen(start, end - start) + 1);
     }
 
-    bool is_str = self_type == &mp_type_str;
-
-    // count the occurrences
+    // count the non-overlapping occurrences
     mp_int_t num_occurrences = 0;
-    for (const byte *haystack_ptr = start; haystack_ptr + needle_len <= end;) {
-        if (memcmp(haystack_ptr, needle, needle_len) == 0) {
-            num_occurrences++;
-            haystack_ptr += needle_len;
-        } else {
-            haystack_ptr = is_str ? utf8_next_char(haystack_ptr) : haystack_ptr + 1;
+    for (const byte *haystack_ptr = start; haystack_ptr < end; haystack_ptr += needle_len) {
+        haystack_ptr = find_subbytes(haystack_ptr, end - haystack_ptr, needle, needle_len, 1);
+        if (haystack_ptr == NULL) {
+            break;
         }
+        num_occurrences++;
     }
 
     return MP_OBJ_NEW_SMALL_INT(num_occurrences);
@@ -36,6 +36,128 @@
 
 static mp_obj_t mp_obj_new_str_iterator(mp_obj_t str, mp_obj_iter_buf_t *iter_buf);
 
+#if MICROPY_PY_BUILTINS_STR_UNICODE_INDEX
+
+// Strings of at least this many bytes get a character index when they are
+// indexed further than STR_INDEX_STRIDE characters from either end.  The index
+// records the byte offset of every STR_INDEX_STRIDE'th character.
+#define STR_INDEX_MIN_LEN (64)
+#define STR_INDEX_STRIDE_LOG2 (5)
+#define STR_INDEX_STRIDE (1 << STR_INDEX_STRIDE_LOG2)
+
+// Hits of a cache entry saturate at this count, see str_index_get
+#define STR_INDEX_MAX_HITS (16)
+
+typedef struct _mp_str_index_t {
+    const byte *data;
+    size_t len;
+    size_t charlen;
+    size_t hits;
+    // Offsets of characters 0, STR_INDEX_STRIDE, 2 * STR_INDEX_STRIDE, etc; not
+    // present for pure ASCII strings, where the byte offset is the index
+    size_t offset[];
+} mp_str_index_t;
+
+// Recently indexed strings, most recently used first.  Apart from its hit
+// count an entry is never modified once it is in the cache, and it refers to
+// the string data, so the data can't be freed and reused for another string
+// while the entry exists.
+MP_REGISTER_ROOT_POINTER(struct _mp_str_index_t *str_index_cache[MICROPY_PY_BUILTINS_STR_UNICODE_INDEX_CACHE]);
+
+static const mp_str_index_t *str_index_lookup(const byte *data, size_t len) {
+    for (size_t i = 0; i < MICROPY_PY_BUILTINS_STR_UNICODE_INDEX_CACHE; ++i) {
+        const mp_str_index_t *idx = MP_STATE_VM(str_index_cache)[i];
+        if (idx != NULL && idx->data == data && idx->len == len) {
+            return idx;
+        }
+    }
+    return NULL;
+}
+
+// Count a cache miss of the given string in MP_STATE_VM(str_index_miss), which
+// keeps the strings that missed most recently, and return its entry there.
+static mp_str_index_miss_t *str_index_count_miss(const byte *data, size_t len) {
+    mp_str_index_miss_t *miss = MP_STATE_VM(str_index_miss);
+    size_t i = 0;
+    while (i < MICROPY_PY_BUILTINS_STR_UNICODE_INDEX_CACHE - 1 && (miss[i].data != data || miss[i].len != len)) {
+        ++i;
+    }
+    mp_str_index_miss_t m = miss[i];
+    if (m.data != data || m.len != len) {
+        m.data = data;
+        m.len = len;
+        m.count = 0;
+    }
+    m.count += 1;
+    memmove(miss + 1, miss, i * sizeof(*miss));
+    miss[0] = m;
+    return &miss[0];
+}
+
+// Returns the index of the given string, building it if needed, or NULL if it
+// is not worth building yet or there is not enough memory to build it.
+//
+// Once the cache is full, a string that misses only replaces the least
+// recently used entry after it has missed twice and more often than that entry
+// has been hit.  Otherwise cycling over more long strings than there are
+// entries would build an index and allocate on every access, and strings that
+// are indexed just once would evict the useful entries.  Each refused miss
+// takes a hit off the entry and hits saturate, so that the cache follows when
+// other strings become the ones indexed the most.
+static const mp_str_index_t *str_index_get(const byte *data, size_t len) {
+    mp_str_index_t **cache = MP_STATE_VM(str_index_cache);
+    for (size_t i = 0; i < MICROPY_PY_BUILTINS_STR_UNICODE_INDEX_CACHE; ++i) {
+        mp_str_index_t *idx = cache[i];
+        if (idx != NULL && idx->data == data && idx->len == len) {
+            memmove(cache + 1, cache, i * sizeof(*cache));
+            cache[0] = idx;
+            if (idx->hits < STR_INDEX_MAX_HITS) {
+                ++idx->hits;
+            }
+            return idx;
+        }
+    }
+    size_t hits = 0;
+    mp_str_index_t *lru = cache[MICROPY_PY_BUILTINS_STR_UNICODE_INDEX_CACHE - 1];
+    if (lru != NULL) {
+        mp_str_index_miss_t *miss = str_index_count_miss(data, len);
+        if (miss->count < 2 || miss->count <= lru->hits) {
+            if (lru->hits > 0) {
+                --lru->hits;
+            }
+            return NULL;
+        }
+        hits = MIN(miss->count, STR_INDEX_MAX_HITS);
+        miss->data = NULL;
+    }
+    size_t charlen = utf8_charlen(data, len);
+    size_t n = charlen == len ? 0 : (charlen >> STR_INDEX_STRIDE_LOG2) + 1;
+    mp_str_index_t *idx = m_new_obj_var_maybe(mp_str_index_t, offset, size_t, n);
+    if (idx == NULL) {
+        return NULL;
+    }
+    idx->data = data;
+    idx->len = len;
+    idx->charlen = charlen;
+    idx->hits = hits;
+    if (n != 0) {
+        size_t c = 0;
+        for (const byte *s = data, *top = data + len; s < top; ++s) {
+            if (!UTF8_IS_CONT(*s)) {
+                if ((c & (STR_INDEX_STRIDE - 1)) == 0) {
+                    idx->offset[c >> STR_INDEX_STRIDE_LOG2] = s - data;
+                }
+                ++c;
+            }
+        }
+    }
+    memmove(cache + 1, cache, (MICROPY_PY_BUILTINS_STR_UNICODE_INDEX_CACHE - 1) * sizeof(*cache));
+    cache[0] = idx;
+    return idx;
+}
+
+#endif
+
 /******************************************************************************/
 /* str                                                                        */
 
@@ -103,8 +225,15 @@ static mp_obj_t uni_unary_op(mp_unary_op_t op, mp_obj_t self_in) {
     switch (op) {
         case MP_UNARY_OP_BOOL:
             return mp_obj_new_bool(str_len != 0);
-        case MP_UNARY_OP_LEN:
+        case MP_UNARY_OP_LEN: {
+            #if MICROPY_PY_BUILTINS_STR_UNICODE_INDEX
+            const mp_str_index_t *idx = str_index_lookup(str_data, str_len);
+            if (idx != NULL) {
+                return MP_OBJ_NEW_SMALL_INT(idx->charlen);
+            }
+            #endif
             return MP_OBJ_NEW_SMALL_INT(utf8_charlen(str_data, str_len));
+        }
         default:
             return MP_OBJ_NULL; // op not supported
     }
@@ -136,6 +265,32 @@ const byte *str_index_to_ptr(const mp_obj_type_t *type, const byte *self_data, s
         mp_raise_msg_varg(&mp_type_TypeError, MP_ERROR_TEXT("string indices must be integers, not %s"), mp_obj_get_type_str(index));
     }
     const byte *s, *top = self_data + self_len;
+    #if MICROPY_PY_BUILTINS_STR_UNICODE_INDEX
+    // Walking a long way into a long string would make loops over its indices
+    // quadratic, so find the character from the index instead.
+    if (self_len >= STR_INDEX_MIN_LEN && (i >= STR_INDEX_STRIDE || i < -STR_INDEX_STRIDE)) {
+        const mp_str_index_t *idx = str_index_get(self_data, self_len);
+        if (idx != NULL) {
+            if (i < 0) {
+                i += idx->charlen;
+            }
+            if (i < 0 || (size_t)i >= idx->charlen) {
+                if (is_slice) {
+                    return i < 0 ? self_data : top;
+                }
+                mp_raise_msg(&mp_type_IndexError, MP_ERROR_TEXT("string index out of range"));
+            }
+            if (idx->charlen == self_len) {
+                return self_data + i;
+            }
+            s = self_data + idx->offset[i >> STR_INDEX_STRIDE_LOG2];
+            for (i &= STR_INDEX_STRIDE - 1; i; --i) {
+                s = utf8_next_char(s);
+            }
+            return s;
+        }
+    }
+    #endif
     if (i < 0) {
         // Negative indexing is performed by counting from the end of the string.
         for (s = top - 1; i; --s) {
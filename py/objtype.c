@@ -94,6 +94,116 @@ static mp_obj_t native_base_init_wrapper(size_t n_args, const mp_obj_t *args, mp
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(native_base_init_wrapper_obj, 1, native_base_init_wrapper);
 
+#if MICROPY_OPT_INSTANCE_SHAPES
+
+// Limits on the shapes of instances, past which they use a map instead.
+#define INSTANCE_SHAPE_MAX_ATTRS (16)
+#define INSTANCE_SHAPE_MAX_CHILDREN (8)
+
+// The values of the attributes are allocated in whole GC blocks.
+#define INSTANCE_VALUES_CHUNK (MICROPY_BYTES_PER_GC_BLOCK / sizeof(mp_obj_t))
+#define INSTANCE_VALUES_ALLOC(n) (((n) + INSTANCE_VALUES_CHUNK - 1) / INSTANCE_VALUES_CHUNK * INSTANCE_VALUES_CHUNK)
+
+// The type of a class has one slot more than mp_obj_new_type sets, which holds
+// the shape with no attributes that its instances start with.
+static size_t instance_type_num_slots(const mp_obj_type_t *type) {
+    return 10 + (type->slot_index_parent != 0) + (type->slot_index_protocol != 0);
+}
+
+static mp_obj_instance_shape_t *instance_shape_new(size_t num_attrs) {
+    mp_obj_instance_shape_t *shape = m_new_obj_var(mp_obj_instance_shape_t, attrs, qstr, num_attrs);
+    shape->children = NULL;
+    shape->sibling = NULL;
+    shape->num_children = 0;
+    shape->num_attrs = num_attrs;
+    return shape;
+}
+
+// Returns the shape with the given attribute added to the end, or NULL if
+// there would be too many shapes.
+static mp_obj_instance_shape_t *instance_shape_add(mp_obj_instance_shape_t *shape, qstr attr) {
+    size_t n = shape->num_attrs;
+    for (mp_obj_instance_shape_t *child = shape->children; child != NULL; child = child->sibling) {
+        if (child->attrs[n] == attr) {
+            return child;
+        }
+    }
+    if (n >= INSTANCE_SHAPE_MAX_ATTRS || shape->num_children >= INSTANCE_SHAPE_MAX_CHILDREN) {
+        return NULL;
+    }
+    mp_obj_instance_shape_t *child = instance_shape_new(n + 1);
+    memcpy(child->attrs, shape->attrs, n * sizeof(qstr));
+    child->attrs[n] = attr;
+    child->sibling = shape->children;
+    shape->children = child;
+    shape->num_children += 1;
+    return child;
+}
+
+// Moves the attributes of the instance from its shape to a new map.
+static void instance_convert_to_map(mp_obj_instance_t *self) {
+    const mp_obj_instance_shape_t *shape = self->shape;
+    mp_obj_t *values = self->members.values;
+    mp_map_t *map = m_new(mp_map_t, 1);
+    mp_map_init(map, shape->num_attrs);
+    for (size_t i = 0; i < shape->num_attrs; i++) {
+        mp_map_lookup(map, MP_OBJ_NEW_QSTR(shape->attrs[i]), MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)->value = values[i];
+    }
+    self->shape = NULL;
+    self->members.map = map;
+    m_del(mp_obj_t, values, INSTANCE_VALUES_ALLOC(shape->num_attrs));
+}
+
+void mp_obj_instance_add_member(mp_obj_instance_t *self, mp_obj_instance_shape_t *new_shape, mp_obj_t value) {
+    size_t n = self->shape->num_attrs;
+    if (n % INSTANCE_VALUES_CHUNK == 0) {
+        self->members.values = m_renew(mp_obj_t, self->members.values, n, n + INSTANCE_VALUES_CHUNK);
+    }
+    self->members.values[n] = value;
+    self->shape = new_shape;
+}
+
+void mp_obj_instance_store_member(mp_obj_instance_t *self, qstr attr, mp_obj_t value) {
+    mp_obj_instance_shape_t *shape = self->shape;
+    if (shape != NULL) {
+        mp_obj_t *member = mp_obj_instance_find_member(self, attr);
+        if (member != NULL) {
+            *member = value;
+            return;
+        }
+        mp_obj_instance_shape_t *new_shape = instance_shape_add(shape, attr);
+        if (new_shape != NULL) {
+            mp_obj_instance_add_member(self, new_shape, value);
+            return;
+        }
+        instance_convert_to_map(self);
+    }
+    mp_map_lookup(self->members.map, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)->value = value;
+}
+
+bool mp_obj_instance_delete_member(mp_obj_instance_t *self, qstr attr) {
+    if (self->shape != NULL) {
+        if (mp_obj_instance_find_member(self, attr) == NULL) {
+            return false;
+        }
+        // shapes only ever have attributes added
+        instance_convert_to_map(self);
+    }
+    return mp_map_lookup(self->members.map, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP_REMOVE_IF_FOUND) != NULL;
+}
+
+#else
+
+void mp_obj_instance_store_member(mp_obj_instance_t *self, qstr attr, mp_obj_t value) {
+    mp_map_lookup(&self->members, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)->value = value;
+}
+
+bool mp_obj_instance_delete_member(mp_obj_instance_t *self, qstr attr) {
+    return mp_map_lookup(&self->members, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP_REMOVE_IF_FOUND) != NULL;
+}
+
+#endif
+
 #if !MICROPY_CPYTHON_COMPAT
 static
 #endif
@@ -101,7 +211,12 @@ mp_obj_instance_t *mp_obj_new_instance(const mp_obj_type_t *class, const mp_obj_
     size_t num_native_bases = instance_count_native_bases(class, native_base);
     assert(num_native_bases < 2);
     mp_obj_instance_t *o = mp_obj_malloc_var(mp_obj_instance_t, subobj, mp_obj_t, num_native_bases, class);
+    #if MICROPY_OPT_INSTANCE_SHAPES
+    o->shape = (mp_obj_instance_shape_t *)class->slots[instance_type_num_slots(class)];
+    o->members.values = NULL;
+    #else
     mp_map_init(&o->members, 0);
+    #endif
     // Initialise the native base-class slot (should be 1 at most) with a valid
     // object.  It doesn't matter which object, so long as it can be uniquely
     // distinguished from a native class that is initialised.
@@ -131,11 +246,49 @@ struct class_lookup_data {
     size_t slot_offset;
     mp_obj_t *dest;
     bool is_type;
+    #if MICROPY_OPT_CLASS_LOOKUP_CACHE
+    // Where the attribute was found, for the cache, and whether the search
+    // depended on the instance (and so can't be cached).
+    const mp_obj_type_t *found_type;
+    mp_obj_t found_value;
+    bool uncacheable;
+    #endif
 };
 
-static void mp_obj_class_lookup(struct class_lookup_data *lookup, const mp_obj_type_t *type) {
-    assert(lookup->dest[0] == MP_OBJ_NULL);
-    assert(lookup->dest[1] == MP_OBJ_NULL);
+// Converts the value of an attribute found in the locals_dict of type (or
+// MP_OBJ_SENTINEL for a special method in a native slot) into lookup->dest.
+static void class_lookup_found(struct class_lookup_data *lookup, const mp_obj_type_t *type, mp_obj_t value) {
+    #if MICROPY_OPT_CLASS_LOOKUP_CACHE
+    lookup->found_type = type;
+    lookup->found_value = value;
+    #endif
+    if (value == MP_OBJ_SENTINEL) {
+        lookup->dest[0] = MP_OBJ_SENTINEL;
+    } else if (lookup->is_type) {
+        // If we look up a class method, we need to return original type for which we
+        // do a lookup, not a (base) type in which we found the class method.
+        const mp_obj_type_t *org_type = (const mp_obj_type_t *)lookup->obj;
+        mp_convert_member_lookup(MP_OBJ_NULL, org_type, value, lookup->dest);
+    } else {
+        mp_obj_instance_t *obj = lookup->obj;
+        mp_obj_t obj_obj;
+        if (obj != NULL && mp_obj_is_native_type(type) && type != &mp_type_object /* object is not a real type */) {
+            // If we're dealing with native base class, then it applies to native sub-object
+            obj_obj = obj->subobj[0];
+            #if MICROPY_BUILTIN_METHOD_CHECK_SELF_ARG
+            if (obj_obj == MP_OBJ_FROM_PTR(&native_base_init_wrapper_obj)) {
+                // But we shouldn't attempt lookups on object that is not yet instantiated.
+                mp_raise_msg(&mp_type_AttributeError, MP_ERROR_TEXT("call super().__init__() first"));
+            }
+            #endif // MICROPY_BUILTIN_METHOD_CHECK_SELF_ARG
+        } else {
+            obj_obj = MP_OBJ_FROM_PTR(obj);
+        }
+        mp_convert_member_lookup(obj_obj, type, value, lookup->dest);
+    }
+}
+
+static void class_lookup_search(struct class_lookup_data *lookup, const mp_obj_type_t *type) {
     for (;;) {
         DEBUG_printf("mp_obj_class_lookup: Looking up %s in %s\n", qstr_str(lookup->attr), qstr_str(type->name));
         // Optimize special method lookup for native types
@@ -149,7 +302,7 @@ static void mp_obj_class_lookup(struct class_lookup_data *lookup, const mp_obj_t
             if (MP_OBJ_TYPE_HAS_SLOT_BY_OFFSET(type, lookup->slot_offset) || (lookup->slot_offset == MP_OBJ_TYPE_OFFSETOF_SLOT(iter) && type->flags & MP_TYPE_FLAG_ITER_IS_STREAM)) {
                 DEBUG_printf("mp_obj_class_lookup: Matched special meth slot (off=%d) for %s\n",
                     lookup->slot_offset, qstr_str(lookup->attr));
-                lookup->dest[0] = MP_OBJ_SENTINEL;
+                class_lookup_found(lookup, type, MP_OBJ_SENTINEL);
                 return;
             }
         }
@@ -160,28 +313,7 @@ static void mp_obj_class_lookup(struct class_lookup_data *lookup, const mp_obj_t
             mp_map_t *locals_map = &MP_OBJ_TYPE_GET_SLOT(type, locals_dict)->map;
             mp_map_elem_t *elem = mp_map_lookup(locals_map, MP_OBJ_NEW_QSTR(lookup->attr), MP_MAP_LOOKUP);
             if (elem != NULL) {
-                if (lookup->is_type) {
-                    // If we look up a class method, we need to return original type for which we
-                    // do a lookup, not a (base) type in which we found the class method.
-                    const mp_obj_type_t *org_type = (const mp_obj_type_t *)lookup->obj;
-                    mp_convert_member_lookup(MP_OBJ_NULL, org_type, elem->value, lookup->dest);
-                } else {
-                    mp_obj_instance_t *obj = lookup->obj;
-                    mp_obj_t obj_obj;
-                    if (obj != NULL && mp_obj_is_native_type(type) && type != &mp_type_object /* object is not a real type */) {
-                        // If we're dealing with native base class, then it applies to native sub-object
-                        obj_obj = obj->subobj[0];
-                        #if MICROPY_BUILTIN_METHOD_CHECK_SELF_ARG
-                        if (obj_obj == MP_OBJ_FROM_PTR(&native_base_init_wrapper_obj)) {
-                            // But we shouldn't attempt lookups on object that is not yet instantiated.
-                            mp_raise_msg(&mp_type_AttributeError, MP_ERROR_TEXT("call super().__init__() first"));
-                        }
-                        #endif // MICROPY_BUILTIN_METHOD_CHECK_SELF_ARG
-                    } else {
-                        obj_obj = MP_OBJ_FROM_PTR(obj);
-                    }
-                    mp_convert_member_lookup(obj_obj, type, elem->value, lookup->dest);
-                }
+                class_lookup_found(lookup, type, elem->value);
                 #if DEBUG_PRINT
                 DEBUG_printf("mp_obj_class_lookup: Returning: ");
                 mp_obj_print_helper(MICROPY_DEBUG_PRINTER, lookup->dest[0], PRINT_REPR);
@@ -198,10 +330,16 @@ static void mp_obj_class_lookup(struct class_lookup_data *lookup, const mp_obj_t
         // Previous code block takes care about attributes defined in .locals_dict,
         // but some attributes of native types may be handled using .load_attr method,
         // so make sure we try to lookup those too.
-        if (lookup->obj != NULL && !lookup->is_type && mp_obj_is_native_type(type) && type != &mp_type_object /* object is not a real type */) {
-            mp_load_method_maybe(lookup->obj->subobj[0], lookup->attr, lookup->dest);
-            if (lookup->dest[0] != MP_OBJ_NULL) {
-                return;
+        if (mp_obj_is_native_type(type) && type != &mp_type_object /* object is not a real type */) {
+            #if MICROPY_OPT_CLASS_LOOKUP_CACHE
+            // from here on the result depends on the instance
+            lookup->uncacheable = true;
+            #endif
+            if (lookup->obj != NULL && !lookup->is_type) {
+                mp_load_method_maybe(lookup->obj->subobj[0], lookup->attr, lookup->dest);
+                if (lookup->dest[0] != MP_OBJ_NULL) {
+                    return;
+                }
             }
         }
 
@@ -222,7 +360,7 @@ static void mp_obj_class_lookup(struct class_lookup_data *lookup, const mp_obj_t
                     // Not a "real" type
                     continue;
                 }
-                mp_obj_class_lookup(lookup, bt);
+                class_lookup_search(lookup, bt);
                 if (lookup->dest[0] != MP_OBJ_NULL) {
                     return;
                 }
@@ -242,6 +380,87 @@ static void mp_obj_class_lookup(struct class_lookup_data *lookup, const mp_obj_t
     }
 }
 
+#if MICROPY_OPT_CLASS_LOOKUP_CACHE
+// The cache maps (type, attr, slot_offset) to where the search found the
+// attribute, if anywhere.  An entry is valid while MP_STATE_VM(class_lookup_version)
+// is unchanged, which is incremented whenever a class is created or has an
+// attribute stored or deleted, including through its locals dict (marked with
+// is_class_locals), and at the start of each garbage collection.  The cache is
+// not traced, so a freed class may otherwise leave entries for its address to
+// a new type.  This is simpler than a version per type and invalidates
+// subclasses as well; classes are rarely changed once created.
+// Searches which pass a native base class other than object aren't cached,
+// because then the result can come from the native sub-object of the instance.
+void mp_obj_class_lookup_invalidate(void) {
+    if (++MP_STATE_VM(class_lookup_version) == 0) {
+        // on wrap-around, make sure no old entry matches
+        memset(MP_STATE_VM(class_lookup_cache), 0, sizeof(MP_STATE_VM(class_lookup_cache)));
+    }
+}
+
+#if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
+// Without the GIL only the main thread uses the cache, so it needs no locking
+#define CLASS_LOOKUP_CACHE_USABLE() (mp_thread_is_main_thread())
+#else
+#define CLASS_LOOKUP_CACHE_USABLE() (true)
+#endif
+#endif
+
+static void mp_obj_class_lookup(struct class_lookup_data *lookup, const mp_obj_type_t *type) {
+    assert(lookup->dest[0] == MP_OBJ_NULL);
+    assert(lookup->dest[1] == MP_OBJ_NULL);
+    #if MICROPY_OPT_CLASS_LOOKUP_CACHE
+    if (!CLASS_LOOKUP_CACHE_USABLE()) {
+        class_lookup_search(lookup, type);
+        return;
+    }
+    size_t version = MP_STATE_VM(class_lookup_version);
+    size_t index = ((uintptr_t)type / sizeof(mp_obj_t) ^ lookup->attr * 5 ^ lookup->slot_offset)
+        & (MICROPY_OPT_CLASS_LOOKUP_CACHE_SIZE - 1);
+    mp_class_lookup_cache_entry_t *entry = &MP_STATE_VM(class_lookup_cache)[index];
+    if (entry->version == version && entry->type == type
+        && entry->attr == lookup->attr && entry->slot_offset == lookup->slot_offset) {
+        if (entry->found_type != NULL) {
+            class_lookup_found(lookup, entry->found_type, entry->value);
+        }
+        return;
+    }
+    lookup->found_type = NULL;
+    lookup->found_value = MP_OBJ_NULL;
+    lookup->uncacheable = false;
+    class_lookup_search(lookup, type);
+    if (!lookup->uncacheable) {
+        entry->version = version;
+        entry->type = type;
+        entry->attr = lookup->attr;
+        entry->slot_offset = lookup->slot_offset;
+        entry->found_type = lookup->found_type;
+        entry->value = lookup->found_value;
+    }
+    #else
+    class_lookup_search(lookup, type);
+    #endif
+}
+
+#if MICROPY_OPT_INLINE_CACHE
+bool mp_obj_instance_type_is_plain(const mp_obj_type_t *type) {
+    const mp_obj_type_t *native_base = NULL;
+    if (instance_count_native_bases(type, &native_base) != 0) {
+        return false;
+    }
+    mp_obj_t member[2] = {MP_OBJ_NULL};
+    struct class_lookup_data lookup = {
+        .obj = NULL,
+        .attr = MP_QSTR___getattr__,
+        .slot_offset = 0,
+        .dest = member,
+        .is_type = false,
+    };
+    mp_obj_class_lookup(&lookup, type);
+    return member[0] == MP_OBJ_NULL;
+}
+#endif
+
 static void instance_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
     mp_obj_instance_t *self = MP_OBJ_TO_PTR(self_in);
     qstr meth = (kind == PRINT_STR) ? MP_QSTR___str__ : MP_QSTR___repr__;
@@ -410,8 +629,16 @@ static mp_obj_t instance_unary_op(mp_unary_op_t op, mp_obj_t self_in) {
         const mp_obj_type_t *native_base;
         size_t num_native_bases = instance_count_native_bases(mp_obj_get_type(self_in), &native_base);
 
-        size_t sz = sizeof(*self) + sizeof(*self->subobj) * num_native_bases
-            + sizeof(*self->members.table) * self->members.alloc;
+        size_t sz = sizeof(*self) + sizeof(*self->subobj) * num_native_bases;
+        #if MICROPY_OPT_INSTANCE_SHAPES
+        if (self->shape != NULL) {
+            sz += sizeof(mp_obj_t) * INSTANCE_VALUES_ALLOC(self->shape->num_attrs);
+        } else {
+            sz += sizeof(mp_map_t) + sizeof(*self->members.map->table) * self->members.map->alloc;
+        }
+        #else
+        sz += sizeof(*self->members.table) * self->members.alloc;
+        #endif
         return MP_OBJ_NEW_SMALL_INT(sz);
     }
     #endif
@@ -589,20 +816,35 @@ static void mp_obj_instance_load_attr(mp_obj_t self_in, qstr attr, mp_obj_t *des
     mp_obj_instance_t *self = MP_OBJ_TO_PTR(self_in);
 
     // Note: This is fast-path'ed in the VM for the MP_BC_LOAD_ATTR operation.
-    mp_map_elem_t *elem = mp_map_lookup(&self->members, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP);
-    if (elem != NULL) {
+    mp_obj_t *value = mp_obj_instance_find_member(self, attr);
+    if (value != NULL) {
         // object member, always treated as a value
-        dest[0] = elem->value;
+        dest[0] = *value;
         return;
     }
     #if MICROPY_CPYTHON_COMPAT
     if (attr == MP_QSTR___dict__) {
         // Create a new dict with a copy of the instance's map items.
         // This creates, unlike CPython, a read-only __dict__ that can't be modified.
-        mp_obj_dict_t dict;
-        dict.base.type = &mp_type_dict;
-        dict.map = self->members;
-        dest[0] = mp_obj_dict_copy(MP_OBJ_FROM_PTR(&dict));
+        #if MICROPY_OPT_INSTANCE_SHAPES
+        if (self->shape != NULL) {
+            const mp_obj_instance_shape_t *shape = self->shape;
+            dest[0] = mp_obj_new_dict(shape->num_attrs);
+            for (size_t i = 0; i < shape->num_attrs; i++) {
+                mp_obj_dict_store(dest[0], MP_OBJ_NEW_QSTR(shape->attrs[i]), self->members.values[i]);
+            }
+        } else
+        #endif
+        {
+            mp_obj_dict_t dict;
+            dict.base.type = &mp_type_dict;
+            #if MICROPY_OPT_INSTANCE_SHAPES
+            dict.map = *self->members.map;
+            #else
+            dict.map = self->members;
+            #endif
+            dest[0] = mp_obj_dict_copy(MP_OBJ_FROM_PTR(&dict));
+        }
         mp_obj_dict_t *dest_dict = MP_OBJ_TO_PTR(dest[0]);
         dest_dict->map.is_fixed = 1;
         return;
@@ -801,11 +1043,10 @@ skip_special_accessors:
 
     if (value == MP_OBJ_NULL) {
         // delete attribute
-        mp_map_elem_t *elem = mp_map_lookup(&self->members, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP_REMOVE_IF_FOUND);
-        return elem != NULL;
+        return mp_obj_instance_delete_member(self, attr);
     } else {
         // store attribute
-        mp_map_lookup(&self->members, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)->value = value;
+        mp_obj_instance_store_member(self, attr, value);
         return true;
     }
 }
@@ -1083,6 +1324,9 @@ static void type_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
                 // can't apply delete/store to a fixed map
                 return;
             }
+            #if MICROPY_OPT_CLASS_LOOKUP_CACHE
+            mp_obj_class_lookup_invalidate();
+            #endif
             if (dest[1] == MP_OBJ_NULL) {
                 // delete attribute
                 mp_map_elem_t *elem = mp_map_lookup(locals_map, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP_REMOVE_IF_FOUND);
@@ -1170,10 +1414,12 @@ mp_obj_t mp_obj_new_type(qstr name, mp_obj_t bases_tuple, mp_obj_t locals_dict)
     }
 
     // Allocate a variable-sized mp_obj_type_t with as many slots as we need
-    // (currently 10, plus 1 for base, plus 1 for base-protocol).
+    // (currently 10, plus 1 for base, plus 1 for base-protocol, plus 1 for the
+    // root shape of instances).
     // Note: mp_obj_type_t is (2 + 3 + #slots) words, so going from 11 to 12 slots
     // moves from 4 to 5 gc blocks.
-    mp_obj_type_t *o = m_new_obj_var0(mp_obj_type_t, slots, void *, 10 + (bases_len ? 1 : 0) + (base_protocol ? 1 : 0));
+    size_t num_slots = 10 + (bases_len ? 1 : 0) + (base_protocol ? 1 : 0);
+    mp_obj_type_t *o = m_new_obj_var0(mp_obj_type_t, slots, void *, num_slots + MICROPY_OPT_INSTANCE_SHAPES);
     o->base.type = &mp_type_type;
     o->flags = base_flags;
     o->name = name;
@@ -1189,6 +1435,10 @@ mp_obj_t mp_obj_new_type(qstr name, mp_obj_t bases_tuple, mp_obj_t locals_dict)
 
     mp_obj_dict_t *locals_ptr = MP_OBJ_TO_PTR(locals_dict);
     MP_OBJ_TYPE_SET_SLOT(o, locals_dict, locals_ptr, 9);
+    #if MICROPY_OPT_CLASS_LOOKUP_CACHE
+    // the dict is shared with the caller, eg locals() in the class body
+    locals_ptr->map.is_class_locals = 1;
+    #endif
 
     if (bases_len > 0) {
         if (bases_len >= 2) {
@@ -1210,6 +1460,11 @@ mp_obj_t mp_obj_new_type(qstr name, mp_obj_t bases_tuple, mp_obj_t locals_dict)
         }
     }
 
+    #if MICROPY_OPT_INSTANCE_SHAPES
+    assert(instance_type_num_slots(o) == num_slots);
+    o->slots[num_slots] = instance_shape_new(0);
+    #endif
+
     #if ENABLE_SPECIAL_ACCESSORS
     // Check if the class has any special accessor methods
     if (!(o->flags & MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS)) {
@@ -1231,6 +1486,11 @@ mp_obj_t mp_obj_new_type(qstr name, mp_obj_t bases_tuple, mp_obj_t locals_dict)
         mp_raise_TypeError(MP_ERROR_TEXT("multiple bases have instance lay-out conflict"));
     }
 
+    #if MICROPY_OPT_CLASS_LOOKUP_CACHE
+    // the new type may be at the address of one which was freed
+    mp_obj_class_lookup_invalidate();
+    #endif
+
     mp_map_t *locals_map = &MP_OBJ_TYPE_GET_SLOT(o, locals_dict)->map;
     mp_map_elem_t *elem = mp_map_lookup(locals_map, MP_OBJ_NEW_QSTR(MP_QSTR___new__), MP_MAP_LOOKUP);
     if (elem != NULL) {
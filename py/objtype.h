@@ -28,11 +28,34 @@
 
 #include "py/obj.h"
 
+#if MICROPY_OPT_INSTANCE_SHAPES
+// The names of the attributes of an instance, in the order they were added.
+// Shapes form a tree for each class, rooted at the shape with no attributes,
+// and are shared by all instances which have the same attributes.
+typedef struct _mp_obj_instance_shape_t {
+    struct _mp_obj_instance_shape_t *children; // shapes with one more attribute
+    struct _mp_obj_instance_shape_t *sibling; // next child of the same parent
+    uint16_t num_children;
+    uint16_t num_attrs;
+    qstr attrs[];
+} mp_obj_instance_shape_t;
+#endif
+
 // instance object
 // creating an instance of a class makes one of these objects
 typedef struct _mp_obj_instance_t {
     mp_obj_base_t base;
+    #if MICROPY_OPT_INSTANCE_SHAPES
+    // If shape is not NULL then members.values[i] is the value of the attribute
+    // shape->attrs[i], otherwise the attributes are stored in members.map.
+    mp_obj_instance_shape_t *shape;
+    union {
+        mp_obj_t *values;
+        mp_map_t *map;
+    } members;
+    #else
     mp_map_t members;
+    #endif
     mp_obj_t subobj[];
     // TODO maybe cache __getattr__ and __setattr__ for efficient lookup of them
 } mp_obj_instance_t;
@@ -42,6 +65,42 @@ typedef struct _mp_obj_instance_t {
 mp_obj_instance_t *mp_obj_new_instance(const mp_obj_type_t *cls, const mp_obj_type_t **native_base);
 #endif
 
+// Returns a pointer to the value of the given attribute of the instance itself
+// (not of its class), or NULL if it doesn't have one.
+static inline mp_obj_t *mp_obj_instance_find_member(mp_obj_instance_t *self, qstr attr) {
+    #if MICROPY_OPT_INSTANCE_SHAPES
+    const mp_obj_instance_shape_t *shape = self->shape;
+    if (shape != NULL) {
+        for (size_t i = 0; i < shape->num_attrs; i++) {
+            if (shape->attrs[i] == attr) {
+                return &self->members.values[i];
+            }
+        }
+        return NULL;
+    }
+    mp_map_elem_t *elem = mp_map_lookup(self->members.map, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP);
+    #else
+    mp_map_elem_t *elem = mp_map_lookup(&self->members, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP);
+    #endif
+    return elem == NULL ? NULL : &elem->value;
+}
+
+// these store or delete attributes of the instance itself, bypassing its class
+void mp_obj_instance_store_member(mp_obj_instance_t *self, qstr attr, mp_obj_t value);
+bool mp_obj_instance_delete_member(mp_obj_instance_t *self, qstr attr);
+
+#if MICROPY_OPT_INSTANCE_SHAPES
+// adds the last attribute of new_shape, a child of the shape of the instance
+void mp_obj_instance_add_member(mp_obj_instance_t *self, mp_obj_instance_shape_t *new_shape, mp_obj_t value);
+#endif
+
+#if MICROPY_OPT_INLINE_CACHE
+// whether what an attribute of instances of the class is, when the instance
+// itself doesn't have it, depends only on the dicts of the class and its bases
+// (it has no native base class and no __getattr__)
+bool mp_obj_instance_type_is_plain(const mp_obj_type_t *type);
+#endif
+
 // these need to be exposed so mp_obj_is_callable can work correctly
 bool mp_obj_instance_is_callable(mp_obj_t self_in);
 mp_obj_t mp_obj_instance_call(mp_obj_t self_in, size_t n_args, size_t n_kw, const mp_obj_t *args);
@@ -52,4 +111,9 @@ mp_obj_t mp_obj_instance_call(mp_obj_t self_in, size_t n_args, size_t n_kw, cons
 // this needs to be exposed for mp_getiter
 mp_obj_t mp_obj_instance_getiter(mp_obj_t self_in, mp_obj_iter_buf_t *iter_buf);
 
+#if MICROPY_OPT_CLASS_LOOKUP_CACHE
+// must be called when the locals_dict of any class is changed
+void mp_obj_class_lookup_invalidate(void);
+#endif
+
 #endif // MICROPY_INCLUDED_PY_OBJTYPE_H
@@ -464,7 +464,8 @@ void mp_raw_code_load(mp_reader_t *reader, mp_compiled_module_t *cm) {
     read_bytes(reader, header, sizeof(header));
     byte arch = MPY_FEATURE_DECODE_ARCH(header[2]);
     if (header[0] != 'M'
-        || header[1] != MPY_VERSION
+        || header[1] < MPY_VERSION_MIN
+        || header[1] > MPY_VERSION
         || (arch != MP_NATIVE_ARCH_NONE && MPY_FEATURE_DECODE_SUB_VERSION(header[2]) != MPY_SUB_VERSION)
         || header[3] > MP_SMALL_INT_BITS) {
         mp_raise_ValueError(MP_ERROR_TEXT("incompatible .mpy file"));
@@ -530,6 +531,71 @@ void mp_raw_code_load_file(qstr filename, mp_compiled_module_t *context) {
 
 #include "py/objstr.h"
 
+#define MP_BC_OPCODE_HAS_SIGNED_OFFSET(opcode) (MP_BC_UNWIND_JUMP <= (opcode) && (opcode) <= MP_BC_POP_JUMP_IF_FALSE)
+
+typedef struct _mp_opcode_t {
+    uint8_t opcode;
+    uint8_t format;
+    uint8_t size;
+    mp_int_t arg;
+    uint8_t extra_arg;
+} mp_opcode_t;
+
+static mp_opcode_t mp_opcode_decode(const uint8_t *ip) {
+    const uint8_t *ip_start = ip;
+    uint8_t opcode = *ip++;
+    uint8_t opcode_format = MP_BC_FORMAT(opcode);
+    mp_uint_t arg = 0;
+    uint8_t extra_arg = 0;
+    if (opcode_format == MP_BC_FORMAT_QSTR || opcode_format == MP_BC_FORMAT_VAR_UINT) {
+        arg = *ip & 0x7f;
+        if (opcode == MP_BC_LOAD_CONST_SMALL_INT && (arg & 0x40) != 0) {
+            arg |= (mp_uint_t)(-1) << 7;
+        }
+        while ((*ip & 0x80) != 0) {
+            arg = (arg << 7) | (*++ip & 0x7f);
+        }
+        ++ip;
+    } else if (opcode_format == MP_BC_FORMAT_OFFSET) {
+        if ((*ip & 0x80) == 0) {
+            arg = *ip++;
+            if (MP_BC_OPCODE_HAS_SIGNED_OFFSET(opcode)) {
+                arg -= 0x40;
+            }
+        } else {
+            arg = (ip[0] & 0x7f) | (ip[1] << 7);
+            ip += 2;
+            if (MP_BC_OPCODE_HAS_SIGNED_OFFSET(opcode)) {
+                arg -= 0x4000;
+            }
+        }
+    }
+    if (MP_BC_OPCODE_HAS_EXTRA_BYTE(opcode)) {
+        extra_arg = *ip++;
+    }
+
+    mp_opcode_t op = { opcode, opcode_format, ip - ip_start, arg, extra_arg };
+    return op;
+}
+
+// Whether an opcode is one of those added by .mpy version 7.
+static bool mp_opcode_is_mpy_v7(uint8_t opcode) {
+    switch (opcode) {
+        case MP_BC_LOAD_FAST_LOAD_ATTR:
+        case MP_BC_LOAD_FAST_LOAD_METHOD:
+        case MP_BC_LOAD_FAST_BINARY_OP_SMALL_INT:
+        case MP_BC_STORE_FAST_LOAD_FAST:
+        case MP_BC_BINARY_OP_POP_JUMP_IF:
+        case MP_BC_FORMAT_VALUE:
+        case MP_BC_BUILD_STRING:
+        case MP_BC_BINARY_OP_TEMP:
+        case MP_BC_BINARY_OP_TEMP_RESULT:
+            return true;
+        default:
+            return false;
+    }
+}
+
 static void mp_print_bytes(mp_print_t *print, const byte *data, size_t len) {
     print->print_strn(print->data, (const char *)data, len);
 }
@@ -628,6 +694,29 @@ static void save_obj(mp_print_t *print, mp_obj_t o) {
 
 #if MICROPY_PERSISTENT_CODE_SAVE
 
+// Return the .mpy version needed by a raw code and its children.
+static byte raw_code_mpy_version(const mp_raw_code_t *rc) {
+    if (rc->kind == MP_CODE_BYTECODE) {
+        const byte *ip = rc->fun_data;
+        const byte *ip_top = ip + rc->fun_data_len;
+        MP_BC_PRELUDE_SIG_DECODE(ip);
+        MP_BC_PRELUDE_SIZE_DECODE(ip);
+        for (ip += n_info + n_cell; ip < ip_top;) {
+            mp_opcode_t op = mp_opcode_decode(ip);
+            if (mp_opcode_is_mpy_v7(op.opcode)) {
+                return MPY_VERSION;
+            }
+            ip += op.size;
+        }
+    }
+    for (size_t i = 0; i < rc->n_children; ++i) {
+        if (raw_code_mpy_version(rc->children[i]) == MPY_VERSION) {
+            return MPY_VERSION;
+        }
+    }
+    return MPY_VERSION_MIN;
+}
+
 static void save_raw_code(mp_print_t *print, const mp_raw_code_t *rc) {
     // Save function kind and data length
     mp_print_uint(print, (rc->fun_data_len << 3) | ((rc->n_children != 0) << 2) | (rc->kind - MP_CODE_BYTECODE));
@@ -669,7 +758,7 @@ void mp_raw_code_save(mp_compiled_module_t *cm, mp_print_t *print) {
     //  byte  number of bits in a small int
     byte header[4] = {
         'M',
-        MPY_VERSION,
+        raw_code_mpy_version(cm->rc),
         cm->has_native ? MPY_FEATURE_ENCODE_SUB_VERSION(MPY_SUB_VERSION) | MPY_FEATURE_ENCODE_ARCH(MPY_FEATURE_ARCH_DYNAMIC) : 0,
         #if MICROPY_DYNAMIC_COMPILER
         mp_dynamic_compiler.small_int_bits,
@@ -736,8 +825,6 @@ void mp_raw_code_save_file(mp_compiled_module_t *cm, qstr filename) {
 #include "py/smallint.h"
 #include "py/gc.h"
 
-#define MP_BC_OPCODE_HAS_SIGNED_OFFSET(opcode) (MP_BC_UNWIND_JUMP <= (opcode) && (opcode) <= MP_BC_POP_JUMP_IF_FALSE)
-
 typedef struct _bit_vector_t {
     size_t max_bit_set;
     size_t alloc;
@@ -771,51 +858,6 @@ static void bit_vector_set(bit_vector_t *self, size_t index) {
     self->bits[index / bits_size] |= 1 << (index % bits_size);
 }
 
-typedef struct _mp_opcode_t {
-    uint8_t opcode;
-    uint8_t format;
-    uint8_t size;
-    mp_int_t arg;
-    uint8_t extra_arg;
-} mp_opcode_t;
-
-static mp_opcode_t mp_opcode_decode(const uint8_t *ip) {
-    const uint8_t *ip_start = ip;
-    uint8_t opcode = *ip++;
-    uint8_t opcode_format = MP_BC_FORMAT(opcode);
-    mp_uint_t arg = 0;
-    uint8_t extra_arg = 0;
-    if (opcode_format == MP_BC_FORMAT_QSTR || opcode_format == MP_BC_FORMAT_VAR_UINT) {
-        arg = *ip & 0x7f;
-        if (opcode == MP_BC_LOAD_CONST_SMALL_INT && (arg & 0x40) != 0) {
-            arg |= (mp_uint_t)(-1) << 7;
-        }
-        while ((*ip & 0x80) != 0) {
-            arg = (arg << 7) | (*++ip & 0x7f);
-        }
-        ++ip;
-    } else if (opcode_format == MP_BC_FORMAT_OFFSET) {
-        if ((*ip & 0x80) == 0) {
-            arg = *ip++;
-            if (MP_BC_OPCODE_HAS_SIGNED_OFFSET(opcode)) {
-                arg -= 0x40;
-            }
-        } else {
-            arg = (ip[0] & 0x7f) | (ip[1] << 7);
-            ip += 2;
-            if (MP_BC_OPCODE_HAS_SIGNED_OFFSET(opcode)) {
-                arg -= 0x4000;
-            }
-        }
-    }
-    if ((opcode & MP_BC_MASK_EXTRA_BYTE) == 0) {
-        extra_arg = *ip++;
-    }
-
-    mp_opcode_t op = { opcode, opcode_format, ip - ip_start, arg, extra_arg };
-    return op;
-}
-
 mp_obj_t mp_raw_code_save_fun_to_bytes(const mp_module_constants_t *consts, const uint8_t *bytecode) {
     const uint8_t *fun_data = bytecode;
     const uint8_t *fun_data_top = fun_data + gc_nbytes(fun_data);
@@ -846,8 +888,12 @@ mp_obj_t mp_raw_code_save_fun_to_bytes(const mp_module_constants_t *consts, cons
     ip += n_info + n_cell;
 
     // Decode bytecode.
+    byte mpy_version = MPY_VERSION_MIN;
     while (ip < fun_data_top) {
         mp_opcode_t op = mp_opcode_decode(ip);
+        if (mp_opcode_is_mpy_v7(op.opcode)) {
+            mpy_version = MPY_VERSION;
+        }
         if (op.opcode == MP_BC_BASE_RESERVED) {
             // End of opcodes.
             fun_data_top = ip;
@@ -866,7 +912,7 @@ mp_obj_t mp_raw_code_save_fun_to_bytes(const mp_module_constants_t *consts, cons
     vstr_init_print(&vstr, 64, &print);
 
     // Start with .mpy header.
-    const uint8_t header[4] = { 'M', MPY_VERSION, 0, MP_SMALL_INT_BITS };
+    const uint8_t header[4] = { 'M', mpy_version, 0, MP_SMALL_INT_BITS };
     mp_print_bytes(&print, header, sizeof(header));
 
     // Number of entries in constant table.
@@ -31,10 +31,14 @@
 #include "py/emitglue.h"
 
 // The current version of .mpy files. A bytecode-only .mpy file can be loaded
-// as long as MPY_VERSION matches, but a native .mpy (i.e. one with an arch
-// set) must also match MPY_SUB_VERSION. This allows 3 additional updates to
-// the native ABI per bytecode revision.
-#define MPY_VERSION 6
+// as long as its version is between MPY_VERSION_MIN and MPY_VERSION, but a
+// native .mpy (i.e. one with an arch set) must also match MPY_SUB_VERSION.
+// This allows 3 additional updates to the native ABI per bytecode revision.
+// Version 7 is version 6 plus the superinstructions, FORMAT_VALUE, BUILD_STRING
+// and BINARY_OP_TEMP opcodes (see py/bc0.h), with the same native ABI.  A file
+// is only written as version 7 if its bytecode uses one of those opcodes.
+#define MPY_VERSION 7
+#define MPY_VERSION_MIN 6
 #define MPY_SUB_VERSION 3
 
 // Macros to encode/decode sub-version to/from the feature byte. This replaces
@@ -73,6 +77,8 @@
     #define MPY_FEATURE_ARCH (MP_NATIVE_ARCH_XTENSAWIN)
 #elif MICROPY_EMIT_RV32
     #define MPY_FEATURE_ARCH (MP_NATIVE_ARCH_RV32IMC)
+#elif MICROPY_EMIT_SH
+    #define MPY_FEATURE_ARCH (MP_NATIVE_ARCH_SH4)
 #else
     #define MPY_FEATURE_ARCH (MP_NATIVE_ARCH_NONE)
 #endif
@@ -98,7 +104,8 @@ enum {
     MP_NATIVE_ARCH_XTENSA,
     MP_NATIVE_ARCH_XTENSAWIN,
     MP_NATIVE_ARCH_RV32IMC,
-    MP_NATIVE_ARCH_DEBUG, // this entry should always be last
+    MP_NATIVE_ARCH_DEBUG,
+    MP_NATIVE_ARCH_SH4, // after DEBUG, so the upstream values are unchanged
 };
 
 enum {
@@ -121,6 +128,14 @@ void mp_raw_code_load_file(qstr filename, mp_compiled_module_t *ctx);
 
 void mp_raw_code_save(mp_compiled_module_t *cm, mp_print_t *print);
 void mp_raw_code_save_file(mp_compiled_module_t *cm, qstr filename);
+
+#if MICROPY_PERSISTENT_CODE_CACHE
+// A port enabling the compiled code cache provides these. The load function
+// fills cm and returns true if an up-to-date compilation of the source file is
+// available; the store function receives each freshly-compiled source file.
+bool mp_raw_code_cache_load(qstr source_file, mp_compiled_module_t *cm);
+void mp_raw_code_cache_store(qstr source_file, mp_compiled_module_t *cm);
+#endif
 mp_obj_t mp_raw_code_save_fun_to_bytes(const mp_module_constants_t *consts, const uint8_t *bytecode);
 
 void mp_native_relocate(void *reloc, uint8_t *text, uintptr_t reloc_text);
@@ -10,6 +10,7 @@ set(MICROPY_SOURCE_PY
     ${MICROPY_PY_DIR}/asmarm.c
     ${MICROPY_PY_DIR}/asmbase.c
     ${MICROPY_PY_DIR}/asmrv32.c
+    ${MICROPY_PY_DIR}/asmsh.c
     ${MICROPY_PY_DIR}/asmthumb.c
     ${MICROPY_PY_DIR}/asmx64.c
     ${MICROPY_PY_DIR}/asmx86.c
@@ -30,6 +31,7 @@ set(MICROPY_SOURCE_PY
     ${MICROPY_PY_DIR}/emitnarm.c
     ${MICROPY_PY_DIR}/emitndebug.c
     ${MICROPY_PY_DIR}/emitnrv32.c
+    ${MICROPY_PY_DIR}/emitnsh.c
     ${MICROPY_PY_DIR}/emitnthumb.c
     ${MICROPY_PY_DIR}/emitnx64.c
     ${MICROPY_PY_DIR}/emitnx86.c
@@ -63,6 +65,7 @@ set(MICROPY_SOURCE_PY
     ${MICROPY_PY_DIR}/nlrrv32.c
     ${MICROPY_PY_DIR}/nlrrv64.c
     ${MICROPY_PY_DIR}/nlrsetjmp.c
+    ${MICROPY_PY_DIR}/nlrsh.c
     ${MICROPY_PY_DIR}/nlrthumb.c
     ${MICROPY_PY_DIR}/nlrx64.c
     ${MICROPY_PY_DIR}/nlrx86.c
@@ -91,6 +91,7 @@ PY_CORE_O_BASENAME = $(addprefix py/,\
 	nlrxtensa.o \
 	nlrrv32.o \
 	nlrrv64.o \
+	nlrsh.o \
 	nlrsetjmp.o \
 	malloc.o \
 	gc.o \
@@ -124,6 +125,8 @@ PY_CORE_O_BASENAME = $(addprefix py/,\
 	asmrv32.o \
 	emitnrv32.o \
 	emitinlinerv32.o \
+	asmsh.o \
+	emitnsh.o \
 	emitndebug.o \
 	formatfloat.o \
 	parsenumbase.o \
@@ -56,17 +56,33 @@
 #define QSTR_EXIT()
 #endif
 
+#if MICROPY_QSTR_GC
+#if !MICROPY_QSTR_HASH_INDEX
+#error MICROPY_QSTR_GC requires MICROPY_QSTR_HASH_INDEX
+#endif
+#if MICROPY_OBJ_REPR == MICROPY_OBJ_REPR_D
+#error MICROPY_QSTR_GC is not supported with MICROPY_OBJ_REPR_D
+#endif
+#if MICROPY_ENABLE_COMPILER && !MICROPY_EMIT_BYTECODE_USES_QSTR_TABLE
+#error MICROPY_QSTR_GC requires MICROPY_EMIT_BYTECODE_USES_QSTR_TABLE
+#endif
+#endif
+
 // Initial number of entries for qstr pool, set so that the first dynamically
 // allocated pool is twice this size.  The value here must be <= MP_QSTRnumber_of.
 #define MICROPY_ALLOC_QSTR_ENTRIES_INIT (10)
 
-// this must match the equivalent function in makeqstrdata.py
-size_t qstr_compute_hash(const byte *data, size_t len) {
-    // djb2 algorithm; see http://www.cse.yorku.ca/~oz/hash.html
+// djb2 algorithm; see http://www.cse.yorku.ca/~oz/hash.html
+static size_t qstr_compute_hash_full(const byte *data, size_t len) {
     size_t hash = 5381;
     for (const byte *top = data + len; data < top; data++) {
         hash = ((hash << 5) + hash) ^ (*data); // hash * 33 ^ data
     }
+    return hash;
+}
+
+// Reduce a full hash to the stored qstr hash.
+static size_t qstr_mask_hash(size_t hash) {
     hash &= Q_HASH_MASK;
     // Make sure that valid hash is never zero, zero means "hash not computed"
     if (hash == 0) {
@@ -75,6 +91,11 @@ size_t qstr_compute_hash(const byte *data, size_t len) {
     return hash;
 }
 
+// this must match the equivalent function in makeqstrdata.py
+size_t qstr_compute_hash(const byte *data, size_t len) {
+    return qstr_mask_hash(qstr_compute_hash_full(data, len));
+}
+
 // The first pool is the static qstr table. The contents must remain stable as
 // it is part of the .mpy ABI. See the top of py/persistentcode.c and
 // static_qstr_list in makeqstrdata.py. This pool is unsorted (although in a
@@ -181,6 +202,18 @@ extern const qstr_pool_t MICROPY_QSTR_EXTRA_POOL;
 void qstr_init(void) {
     MP_STATE_VM(last_pool) = (qstr_pool_t *)&CONST_POOL; // we won't modify the const_pool since it has no allocated room left
     MP_STATE_VM(qstr_last_chunk) = NULL;
+    #if MICROPY_QSTR_HASH_INDEX
+    MP_STATE_VM(qstr_index) = NULL;
+    #endif
+    #if MICROPY_QSTR_GC
+    MP_STATE_VM(qstr_gc_len) = 0;
+    MP_STATE_VM(qstr_free) = MP_QSTRnull;
+    MP_STATE_VM(qstr_gc_added) = 0;
+    MP_STATE_VM(qstr_reclaimed_bytes) = 0;
+    #if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
+    MP_STATE_VM(qstr_gc_threads) = 0;
+    #endif
+    #endif
 
     #if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
     mp_thread_mutex_init(&MP_STATE_VM(qstr_mutex));
@@ -199,15 +232,236 @@ static const qstr_pool_t *find_qstr(qstr *q) {
     return pool;
 }
 
+#if MICROPY_QSTR_HASH_INDEX
+
+// The dynamic pools are those allocated by qstr_add on top of CONST_POOL; the
+// hash index, when allocated, holds every qstr stored in them.
+#define QSTR_INDEX_FIRST (CONST_POOL.total_prev_len + CONST_POOL.len)
+
+// With MICROPY_QSTR_GC the allocation of the index also holds one mark bit
+// per dynamic qstr, for the garbage collector.
+#define QSTR_INDEX_MARKS(index) ((byte *)&(index)->slots[(index)->alloc])
+
+static size_t qstr_index_bytes(size_t alloc) {
+    size_t n_bytes = sizeof(qstr_index_t) + alloc * sizeof(qstr);
+    #if MICROPY_QSTR_GC
+    n_bytes += alloc / 8;
+    #endif
+    return n_bytes;
+}
+
+// The low bits of a djb2 hash depend on few bits of the input (the low 5 bits
+// are just the xor of those of each character) so mix the bits before using
+// them as the first slot to probe.
+static size_t qstr_index_slot(const qstr_index_t *index, size_t hash) {
+    hash ^= hash >> 16;
+    hash *= 0x45d9f3b;
+    hash ^= hash >> 16;
+    return hash & (index->alloc - 1);
+}
+
+static void qstr_index_insert(qstr_index_t *index, size_t hash, qstr q) {
+    size_t mask = index->alloc - 1;
+    size_t i = qstr_index_slot(index, hash);
+    while (index->slots[i] != MP_QSTRnull) {
+        i = (i + 1) & mask;
+    }
+    index->slots[i] = q;
+}
+
+// Insert all qstrs of the dynamic pools into an empty index.
+static void qstr_index_fill(qstr_index_t *index) {
+    memset(index->slots, 0, index->alloc * sizeof(qstr));
+    for (const qstr_pool_t *pool = MP_STATE_VM(last_pool); pool->total_prev_len >= QSTR_INDEX_FIRST; pool = pool->prev) {
+        for (size_t at = 0; at < pool->len; at++) {
+            #if MICROPY_QSTR_GC
+            if (pool->lengths[at] == 0) {
+                // freed entry
+                continue;
+            }
+            #endif
+            size_t hash = qstr_compute_hash_full((const byte *)pool->qstrs[at], pool->lengths[at]);
+            qstr_index_insert(index, hash, pool->total_prev_len + at);
+        }
+    }
+}
+
+// Called after a new dynamic pool is allocated, to grow the index so that it
+// can hold all the dynamic pools once they are full, with a load factor of at
+// most 2/3.  If the new index can't be allocated then there is no index until
+// the next pool is added, and lookups scan the dynamic pools instead.
+static void qstr_index_grow(void) {
+    const qstr_pool_t *last_pool = MP_STATE_VM(last_pool);
+    size_t n_dynamic = last_pool->total_prev_len + last_pool->alloc - QSTR_INDEX_FIRST;
+    size_t alloc = 16;
+    while (alloc * 2 < n_dynamic * 3) {
+        alloc *= 2;
+    }
+
+    qstr_index_t *index = MP_STATE_VM(qstr_index);
+    if (index != NULL) {
+        if (index->alloc >= alloc) {
+            return;
+        }
+        MP_STATE_VM(qstr_index) = NULL;
+        m_del(byte, index, qstr_index_bytes(index->alloc));
+    }
+
+    index = m_malloc_maybe(qstr_index_bytes(alloc));
+    if (index == NULL) {
+        return;
+    }
+    index->alloc = alloc;
+    qstr_index_fill(index);
+    MP_STATE_VM(qstr_index) = index;
+}
+
+static qstr qstr_index_find(const qstr_index_t *index, size_t hash, const char *str, size_t str_len) {
+    size_t mask = index->alloc - 1;
+    for (size_t i = qstr_index_slot(index, hash);; i = (i + 1) & mask) {
+        qstr q = index->slots[i];
+        if (q == MP_QSTRnull) {
+            return MP_QSTRnull;
+        }
+        qstr at = q;
+        const qstr_pool_t *pool = find_qstr(&at);
+        if (pool->lengths[at] == str_len && memcmp(pool->qstrs[at], str, str_len) == 0) {
+            return q;
+        }
+    }
+}
+
+#if MICROPY_QSTR_GC
+
+// Called at the start of a collection, before the roots are traced.  This
+// clears the marks of the dynamic qstrs and marks the pools and the index
+// without scanning them, so that the pointers to the string data and the ids
+// they hold don't count as references: the collector marks a qstr when it
+// finds its id anywhere else, in any of the forms it may be stored in.
+//
+// Looking for qstr ids makes marking slower, so qstrs are only collected once
+// the number added since the last time reaches a quarter of the dynamic ones.
+// Otherwise the pools are traced like any other block.
+//
+// Without the GIL, other threads keep running while the heap is marked and
+// could take the id of a qstr after the places that they store it in were
+// looked at.  So qstrs are then only collected while no thread started by
+// _thread is running; the only thread that could start one meanwhile is the
+// collecting one, from a finaliser, in which case nothing is reclaimed.
+void qstr_gc_collect_start(void) {
+    qstr_index_t *index = MP_STATE_VM(qstr_index);
+    if (index == NULL || MP_STATE_VM(qstr_gc_added) * 4 < QSTR_TOTAL() - QSTR_INDEX_FIRST) {
+        return;
+    }
+    #if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
+    if (MP_STATE_VM(qstr_gc_threads) != 0) {
+        return;
+    }
+    #endif
+    memset(QSTR_INDEX_MARKS(index), 0, index->alloc / 8);
+    gc_mark_leaf(index);
+    for (const qstr_pool_t *pool = MP_STATE_VM(last_pool); pool->total_prev_len >= QSTR_INDEX_FIRST; pool = pool->prev) {
+        gc_mark_leaf(pool);
+    }
+    MP_STATE_VM(qstr_gc_marks) = QSTR_INDEX_MARKS(index);
+    MP_STATE_VM(qstr_gc_first) = QSTR_INDEX_FIRST;
+    MP_STATE_VM(qstr_gc_len) = QSTR_TOTAL() - QSTR_INDEX_FIRST;
+}
+
+// Called once marking is complete and before the sweep.  A qstr is freed if
+// its id was not found and nothing points to its string data; otherwise its
+// data is marked, since the pools were not scanned.  If reclaim is false then
+// all qstrs are kept.
+void qstr_gc_sweep(bool reclaim) {
+    if (MP_STATE_VM(qstr_gc_len) == 0) {
+        return;
+    }
+    MP_STATE_VM(qstr_gc_len) = 0;
+    if (reclaim) {
+        MP_STATE_VM(qstr_gc_added) = 0;
+    }
+    const byte *marks = MP_STATE_VM(qstr_gc_marks);
+    size_t n_freed = 0;
+    for (qstr_pool_t *pool = MP_STATE_VM(last_pool); pool->total_prev_len >= QSTR_INDEX_FIRST; pool = (qstr_pool_t *)pool->prev) {
+        for (size_t at = 0; at < pool->len; at++) {
+            if (pool->lengths[at] == 0) {
+                // already free
+                continue;
+            }
+            size_t i = pool->total_prev_len + at - QSTR_INDEX_FIRST;
+            const char *data = pool->qstrs[at];
+            if (!reclaim || (marks[i / 8] & (1 << (i & 7))) || gc_is_marked(data)) {
+                gc_mark_leaf(data);
+                continue;
+            }
+            // free this qstr, its data is swept with the rest of the heap
+            MP_STATE_VM(qstr_reclaimed_bytes) += pool->lengths[at] + 1;
+            #if MICROPY_QSTR_BYTES_IN_HASH
+            pool->hashes[at] = 0;
+            #endif
+            pool->lengths[at] = 0;
+            pool->qstrs[at] = (const char *)MP_STATE_VM(qstr_free);
+            MP_STATE_VM(qstr_free) = pool->total_prev_len + at;
+            n_freed += 1;
+        }
+    }
+    if (n_freed != 0) {
+        qstr_index_fill(MP_STATE_VM(qstr_index));
+    }
+}
+
+#if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
+// Called with n = 1 before a thread is created by _thread, and with n = -1
+// once it has finished or failed to start.
+void qstr_gc_add_threads(int n) {
+    QSTR_ENTER();
+    MP_STATE_VM(qstr_gc_threads) += n;
+    QSTR_EXIT();
+}
+#endif
+
+#endif // MICROPY_QSTR_GC
+
+#endif // MICROPY_QSTR_HASH_INDEX
+
 // qstr_mutex must be taken while in this function
 static qstr qstr_add(mp_uint_t len, const char *q_ptr) {
+    #if MICROPY_QSTR_HASH_INDEX
+    size_t hash_full = qstr_compute_hash_full((const byte *)q_ptr, len);
+    bool new_pool = false;
+    #endif
     #if MICROPY_QSTR_BYTES_IN_HASH
+    #if MICROPY_QSTR_HASH_INDEX
+    mp_uint_t hash = qstr_mask_hash(hash_full);
+    #else
     mp_uint_t hash = qstr_compute_hash((const byte *)q_ptr, len);
+    #endif
     DEBUG_printf("QSTR: add hash=%d len=%d data=%.*s\n", hash, len, len, q_ptr);
     #else
     DEBUG_printf("QSTR: add len=%d data=%.*s\n", len, len, q_ptr);
     #endif
 
+    #if MICROPY_QSTR_GC
+    MP_STATE_VM(qstr_gc_added) += 1;
+
+    // reuse the id of a freed qstr if there is one
+    if (MP_STATE_VM(qstr_free) != MP_QSTRnull) {
+        qstr q = MP_STATE_VM(qstr_free);
+        qstr at = q;
+        qstr_pool_t *pool = (qstr_pool_t *)find_qstr(&at);
+        MP_STATE_VM(qstr_free) = (uintptr_t)pool->qstrs[at];
+        #if MICROPY_QSTR_BYTES_IN_HASH
+        pool->hashes[at] = hash;
+        #endif
+        pool->lengths[at] = len;
+        pool->qstrs[at] = q_ptr;
+        if (MP_STATE_VM(qstr_index) != NULL) {
+            qstr_index_insert(MP_STATE_VM(qstr_index), hash_full, q);
+        }
+        return q;
+    }
+    #endif
+
     // make sure we have room in the pool for a new qstr
     if (MP_STATE_VM(last_pool)->len >= MP_STATE_VM(last_pool)->alloc) {
         size_t new_alloc = MP_STATE_VM(last_pool)->alloc * 2;
@@ -244,6 +498,9 @@ static qstr qstr_add(mp_uint_t len, const char *q_ptr) {
         pool->len = 0;
         MP_STATE_VM(last_pool) = pool;
         DEBUG_printf("QSTR: allocate new pool of size %d\n", MP_STATE_VM(last_pool)->alloc);
+        #if MICROPY_QSTR_HASH_INDEX
+        new_pool = true;
+        #endif
     }
 
     // add the new qstr
@@ -255,6 +512,16 @@ static qstr qstr_add(mp_uint_t len, const char *q_ptr) {
     MP_STATE_VM(last_pool)->qstrs[at] = q_ptr;
     MP_STATE_VM(last_pool)->len++;
 
+    #if MICROPY_QSTR_HASH_INDEX
+    // The index is grown only once the new qstr is reachable from its pool,
+    // because allocating the index may run a garbage collection.
+    if (new_pool) {
+        qstr_index_grow();
+    } else if (MP_STATE_VM(qstr_index) != NULL) {
+        qstr_index_insert(MP_STATE_VM(qstr_index), hash_full, MP_STATE_VM(last_pool)->total_prev_len + at);
+    }
+    #endif
+
     // return id for the newly-added qstr
     return MP_STATE_VM(last_pool)->total_prev_len + at;
 }
@@ -275,13 +542,31 @@ qstr qstr_find_strn(const char *str, size_t str_len) {
         return MP_QSTR_;
     }
 
+    const qstr_pool_t *pool = MP_STATE_VM(last_pool);
+
+    #if MICROPY_QSTR_HASH_INDEX
+    // work out hash of str
+    size_t str_hash = qstr_compute_hash_full((const byte *)str, str_len);
+
+    // the index covers all dynamic pools, so only the const pools remain
+    const qstr_index_t *index = MP_STATE_VM(qstr_index);
+    if (index != NULL) {
+        qstr q = qstr_index_find(index, str_hash, str, str_len);
+        if (q != MP_QSTRnull) {
+            return q;
+        }
+        pool = &CONST_POOL;
+    }
     #if MICROPY_QSTR_BYTES_IN_HASH
+    str_hash = qstr_mask_hash(str_hash);
+    #endif
+    #elif MICROPY_QSTR_BYTES_IN_HASH
     // work out hash of str
     size_t str_hash = qstr_compute_hash((const byte *)str, str_len);
     #endif
 
     // search pools for the data
-    for (const qstr_pool_t *pool = MP_STATE_VM(last_pool); pool != NULL; pool = pool->prev) {
+    for (; pool != NULL; pool = pool->prev) {
         size_t low = 0;
         size_t high = pool->len - 1;
 
@@ -340,6 +625,15 @@ static qstr qstr_from_strn_helper(const char *str, size_t len, bool data_is_stat
         // compute number of bytes needed to intern this string
         size_t n_bytes = len + 1;
 
+        #if MICROPY_QSTR_GC
+        // Each string gets its own heap block, so that it can be freed with
+        // its qstr.
+        char *q_ptr = m_new_maybe(char, n_bytes);
+        if (q_ptr == NULL) {
+            QSTR_EXIT();
+            m_malloc_fail(n_bytes);
+        }
+        #else
         if (MP_STATE_VM(qstr_last_chunk) != NULL && MP_STATE_VM(qstr_last_used) + n_bytes > MP_STATE_VM(qstr_last_alloc)) {
             // not enough room at end of previously interned string so try to grow
             char *new_p = m_renew_maybe(char, MP_STATE_VM(qstr_last_chunk), MP_STATE_VM(qstr_last_alloc), MP_STATE_VM(qstr_last_alloc) + n_bytes, false);
@@ -376,6 +670,7 @@ static qstr qstr_from_strn_helper(const char *str, size_t len, bool data_is_stat
         // allocate memory from the chunk for this new interned string's data
         char *q_ptr = MP_STATE_VM(qstr_last_chunk) + MP_STATE_VM(qstr_last_used);
         MP_STATE_VM(qstr_last_used) += n_bytes;
+        #endif
 
         // store the interned strings' data
         memcpy(q_ptr, str, len);
@@ -425,16 +720,27 @@ const byte *qstr_data(qstr q, size_t *len) {
     return (byte *)pool->qstrs[q];
 }
 
-void qstr_pool_info(size_t *n_pool, size_t *n_qstr, size_t *n_str_data_bytes, size_t *n_total_bytes) {
+void qstr_pool_info(size_t *n_pool, size_t *n_qstr, size_t *n_str_data_bytes, size_t *n_total_bytes, size_t *n_reclaimed_bytes) {
     QSTR_ENTER();
     *n_pool = 0;
     *n_qstr = 0;
     *n_str_data_bytes = 0;
     *n_total_bytes = 0;
+    *n_reclaimed_bytes = 0;
+    #if MICROPY_QSTR_GC
+    *n_reclaimed_bytes = MP_STATE_VM(qstr_reclaimed_bytes);
+    #endif
     for (const qstr_pool_t *pool = MP_STATE_VM(last_pool); pool != NULL && pool != &CONST_POOL; pool = pool->prev) {
         *n_pool += 1;
         *n_qstr += pool->len;
         for (qstr_len_t *l = pool->lengths, *l_top = pool->lengths + pool->len; l < l_top; l++) {
+            #if MICROPY_QSTR_GC
+            if (*l == 0) {
+                // freed entry
+                *n_qstr -= 1;
+                continue;
+            }
+            #endif
             *n_str_data_bytes += *l + 1;
         }
         #if MICROPY_ENABLE_GC
@@ -448,6 +754,11 @@ void qstr_pool_info(size_t *n_pool, size_t *n_qstr, size_t *n_str_data_bytes, si
                 + sizeof(qstr_len_t)) * pool->alloc;
         #endif
     }
+    #if MICROPY_QSTR_HASH_INDEX
+    if (MP_STATE_VM(qstr_index) != NULL) {
+        *n_total_bytes += qstr_index_bytes(MP_STATE_VM(qstr_index)->alloc);
+    }
+    #endif
     *n_total_bytes += *n_str_data_bytes;
     QSTR_EXIT();
 }
@@ -457,6 +768,12 @@ void qstr_dump_data(void) {
     QSTR_ENTER();
     for (const qstr_pool_t *pool = MP_STATE_VM(last_pool); pool != NULL && pool != &CONST_POOL; pool = pool->prev) {
         for (const char *const *q = pool->qstrs, *const *q_top = pool->qstrs + pool->len; q < q_top; q++) {
+            #if MICROPY_QSTR_GC
+            if (pool->lengths[q - pool->qstrs] == 0) {
+                // freed entry
+                continue;
+            }
+            #endif
             mp_printf(&mp_plat_print, "Q(%s)\n", *q);
         }
     }
@@ -91,6 +91,15 @@ typedef struct _qstr_pool_t {
     const char *qstrs[];
 } qstr_pool_t;
 
+#if MICROPY_QSTR_HASH_INDEX
+// Open-addressed hash index over the dynamically allocated qstr pools.  Each
+// slot holds a qstr, or MP_QSTRnull if it is empty; alloc is a power of 2.
+typedef struct _qstr_index_t {
+    size_t alloc;
+    qstr slots[];
+} qstr_index_t;
+#endif
+
 #define QSTR_TOTAL() (MP_STATE_VM(last_pool)->total_prev_len + MP_STATE_VM(last_pool)->len)
 
 void qstr_init(void);
@@ -110,9 +119,29 @@ const char *qstr_str(qstr q);
 size_t qstr_len(qstr q);
 const byte *qstr_data(qstr q, size_t *len);
 
-void qstr_pool_info(size_t *n_pool, size_t *n_qstr, size_t *n_str_data_bytes, size_t *n_total_bytes);
+void qstr_pool_info(size_t *n_pool, size_t *n_qstr, size_t *n_str_data_bytes, size_t *n_total_bytes, size_t *n_reclaimed_bytes);
 void qstr_dump_data(void);
 
+#if MICROPY_QSTR_GC
+void qstr_gc_collect_start(void);
+void qstr_gc_sweep(bool reclaim);
+#if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
+void qstr_gc_add_threads(int n);
+#endif
+#endif
+
+// Whether q names a qstr.  The collector frees a dynamic qstr by setting its
+// length to 0 and keeps its id for reuse, so loops over all the qstr ids must
+// skip the ids that this returns false for.
+static inline bool qstr_is_live(qstr q) {
+    #if MICROPY_QSTR_GC
+    return q == MP_QSTR_ || qstr_len(q) != 0;
+    #else
+    (void)q;
+    return true;
+    #endif
+}
+
 #if MICROPY_ROM_TEXT_COMPRESSION
 void mp_decompress_rom_string(byte *dst, const mp_rom_error_text_t src);
 #define MP_IS_COMPRESSED_ROM_STRING(s) (*(byte *)(s) == 0xff)
@@ -175,6 +175,9 @@ static const char *find_completions(const char *s_start, size_t s_len,
     *q_first = *q_last = 0;
     size_t nqstr = QSTR_TOTAL();
     for (qstr q = MP_QSTR_ + 1; q < nqstr; ++q) {
+        if (!qstr_is_live(q)) {
+            continue;
+        }
         size_t d_len;
         const char *d_str = (const char *)qstr_data(q, &d_len);
         // special case; filter out words that begin with underscore
@@ -216,6 +219,9 @@ static void print_completions(const mp_print_t *print,
 
     int line_len = MAX_LINE_LEN; // force a newline for first word
     for (qstr q = q_first; q <= q_last; ++q) {
+        if (!qstr_is_live(q)) {
+            continue;
+        }
         size_t d_len;
         const char *d_str = (const char *)qstr_data(q, &d_len);
         if (s_len <= d_len && strncmp(s_start, d_str, s_len) == 0) {
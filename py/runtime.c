@@ -73,6 +73,16 @@
  
      // no pending exceptions to start with
      MP_STATE_THREAD(mp_pending_exception) = MP_OBJ_NULL;
+
+     #if MICROPY_OPT_FRAME_CACHE
+     // any cached frames were on the old heap
+     MP_STATE_THREAD(frame_cache_len) = 0;
+     #endif
+
+     #if MICROPY_OPT_FLOAT_POOL
+     // any pooled floats were on the old heap
+     memset(MP_STATE_THREAD(float_pool_len), 0, sizeof(MP_STATE_THREAD(float_pool_len)));
+     #endif
      #if MICROPY_ENABLE_SCHEDULER
      // no pending callbacks to start with
      MP_STATE_VM(sched_state) = MP_SCHED_IDLE;
@@ -130,6 +140,13 @@
      #if MICROPY_PERSISTENT_CODE_TRACK_FUN_DATA || MICROPY_PERSISTENT_CODE_TRACK_BSS_RODATA
      MP_STATE_VM(persistent_code_root_pointers) = MP_OBJ_NULL;
      #endif
+
+     #if MICROPY_PY_BUILTINS_STR_UNICODE_INDEX
+     for (size_t i = 0; i < MICROPY_PY_BUILTINS_STR_UNICODE_INDEX_CACHE; ++i) {
+         MP_STATE_VM(str_index_cache)[i] = NULL;
+         MP_STATE_VM(str_index_miss)[i].data = NULL;
+     }
+     #endif
  
      #if MICROPY_PY_OS_DUPTERM
      for (size_t i = 0; i < MICROPY_PY_OS_DUPTERM; ++i) {
@@ -168,6 +185,8 @@
      #if MICROPY_PY_SYS_SETTRACE
      MP_STATE_THREAD(prof_trace_callback) = MP_OBJ_NULL;
      MP_STATE_THREAD(prof_callback_is_executing) = false;
+     #endif
+     #if MICROPY_PY_SYS_SETTRACE || MICROPY_PY_MICROPYTHON_HEAP_PROFILE
      MP_STATE_THREAD(current_code_state) = NULL;
      #endif
  
@@ -168,6 +168,21 @@ static inline void mp_thread_init_state(mp_state_thread_t *ts, size_t stack_size
     ts->nlr_jump_callback_top = NULL;
     ts->mp_pending_exception = MP_OBJ_NULL;
 
+    #if MICROPY_PY_SYS_SETTRACE || MICROPY_PY_MICROPYTHON_HEAP_PROFILE
+    // No bytecode is running in this thread yet
+    ts->current_code_state = NULL;
+    #endif
+
+    #if MICROPY_OPT_FRAME_CACHE
+    // Start with an empty frame cache
+    ts->frame_cache_len = 0;
+    #endif
+
+    #if MICROPY_OPT_FLOAT_POOL
+    // Start with an empty float pool
+    memset(ts->float_pool_len, 0, sizeof(ts->float_pool_len));
+    #endif
+
     // If locals/globals are not given, inherit from main thread
     if (locals == NULL) {
         locals = mp_state_ctx.thread.dict_locals;
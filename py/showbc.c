@@ -240,6 +240,18 @@ const byte *mp_bytecode_print_str(const mp_print_t *print, const byte *ip_start,
             mp_printf(print, "LOAD_METHOD %s", qstr_str(qst));
             break;
 
+        case MP_BC_LOAD_FAST_LOAD_ATTR:
+            DECODE_QSTR;
+            mp_printf(print, "LOAD_FAST_LOAD_ATTR %d %s", *ip, qstr_str(qst));
+            ip += 1;
+            break;
+
+        case MP_BC_LOAD_FAST_LOAD_METHOD:
+            DECODE_QSTR;
+            mp_printf(print, "LOAD_FAST_LOAD_METHOD %d %s", *ip, qstr_str(qst));
+            ip += 1;
+            break;
+
         case MP_BC_LOAD_SUPER_METHOD:
             DECODE_QSTR;
             mp_printf(print, "LOAD_SUPER_METHOD %s", qstr_str(qst));
@@ -258,6 +270,11 @@ const byte *mp_bytecode_print_str(const mp_print_t *print, const byte *ip_start,
             mp_printf(print, "STORE_FAST_N " UINT_FMT, unum);
             break;
 
+        case MP_BC_STORE_FAST_LOAD_FAST:
+            DECODE_UINT;
+            mp_printf(print, "STORE_FAST_LOAD_FAST " UINT_FMT, unum);
+            break;
+
         case MP_BC_STORE_DEREF:
             DECODE_UINT;
             mp_printf(print, "STORE_DEREF " UINT_FMT, unum);
@@ -337,6 +354,16 @@ const byte *mp_bytecode_print_str(const mp_print_t *print, const byte *ip_start,
             mp_printf(print, "POP_JUMP_IF_FALSE " UINT_FMT, (mp_uint_t)(ip + unum - ip_start));
             break;
 
+        case MP_BC_BINARY_OP_POP_JUMP_IF: {
+            DECODE_SLABEL;
+            mp_uint_t op = *ip & ~MP_BC_BINARY_OP_POP_JUMP_IF_TRUE;
+            mp_printf(print, "BINARY_OP_POP_JUMP_IF_%s " UINT_FMT " " UINT_FMT " %s",
+                *ip & MP_BC_BINARY_OP_POP_JUMP_IF_TRUE ? "TRUE" : "FALSE",
+                (mp_uint_t)(ip + unum - ip_start), op, qstr_str(mp_binary_op_method_name[op]));
+            ip += 1;
+            break;
+        }
+
         case MP_BC_JUMP_IF_TRUE_OR_POP:
             DECODE_ULABEL;
             mp_printf(print, "JUMP_IF_TRUE_OR_POP " UINT_FMT, (mp_uint_t)(ip + unum - ip_start));
@@ -439,6 +466,28 @@ const byte *mp_bytecode_print_str(const mp_print_t *print, const byte *ip_start,
             mp_printf(print, "UNPACK_SEQUENCE " UINT_FMT, unum);
             break;
 
+        case MP_BC_FORMAT_VALUE:
+            DECODE_UINT;
+            mp_printf(print, "FORMAT_VALUE " UINT_FMT, unum);
+            break;
+
+        case MP_BC_BUILD_STRING:
+            DECODE_UINT;
+            mp_printf(print, "BUILD_STRING " UINT_FMT, unum);
+            break;
+
+        case MP_BC_BINARY_OP_TEMP:
+        case MP_BC_BINARY_OP_TEMP_RESULT: {
+            mp_uint_t op = *ip & MP_BC_BINARY_OP_TEMP_OP_MASK;
+            mp_printf(print, "BINARY_OP_TEMP%s " UINT_FMT " %s%s%s",
+                ip[-1] == MP_BC_BINARY_OP_TEMP_RESULT ? "_RESULT" : "",
+                op, qstr_str(mp_binary_op_method_name[op]),
+                *ip & MP_BC_BINARY_OP_TEMP_LHS ? " lhs" : "",
+                *ip & MP_BC_BINARY_OP_TEMP_RHS ? " rhs" : "");
+            ip += 1;
+            break;
+        }
+
         case MP_BC_UNPACK_EX:
             DECODE_UINT;
             mp_printf(print, "UNPACK_EX " UINT_FMT, unum);
@@ -526,6 +575,15 @@ const byte *mp_bytecode_print_str(const mp_print_t *print, const byte *ip_start,
             mp_printf(print, "IMPORT_STAR");
             break;
 
+        case MP_BC_LOAD_FAST_BINARY_OP_SMALL_INT: {
+            DECODE_UINT;
+            mp_uint_t op = MP_BC_LOAD_FAST_BINARY_OP_SMALL_INT_OP(unum);
+            mp_printf(print, "LOAD_FAST_BINARY_OP_SMALL_INT " UINT_FMT " " UINT_FMT " %s " INT_FMT,
+                MP_BC_LOAD_FAST_BINARY_OP_SMALL_INT_LOCAL(unum), op, qstr_str(mp_binary_op_method_name[op]),
+                MP_BC_LOAD_FAST_BINARY_OP_SMALL_INT_VAL(unum));
+            break;
+        }
+
         default:
             if (ip[-1] < MP_BC_LOAD_CONST_SMALL_INT_MULTI + 64) {
                 mp_printf(print, "LOAD_CONST_SMALL_INT " INT_FMT, (mp_int_t)ip[-1] - MP_BC_LOAD_CONST_SMALL_INT_MULTI - 16);
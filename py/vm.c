@@ -29,10 +29,13 @@
 #include <string.h>
 #include <assert.h>
 
+#include "py/builtin.h"
 #include "py/emitglue.h"
 #include "py/objtype.h"
 #include "py/objfun.h"
+#include "py/objstr.h"
 #include "py/runtime.h"
+#include "py/smallint.h"
 #include "py/bc0.h"
 #include "py/profile.h"
 
@@ -187,6 +190,24 @@
     } \
 } while(0)
 
+#elif MICROPY_PY_MICROPYTHON_HEAP_PROFILE
+
+// The heap profiler only needs to know the running code state
+#define FRAME_SETUP() do { \
+    MP_STATE_THREAD(current_code_state) = code_state; \
+} while(0)
+
+#define FRAME_ENTER() do { \
+    code_state->prev_state = MP_STATE_THREAD(current_code_state); \
+} while(0)
+
+#define FRAME_LEAVE() do { \
+    MP_STATE_THREAD(current_code_state) = code_state->prev_state; \
+} while(0)
+
+#define FRAME_UPDATE()
+#define TRACE_TICK(current_ip, current_sp, is_exception)
+
 #else // MICROPY_PY_SYS_SETTRACE
 #define FRAME_SETUP()
 #define FRAME_ENTER()
@@ -195,6 +216,467 @@
 #define TRACE_TICK(current_ip, current_sp, is_exception)
 #endif // MICROPY_PY_SYS_SETTRACE
 
+#if MICROPY_OPT_INLINE_CACHE
+
+// Each bytecode function object gets a table of entries when it first runs an
+// opcode which uses the inline cache.  The entry of an opcode is found from its
+// offset in the bytecode, and remembers where that opcode last found its name,
+// together with a guard that must match for the entry to be used again:
+//  - an attribute of an instance with a shape: the guard is the shape, which
+//    fixes the names of all its attributes, and index is the attribute's slot;
+//  - a new attribute stored in such an instance: the guard is the shape before
+//    the store, index is INLINE_CACHE_NOT_MEMBER and value the shape after it;
+//  - an attribute of the class of such an instance that isn't a method: as for
+//    a method below, with index INLINE_CACHE_NOT_MEMBER and value the attribute;
+//  - an attribute of a module, or a global: the guard is the map, and index is
+//    the slot of the name in its table, whose key is checked on each use;
+//  - a global found in the builtins: as above with the globals map, with
+//    INLINE_CACHE_BUILTIN set in index and version MP_STATE_VM(map_keys_added)
+//    from before the globals were searched, so no key has been added since;
+//  - a method loaded by LOAD_METHOD from the class of an instance: the guard is
+//    the shape of the instance, and version the class lookup cache version;
+//  - a method loaded from a native type: the guard is the type.
+// The table starts small and doubles, up to MICROPY_OPT_INLINE_CACHE_MAX_ENTRIES,
+// when two opcodes need the same entry.  The GC traces the entries, so a guard
+// can't be freed and its address reused while an entry refers to it.
+
+#define INLINE_CACHE_MIN_ENTRIES (4)
+#define INLINE_CACHE_BUILTIN (0x8000)
+#define INLINE_CACHE_NOT_MEMBER (0xffff)
+#define INLINE_CACHE_INSTANCE_METHODS (MICROPY_OPT_INSTANCE_SHAPES && MICROPY_OPT_CLASS_LOOKUP_CACHE)
+
+typedef struct _mp_inline_cache_entry_t {
+    uint16_t offset; // of the opcode in the bytecode, 0 if the entry is unused
+    uint16_t index;
+    const void *guard;
+    mp_obj_t value;
+    size_t version;
+} mp_inline_cache_entry_t;
+
+typedef struct _mp_inline_cache_t {
+    size_t mask;
+    mp_inline_cache_entry_t entries[];
+} mp_inline_cache_t;
+
+#if MICROPY_PY_MICROPYTHON_INLINE_CACHE_STATS
+#define INLINE_CACHE_HIT() (++MP_STATE_VM(inline_cache_hits))
+#define INLINE_CACHE_MISS() (++MP_STATE_VM(inline_cache_misses))
+#else
+#define INLINE_CACHE_HIT()
+#define INLINE_CACHE_MISS()
+#endif
+
+#if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
+// Without the GIL only the main thread uses the caches, so they need no locking
+#define INLINE_CACHE_USABLE() (mp_thread_is_main_thread())
+#else
+#define INLINE_CACHE_USABLE() (true)
+#endif
+
+// The functions below take the function being run, or NULL when the thread
+// can't use the inline caches, which is worked out once per run of the VM.
+
+// Returns the entry for the opcode at op_ip, or NULL if it has none.
+static inline mp_inline_cache_entry_t *inline_cache_get(mp_obj_fun_bc_t *fun, const byte *op_ip) {
+    if (fun == NULL) {
+        return NULL;
+    }
+    mp_inline_cache_t *cache = fun->inline_cache;
+    if (cache == NULL) {
+        return NULL;
+    }
+    size_t offset = op_ip - fun->bytecode;
+    mp_inline_cache_entry_t *entry = &cache->entries[offset & cache->mask];
+    if (entry->offset != offset) {
+        return NULL;
+    }
+    return entry;
+}
+
+static mp_inline_cache_t *inline_cache_new(size_t num_entries) {
+    mp_inline_cache_t *cache = m_new_obj_var_maybe(mp_inline_cache_t, entries, mp_inline_cache_entry_t, num_entries);
+    if (cache != NULL) {
+        cache->mask = num_entries - 1;
+        memset(cache->entries, 0, num_entries * sizeof(mp_inline_cache_entry_t));
+    }
+    return cache;
+}
+
+// Returns the entry to fill in for the opcode at op_ip, or NULL if it can't
+// have one.  The table is looked up again because the lookup which missed may
+// have run code which replaced it.
+static MP_NOINLINE mp_inline_cache_entry_t *inline_cache_fill(mp_obj_fun_bc_t *fun, const byte *op_ip) {
+    if (fun == NULL || (size_t)(op_ip - fun->bytecode) > 0xffff) {
+        return NULL;
+    }
+    size_t offset = op_ip - fun->bytecode;
+    mp_inline_cache_t *cache = fun->inline_cache;
+    if (cache == NULL) {
+        cache = inline_cache_new(INLINE_CACHE_MIN_ENTRIES);
+        if (cache == NULL) {
+            return NULL;
+        }
+        fun->inline_cache = cache;
+    }
+    mp_inline_cache_entry_t *entry = &cache->entries[offset & cache->mask];
+    if (entry->offset != 0 && entry->offset != offset && cache->mask + 1 < MICROPY_OPT_INLINE_CACHE_MAX_ENTRIES) {
+        // another opcode has this entry, so move to a larger table
+        size_t num_entries = cache->mask + 1;
+        mp_inline_cache_t *new_cache = inline_cache_new(num_entries * 2);
+        if (new_cache != NULL) {
+            for (size_t i = 0; i < num_entries; i++) {
+                const mp_inline_cache_entry_t *e = &cache->entries[i];
+                if (e->offset != 0) {
+                    new_cache->entries[e->offset & new_cache->mask] = *e;
+                }
+            }
+            fun->inline_cache = new_cache;
+            m_del_var(mp_inline_cache_t, entries, mp_inline_cache_entry_t, num_entries, cache);
+            entry = &new_cache->entries[offset & new_cache->mask];
+        }
+    }
+    entry->offset = offset;
+    return entry;
+}
+
+static void inline_cache_fill_index(mp_obj_fun_bc_t *fun, const byte *op_ip, const void *guard, size_t index) {
+    if (index <= 0xffff) {
+        mp_inline_cache_entry_t *entry = inline_cache_fill(fun, op_ip);
+        if (entry != NULL) {
+            entry->guard = guard;
+            entry->index = index;
+        }
+    }
+}
+
+static MP_NOINLINE mp_obj_t inline_cache_load_global_slow(mp_obj_fun_bc_t *fun, const byte *op_ip, qstr qst) {
+    mp_map_t *globals = &mp_globals_get()->map;
+    mp_obj_t key = MP_OBJ_NEW_QSTR(qst);
+    size_t version = MP_STATE_VM(map_keys_added);
+    INLINE_CACHE_MISS();
+    mp_map_elem_t *elem = mp_map_lookup(globals, key, MP_MAP_LOOKUP);
+    if (elem != NULL) {
+        size_t index = elem - globals->table;
+        if (index < INLINE_CACHE_BUILTIN) {
+            inline_cache_fill_index(fun, op_ip, globals, index);
+        }
+        return elem->value;
+    }
+    #if MICROPY_CAN_OVERRIDE_BUILTINS
+    if (MP_STATE_VM(mp_module_builtins_override_dict) == NULL)
+    #endif
+    {
+        const mp_map_t *builtins = &mp_module_builtins_globals.map;
+        elem = mp_map_lookup((mp_map_t *)builtins, key, MP_MAP_LOOKUP);
+        if (elem != NULL) {
+            mp_inline_cache_entry_t *entry = inline_cache_fill(fun, op_ip);
+            if (entry != NULL) {
+                entry->guard = globals;
+                entry->index = INLINE_CACHE_BUILTIN | (elem - builtins->table);
+                // once the count stops it no longer shows that no key was added
+                entry->version = version == SIZE_MAX ? 0 : version;
+            }
+            return elem->value;
+        }
+    }
+    return mp_load_global(qst);
+}
+
+static MP_NOINLINE mp_obj_t inline_cache_load_attr_slow(mp_obj_fun_bc_t *fun, const byte *op_ip, mp_obj_t obj, qstr qst) {
+    const mp_obj_type_t *type = mp_obj_get_type(obj);
+    mp_inline_cache_entry_t *entry = inline_cache_get(fun, op_ip);
+    if (mp_obj_is_instance_type(type)) {
+        mp_obj_instance_t *self = MP_OBJ_TO_PTR(obj);
+        #if MICROPY_OPT_INSTANCE_SHAPES
+        if (entry != NULL && self->shape == entry->guard) {
+            if (entry->index != INLINE_CACHE_NOT_MEMBER) {
+                INLINE_CACHE_HIT();
+                return self->members.values[entry->index];
+            }
+            #if INLINE_CACHE_INSTANCE_METHODS
+            if (entry->version == MP_STATE_VM(class_lookup_version)) {
+                INLINE_CACHE_HIT();
+                return entry->value;
+            }
+            #endif
+        }
+        #endif
+        INLINE_CACHE_MISS();
+        mp_obj_t *member = mp_obj_instance_find_member(self, qst);
+        if (member != NULL) {
+            #if MICROPY_OPT_INSTANCE_SHAPES
+            if (self->shape != NULL) {
+                inline_cache_fill_index(fun, op_ip, self->shape, member - self->members.values);
+            }
+            #endif
+            return *member;
+        }
+        #if INLINE_CACHE_INSTANCE_METHODS
+        if (self->shape != NULL && !(type->flags & MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS)
+            && mp_obj_instance_type_is_plain(type)) {
+            // The attribute comes from the class, and without special accessors
+            // it's either a method, which is bound to obj anew each time, or a
+            // value that stays the same while the class is unchanged.
+            size_t version = MP_STATE_VM(class_lookup_version);
+            mp_obj_t dest[2];
+            mp_load_method(obj, qst, dest);
+            if (dest[1] != MP_OBJ_NULL) {
+                return mp_obj_new_bound_meth(dest[0], dest[1]);
+            }
+            entry = inline_cache_fill(fun, op_ip);
+            if (entry != NULL) {
+                entry->guard = self->shape;
+                entry->index = INLINE_CACHE_NOT_MEMBER;
+                entry->value = dest[0];
+                entry->version = version;
+            }
+            return dest[0];
+        }
+        #endif
+    } else if (type == &mp_type_module) {
+        mp_map_t *map = &mp_obj_module_get_globals(obj)->map;
+        mp_obj_t key = MP_OBJ_NEW_QSTR(qst);
+        if (entry != NULL && entry->guard == map && entry->index < map->alloc && map->table[entry->index].key == key) {
+            INLINE_CACHE_HIT();
+            return map->table[entry->index].value;
+        }
+        INLINE_CACHE_MISS();
+        mp_map_elem_t *elem = mp_map_lookup(map, key, MP_MAP_LOOKUP);
+        if (elem != NULL) {
+            inline_cache_fill_index(fun, op_ip, map, elem - map->table);
+            return elem->value;
+        }
+    }
+    return mp_load_attr(obj, qst);
+}
+
+static MP_NOINLINE void inline_cache_store_attr_slow(mp_obj_fun_bc_t *fun, const byte *op_ip, mp_obj_t obj, qstr qst, mp_obj_t value) {
+    const mp_obj_type_t *type = mp_obj_get_type(obj);
+    // Stores to the instance itself, when there's no property, descriptor or
+    // __setattr__ that could take them instead.  A NULL value is a delete.
+    if (value != MP_OBJ_NULL && mp_obj_is_instance_type(type) && !(type->flags & MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS)) {
+        mp_obj_instance_t *self = MP_OBJ_TO_PTR(obj);
+        #if MICROPY_OPT_INSTANCE_SHAPES
+        mp_obj_instance_shape_t *shape = self->shape;
+        mp_inline_cache_entry_t *entry = inline_cache_get(fun, op_ip);
+        if (entry != NULL && shape == entry->guard) {
+            INLINE_CACHE_HIT();
+            if (entry->index != INLINE_CACHE_NOT_MEMBER) {
+                self->members.values[entry->index] = value;
+            } else {
+                mp_obj_instance_add_member(self, MP_OBJ_TO_PTR(entry->value), value);
+            }
+            return;
+        }
+        #endif
+        INLINE_CACHE_MISS();
+        mp_obj_t *member = mp_obj_instance_find_member(self, qst);
+        if (member != NULL) {
+            *member = value;
+            #if MICROPY_OPT_INSTANCE_SHAPES
+            if (shape != NULL) {
+                inline_cache_fill_index(fun, op_ip, shape, member - self->members.values);
+            }
+            #endif
+            return;
+        }
+        #if MICROPY_OPT_INSTANCE_SHAPES
+        if (shape != NULL) {
+            mp_obj_instance_store_member(self, qst, value);
+            if (self->shape != NULL) {
+                // remember the move to the shape with the new attribute
+                entry = inline_cache_fill(fun, op_ip);
+                if (entry != NULL) {
+                    entry->guard = shape;
+                    entry->index = INLINE_CACHE_NOT_MEMBER;
+                    entry->value = MP_OBJ_FROM_PTR(self->shape);
+                }
+            }
+            return;
+        }
+        #endif
+    }
+    mp_store_attr(obj, qst, value);
+}
+
+static MP_NOINLINE void inline_cache_load_method_slow(mp_obj_fun_bc_t *fun, const byte *op_ip, mp_obj_t obj, qstr qst, mp_obj_t *dest) {
+    const mp_obj_type_t *type = mp_obj_get_type(obj);
+    if (type == &mp_type_module) {
+        // a module attribute, as for LOAD_ATTR
+        dest[0] = inline_cache_load_attr_slow(fun, op_ip, obj, qst);
+        dest[1] = MP_OBJ_NULL;
+        return;
+    }
+    const void *guard = type;
+    if (mp_obj_is_instance_type(type)) {
+        #if INLINE_CACHE_INSTANCE_METHODS
+        guard = ((mp_obj_instance_t *)MP_OBJ_TO_PTR(obj))->shape;
+        #else
+        guard = NULL;
+        #endif
+    }
+    #if INLINE_CACHE_INSTANCE_METHODS
+    size_t version = MP_STATE_VM(class_lookup_version);
+    #endif
+    mp_inline_cache_entry_t *entry = inline_cache_get(fun, op_ip);
+    if (guard != NULL && entry != NULL && entry->guard == guard
+        #if INLINE_CACHE_INSTANCE_METHODS
+        && (guard == type || entry->version == version)
+        #endif
+        ) {
+        INLINE_CACHE_HIT();
+        dest[0] = entry->value;
+        dest[1] = obj;
+        return;
+    }
+    INLINE_CACHE_MISS();
+    mp_load_method(obj, qst, dest);
+    if (guard == NULL || dest[1] != obj) {
+        // not a method bound to obj
+        return;
+    }
+    if (guard != type) {
+        // A method of an instance found in its class: the shape shows that the
+        // instance has no attribute of this name, and the version that the
+        // class hasn't changed since.
+        if ((type->flags & MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS) || !mp_obj_instance_type_is_plain(type)) {
+            return;
+        }
+    } else if (MP_OBJ_TYPE_HAS_SLOT(type, attr) || !MP_OBJ_TYPE_HAS_SLOT(type, locals_dict)
+               || !MP_OBJ_TYPE_GET_SLOT(type, locals_dict)->map.is_fixed) {
+        // only native types whose methods all come from a fixed locals_dict
+        return;
+    }
+    entry = inline_cache_fill(fun, op_ip);
+    if (entry != NULL) {
+        entry->guard = guard;
+        entry->value = dest[0];
+        #if INLINE_CACHE_INSTANCE_METHODS
+        entry->version = version;
+        #endif
+    }
+}
+
+// The common hits, which are inlined into the opcodes, leaving everything else
+// to the functions above.
+
+static inline mp_obj_t inline_cache_load_global(mp_obj_fun_bc_t *fun, const byte *op_ip, qstr qst) {
+    mp_map_t *globals = &mp_globals_get()->map;
+    mp_inline_cache_entry_t *entry = inline_cache_get(fun, op_ip);
+    if (entry != NULL && entry->guard == globals) {
+        size_t index = entry->index;
+        if (index < globals->alloc && globals->table[index].key == MP_OBJ_NEW_QSTR(qst)) {
+            INLINE_CACHE_HIT();
+            return globals->table[index].value;
+        }
+        if ((index & INLINE_CACHE_BUILTIN) && entry->version == MP_STATE_VM(map_keys_added)) {
+            INLINE_CACHE_HIT();
+            return mp_module_builtins_globals.map.table[index & ~INLINE_CACHE_BUILTIN].value;
+        }
+    }
+    return inline_cache_load_global_slow(fun, op_ip, qst);
+}
+
+#if MICROPY_OPT_INSTANCE_SHAPES
+// Returns the entry of the opcode if obj is an instance with the shape it's for.
+static inline mp_inline_cache_entry_t *inline_cache_get_instance(mp_obj_fun_bc_t *fun, const byte *op_ip, mp_obj_t obj) {
+    if (mp_obj_is_obj(obj)) {
+        mp_obj_instance_t *self = MP_OBJ_TO_PTR(obj);
+        mp_inline_cache_entry_t *entry = inline_cache_get(fun, op_ip);
+        if (entry != NULL && mp_obj_is_instance_type(self->base.type) && self->shape == entry->guard) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+#endif
+
+static inline mp_obj_t inline_cache_load_attr(mp_obj_fun_bc_t *fun, const byte *op_ip, mp_obj_t obj, qstr qst) {
+    #if MICROPY_OPT_INSTANCE_SHAPES
+    mp_inline_cache_entry_t *entry = inline_cache_get_instance(fun, op_ip, obj);
+    if (entry != NULL && entry->index != INLINE_CACHE_NOT_MEMBER) {
+        INLINE_CACHE_HIT();
+        return ((mp_obj_instance_t *)MP_OBJ_TO_PTR(obj))->members.values[entry->index];
+    }
+    #endif
+    return inline_cache_load_attr_slow(fun, op_ip, obj, qst);
+}
+
+static inline void inline_cache_store_attr(mp_obj_fun_bc_t *fun, const byte *op_ip, mp_obj_t obj, qstr qst, mp_obj_t value) {
+    #if MICROPY_OPT_INSTANCE_SHAPES
+    mp_inline_cache_entry_t *entry = inline_cache_get_instance(fun, op_ip, obj);
+    if (entry != NULL && entry->index != INLINE_CACHE_NOT_MEMBER && value != MP_OBJ_NULL
+        && !(((mp_obj_base_t *)MP_OBJ_TO_PTR(obj))->type->flags & MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS)) {
+        INLINE_CACHE_HIT();
+        ((mp_obj_instance_t *)MP_OBJ_TO_PTR(obj))->members.values[entry->index] = value;
+        return;
+    }
+    #endif
+    inline_cache_store_attr_slow(fun, op_ip, obj, qst, value);
+}
+
+static inline void inline_cache_load_method(mp_obj_fun_bc_t *fun, const byte *op_ip, mp_obj_t obj, qstr qst, mp_obj_t *dest) {
+    #if INLINE_CACHE_INSTANCE_METHODS
+    mp_inline_cache_entry_t *entry = inline_cache_get_instance(fun, op_ip, obj);
+    if (entry != NULL && entry->version == MP_STATE_VM(class_lookup_version)) {
+        INLINE_CACHE_HIT();
+        dest[0] = entry->value;
+        dest[1] = obj;
+        return;
+    }
+    #endif
+    inline_cache_load_method_slow(fun, op_ip, obj, qst, dest);
+}
+
+#endif // MICROPY_OPT_INLINE_CACHE
+
+#if !MICROPY_OPT_INLINE_CACHE
+static inline mp_obj_t vm_load_attr(mp_obj_t obj, qstr qst) {
+    #if MICROPY_OPT_LOAD_ATTR_FAST_PATH
+    // For the specific case of an instance type, it implements .attr
+    // and forwards to its members. Attribute lookups on instance
+    // types are extremely common, so avoid all the other checks and
+    // calls that normally happen first.
+    if (mp_obj_is_instance_type(mp_obj_get_type(obj))) {
+        mp_obj_t *member = mp_obj_instance_find_member(MP_OBJ_TO_PTR(obj), qst);
+        if (member) {
+            return *member;
+        }
+    }
+    #endif
+    return mp_load_attr(obj, qst);
+}
+#endif
+
+// Compares two small ints with one of the binary ops from LESS to NOT_EQUAL.
+static inline bool vm_small_int_compare(mp_uint_t op, mp_int_t lhs, mp_int_t rhs) {
+    switch (op) {
+        case MP_BINARY_OP_LESS:
+            return lhs < rhs;
+        case MP_BINARY_OP_MORE:
+            return lhs > rhs;
+        case MP_BINARY_OP_EQUAL:
+            return lhs == rhs;
+        case MP_BINARY_OP_LESS_EQUAL:
+            return lhs <= rhs;
+        case MP_BINARY_OP_MORE_EQUAL:
+            return lhs >= rhs;
+        default:
+            return lhs != rhs;
+    }
+}
+
+#if MICROPY_OPT_FLOAT_POOL
+// Whether o is a float or complex, and so can be given to the float pool.
+static inline bool vm_is_float_or_complex(mp_obj_t o) {
+    #if MICROPY_PY_BUILTINS_COMPLEX
+    return mp_obj_is_float(o) || mp_obj_is_type(o, &mp_type_complex);
+    #else
+    return mp_obj_is_float(o);
+    #endif
+}
+#endif
+
 // fastn has items in reverse order (fastn[0] is local[0], fastn[-1] is local[1], etc)
 // sp points to bottom of stack which grows up
 // returns:
@@ -289,7 +771,15 @@ outer_dispatch_loop:
             #if MICROPY_EMIT_BYTECODE_USES_QSTR_TABLE
             const qstr_short_t *qstr_table = code_state->fun_bc->context->constants.qstr_table;
             #endif
+            #if MICROPY_OPT_INLINE_CACHE
+            mp_obj_fun_bc_t *ic_fun = INLINE_CACHE_USABLE() ? code_state->fun_bc : NULL;
+            #endif
             mp_obj_t obj_shared;
+            #if MICROPY_OPT_FLOAT_POOL
+            // The new float or complex made by the last BINARY_OP_TEMP_RESULT,
+            // if it made one, see MP_BC_BINARY_OP_TEMP
+            mp_obj_t float_temp = MP_OBJ_NULL;
+            #endif
             MICROPY_VM_HOOK_INIT
 
             // If we have exception to inject, now that we finish setting up
@@ -387,46 +877,84 @@ dispatch_loop:
 
                 ENTRY(MP_BC_LOAD_GLOBAL): {
                     MARK_EXC_IP_SELECTIVE();
+                    #if MICROPY_OPT_INLINE_CACHE
+                    const byte *op_ip = ip - 1;
+                    DECODE_QSTR;
+                    PUSH(inline_cache_load_global(ic_fun, op_ip, qst));
+                    #else
                     DECODE_QSTR;
                     PUSH(mp_load_global(qst));
+                    #endif
                     DISPATCH();
                 }
 
                 ENTRY(MP_BC_LOAD_ATTR): {
                     FRAME_UPDATE();
                     MARK_EXC_IP_SELECTIVE();
+                    #if MICROPY_OPT_INLINE_CACHE
+                    const byte *op_ip = ip - 1;
+                    #endif
                     DECODE_QSTR;
-                    mp_obj_t top = TOP();
-                    mp_obj_t obj;
-                    #if MICROPY_OPT_LOAD_ATTR_FAST_PATH
-                    // For the specific case of an instance type, it implements .attr
-                    // and forwards to its members map. Attribute lookups on instance
-                    // types are extremely common, so avoid all the other checks and
-                    // calls that normally happen first.
-                    mp_map_elem_t *elem = NULL;
-                    if (mp_obj_is_instance_type(mp_obj_get_type(top))) {
-                        mp_obj_instance_t *self = MP_OBJ_TO_PTR(top);
-                        elem = mp_map_lookup(&self->members, MP_OBJ_NEW_QSTR(qst), MP_MAP_LOOKUP);
-                    }
-                    if (elem) {
-                        obj = elem->value;
-                    } else
+                    #if MICROPY_OPT_INLINE_CACHE
+                    SET_TOP(inline_cache_load_attr(ic_fun, op_ip, TOP(), qst));
+                    #else
+                    SET_TOP(vm_load_attr(TOP(), qst));
                     #endif
-                    {
-                        obj = mp_load_attr(top, qst);
+                    DISPATCH();
+                }
+
+                ENTRY(MP_BC_LOAD_FAST_LOAD_ATTR): {
+                    FRAME_UPDATE();
+                    MARK_EXC_IP_SELECTIVE();
+                    #if MICROPY_OPT_INLINE_CACHE
+                    const byte *op_ip = ip - 1;
+                    #endif
+                    DECODE_QSTR;
+                    obj_shared = fastn[-(mp_int_t)*ip++];
+                    if (obj_shared == MP_OBJ_NULL) {
+                        goto local_name_error;
                     }
-                    SET_TOP(obj);
+                    #if MICROPY_OPT_INLINE_CACHE
+                    PUSH(inline_cache_load_attr(ic_fun, op_ip, obj_shared, qst));
+                    #else
+                    PUSH(vm_load_attr(obj_shared, qst));
+                    #endif
                     DISPATCH();
                 }
 
                 ENTRY(MP_BC_LOAD_METHOD): {
                     MARK_EXC_IP_SELECTIVE();
+                    #if MICROPY_OPT_INLINE_CACHE
+                    const byte *op_ip = ip - 1;
+                    DECODE_QSTR;
+                    inline_cache_load_method(ic_fun, op_ip, *sp, qst, sp);
+                    #else
                     DECODE_QSTR;
                     mp_load_method(*sp, qst, sp);
+                    #endif
                     sp += 1;
                     DISPATCH();
                 }
 
+                ENTRY(MP_BC_LOAD_FAST_LOAD_METHOD): {
+                    MARK_EXC_IP_SELECTIVE();
+                    #if MICROPY_OPT_INLINE_CACHE
+                    const byte *op_ip = ip - 1;
+                    #endif
+                    DECODE_QSTR;
+                    obj_shared = fastn[-(mp_int_t)*ip++];
+                    if (obj_shared == MP_OBJ_NULL) {
+                        goto local_name_error;
+                    }
+                    #if MICROPY_OPT_INLINE_CACHE
+                    inline_cache_load_method(ic_fun, op_ip, obj_shared, qst, sp + 1);
+                    #else
+                    mp_load_method(obj_shared, qst, sp + 1);
+                    #endif
+                    sp += 2;
+                    DISPATCH();
+                }
+
                 ENTRY(MP_BC_LOAD_SUPER_METHOD): {
                     MARK_EXC_IP_SELECTIVE();
                     DECODE_QSTR;
@@ -453,6 +981,12 @@ dispatch_loop:
                     DISPATCH();
                 }
 
+                ENTRY(MP_BC_STORE_FAST_LOAD_FAST): {
+                    DECODE_UINT;
+                    fastn[-unum] = TOP();
+                    DISPATCH();
+                }
+
                 ENTRY(MP_BC_STORE_DEREF): {
                     DECODE_UINT;
                     mp_obj_cell_set(fastn[-unum], POP());
@@ -476,8 +1010,14 @@ dispatch_loop:
                 ENTRY(MP_BC_STORE_ATTR): {
                     FRAME_UPDATE();
                     MARK_EXC_IP_SELECTIVE();
+                    #if MICROPY_OPT_INLINE_CACHE
+                    const byte *op_ip = ip - 1;
+                    DECODE_QSTR;
+                    inline_cache_store_attr(ic_fun, op_ip, sp[0], qst, sp[-1]);
+                    #else
                     DECODE_QSTR;
                     mp_store_attr(sp[0], qst, sp[-1]);
+                    #endif
                     sp -= 2;
                     DISPATCH();
                 }
@@ -575,6 +1115,26 @@ dispatch_loop:
                     DISPATCH_WITH_PEND_EXC_CHECK();
                 }
 
+                ENTRY(MP_BC_BINARY_OP_POP_JUMP_IF): {
+                    MARK_EXC_IP_SELECTIVE();
+                    DECODE_SLABEL;
+                    const byte *target = ip + slab;
+                    mp_uint_t op = *ip & ~MP_BC_BINARY_OP_POP_JUMP_IF_TRUE;
+                    bool jump_if = *ip++ & MP_BC_BINARY_OP_POP_JUMP_IF_TRUE;
+                    mp_obj_t rhs = POP();
+                    mp_obj_t lhs = POP();
+                    bool cond;
+                    if (mp_obj_is_small_int(lhs) && mp_obj_is_small_int(rhs) && op <= MP_BINARY_OP_NOT_EQUAL) {
+                        cond = vm_small_int_compare(op, MP_OBJ_SMALL_INT_VALUE(lhs), MP_OBJ_SMALL_INT_VALUE(rhs));
+                    } else {
+                        cond = mp_obj_is_true(mp_binary_op(op, lhs, rhs));
+                    }
+                    if (cond == jump_if) {
+                        ip = target;
+                    }
+                    DISPATCH_WITH_PEND_EXC_CHECK();
+                }
+
                 ENTRY(MP_BC_JUMP_IF_TRUE_OR_POP): {
                     DECODE_ULABEL;
                     if (mp_obj_is_true(TOP())) {
@@ -891,6 +1451,63 @@ unwind_jump:;
                     DISPATCH();
                 }
 
+                ENTRY(MP_BC_FORMAT_VALUE): {
+                    MARK_EXC_IP_SELECTIVE();
+                    DECODE_UINT;
+                    mp_obj_t format_spec = MP_OBJ_NULL;
+                    if (unum & MP_BC_FORMAT_VALUE_SPEC) {
+                        format_spec = POP();
+                    }
+                    char conversion = (unum & MP_BC_FORMAT_VALUE_STR) ? 's' : (unum & MP_BC_FORMAT_VALUE_REPR) ? 'r' : '\0';
+                    mp_obj_t *value = sp - (unum >> MP_BC_FORMAT_VALUE_DEPTH_SHIFT);
+                    *value = mp_obj_str_format_value(*value, conversion, format_spec);
+                    DISPATCH();
+                }
+
+                ENTRY(MP_BC_BUILD_STRING): {
+                    MARK_EXC_IP_SELECTIVE();
+                    DECODE_UINT;
+                    sp -= unum - 1;
+                    SET_TOP(mp_obj_str_build(unum, sp));
+                    DISPATCH();
+                }
+
+                ENTRY(MP_BC_BINARY_OP_TEMP):
+                ENTRY(MP_BC_BINARY_OP_TEMP_RESULT): {
+                    MARK_EXC_IP_SELECTIVE();
+                    mp_uint_t arg = *ip++;
+                    mp_obj_t rhs = POP();
+                    mp_obj_t lhs = TOP();
+                    #if MICROPY_OPT_FLOAT_POOL
+                    // Binary ops between small ints, floats and complex numbers
+                    // read the values of their operands before making a new float
+                    // or complex result, and don't keep the operands.  So when an
+                    // operand flagged as the result of a nested binary op is
+                    // float_temp, it was made by that op and only the stack refers
+                    // to it: it goes back to the pool now and the result of this
+                    // op is usually made in the same object.
+                    bool numeric = (mp_obj_is_small_int(lhs) || vm_is_float_or_complex(lhs))
+                        && (mp_obj_is_small_int(rhs) || vm_is_float_or_complex(rhs));
+                    if (numeric && float_temp != MP_OBJ_NULL) {
+                        if (lhs == float_temp && (arg & MP_BC_BINARY_OP_TEMP_LHS)) {
+                            mp_obj_float_recycle(lhs);
+                        } else if (rhs == float_temp && (arg & MP_BC_BINARY_OP_TEMP_RHS)) {
+                            mp_obj_float_recycle(rhs);
+                        }
+                    }
+                    float_temp = MP_OBJ_NULL;
+                    #endif
+                    mp_obj_t res = mp_binary_op(arg & MP_BC_BINARY_OP_TEMP_OP_MASK, lhs, rhs);
+                    SET_TOP(res);
+                    #if MICROPY_OPT_FLOAT_POOL
+                    // ip[-2] is the opcode
+                    if (numeric && ip[-2] == MP_BC_BINARY_OP_TEMP_RESULT && vm_is_float_or_complex(res)) {
+                        float_temp = res;
+                    }
+                    #endif
+                    DISPATCH();
+                }
+
                 ENTRY(MP_BC_MAKE_FUNCTION): {
                     DECODE_PTR;
                     PUSH(mp_make_function_from_proto_fun(ptr, code_state->fun_bc->context, NULL));
@@ -1250,6 +1867,40 @@ yield:
                     mp_import_all(POP());
                     DISPATCH();
 
+                ENTRY(MP_BC_LOAD_FAST_BINARY_OP_SMALL_INT): {
+                    MARK_EXC_IP_SELECTIVE();
+                    DECODE_UINT;
+                    obj_shared = fastn[-(mp_int_t)MP_BC_LOAD_FAST_BINARY_OP_SMALL_INT_LOCAL(unum)];
+                    if (obj_shared == MP_OBJ_NULL) {
+                        goto local_name_error;
+                    }
+                    mp_uint_t op = MP_BC_LOAD_FAST_BINARY_OP_SMALL_INT_OP(unum);
+                    mp_int_t rhs = MP_BC_LOAD_FAST_BINARY_OP_SMALL_INT_VAL(unum);
+                    #if MICROPY_OPT_FLOAT_POOL
+                    // This may stand for a BINARY_OP_TEMP_RESULT with no flags,
+                    // and its result is not known to be new
+                    float_temp = MP_OBJ_NULL;
+                    #endif
+                    if (mp_obj_is_small_int(obj_shared)) {
+                        mp_int_t lhs = MP_OBJ_SMALL_INT_VALUE(obj_shared);
+                        if (op <= MP_BINARY_OP_NOT_EQUAL) {
+                            PUSH(mp_obj_new_bool(vm_small_int_compare(op, lhs, rhs)));
+                            DISPATCH();
+                        }
+                        // rhs is small enough that these can't overflow an mp_int_t
+                        if ((op == MP_BINARY_OP_ADD || op == MP_BINARY_OP_INPLACE_ADD) && MP_SMALL_INT_FITS(lhs + rhs)) {
+                            PUSH(MP_OBJ_NEW_SMALL_INT(lhs + rhs));
+                            DISPATCH();
+                        }
+                        if ((op == MP_BINARY_OP_SUBTRACT || op == MP_BINARY_OP_INPLACE_SUBTRACT) && MP_SMALL_INT_FITS(lhs - rhs)) {
+                            PUSH(MP_OBJ_NEW_SMALL_INT(lhs - rhs));
+                            DISPATCH();
+                        }
+                    }
+                    PUSH(mp_binary_op(op, obj_shared, MP_OBJ_NEW_SMALL_INT(rhs)));
+                    DISPATCH();
+                }
+
                 #if MICROPY_OPT_COMPUTED_GOTO
                 ENTRY(MP_BC_LOAD_CONST_SMALL_INT_MULTI):
                     PUSH(MP_OBJ_NEW_SMALL_INT((mp_int_t)ip[-1] - MP_BC_LOAD_CONST_SMALL_INT_MULTI - MP_BC_LOAD_CONST_SMALL_INT_MULTI_EXCESS));
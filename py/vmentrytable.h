@@ -50,10 +50,13 @@ static const void *const entry_table[256] = {
     [MP_BC_LOAD_GLOBAL] = &&entry_MP_BC_LOAD_GLOBAL,
     [MP_BC_LOAD_ATTR] = &&entry_MP_BC_LOAD_ATTR,
     [MP_BC_LOAD_METHOD] = &&entry_MP_BC_LOAD_METHOD,
+    [MP_BC_LOAD_FAST_LOAD_ATTR] = &&entry_MP_BC_LOAD_FAST_LOAD_ATTR,
+    [MP_BC_LOAD_FAST_LOAD_METHOD] = &&entry_MP_BC_LOAD_FAST_LOAD_METHOD,
     [MP_BC_LOAD_SUPER_METHOD] = &&entry_MP_BC_LOAD_SUPER_METHOD,
     [MP_BC_LOAD_BUILD_CLASS] = &&entry_MP_BC_LOAD_BUILD_CLASS,
     [MP_BC_LOAD_SUBSCR] = &&entry_MP_BC_LOAD_SUBSCR,
     [MP_BC_STORE_FAST_N] = &&entry_MP_BC_STORE_FAST_N,
+    [MP_BC_STORE_FAST_LOAD_FAST] = &&entry_MP_BC_STORE_FAST_LOAD_FAST,
     [MP_BC_STORE_DEREF] = &&entry_MP_BC_STORE_DEREF,
     [MP_BC_STORE_NAME] = &&entry_MP_BC_STORE_NAME,
     [MP_BC_STORE_GLOBAL] = &&entry_MP_BC_STORE_GLOBAL,
@@ -71,6 +74,7 @@ static const void *const entry_table[256] = {
     [MP_BC_JUMP] = &&entry_MP_BC_JUMP,
     [MP_BC_POP_JUMP_IF_TRUE] = &&entry_MP_BC_POP_JUMP_IF_TRUE,
     [MP_BC_POP_JUMP_IF_FALSE] = &&entry_MP_BC_POP_JUMP_IF_FALSE,
+    [MP_BC_BINARY_OP_POP_JUMP_IF] = &&entry_MP_BC_BINARY_OP_POP_JUMP_IF,
     [MP_BC_JUMP_IF_TRUE_OR_POP] = &&entry_MP_BC_JUMP_IF_TRUE_OR_POP,
     [MP_BC_JUMP_IF_FALSE_OR_POP] = &&entry_MP_BC_JUMP_IF_FALSE_OR_POP,
     [MP_BC_SETUP_WITH] = &&entry_MP_BC_SETUP_WITH,
@@ -96,6 +100,10 @@ static const void *const entry_table[256] = {
     [MP_BC_STORE_COMP] = &&entry_MP_BC_STORE_COMP,
     [MP_BC_UNPACK_SEQUENCE] = &&entry_MP_BC_UNPACK_SEQUENCE,
     [MP_BC_UNPACK_EX] = &&entry_MP_BC_UNPACK_EX,
+    [MP_BC_FORMAT_VALUE] = &&entry_MP_BC_FORMAT_VALUE,
+    [MP_BC_BUILD_STRING] = &&entry_MP_BC_BUILD_STRING,
+    [MP_BC_BINARY_OP_TEMP] = &&entry_MP_BC_BINARY_OP_TEMP,
+    [MP_BC_BINARY_OP_TEMP_RESULT] = &&entry_MP_BC_BINARY_OP_TEMP_RESULT,
     [MP_BC_MAKE_FUNCTION] = &&entry_MP_BC_MAKE_FUNCTION,
     [MP_BC_MAKE_FUNCTION_DEFARGS] = &&entry_MP_BC_MAKE_FUNCTION_DEFARGS,
     [MP_BC_MAKE_CLOSURE] = &&entry_MP_BC_MAKE_CLOSURE,
@@ -113,6 +121,7 @@ static const void *const entry_table[256] = {
     [MP_BC_IMPORT_NAME] = &&entry_MP_BC_IMPORT_NAME,
     [MP_BC_IMPORT_FROM] = &&entry_MP_BC_IMPORT_FROM,
     [MP_BC_IMPORT_STAR] = &&entry_MP_BC_IMPORT_STAR,
+    [MP_BC_LOAD_FAST_BINARY_OP_SMALL_INT] = &&entry_MP_BC_LOAD_FAST_BINARY_OP_SMALL_INT,
     [MP_BC_LOAD_CONST_SMALL_INT_MULTI ... MP_BC_LOAD_CONST_SMALL_INT_MULTI + MP_BC_LOAD_CONST_SMALL_INT_MULTI_NUM - 1] = &&entry_MP_BC_LOAD_CONST_SMALL_INT_MULTI,
     [MP_BC_LOAD_FAST_MULTI ... MP_BC_LOAD_FAST_MULTI + MP_BC_LOAD_FAST_MULTI_NUM - 1] = &&entry_MP_BC_LOAD_FAST_MULTI,
     [MP_BC_STORE_FAST_MULTI ... MP_BC_STORE_FAST_MULTI + MP_BC_STORE_FAST_MULTI_NUM - 1] = &&entry_MP_BC_STORE_FAST_MULTI,
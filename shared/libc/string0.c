@@ -122,13 +122,27 @@ int memcmp(const void *s1, const void *s2, size_t n) {
 }
 
 void *memchr(const void *s, int c, size_t n) {
-    if (n != 0) {
-        const unsigned char *p = s;
+    const unsigned char *p = s;
+    unsigned char ch = c;
 
-        do {
-            if (*p++ == c)
-                return ((void *)(p - 1));
-        } while (--n != 0);
+    // check bytes until the pointer is aligned
+    for (; n != 0 && (((uintptr_t)p) & 3); --n, ++p) {
+        if (*p == ch)
+            return ((void *)p);
+    }
+
+    // then skip whole words which don't contain the byte
+    uint32_t pattern = (uint32_t)ch * 0x01010101;
+    for (; n >= 4; n -= 4, p += 4) {
+        uint32_t w = *(const uint32_t*)p ^ pattern;
+        if ((w - 0x01010101) & ~w & 0x80808080)
+            break;
+    }
+
+    // and find it in the last (partial) word
+    for (; n != 0; --n, ++p) {
+        if (*p == ch)
+            return ((void *)p);
     }
     return 0;
 }
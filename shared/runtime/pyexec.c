@@ -156,11 +156,14 @@ static int parse_compile_execute(const void *source, mp_parse_input_kind_t input
         mp_printf(&mp_plat_print, "took " UINT_FMT " ms\n", ticks);
         // qstr info
         {
-            size_t n_pool, n_qstr, n_str_data_bytes, n_total_bytes;
-            qstr_pool_info(&n_pool, &n_qstr, &n_str_data_bytes, &n_total_bytes);
+            size_t n_pool, n_qstr, n_str_data_bytes, n_total_bytes, n_reclaimed_bytes;
+            qstr_pool_info(&n_pool, &n_qstr, &n_str_data_bytes, &n_total_bytes, &n_reclaimed_bytes);
             mp_printf(&mp_plat_print, "qstr:\n  n_pool=%u\n  n_qstr=%u\n  "
                 "n_str_data_bytes=%u\n  n_total_bytes=%u\n",
                 (unsigned)n_pool, (unsigned)n_qstr, (unsigned)n_str_data_bytes, (unsigned)n_total_bytes);
+            #if MICROPY_QSTR_GC
+            mp_printf(&mp_plat_print, "  n_reclaimed_bytes=%u\n", (unsigned)n_reclaimed_bytes);
+            #endif
         }
 
         #if MICROPY_ENABLE_GC
@@ -0,0 +1,85 @@
+# test storing, loading and deleting many attributes of instances
+
+
+class A:
+    pass
+
+
+def show(a, names):
+    print([getattr(a, n, None) for n in names], sorted(a.__dict__.items()))
+
+
+# same attributes added in different orders
+a1 = A()
+a1.x = 1
+a1.y = 2
+a2 = A()
+a2.y = 3
+a2.x = 4
+a2.x += 10
+show(a1, "xyz")
+show(a2, "xyz")
+
+# more attributes than fit in one shape
+a = A()
+names = ["a%d" % i for i in range(40)]
+for i, n in enumerate(names):
+    setattr(a, n, i)
+print(sum(getattr(a, n) for n in names), len(a.__dict__))
+for n in names[::3]:
+    delattr(a, n)
+print(sum(getattr(a, n, 0) for n in names), len(a.__dict__))
+
+# instances which each get a different attribute
+objs = []
+for i in range(20):
+    o = A()
+    setattr(o, "k%d" % i, i)
+    o.common = -i
+    objs.append(o)
+print([getattr(o, "k%d" % i) + o.common for i, o in enumerate(objs)])
+
+# delete then add again
+a = A()
+a.x = 1
+a.y = 2
+del a.x
+try:
+    a.x
+except AttributeError:
+    print("AttributeError")
+a.x = 3
+show(a, "xy")
+try:
+    del a.z
+except AttributeError:
+    print("AttributeError")
+
+
+# attributes stored in __init__ of a subclass and its base
+class B(A):
+    def __init__(self, n):
+        self.n = n
+        self.items = list(range(n))
+
+
+class C(B):
+    def __init__(self, n):
+        super().__init__(n)
+        self.total = sum(self.items)
+
+
+print([(c.n, c.total) for c in [C(i) for i in range(5)]])
+
+
+# instance of a subclass of a native type
+class L(list):
+    def __init__(self, name):
+        super().__init__()
+        self.name = name
+
+
+l = L("l")
+l.append(1)
+l.size = len(l)
+print(l, l.name, l.size)
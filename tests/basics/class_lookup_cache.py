@@ -0,0 +1,89 @@
+# test that changes to classes are seen by lookups made before the change
+
+
+class A:
+    def f(self):
+        return "A.f"
+
+    def __add__(self, other):
+        return "A+"
+
+
+class B(A):
+    x = 1
+
+
+class C(B):
+    pass
+
+
+c = C()
+for _ in range(3):
+    print(c.f(), c + 1, c.x, C.x)
+
+# redefine a method in a base class
+A.f = lambda self: "A.f2"
+print(c.f())
+
+# override in a subclass, then delete the override
+B.f = lambda self: "B.f"
+print(c.f())
+del B.f
+print(c.f())
+
+# class attributes
+B.x = 2
+print(c.x, C.x)
+C.x = 3
+print(c.x, C.x, B.x)
+del C.x
+print(c.x, C.x)
+del B.x
+try:
+    c.x
+except AttributeError:
+    print("AttributeError")
+
+# special methods added after the first use
+try:
+    c - 1
+except TypeError:
+    print("TypeError")
+C.__sub__ = lambda self, other: "C-"
+print(c - 1)
+del A.__add__
+try:
+    c + 1
+except TypeError:
+    print("TypeError")
+
+# an instance attribute shadows the class
+c.f = lambda: "instance"
+print(c.f(), C().f())
+
+
+# classes created later with the same attribute names
+def make(n):
+    class D:
+        def g(self):
+            return n
+
+    return D()
+
+
+for i in range(5):
+    print(make(i).g())
+
+
+# native base class
+class L(list):
+    def total(self):
+        return sum(self)
+
+
+l = L([1, 2, 3])
+for _ in range(2):
+    print(l.total(), len(l), l[1])
+l.append(4)
+L.total = lambda self: -1
+print(l.total(), l.pop(), l)
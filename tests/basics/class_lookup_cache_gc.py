@@ -0,0 +1,23 @@
+# test that a type allocated where a freed class was doesn't see its attributes
+
+try:
+    from collections import namedtuple
+    import gc
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+# the fields and padding vary the layout so some type lands on a freed class
+for n in range(1, 9):
+    found = False
+    for pad in range(4):
+        class K:
+            a = 5
+
+        K.a
+        del K
+        gc.collect()
+        p = [None] * pad
+        T = namedtuple("T", tuple("f%d" % i for i in range(n)))
+        found = found or hasattr(T, "a") or hasattr(T(*range(n)), "a")
+    print(n, found)
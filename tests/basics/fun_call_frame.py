@@ -0,0 +1,60 @@
+# test calls that reuse the frames of functions that have returned
+
+
+# function with enough locals that its frame doesn't fit on the C stack
+def big(n, x):
+    a = b = c = d = e = f = g = h = i = j = x
+    if n > 0:
+        a = big(n - 1, x + 1)
+    return a + b + c + d + e + f + g + h + i + j
+
+
+for n in range(20):
+    print(n, big(n, 1))
+
+
+# big frames of different sizes interleaved
+def bigger(x):
+    a = b = c = d = e = f = g = h = i = j = k = l = m = n = o = p = q = r = s = t = x
+    return [a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t]
+
+
+for x in range(5):
+    print(big(2, x), sum(bigger(x)), big(1, x))
+
+
+# a frame returned by an exception
+def big_raise(x):
+    a = b = c = d = e = f = g = h = i = j = x
+    raise ValueError(a + b + c + d + e + f + g + h + i + j)
+
+
+for x in range(3):
+    try:
+        big_raise(x)
+    except ValueError as er:
+        print("ValueError", er.args[0], big(0, x))
+
+
+# positional args with the wrong arity still raise
+def f2(a, b):
+    return a, b
+
+
+print(f2(1, 2))
+for args in ((), (1,), (1, 2, 3)):
+    try:
+        f2(*args)
+    except TypeError:
+        print("TypeError", len(args))
+
+
+# defaults, keyword args and closed over variables still work
+def f3(a, b=2, *, c=3):
+    def inner():
+        return a + b + c
+
+    return inner()
+
+
+print(f3(1), f3(1, 5), f3(1, c=10), f3(b=0, a=0))
@@ -0,0 +1,275 @@
+# test that the caches of global, attribute and method loads are invalidated
+# when the thing they looked up changes
+
+
+# globals rebound and deleted between executions of the same load
+def get_g():
+    return g
+
+
+g = 1
+print(get_g())
+g = 2
+print(get_g())
+del g
+try:
+    get_g()
+except NameError:
+    print("NameError")
+
+
+# a global shadowing a builtin, then removed again
+def call_len():
+    return len([1, 2, 3])
+
+
+print(call_len())
+len = lambda x: "shadowed"
+print(call_len())
+del len
+print(call_len())
+
+
+# module attribute, and the module global rebound to another object
+import sys
+
+
+def get_path():
+    return type(sys.path)
+
+
+print(get_path())
+print(get_path())
+
+
+class S:
+    path = 1
+
+
+sys = S
+print(get_path())
+
+
+# method redefined on the class after calls were made
+class A:
+    def __init__(self):
+        self.x = 1
+        self.y = 2
+
+    def f(self):
+        return "A.f"
+
+
+def call_f(o):
+    return o.f()
+
+
+a = A()
+for _ in range(3):
+    print(call_f(a))
+A.f = lambda self: "new A.f"
+print(call_f(a))
+
+# instance attribute shadowing the method
+a.f = lambda: "instance f"
+print(call_f(a))
+del a.f
+print(call_f(a))
+
+
+# different instance layouts at the same site
+class B:
+    pass
+
+
+def get_x(o):
+    return o.x
+
+
+def set_x(o, v):
+    o.x = v
+
+
+b1 = B()
+b1.x = 10
+b2 = B()
+b2.z = 0
+b2.x = 20
+for o in (a, b1, b2, a, b1, b2):
+    print(get_x(o))
+for o in (a, b1, b2):
+    set_x(o, get_x(o) + 1)
+    print(get_x(o))
+
+# delete then load at the same sites
+del b1.x
+try:
+    get_x(b1)
+except AttributeError:
+    print("AttributeError")
+set_x(b1, 5)
+print(get_x(b1))
+
+
+# properties and __setattr__ are not bypassed
+class C:
+    def __init__(self):
+        self._x = 0
+
+    @property
+    def x(self):
+        return self._x + 100
+
+    @x.setter
+    def x(self, v):
+        self._x = v * 2
+
+
+c = C()
+for o in (b1, c, b1, c):
+    set_x(o, 3)
+    print(get_x(o))
+
+
+class D:
+    def __setattr__(self, name, value):
+        print("setattr", name, value)
+
+
+d = D()
+set_x(d, 1)
+set_x(d, 2)
+
+
+# the attribute moving from the class to the instance and back
+class E:
+    x = "class"
+
+
+e = E()
+print(get_x(e))
+e.x = "instance"
+print(get_x(e))
+del e.x
+print(get_x(e))
+E.x = "class again"
+print(get_x(e))
+
+
+# built-in type methods
+def append(lst, v):
+    lst.append(v)
+
+
+lst = []
+for i in range(3):
+    append(lst, i)
+print(lst)
+
+
+class L(list):
+    def append(self, v):
+        super().append(v * 10)
+
+
+lst = L()
+for i in range(3):
+    append(lst, i)
+print(lst)
+
+
+# a function with many load sites
+def many(o):
+    return (
+        o.a + o.b + o.c + o.d + o.e + o.f + o.g + o.h
+        + o.a + o.b + o.c + o.d + o.e + o.f + o.g + o.h
+        + o.a + o.b + o.c + o.d + o.e + o.f + o.g + o.h
+        + o.a + o.b + o.c + o.d + o.e + o.f + o.g + o.h
+        + o.a + o.b + o.c + o.d + o.e + o.f + o.g + o.h
+        + o.a + o.b + o.c + o.d + o.e + o.f + o.g + o.h
+        + o.a + o.b + o.c + o.d + o.e + o.f + o.g + o.h
+        + o.a + o.b + o.c + o.d + o.e + o.f + o.g + o.h
+        + o.a + o.b + o.c + o.d + o.e + o.f + o.g + o.h
+        + o.a + o.b + o.c + o.d + o.e + o.f + o.g + o.h
+    )
+
+
+class M:
+    pass
+
+
+m = M()
+for i, n in enumerate("abcdefgh"):
+    setattr(m, n, i)
+for _ in range(3):
+    print(many(m))
+m.h = 100
+print(many(m))
+
+
+# attributes added in __init__, past the first allocation of their values
+class N:
+    def __init__(self, n):
+        self.a = n
+        self.b = n + 1
+        self.c = n + 2
+        self.d = n + 3
+        self.e = n + 4
+        self.f = n + 5
+
+
+for i in range(3):
+    n = N(i)
+    print(n.a, n.b, n.c, n.d, n.e, n.f)
+n = N(10)
+n.g = 1
+print(n.a, n.f, n.g)
+
+
+# class attributes read through instances
+class K:
+    k = 1
+
+    @staticmethod
+    def s():
+        return "static"
+
+    @classmethod
+    def c(cls):
+        return cls.__name__
+
+
+def get_k(o):
+    return o.k
+
+
+def get_s(o):
+    return o.s, o.c
+
+
+k = K()
+for _ in range(3):
+    print(get_k(k))
+K.k = 2
+print(get_k(k))
+k.k = 3
+print(get_k(k))
+for _ in range(2):
+    s, c = get_s(k)
+    print(s(), c())
+
+
+# __getattr__ answers only for missing attributes, and may change its answer
+getattr_count = 0
+
+
+class G:
+    def __getattr__(self, name):
+        global getattr_count
+        getattr_count += 1
+        return getattr_count
+
+
+g = G()
+for _ in range(3):
+    print(get_k(g))
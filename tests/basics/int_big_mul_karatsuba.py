@@ -0,0 +1,59 @@
+# test multiplication of big ints large enough to be split into pieces
+
+
+# deterministic pseudo-random ints with the given number of bits
+seed = 1
+
+
+def rnd(bits):
+    global seed
+    r = 1
+    while bits > 0:
+        seed = (seed * 1103515245 + 12345) & 0x7FFFFFFF
+        r = (r << 15) | (seed >> 16)
+        bits -= 15
+    return r
+
+
+# compare against the product built from small pieces of the rhs
+def check(a, b):
+    p = a * b
+    q = 0
+    n = 0
+    while b:
+        q += (a * (b & 0x7FFF)) << n
+        b >>= 15
+        n += 15
+    return p == q, p % 1000000007
+
+
+sizes = (100, 500, 1000, 1024, 1025, 2000, 3000, 5000, 10000)
+for sa in sizes:
+    for sb in sizes:
+        a = rnd(sa)
+        b = rnd(sb)
+        print(sa, sb, check(a, b), check(-a, b), check(b, a))
+
+# all bits set, and trailing zero digits
+for bits in (1000, 2048, 4096, 10000):
+    m = (1 << bits) - 1
+    print(bits, check(m, m), check(m << 3000, m), (m * m) % 1000000007)
+
+# squaring
+x = rnd(4000)
+for _ in range(4):
+    print(check(x, x))
+    x = x * x
+print(x % 1000000007, (x >> 12345) % 999983)
+
+# products that build up from small ones
+f = 1
+for i in range(2, 2000):
+    f *= i
+g = 1
+for i in range(1, 2000, 2):
+    g *= i
+h = 1
+for i in range(2, 2000, 2):
+    h *= i
+print(g * h == f, (g * h) % 1000000007)
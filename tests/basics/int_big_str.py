@@ -0,0 +1,40 @@
+# test conversion of big ints to and from strings long enough to be split
+
+
+# deterministic pseudo-random ints with the given number of bits
+seed = 1
+
+
+def rnd(bits):
+    global seed
+    r = 1
+    while bits > 0:
+        seed = (seed * 1103515245 + 12345) & 0x7FFFFFFF
+        r = (r << 15) | (seed >> 16)
+        bits -= 15
+    return r
+
+
+# values with runs of zero and nine digits around the split points
+values = [10**1000, 10**1000 - 1, 10**2000 + 1, 7**1500, (1 << 5000) - 1, 1 << 4096]
+values += [rnd(bits) for bits in (500, 1000, 1024, 2000, 4000, 8000, 14000)]
+for x in values:
+    for v in (x, -x):
+        s = str(v)
+        print(len(s), s[:30], s[-30:], int(s) == v)
+        for fmt, base in (("{:x}", 16), ("{:o}", 8), ("{:b}", 2), ("{:X}", 16)):
+            s = fmt.format(v)
+            print(len(s), s[-20:], int(s, base) == v)
+        s = "{:,}".format(v)
+        print(len(s), s[:30], s[-30:], int(s.replace(",", "")) == v)
+
+# other bases, leading zeros and invalid characters
+s = str(rnd(6000))
+for base in (3, 7, 11, 36):
+    t = "".join("0123456789abcdefghijklmnopqrstuvwxyz"[(int(c) * 5) % base] for c in s)
+    x = int(t, base)
+    print(base, x % 1000000007, int(t.upper(), base) == x, int("0" * 500 + t, base) == x)
+try:
+    int("1" * 3000 + "x")
+except ValueError:
+    print("ValueError")
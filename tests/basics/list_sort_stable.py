@@ -0,0 +1,36 @@
+# test that list.sort and sorted are stable, and keep all items on error
+
+# stability, with and without reverse, on random-like and partly sorted data
+data = [(i * 7919) % 1009 // 8 for i in range(600)] + list(range(100)) + list(range(300, 200, -1))
+idx = list(range(len(data)))
+print(sorted(idx, key=lambda i: data[i]) == sorted(idx, key=lambda i: (data[i], i)))
+print(sorted(idx, key=lambda i: data[i], reverse=True) == sorted(idx, key=lambda i: (-data[i], i)))
+pairs = [(x // 3, i) for i, x in enumerate(data)]
+print(sorted(pairs, key=lambda p: p[0])[:8], sorted(pairs, key=lambda p: p[0], reverse=True)[:8])
+
+# the key function is called once per item
+calls = []
+print(sorted([3, 1, 2, 1], key=lambda x: calls.append(x) or -x), calls)
+
+# a comparison which raises part way leaves all items in the list
+class C:
+    def __init__(self, v):
+        self.v = v
+
+    def __lt__(self, other):
+        global budget
+        budget -= 1
+        if budget < 0:
+            raise ValueError
+        return self.v < other.v
+
+
+for n in (10, 100, 1000):
+    for b in (5, n, n * 4):
+        lst = [C((i * 37) % 101) for i in range(n)]
+        budget = b
+        try:
+            lst.sort()
+        except ValueError:
+            pass
+        print(n, b, sorted(x.v for x in lst) == sorted((i * 37) % 101 for i in range(n)))
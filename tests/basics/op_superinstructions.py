@@ -0,0 +1,119 @@
+# test sequences of opcodes that the compiler may fuse into single opcodes
+
+
+# a local compared with or added to a small int
+def small_int(x):
+    return x < 3, x > -3, x == 0, x <= 1, x >= 1, x != 2, x + 5, x - 5, x * 2, x // 2
+
+
+for x in (-4, 0, 1, 2, 3, True):
+    print(small_int(x))
+
+
+# operators on other types still apply
+try:
+    small_int("a")
+except TypeError:
+    print("TypeError")
+
+
+# compares followed by conditional jumps
+def compare_jump(a, b):
+    r = []
+    if a < b:
+        r.append("<")
+    if a > b:
+        r.append(">")
+    if a == b:
+        r.append("==")
+    if a != b:
+        r.append("!=")
+    if a <= b:
+        r.append("<=")
+    if a >= b:
+        r.append(">=")
+    if a is b:
+        r.append("is")
+    if a is not b:
+        r.append("is not")
+    if not a == b:
+        r.append("not ==")
+    return r
+
+
+for a, b in ((1, 2), (2, 1), (1, 1), (-1, True), (0, False), ("a", "a"), ((), ())):
+    print(compare_jump(a, b))
+
+
+def count(a, b):
+    n = 0
+    while a < b:
+        a += 1
+        n += 1
+    return n
+
+
+print(count(0, 5), count(5, 0), count(-3, -1))
+
+
+def contains(x, seq):
+    if x in seq:
+        return "in"
+    if x not in seq:
+        return "not in"
+
+
+print(contains(1, (1, 2)), contains(3, (1, 2)), contains("a", "abc"), contains("d", "abc"))
+
+
+# an object whose compares return objects that aren't bools
+class Cmp:
+    def __init__(self, truthy):
+        self.truthy = truthy
+
+    def __lt__(self, other):
+        return self.truthy
+
+    def __bool__(self):
+        raise ValueError("no bool")
+
+
+def cmp_jump(a, b):
+    if a < b:
+        return "yes"
+    return "no"
+
+
+print(cmp_jump(Cmp([1]), 0), cmp_jump(Cmp([]), 0))
+try:
+    cmp_jump(Cmp(Cmp(0)), 0)
+except ValueError as er:
+    print("ValueError", er)
+
+
+# storing a local and loading it straight back
+def store_load(x):
+    y = x * 2
+    if y:
+        z = y
+    z = z + y
+    return z
+
+
+print(store_load(3), store_load(1))
+
+
+# attributes and methods of locals
+class A:
+    def __init__(self):
+        self.x = 1
+
+    def f(self, n):
+        return self.x + n
+
+
+def attrs(a, b):
+    return a.x + b.x, a.f(1), b.f(2)
+
+
+print(attrs(A(), A()))
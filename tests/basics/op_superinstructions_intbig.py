@@ -0,0 +1,10 @@
+# test fused opcodes with small int arguments whose results don't fit a small int
+
+
+def add_big(x):
+    x += 32767
+    return x + 1, x - 32767, x - -32767
+
+
+for x in (0, 1 << 29, 1 << 30, 1 << 61, 1 << 62, -(1 << 62)):
+    print(add_big(x))
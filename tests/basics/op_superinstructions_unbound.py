@@ -0,0 +1,44 @@
+# test fused opcodes that load a local which is unbound
+
+
+# storing a local and loading it straight back
+def store_load(x):
+    y = x * 2
+    if y:
+        z = y
+    z = z + y
+    return z
+
+
+try:
+    store_load(0)
+except NameError:
+    print("NameError")
+
+
+# attributes and methods of locals
+class A:
+    def __init__(self):
+        self.x = 1
+
+    def f(self, n):
+        return self.x + n
+
+
+def unbound_attr():
+    a = A()
+    del a
+    return a.x
+
+
+def unbound_method():
+    a = A()
+    del a
+    return a.f(1)
+
+
+for f in (unbound_attr, unbound_method):
+    try:
+        f()
+    except NameError:
+        print("NameError")
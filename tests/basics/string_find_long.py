@@ -0,0 +1,18 @@
+# test searching long strings, where longer needles use a skip table
+
+h = "abcab" * 60 + "abcabd" + "xy" * 150 + "abcabd" + "ab"
+for n in ("abcabd", "abcabdxy", "yabcabda", "dxyx", "bab", "abd", "zzzz", "b", "d", "ab"):
+    print(n, h.find(n), h.rfind(n), h.count(n), len(h.split(n)), len(h.rsplit(n, 3)), n in h)
+
+# needle longer than 255 bytes, and needle as long as the haystack
+n = "xy" * 130
+print(h.find(n), h.rfind(n), h.find(h), h.rfind(h), h.find(h + "a"))
+
+# with start and end
+print(h.find("abcabd", 10, 306), h.find("abcabd", 10, 305), h.rfind("abcabd", 10, 311), h.rfind("abcab", 0, 20))
+
+# bytes
+b = bytes(range(256)) * 2
+print(b.find(b"\xfe\xff\x00\x01"), b.rfind(b"\xfe\xff\x00\x01"), b.count(b"\x00\x01\x02\x03"))
+print(b.replace(b"\x10\x11\x12\x13", b"!").count(b"!"), b.split(b"\x80\x81\x82\x83")[1][:2])
+print(b.index(b"\x05\x06\x07\x08"), b.rindex(b"\x05\x06\x07\x08"), b"\xfd\xfe\xff\x00" in b)
@@ -0,0 +1,59 @@
+# test f-strings and literal str.format calls that the compiler builds in place
+
+
+class A:
+    def __str__(self):
+        return "str"
+
+    def __repr__(self):
+        return "repr"
+
+
+a, b, c, x = 1, "b", [1, 2], A()
+
+# conversions and format specs
+print(f"{a}", f"{b}", f"{c}", f"{x}", f"{None}", f"{True}")
+print(f"{b!r}", f"{b!s}", f"{x!r}", f"{x!s}", f"{c!r}")
+print(f"{a:05d}", f"{b:>4}", f"{b!r:^7}", f"{x!r:>6}", f"{a:}")
+
+# literal text, escaped braces and empty strings
+print(f"", f"text", f"{{}}", f"{{ {a} }}", f"<{a}{b}{x}>")
+print(f"{b}" f"{a}", f"{b}".upper(), f"{a} {b}".split())
+
+# nested format specs are still handled by str.format
+w = 6
+print(f"{a:{w}}|", f"{b:>{w}}|")
+
+# each field is evaluated in order
+def g(n):
+    print("eval", n)
+    return n
+
+
+print(f"{g(1)}-{g(2)}-{g(3)}")
+
+# explicit calls to format on a literal string
+print("{} and {!r}".format(a, b), "{:>3}".format(a), "{{{}}}".format(a))
+print("{0}{1}".format(a, b), "{x}".format(x=a), "{}{}".format(*(a, b)))
+print("{}".format(a, b))
+
+# all the arguments are evaluated before any is formatted
+l = []
+print("{!r}{}".format(l, l.append(1)), "{!s:>8}{}{!r}".format(l, l.append(2), l))
+try:
+    "{:d}{}".format("a", g(4))
+except ValueError:
+    print("ValueError")
+for args in ((), (1,)):
+    try:
+        "{}{}".format(*args)
+    except IndexError:
+        print("IndexError")
+try:
+    "{}}".format(a)
+except ValueError:
+    print("ValueError")
+try:
+    f"{a:z}"
+except ValueError:
+    print("ValueError")
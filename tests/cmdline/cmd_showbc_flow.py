@@ -0,0 +1,22 @@
+# cmdline: -v -v -O
+# test printing of bytecode when control flow is optimised
+
+
+def f0(x):
+    if x:
+        return 1
+    else:
+        return 2
+
+
+def f1(x):
+    for y in x:
+        if y:
+            print(1)
+        else:
+            print(2)
+
+
+def f2():
+    while True:
+        pass
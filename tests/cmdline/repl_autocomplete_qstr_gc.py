@@ -0,0 +1,15 @@
+# tests for autocompletion and dir() once qstrs have been freed by the collector
+import gc
+a = type("A", (), {})()
+n = len([setattr(a, "gone_%d" % i, i) for i in range(400)])
+del a
+n = gc.collect()
+n = gc.collect()
+x = '123'
+x.isdi	()
+x.is	upper()
+c = type("C", (), {"one": 1, "two": 2})()
+c.	one
+g = gc.coll	
+b = type("B", (), {"__getattr__": lambda self, name: 1})()
+0 in [len(name) for name in dir(b)]
@@ -16,6 +16,10 @@ class Test(unittest.TestCase):
         with self.assertRaises(ValueError):
             marshal.dumps(code)
 
+    def test_mpy_version(self):
+        # Bytecode without any of the opcodes added by .mpy version 7 is saved as version 6.
+        self.assertEqual(marshal.dumps((lambda: a).__code__)[:2], b"M\x06")
+
 
 if __name__ == "__main__":
     unittest.main()
@@ -19,5 +19,7 @@ arch = [
     "xtensa",
     "xtensawin",
     "rv32imc",
+    None,  # debug
+    "sh4",
 ][sys_mpy >> 10]
 print(platform, arch)
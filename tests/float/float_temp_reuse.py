@@ -0,0 +1,93 @@
+# test arithmetic expressions whose intermediate floats may be reused
+
+a, b, c = 1.5, 2.5, 4.0
+
+
+# intermediate results that are also kept elsewhere
+def walrus():
+    r = (t := a * b) + c
+    return r, t
+
+
+print(walrus())
+
+saved = []
+
+
+class U:
+    def __init__(self, v):
+        self.v = v
+
+    def __mul__(self, o):
+        return self.v
+
+    def __add__(self, o):
+        return self.v
+
+    def __radd__(self, o):
+        saved.append(o)
+        return 0.0
+
+
+u = U(3.25)
+
+
+def user_ops():
+    x = u * a + c
+    y = a * b + u
+    z = (a * b) * c + 1.0
+    w = (u * 2) + 1.0
+    return x, y, z, w
+
+
+print(user_ops(), u.v, saved)
+
+
+# a generator suspended in the middle of an expression
+def gen():
+    x = a * b + (yield)
+    yield x
+
+
+g = gen()
+next(g)
+print(g.send(1.0))
+
+
+# an exception in the middle of an expression
+def raises():
+    try:
+        return a * b + (1 / 0)
+    except ZeroDivisionError:
+        pass
+    try:
+        return (a * b) / 0.0
+    except ZeroDivisionError:
+        return a * b - c * a
+
+
+print(raises(), a, b, c)
+
+
+# loops
+def loop(n):
+    s = 0.0
+    for i in range(n):
+        s += a * i + b * i * i - c / (i + 1)
+    return s
+
+
+print(loop(1000))
+vals = []
+for i in range(5):
+    v = i * 1.5 + i * 0.5
+    vals.append(v)
+    w = v * 2.0 + 1.0
+print(vals, w)
+
+# complex numbers
+z = 1j
+print(z * z + c, (z + 1) * (z - 1) * 2, abs(z * z * z + 1j), z)
+
+# ints and other types are unaffected
+print(1 + 2 * 3, 7 // 2 + 3 % 2, 2**3**2, (1 << 3) + 5, [1] * 2 + [3])
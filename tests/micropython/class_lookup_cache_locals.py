@@ -0,0 +1,34 @@
+# test that changes to a class made through its locals dict are seen
+# (MicroPython shares the dict with the class, CPython copies it)
+
+
+class C:
+    x = 1
+    d = locals()
+
+
+c = C()
+for _ in range(2):
+    print(C.x, c.x)
+C.d["x"] = 2
+print(C.x, c.x)
+C.d["y"] = 3
+print(C.y, c.y)
+del C.d["y"]
+print(hasattr(C, "y"), hasattr(c, "y"))
+C.d.update({"x": 4})
+print(C.x, c.x)
+print(C.d.pop("x"), hasattr(C, "x"), hasattr(c, "x"))
+C.d.setdefault("x", 5)
+print(C.x, c.x)
+
+# a class created with type() and a dict the caller keeps
+dct = {"f": lambda self: "f"}
+X = type("X", (), dct)
+x = X()
+for _ in range(2):
+    print(x.f())
+dct["f"] = lambda self: "f2"
+print(x.f())
+dct.clear()
+print(hasattr(x, "f"), hasattr(X, "f"))
@@ -0,0 +1,50 @@
+# test that the float temporaries of an arithmetic expression are reused
+# rather than each allocated on the heap
+
+import gc
+
+try:
+    float
+except NameError:
+    print("SKIP")
+    raise SystemExit
+
+
+def single(n, a, b):
+    for i in range(n):
+        x = a * b
+    return x
+
+
+def expr(n, a, b, c, d, e):
+    for i in range(n):
+        x = a * b + c * d - e
+    return x
+
+
+def measure(f, *args):
+    gc.collect()
+    gc.disable()
+    m = gc.mem_alloc()
+    f(*args)
+    m = gc.mem_alloc() - m
+    gc.enable()
+    return m
+
+
+N = 200
+
+# warm up, then measure the memory taken by one float per iteration
+single(1, 1.5, 2.5)
+expr(1, 1.5, 2.5, 3.5, 4.5, 5.5)
+unit = measure(single, N, 1.5, 2.5)
+if unit < N:
+    # floats are not allocated on the heap
+    print("SKIP")
+    raise SystemExit
+
+# the expression makes four floats per iteration, but c * d and the sum are
+# temporaries whose objects are reused by the next operation, so only two of
+# them are allocated
+print(measure(expr, N, 1.5, 2.5, 3.5, 4.5, 5.5) < 3 * unit)
+print(expr(2, 1.5, 2.5, 3.5, 4.5, 5.5))
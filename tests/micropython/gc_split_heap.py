@@ -0,0 +1,41 @@
+# test that objects spread over all the areas of a split heap, and pointing
+# from one area to another, survive collections
+
+import gc
+
+
+def make(i):
+    b = bytearray(SIZE)
+    for k in range(0, SIZE, 7):
+        b[k] = (i + k) & 0xFF
+    return b
+
+
+def check(chunks):
+    return all(c is None or all(b == make(c[0] + k) for k, b in enumerate(c[1])) for c in chunks)
+
+
+SIZE = 400
+CHUNK = 16
+
+# fill about three quarters of the heap, so a heap split into a few areas has
+# live objects in all of them
+gc.collect()
+n = (gc.mem_alloc() + gc.mem_free()) * 3 // 4 // (SIZE + 48) // CHUNK
+chunks = [(i * CHUNK, [make(i * CHUNK + k) for k in range(CHUNK)]) for i in range(n)]
+gc.collect()
+gc.collect()
+print(check(chunks))
+
+# free every other chunk and allocate new objects into the holes, with garbage
+# in between
+for i in range(0, n, 2):
+    chunks[i] = None
+gc.collect()
+for i in range(0, n, 2):
+    [i] * 20
+    chunks[i] = (i * CHUNK + 1, [make(i * CHUNK + 1 + k) for k in range(CHUNK)])
+gc.collect()
+print(check(chunks))
+chunks = None
+gc.collect()
@@ -0,0 +1,57 @@
+# test lazy sweeping of the heap after collections started by gc.threshold()
+
+import gc
+
+try:
+    gc.sweep_step
+    gc.threshold
+    gc.pause_info
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+
+def make(i):
+    return bytearray((i + k) & 0xFF for k in range(i % 40 + 1))
+
+
+def check(objs):
+    return all(objs[i] == make(i) for i in range(len(objs)))
+
+
+gc.collect()
+gc.sweep_step(256)
+print(gc.sweep_step())
+gc.threshold(2048)
+
+# allocate during pending sweeps, mixing garbage and live objects of all
+# sizes, so new chains land on both sides of the sweep position
+live = []
+for i in range(2000):
+    [i] * (i % 20)
+    live.append(make(i))
+print(check(live))
+
+# gc.collect() with a sweep pending finishes it, then collects again
+for i in range(200):
+    [i] * 16
+    live.append(make(len(live)))
+gc.collect()
+print(check(live))
+
+# drop and grow objects while the sweep is pending
+for i in range(0, len(live), 3):
+    live[i] = None
+for i in range(500):
+    live.append(make(len(live)))
+    live[-1].extend(b"x")
+print(all(live[i] == make(i) + b"x" for i in range(2200, len(live))))
+live = None
+
+gc.threshold(-1)
+gc.sweep_step(0)
+print(gc.sweep_step())
+
+# collections and sweep steps were counted
+n_pause, last_pause, max_pause, n_step, max_step = gc.pause_info()
+print(n_pause > 0, last_pause <= max_pause, n_step > 0)
@@ -0,0 +1,40 @@
+# test micropython.heap_profile()
+
+import micropython
+
+if not hasattr(micropython, "heap_profile"):
+    print("SKIP")
+    raise SystemExit
+
+
+# the line of the list comprehension in alloc(), update it if lines move
+ALLOC_LINE = 15
+
+
+def alloc(n):
+    return [bytearray(200) for _ in range(n)]
+
+
+def site(prof, name):
+    for s in prof:
+        if s[2] == name:
+            return s
+
+
+# allocations are attributed to the line and function that made them
+keep = alloc(20)
+prof = micropython.heap_profile()
+s = site(prof, "<listcomp>")
+print(s[1] == ALLOC_LINE, s[3] >= 20 * 200, s[4] >= 20, s[5] >= s[3], s[6] >= s[4])
+
+# freed objects are no longer live, but still count as allocated
+keep = None
+import gc
+
+gc.collect()
+s = site(micropython.heap_profile(True), "<listcomp>")
+print(s[3] < 20 * 200, s[5] >= 20 * 200)
+
+# the totals were restarted by the previous call
+s = site(micropython.heap_profile(), "<listcomp>")
+print(s is None or s[5] == 0)
@@ -0,0 +1,32 @@
+# test micropython.inline_cache_stats
+
+import micropython
+
+try:
+    micropython.inline_cache_stats
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+
+class A:
+    def __init__(self):
+        self.x = 1
+
+
+def f(a):
+    total = 0
+    for _ in range(100):
+        total += a.x
+    return total
+
+
+a = A()
+micropython.inline_cache_stats(True)
+f(a)
+hits, misses = micropython.inline_cache_stats(True)
+print(hits >= 99, misses <= 2)
+
+# the counts were reset above
+hits, misses = micropython.inline_cache_stats()
+print(hits < 10, misses < 10)
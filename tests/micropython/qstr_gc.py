@@ -0,0 +1,83 @@
+# test that qstrs created at runtime stay valid across collections, on ports
+# where the collector frees the unused ones
+
+import gc
+
+try:
+    from collections import namedtuple
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+
+class A:
+    pass
+
+
+def make(n, prefix):
+    a = A()
+    for i in range(n):
+        setattr(a, "%s_%d" % (prefix, i), i)
+    return a
+
+
+# names that are dropped, then created again
+for k in range(3):
+    a = make(50, "drop")
+    del a
+    gc.collect()
+    gc.collect()
+a = make(50, "drop")
+print(sum(getattr(a, "drop_%d" % i) for i in range(50)))
+
+# names that are kept while others come and go
+keep = make(50, "keep")
+for k in range(3):
+    make(50, "temp%d" % k)
+    gc.collect()
+print(sum(getattr(keep, "keep_%d" % i) for i in range(50)))
+print(sorted(n for n in dir(keep) if n.startswith("keep_1"))[:3])
+
+# a class, a namedtuple and a function with runtime names
+C = type("Class" + "Name", (), {"meth" + "od": lambda self: 1})
+T = namedtuple("Tuple" + "Name", ["field" + "_a", "field" + "_b"])
+g = {}
+exec("def func" + "_name(x):\n    return x + 1", g)
+gc.collect()
+make(100, "more")
+gc.collect()
+print(C.__name__, C().method())
+print(T(1, 2), T(1, 2).field_b)
+print("func_name" in g, g["func_name"](1))
+
+# a name only held by an exception
+try:
+    raise AttributeError("attr" + "_name")
+except AttributeError as e:
+    exc = e
+gc.collect()
+print(exc)
+
+# interned strings only held by live objects keep their text and still work as
+# names once other qstrs have been freed
+held = [n for n in dir(make(20, "held")) if n.startswith("held_")]
+held.sort(key=lambda n: int(n[5:]))
+gc.collect()
+make(200, "churn")
+gc.collect()
+gc.collect()
+print(held == ["held_%d" % i for i in range(20)])
+b = A()
+for n in held:
+    setattr(b, n, len(n))
+print(sum(getattr(b, "held_%d" % i) for i in range(20)))
+
+# names held as dict keys and in a list
+d = {"key_%d" % i: i for i in range(10)}
+l = [getattr(keep, "keep_%d" % i) for i in range(5)]
+names = dir(keep)
+del keep
+gc.collect()
+make(100, "again")
+gc.collect()
+print(sum(d.values()), l, len([n for n in names if n.startswith("keep_")]))
@@ -0,0 +1,38 @@
+# test that micropython.qstr_info() reports the qstrs freed by a collection
+# (run on the coverage build, which enables MICROPY_QSTR_GC)
+
+import gc
+import micropython
+
+
+class A:
+    pass
+
+
+def make(n, prefix):
+    a = A()
+    for i in range(n):
+        setattr(a, "%s_%d" % (prefix, i), i)
+    return a
+
+
+# names only held by an object that is dropped
+def churn(prefix):
+    a = make(400, prefix)
+    return getattr(a, prefix + "_399")
+
+
+# nothing has been collected yet
+micropython.qstr_info(1)
+
+# the dropped names are freed
+print(churn("reclaimed_name"))
+for i in range(2):
+    gc.collect()
+micropython.qstr_info(1)
+
+# names still in use are kept
+keep = make(400, "kept_name")
+for i in range(2):
+    gc.collect()
+print(sum(getattr(keep, "kept_name_%d" % i) for i in range(400)))
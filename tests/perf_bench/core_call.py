@@ -0,0 +1,51 @@
+# This tests calls to bytecode functions with positional args, including ones
+# whose frame is too big for the C stack and recursive ones
+
+
+def add(x, y):
+    return x + y
+
+
+def big(x):
+    # Enough locals that the frame of this function is allocated on the heap
+    a = b = c = d = e = f = g = h = i = j = x
+    return a + b + c + d + e + f + g + h + i + j
+
+
+def fib(n):
+    if n < 2:
+        return n
+    return fib(n - 1) + fib(n - 2)
+
+
+def test(niter, nfib):
+    total = 0
+    for n in range(niter):
+        total = add(total, n)
+        total += big(n)
+    return total + fib(nfib)
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (50, 10): (300, 10),
+    (100, 10): (1000, 12),
+    (1000, 10): (10000, 16),
+    (5000, 10): (200000, 22),
+}
+
+
+def bm_setup(params):
+    niter, nfib = params
+    state = None
+
+    def run():
+        nonlocal state
+        state = test(niter, nfib)
+
+    def result():
+        return niter, state
+
+    return run, result
@@ -0,0 +1,66 @@
+# This tests method calls, special methods and class attribute reads on
+# instances of a class that inherits most of them from its bases
+
+
+class Base:
+    scale = 3
+
+    def value(self):
+        return self.n
+
+    def __add__(self, other):
+        return self.n + other.n
+
+    def __eq__(self, other):
+        return self.n == other.n
+
+    def __getitem__(self, i):
+        return self.n + i
+
+
+class Middle(Base):
+    def double(self):
+        return self.value() * 2
+
+
+class Leaf(Middle):
+    def __init__(self, n):
+        self.n = n
+
+
+def test(niter, objs):
+    total = 0
+    for _ in range(niter):
+        for a in objs:
+            total += a.double() + a.value() * a.scale
+            total += (a + a) + a[1]
+            total += a == objs[0]
+    return total
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (32, 10): (10, 10),
+    (50, 10): (20, 10),
+    (100, 10): (40, 10),
+    (500, 10): (200, 10),
+    (1000, 10): (400, 10),
+    (5000, 10): (2000, 10),
+}
+
+
+def bm_setup(params):
+    niter, nobj = params
+    objs = [Leaf(i) for i in range(nobj)]
+    state = None
+
+    def run():
+        nonlocal state
+        state = test(niter, objs)
+
+    def result():
+        return niter * nobj, state
+
+    return run, result
@@ -0,0 +1,46 @@
+# This tests the allocation of small objects on a fragmented heap
+
+
+def test(niter, nkeep):
+    # Keep every other one of many single-block objects alive, leaving holes
+    # that the (multi-block) tuples below have to skip over
+    keep = [i + 0.5 for i in range(nkeep * 2)]
+    keep = keep[::2]
+    total = 0
+    for i in range(niter):
+        a = (i, i, i)
+        b = (i, i, i, i, i, i, i)
+        c = (i, i, i, i, i, i, i, i, i, i, i, i, i, i, i)
+        d = (i, i, i, i, i, i, i, i, i, i, i, i, i, i, i, i, i, i, i, i, i, i, i, i, i, i)
+        total += len(a) + len(b) + len(c) + len(d)
+    return total + len(keep)
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (32, 10): (200, 100),
+    (50, 10): (400, 100),
+    (100, 10): (1000, 100),
+    (500, 10): (5000, 100),
+    (1000, 10): (10000, 100),
+    (5000, 10): (50000, 100),
+    (100, 100): (1000, 1000),
+    (1000, 1000): (10000, 10000),
+    (5000, 1000): (50000, 10000),
+}
+
+
+def bm_setup(params):
+    niter, nkeep = params
+    state = None
+
+    def run():
+        nonlocal state
+        state = test(niter, nkeep)
+
+    def result():
+        return niter, state
+
+    return run, result
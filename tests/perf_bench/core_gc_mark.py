@@ -0,0 +1,43 @@
+# This tests the time taken to mark many live objects, eg with a split heap
+
+import gc
+
+
+def test(niter):
+    for _ in range(niter):
+        gc.collect()
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (100, 100): (1000, 10),
+    (1000, 1000): (10000, 10),
+    (5000, 1000): (10000, 50),
+    (1000, 64000): (200000, 10),
+}
+
+
+def bm_setup(params):
+    nobj, niter = params
+
+    # A long chain of small live objects, each holding a pointer to the next
+    # and a pointer to a small int and to a string, all of which the mark
+    # phase has to look up in the heap
+    head = None
+    for i in range(nobj):
+        head = [head, i, "x"]
+
+    def run():
+        test(niter)
+
+    def result():
+        n = 0
+        x = head
+        while x is not None:
+            x = x[0]
+            n += 1
+        return nobj, n
+
+    return run, result
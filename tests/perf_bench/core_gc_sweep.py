@@ -0,0 +1,40 @@
+# This tests the time taken to sweep a large heap, eg run with --heapsize 64M
+
+import gc
+
+
+def test(niter):
+    for _ in range(niter):
+        gc.collect()
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (100, 100): (1000, 10),
+    (1000, 1000): (10000, 10),
+    (1000, 64000): (1000000, 10),
+    (5000, 64000): (1000000, 50),
+}
+
+
+def bm_setup(params):
+    nobj, niter = params
+
+    # Spread small objects over the heap and keep one in a hundred alive, so
+    # the first collection frees most of them and the following ones sweep a
+    # sparse heap up to its last used block
+    keep = []
+    for i in range(nobj):
+        x = (i,)
+        if i % 100 == 0:
+            keep.append(x)
+
+    def run():
+        test(niter)
+
+    def result():
+        return nobj, len(keep)
+
+    return run, result
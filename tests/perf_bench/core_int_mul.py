@@ -0,0 +1,53 @@
+# This tests multiplication of big ints: a factorial built by binary splitting,
+# squaring, and a modular exponentiation with a 4096-bit modulus.
+
+
+def product(lo, hi):
+    # product of lo..hi-1, splitting the range so the multiplied ints have similar sizes
+    if hi - lo <= 8:
+        r = 1
+        for i in range(lo, hi):
+            r *= i
+        return r
+    mid = (lo + hi) // 2
+    return product(lo, mid) * product(mid, hi)
+
+
+def test(niter, nfact):
+    total = 0
+    m = (1 << 4096) - 159
+    b = 3**2584
+    e = 5**1764
+    for _ in range(niter):
+        f = product(2, nfact + 1)
+        s = f * f
+        total += (f + s) % 1000000007
+        total += pow(b, e, m) % 1000000007
+    return total
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (32, 10): (1, 100),
+    (50, 10): (1, 200),
+    (100, 10): (1, 500),
+    (500, 10): (1, 2000),
+    (1000, 10): (1, 5000),
+    (5000, 10): (2, 5000),
+}
+
+
+def bm_setup(params):
+    niter, nfact = params
+    state = None
+
+    def run():
+        nonlocal state
+        state = test(niter, nfact)
+
+    def result():
+        return niter * nfact, state
+
+    return run, result
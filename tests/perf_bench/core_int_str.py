@@ -0,0 +1,38 @@
+# This tests conversion of big ints to and from decimal strings.
+
+
+def test(niter, nbits):
+    x = 7 ** (nbits * 100 // 281)
+    total = 0
+    for _ in range(niter):
+        s = str(x)
+        y = int(s)
+        total += len(s) + len("{:,}".format(y)) + (x == y)
+    return total
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (32, 10): (2, 1000),
+    (50, 10): (2, 2000),
+    (100, 10): (2, 5000),
+    (500, 10): (2, 20000),
+    (1000, 10): (2, 50000),
+    (5000, 10): (5, 100000),
+}
+
+
+def bm_setup(params):
+    niter, nbits = params
+    state = None
+
+    def run():
+        nonlocal state
+        state = test(niter, nbits)
+
+    def result():
+        return niter * nbits, state
+
+    return run, result
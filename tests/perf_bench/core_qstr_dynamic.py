@@ -0,0 +1,33 @@
+# This tests qstr_find_strn() speed when many qstrs have been interned at
+# runtime, eg run with --heapsize 16M.  The cost of a lookup should not
+# depend on the number of dynamic qstrs.
+
+
+def test(r):
+    for i in r:
+        "not interned %d" % i
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (32, 10): (400, 100),
+    (1000, 10): (4000, 1000),
+    (5000, 10): (40000, 1000),
+    (5000, 1000): (40000, 20000),
+}
+
+
+def bm_setup(params):
+    nloop, nqstr = params
+
+    # Intern names at runtime, they go in the dynamic qstr pools
+    class A:
+        pass
+
+    a = A()
+    for i in range(nqstr):
+        setattr(a, "name%d" % i, None)
+
+    return lambda: test(range(nloop)), lambda: (nloop // 100, None)
@@ -0,0 +1,45 @@
+# This tests sorting lists which are random, sorted, reversed or have few unique
+# values, with and without a key function
+
+
+def test(niter, lists):
+    total = 0
+    for _ in range(niter):
+        for l in lists:
+            a = sorted(l)
+            b = sorted(l, key=lambda x: -x)
+            total += a[len(a) // 2] + b[len(b) // 2]
+    return total
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (32, 10): (1, 50),
+    (50, 10): (1, 100),
+    (100, 10): (1, 200),
+    (500, 10): (2, 500),
+    (1000, 10): (4, 500),
+    (5000, 10): (4, 2000),
+}
+
+
+def bm_setup(params):
+    niter, n = params
+    x = 1
+    rand = []
+    for _ in range(n):
+        x = (x * 1103515245 + 12345) & 0x3FFFFFFF
+        rand.append(x >> 10)
+    lists = [rand, list(range(n)), list(range(n, 0, -1)), [v % 4 for v in rand]]
+    state = None
+
+    def run():
+        nonlocal state
+        state = test(niter, lists)
+
+    def result():
+        return niter * n, state
+
+    return run, result
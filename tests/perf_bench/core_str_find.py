@@ -0,0 +1,45 @@
+# This tests searching a large string with find, count, split, replace and in
+
+
+def test(niter, text):
+    total = 0
+    for _ in range(niter):
+        total += text.count("ERROR")
+        total += text.find("timeout waiting for device")
+        total += len(text.split("\n"))
+        total += len(text.replace("status=ok", "status=OK"))
+        total += ("segmentation fault" in text) + text.rfind("sensor 17")
+    return total
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (32, 10): (2, 20),
+    (50, 10): (4, 20),
+    (100, 10): (4, 50),
+    (500, 10): (10, 100),
+    (1000, 10): (20, 100),
+    (5000, 10): (50, 200),
+}
+
+
+def bm_setup(params):
+    niter, nline = params
+    lines = []
+    for i in range(nline):
+        level = "ERROR" if i % 17 == 0 else "INFO"
+        lines.append("%d %s sensor %d read value=%d status=ok" % (i, level, i % 13, i * 7))
+    lines.append("0 ERROR timeout waiting for device")
+    text = "\n".join(lines)
+    state = None
+
+    def run():
+        nonlocal state
+        state = test(niter, text)
+
+    def result():
+        return niter * len(text), state
+
+    return run, result
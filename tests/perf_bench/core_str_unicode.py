@@ -0,0 +1,39 @@
+# This tests indexing and slicing a long non-ASCII string by character position
+
+
+def test(niter, nchar):
+    s = "".join(chr(0x3b1 + i % 25) for i in range(nchar))
+    total = 0
+    for _ in range(niter):
+        for i in range(len(s)):
+            total += ord(s[i])
+        for i in range(0, len(s) - 8, 8):
+            total += len(s[i : i + 8])
+    return total
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (32, 10): (1, 100),
+    (50, 10): (1, 200),
+    (100, 10): (1, 500),
+    (500, 10): (4, 1000),
+    (1000, 10): (4, 2000),
+    (5000, 10): (4, 8000),
+}
+
+
+def bm_setup(params):
+    niter, nchar = params
+    state = None
+
+    def run():
+        nonlocal state
+        state = test(niter, nchar)
+
+    def result():
+        return niter * nchar, state
+
+    return run, result
@@ -334,6 +334,7 @@ special_tests = [
     base_path(file)
     for file in (
         "micropython/meminfo.py",
+        "micropython/qstr_gc_info.py",
         "basics/bytes_compare3.py",
         "basics/builtin_help.py",
         "thread/thread_exc2.py",
@@ -783,6 +784,7 @@ def run_tests(pyb, tests, args, result_dir, num_threads=1):
         skip_tests.add("cmdline/cmd_parsetree.py")
         skip_tests.add("cmdline/repl_sys_ps1_ps2.py")
         skip_tests.add("extmod/ssl_poll.py")
+        skip_tests.add("micropython/qstr_gc_info.py")  # needs MICROPY_QSTR_GC
 
     # Skip thread mutation tests on targets that don't have the GIL.
     if args.platform in PC_PLATFORMS + ("rp2",):
@@ -819,6 +821,9 @@ def run_tests(pyb, tests, args, result_dir, num_threads=1):
         skip_tests.add("basics/del_deref.py")  # requires checking for unbound local
         skip_tests.add("basics/del_local.py")  # requires checking for unbound local
         skip_tests.add("basics/exception_chain.py")  # raise from is not supported
+        skip_tests.add(
+            "basics/op_superinstructions_unbound.py"
+        )  # requires checking for unbound local
         skip_tests.add("basics/scope_implicit.py")  # requires checking for unbound local
         skip_tests.add("basics/sys_tracebacklimit.py")  # requires traceback info
         skip_tests.add("basics/try_finally_return2.py")  # requires raise_varargs
@@ -840,6 +845,9 @@ def run_tests(pyb, tests, args, result_dir, num_threads=1):
         skip_tests.add(
             "micropython/opt_level_lineno.py"
         )  # native doesn't have proper traceback info
+        skip_tests.add(
+            "micropython/float_temp_reuse_alloc.py"
+        )  # native code doesn't reuse float temporaries
         skip_tests.add("micropython/schedule.py")  # native code doesn't check pending events
         skip_tests.add("stress/bytecode_limit.py")  # bytecode specific test
 
@@ -0,0 +1,55 @@
+# test indexing and slicing long strings, far from either end
+
+s = "aé€😀" * 40 + "z"
+n = len(s)
+print(n)
+
+# every index, forwards and backwards, against iteration
+chars = list(s)
+print(all(s[i] == chars[i] for i in range(n)))
+print(all(s[-i] == chars[-i] for i in range(1, n + 1)))
+
+# slices crossing and clamped to the ends
+print(s[33:41], s[-41:-33])
+print(s[100:] == "".join(chars[100:]), s[:-100] == "".join(chars[:-100]))
+print(len(s[-1000:1000]), len(s[1000:]), len(s[:-1000]))
+
+# out of range
+for i in (n, -n - 1, 1000, -1000):
+    try:
+        s[i]
+    except IndexError:
+        print("IndexError", i)
+
+# start and end arguments of find are character indices
+print(s.find("😀", 50), s.find("a", 100, 160), s.count("€", 40, -40))
+
+# long ASCII string and several strings indexed in turn
+a = "0123456789" * 20
+t = "é" * 100
+print(a[150], a[-150], t[70], s[70], a[70], t[-50], len(t[50:-20]))
+
+# more long strings indexed in turn than the index cache holds: the results stay
+# right and an index isn't built, and allocated, on every access
+try:
+    import gc
+
+    gc.mem_alloc
+except (ImportError, AttributeError):
+    gc = None
+for k in (3, 4, 8):
+    ss = [str(j) + "aé€😀" * 40 for j in range(k)]
+    if gc:
+        gc.collect()
+        gc.disable()
+        m = gc.mem_alloc()
+    ok = True
+    for i in range(40, 160):
+        for u in ss:
+            ok = ok and u[i] == ss[0][i]
+    if gc:
+        m = gc.mem_alloc() - m
+        gc.enable()
+    else:
+        m = 0
+    print(k, ok, m < 4096)
@@ -87,7 +87,8 @@ class FreezeError(Exception):
 
 
 class Config:
-    MPY_VERSION = 6
+    MPY_VERSION = 7
+    MPY_VERSION_MIN = 6
     MPY_SUB_VERSION = 3
     MICROPY_LONGINT_IMPL_NONE = 0
     MICROPY_LONGINT_IMPL_LONGLONG = 1
@@ -114,6 +115,8 @@ MP_NATIVE_ARCH_ARMV7EMDP = 8
 MP_NATIVE_ARCH_XTENSA = 9
 MP_NATIVE_ARCH_XTENSAWIN = 10
 MP_NATIVE_ARCH_RV32IMC = 11
+MP_NATIVE_ARCH_DEBUG = 12
+MP_NATIVE_ARCH_SH4 = 13
 
 MP_PERSISTENT_OBJ_FUN_TABLE = 0
 MP_PERSISTENT_OBJ_NONE = 1
@@ -189,12 +192,12 @@ class Opcode:
     # fmt: off
     # Load, Store, Delete, Import, Make, Build, Unpack, Call, Jump, Exception, For, sTack, Return, Yield, Op
     MP_BC_BASE_RESERVED               = (0x00) # ----------------
-    MP_BC_BASE_QSTR_O                 = (0x10) # LLLLLLSSSDDII---
+    MP_BC_BASE_QSTR_O                 = (0x10) # LLLLLLSSSDDII-LL
     MP_BC_BASE_VINT_E                 = (0x20) # MMLLLLSSDDBBBBBB
-    MP_BC_BASE_VINT_O                 = (0x30) # UUMMCCCC--------
-    MP_BC_BASE_JUMP_E                 = (0x40) # J-JJJJJEEEEF----
+    MP_BC_BASE_VINT_O                 = (0x30) # UUMMCCCCOS------
+    MP_BC_BASE_JUMP_E                 = (0x40) # JJJJJJJEEEEF----
     MP_BC_BASE_BYTE_O                 = (0x50) # LLLLSSDTTTTTEEFF
-    MP_BC_BASE_BYTE_E                 = (0x60) # --BREEEYYI------
+    MP_BC_BASE_BYTE_E                 = (0x60) # OOBREEEYYI------
     MP_BC_LOAD_CONST_SMALL_INT_MULTI  = (0x70) # LLLLLLLLLLLLLLLL
     #                                 = (0x80) # LLLLLLLLLLLLLLLL
     #                                 = (0x90) # LLLLLLLLLLLLLLLL
@@ -274,6 +277,11 @@ class Opcode:
     MP_BC_STORE_COMP                  = (MP_BC_BASE_VINT_E + 0x0f) # uint
     MP_BC_UNPACK_SEQUENCE             = (MP_BC_BASE_VINT_O + 0x00) # uint
     MP_BC_UNPACK_EX                   = (MP_BC_BASE_VINT_O + 0x01) # uint
+    MP_BC_FORMAT_VALUE                = (MP_BC_BASE_VINT_O + 0x0a) # uint
+    MP_BC_BUILD_STRING                = (MP_BC_BASE_VINT_O + 0x0b) # uint
+
+    MP_BC_BINARY_OP_TEMP              = (MP_BC_BASE_BYTE_E + 0x00)
+    MP_BC_BINARY_OP_TEMP_RESULT       = (MP_BC_BASE_BYTE_E + 0x01)
 
     MP_BC_RETURN_VALUE                = (MP_BC_BASE_BYTE_E + 0x03)
     MP_BC_RAISE_LAST                  = (MP_BC_BASE_BYTE_E + 0x04)
@@ -294,11 +302,18 @@ class Opcode:
     MP_BC_IMPORT_NAME                 = (MP_BC_BASE_QSTR_O + 0x0b) # qstr
     MP_BC_IMPORT_FROM                 = (MP_BC_BASE_QSTR_O + 0x0c) # qstr
     MP_BC_IMPORT_STAR                 = (MP_BC_BASE_BYTE_E + 0x09)
+
+    MP_BC_LOAD_FAST_LOAD_ATTR         = (MP_BC_BASE_QSTR_O + 0x0e) # qstr; then a byte
+    MP_BC_LOAD_FAST_LOAD_METHOD       = (MP_BC_BASE_QSTR_O + 0x0f) # qstr; then a byte
+    MP_BC_LOAD_FAST_BINARY_OP_SMALL_INT = (MP_BC_BASE_VINT_O + 0x08) # uint
+    MP_BC_STORE_FAST_LOAD_FAST        = (MP_BC_BASE_VINT_O + 0x09) # uint
+    MP_BC_BINARY_OP_POP_JUMP_IF       = (MP_BC_BASE_JUMP_E + 0x01) # signed relative bytecode offset; then a byte
     # fmt: on
 
     # Create sets of related opcodes.
     ALL_OFFSET_SIGNED = (
         MP_BC_UNWIND_JUMP,
+        MP_BC_BINARY_OP_POP_JUMP_IF,
         MP_BC_JUMP,
         MP_BC_POP_JUMP_IF_TRUE,
         MP_BC_POP_JUMP_IF_FALSE,
@@ -376,7 +391,7 @@ def mp_opcode_decode(bytecode, ip):
             ip += 2
             if opcode in Opcode.ALL_OFFSET_SIGNED:
                 arg -= 0x4000
-    if opcode & MP_BC_MASK_EXTRA_BYTE == 0:
+    if opcode & MP_BC_MASK_EXTRA_BYTE == 0 or opcode & 0xFE == Opcode.MP_BC_LOAD_FAST_LOAD_ATTR:
         extra_arg = bytecode[ip]
         ip += 1
     return f, ip - ip_start, arg, extra_arg
@@ -1083,6 +1098,9 @@ class RawCodeNative(RawCode):
             MP_NATIVE_ARCH_RV32IMC,
         ):
             self.fun_data_attributes = '__attribute__((section(".text,\\"ax\\",@progbits # ")))'
+        elif config.native_arch == MP_NATIVE_ARCH_SH4:
+            # "!" starts a comment in SuperH assembly.
+            self.fun_data_attributes = '__attribute__((section(".text,\\"ax\\",@progbits ! ")))'
         else:
             self.fun_data_attributes = '__attribute__((section(".text,\\"ax\\",%progbits @ ")))'
 
@@ -1093,8 +1111,9 @@ class RawCodeNative(RawCode):
             MP_NATIVE_ARCH_ARMV6,
             MP_NATIVE_ARCH_XTENSA,
             MP_NATIVE_ARCH_XTENSAWIN,
+            MP_NATIVE_ARCH_SH4,
         ):
-            # ARMV6 or Xtensa -- four byte align.
+            # ARMV6, Xtensa or SH-4 (constants embedded in the code) -- four byte align.
             self.fun_data_attributes += " __attribute__ ((aligned (4)))"
         elif (
             MP_NATIVE_ARCH_ARMV6M <= config.native_arch <= MP_NATIVE_ARCH_ARMV7EMDP
@@ -1354,7 +1373,7 @@ def read_mpy(filename):
         header = reader.read_bytes(4)
         if header[0] != ord("M"):
             raise MPYReadError(filename, "not a valid .mpy file")
-        if header[1] != config.MPY_VERSION:
+        if not config.MPY_VERSION_MIN <= header[1] <= config.MPY_VERSION:
             raise MPYReadError(filename, "incompatible .mpy version")
         feature_byte = header[2]
         mpy_native_arch = feature_byte >> 2
@@ -1705,7 +1724,7 @@ def merge_mpy(compiled_modules, output_file):
 
         header = bytearray(4)
         header[0] = ord("M")
-        header[1] = config.MPY_VERSION
+        header[1] = max(cm.header[1] for cm in compiled_modules)
         header[2] = config.native_arch << 2 | config.MPY_SUB_VERSION if config.native_arch else 0
         header[3] = config.mp_small_int_bits
         merged_mpy.extend(header)